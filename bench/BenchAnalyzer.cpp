@@ -0,0 +1,31 @@
+#include "BenchUtils.h"
+#include "objects/FlowSimulationAnalyzer.h"
+
+using namespace BenchUtils;
+
+// sampling the particle counts and velocities of each bin
+static void BM_AnalyzerSample(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), false};
+    FlowSimulationAnalyzer fsa{box.pc, 50, 0, box.args.domainSize[0], 1, "bench_statistics", "bench_csv", true};
+    for (auto _ : state) {
+        fsa.sample();
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+// computing (and resetting) the averaged densities and velocities
+static void BM_AnalyzerEvaluate(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), false};
+    FlowSimulationAnalyzer fsa{box.pc, 50, 0, box.args.domainSize[0], 1, "bench_statistics", "bench_csv", false};
+    for (auto _ : state) {
+        fsa.calculateDensitiesAndVelocities();
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+BENCHMARK(BM_AnalyzerSample)->Name("AnalyzerSample")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_AnalyzerEvaluate)->Name("AnalyzerEvaluate")->Apply(syntheticArgs)->UseRealTime();
@@ -0,0 +1,47 @@
+#include "BenchUtils.h"
+#include "strategies/BoundaryConditions.h"
+#include "strategies/ForceCalculation.h"
+#include <optional>
+
+using namespace BenchUtils;
+
+// complete linked cell time steps with the given condition on every side. particles are accelerated towards the
+// walls, so that the boundary handling (reflection, wrapping, deletion) is actually exercised
+template <BoundaryCondition C> static void BM_Boundary(benchmark::State &state) {
+    constexpr size_t steps = 10;
+    setThreads(state.range(3));
+    const TimeIntegrationFuncs ti{SimulationType::LJ, true, StepFeatures{static_cast<size_t>(state.range(2))}};
+    std::optional<Box> box;
+    size_t particles = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        box.reset(); // destroy the previous box outside of the measurement
+        box.emplace(state.range(0), state.range(1), state.range(2), true, C);
+        for (auto &p : box->pc)
+            p.setV({p.getX()[0] < box->args.domainSize[0] / 2 ? -200. : 200., 0., 0.});
+        particles = box->pc.size();
+        state.ResumeTiming();
+        for (size_t i = 0; i < steps; ++i)
+            box->step(ti, calculateF_LennardJones_LC);
+    }
+    setCounters(state, particles, steps);
+}
+
+// creating and removing the ghost particles of periodic boundaries
+static void BM_PeriodicGhosts(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), true, BoundaryCondition::PERIODIC};
+    for (auto _ : state) {
+        mirrorGhostParticles(box.cells());
+        deleteGhostParticles(box.cells());
+    }
+    setCounters(state, box.pc.size());
+}
+
+BENCHMARK(BM_Boundary<BoundaryCondition::OUTFLOW>)->Name("BoundaryOutflow")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_Boundary<BoundaryCondition::REFLECTIVE>)
+    ->Name("BoundaryReflective")
+    ->Apply(syntheticArgs)
+    ->UseRealTime();
+BENCHMARK(BM_Boundary<BoundaryCondition::PERIODIC>)->Name("BoundaryPeriodic")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_PeriodicGhosts)->Name("PeriodicGhosts")->Apply(syntheticArgs)->UseRealTime();
@@ -0,0 +1,85 @@
+#include "BenchUtils.h"
+#include "strategies/ForceCalculation.h"
+#include "strategies/PositionCalculation.h"
+#include "strategies/VelocityCalculation.h"
+#include <optional>
+
+using namespace BenchUtils;
+
+// one force evaluation with the given kernel on a synthetic cuboid
+template <StrategyFactory::FFunc F, bool LC> static void BM_Force(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), LC};
+    for (auto _ : state) {
+        F(box.pc, box.args.cutoffRadius, box.cells());
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+// the direct-sum kernels are quadratic, so they only get small sizes
+static void directArgs(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"n", "density", "dim", "threads"});
+    for (int64_t n : {10, 20, 30, 40})
+        b->Args({n, 80, 2, 1});
+    for (int64_t n : {5, 8, 11})
+        b->Args({n, 80, 3, 1});
+}
+
+// membrane force (harmonic bonds, upward force and repulsive lennard-jones) on a 2D membrane in 3D space
+static void BM_ForceMembrane(benchmark::State &state) {
+    setThreads(state.range(1));
+    Box box{state.range(0), 100, 2, true, BoundaryCondition::REFLECTIVE, true};
+    for (auto _ : state) {
+        calculateF_Membrane_LC(box.pc, box.args.cutoffRadius, box.cells());
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+// complete simulations of 100 steps, continuing the historical results in bench/*.csv
+template <bool LC> static void BM_Simulation(benchmark::State &state) {
+    constexpr size_t steps = 100;
+    setThreads(1);
+    const TimeIntegrationFuncs ti{SimulationType::LJ, LC, StepFeatures{2}};
+    const StrategyFactory::FFunc f = LC ? calculateF_LennardJones_LC : calculateF_LennardJones;
+    std::optional<Box> box;
+    size_t particles = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        box.reset(); // destroy the previous box outside of the measurement
+        box.emplace(state.range(0), 80, 2, LC);
+        particles = box->pc.size();
+        state.ResumeTiming();
+        for (size_t i = 0; i < steps; ++i)
+            box->step(ti, f);
+    }
+    setCounters(state, particles, steps);
+}
+
+BENCHMARK(BM_Force<calculateF_Gravity, false>)->Name("ForceGravity")->Apply(directArgs);
+BENCHMARK(BM_Force<calculateF_LennardJones, false>)->Name("ForceLJ")->Apply(directArgs);
+BENCHMARK(BM_Force<calculateF_LennardJones_LC, true>)->Name("ForceLJ_LC")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_Force<calculateF_LennardJones_LC_task, true>)
+    ->Name("ForceLJ_LC_task")
+    ->Apply(syntheticArgs)
+    ->UseRealTime();
+BENCHMARK(BM_Force<calculateF_LennardJones_LC_cluster, true>)
+    ->Name("ForceLJ_LC_cluster")
+    ->Apply(syntheticArgs)
+    ->UseRealTime();
+BENCHMARK(BM_Force<calculateF_LennardJones_LC_tree, true>)
+    ->Name("ForceLJ_LC_tree")
+    ->Apply(syntheticArgs)
+    ->UseRealTime();
+BENCHMARK(BM_Force<calculateF_LennardJones_LC_levels, true>)
+    ->Name("ForceLJ_LC_levels")
+    ->Apply(syntheticArgs)
+    ->UseRealTime();
+BENCHMARK(BM_ForceMembrane)
+    ->Name("ForceMembrane_LC")
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{25, 50, 100}, threads})
+    ->UseRealTime();
+BENCHMARK(BM_Simulation<false>)->Name("LJNaive")->DenseRange(10, 40, 10)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Simulation<true>)->Name("LJLCNaive")->DenseRange(10, 40, 10)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,45 @@
+#include "BenchUtils.h"
+#include "io/input/XMLReader.h"
+#include "objects/FlowSimulationAnalyzer.h"
+#include "objects/Thermostat.h"
+#include "strategies/VelocityCalculation.h"
+#include <string>
+
+using namespace BenchUtils;
+
+// time steps of a simulation read from one of the input files, including thermostat and analyzer, but no output
+static void BM_Input(benchmark::State &state, const std::string &filename) {
+    constexpr int steps = 10;
+    setThreads(state.range(0));
+    ParticleContainer pc;
+    Arguments args;
+    Thermostat t{pc};
+    FlowSimulationAnalyzer fsa{pc};
+    XMLReader reader{std::string(BENCH_INPUT_DIR) + "/" + filename};
+    reader.readXML(args, pc, t, fsa);
+
+    std::unique_ptr<CellContainer> lc;
+    if (args.linkedCells)
+        lc = std::make_unique<CellContainer>(args.domainSize, args.conditions, args.cutoffRadius, pc, args.dimensions);
+    auto [ti, f] = StrategyFactory::getSimulationFunctions(args, pc);
+
+    int iteration = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < steps; ++i, ++iteration) {
+            if (fsa.getFrequency() > 0 && iteration > 0 && iteration % fsa.getFrequency() == 0)
+                fsa.sample();
+            t.updateSystemTemp(iteration);
+            ti.xf(pc, args.delta_t, args.gravity, lc.get(), args.membrane);
+            f(pc, args.cutoffRadius, lc.get());
+            ti.vf(pc, args.delta_t);
+        }
+    }
+    setCounters(state, pc.size(), steps);
+}
+
+BENCHMARK_CAPTURE(BM_Input, w3t2_small, "input-lj-w3t2-small.xml")->ArgName("threads")->ArgsProduct({threads});
+BENCHMARK_CAPTURE(BM_Input, w3t4, "input-lj-w3t4.xml")->ArgName("threads")->ArgsProduct({threads});
+BENCHMARK_CAPTURE(BM_Input, w4t2_small, "input-lj-w4t2-small.xml")->ArgName("threads")->ArgsProduct({threads});
+BENCHMARK_CAPTURE(BM_Input, w5t1, "input-lj-w5t1.xml")->ArgName("threads")->ArgsProduct({threads});
+BENCHMARK_CAPTURE(BM_Input, w5t3_coarse, "input-lj-w5t3-coarse.xml")->ArgName("threads")->ArgsProduct({threads});
+BENCHMARK_CAPTURE(BM_Input, w5t4_normal, "input-lj-w5t4-normal.xml")->ArgName("threads")->ArgsProduct({threads});
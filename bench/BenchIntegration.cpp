@@ -0,0 +1,88 @@
+#include "BenchUtils.h"
+#include "objects/Thermostat.h"
+#include "strategies/ForceCalculation.h"
+#include "strategies/PositionCalculation.h"
+#include "strategies/VelocityCalculation.h"
+
+using namespace BenchUtils;
+
+// position update of the direct-sum simulation
+static void BM_PositionUpdate(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), false};
+    for (auto _ : state) {
+        calculateX(box.pc, box.args.delta_t, box.args.gravity);
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+// position update of the linked cell simulation, including moving particles between cells
+static void BM_PositionUpdateLC(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), true};
+    for (auto _ : state) {
+        calculateX_LC(box.pc, box.args.delta_t, box.args.gravity, box.cells());
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+// plain velocity update
+static void BM_VelocityUpdate(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), false};
+    for (auto _ : state) {
+        calculateV(box.pc, box.args.delta_t);
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+// velocity update fused with gathering the kinetic sums for the thermostat
+static void BM_VelocityUpdateThermostat(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), false};
+    for (auto _ : state) {
+        KineticSums sums;
+        calculateV_Thermostat(box.pc, box.args.delta_t, sums);
+        benchmark::DoNotOptimize(sums);
+    }
+    setCounters(state, box.pc.size());
+}
+
+// one complete linked cell time step (position, force, velocity), either with the loops specialized for the box or
+// with the loops supporting all particles
+template <bool DETECT> static void BM_Step(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), true};
+    const StepFeatures features =
+        DETECT ? StepFeatures::detect(box.args, box.pc) : StepFeatures{static_cast<size_t>(state.range(2))};
+    const TimeIntegrationFuncs ti{SimulationType::LJ, true, features};
+    for (auto _ : state) {
+        box.step(ti, calculateF_LennardJones_LC);
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+// one complete linked cell time step with a cell skin of 0.3, which only sorts particles into cells again once they
+// may have left their cell
+static void BM_StepSkin(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), true, BoundaryCondition::REFLECTIVE, false, 0.3};
+    const TimeIntegrationFuncs ti{SimulationType::LJ, true, StepFeatures::detect(box.args, box.pc)};
+    for (auto _ : state) {
+        box.step(ti, calculateF_LennardJones_LC);
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+BENCHMARK(BM_PositionUpdate)->Name("PositionUpdate")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_PositionUpdateLC)->Name("PositionUpdate_LC")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_VelocityUpdate)->Name("VelocityUpdate")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_VelocityUpdateThermostat)->Name("VelocityUpdateThermostat")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_Step<true>)->Name("Step_LC")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_Step<false>)->Name("Step_LC_Generic")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_StepSkin)->Name("Step_LC_Skin")->Apply(syntheticArgs)->UseRealTime();
@@ -0,0 +1,70 @@
+#include "BenchUtils.h"
+#include "objects/Disc.h"
+#include "objects/Thermostat.h"
+#include <optional>
+
+using namespace BenchUtils;
+
+// thermostat application (kinetic sums, temperature, scaling), standard or nano-scale flow variant
+template <bool NanoFlow> static void BM_Thermostat(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), false};
+    Thermostat t{box.pc, static_cast<int>(state.range(2)), 40, 1, 45, INFINITY, false, NanoFlow};
+    int step = 1;
+    for (auto _ : state) {
+        t.updateSystemTemp(step++);
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+// initializing the velocities of all particles with brownian motion
+static void BM_BrownianMotion(benchmark::State &state) {
+    setThreads(state.range(3));
+    Box box{state.range(0), state.range(1), state.range(2), false};
+    Thermostat t{box.pc, static_cast<int>(state.range(2)), 40, 1, 45, INFINITY, true};
+    for (auto _ : state) {
+        t.initializeBrownianMotion();
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, box.pc.size());
+}
+
+// generating the particles of a cuboid or disc, including their initial velocities
+template <bool IsDisc> static void BM_Generate(benchmark::State &state) {
+    setThreads(state.range(1));
+    std::optional<ParticleContainer> pc;
+    size_t particles = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        pc.emplace();
+        state.ResumeTiming();
+        if constexpr (IsDisc) {
+            Disc d{*pc, {0., 0., 0.}, static_cast<int>(state.range(0)), {0., 0., 0.}, 1.1225, 1.0};
+            d.initialize(2);
+        } else {
+            const size_t n = static_cast<size_t>(state.range(0));
+            Cuboid c{*pc, {0., 0., 0.}, {n, n, n}, {0., 0., 0.}, 1.1225, 1.0};
+            c.initialize(3);
+        }
+        particles = pc->size();
+        state.PauseTiming();
+        pc.reset();
+        state.ResumeTiming();
+    }
+    setCounters(state, particles);
+}
+
+BENCHMARK(BM_Thermostat<false>)->Name("Thermostat")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_Thermostat<true>)->Name("ThermostatNanoFlow")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_BrownianMotion)->Name("BrownianMotion")->Apply(syntheticArgs)->UseRealTime();
+BENCHMARK(BM_Generate<false>)
+    ->Name("GenerateCuboid")
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{20, 50, 100}, threads})
+    ->UseRealTime();
+BENCHMARK(BM_Generate<true>)
+    ->Name("GenerateDisc")
+    ->ArgNames({"r", "threads"})
+    ->ArgsProduct({{50, 200, 500}, threads})
+    ->UseRealTime();
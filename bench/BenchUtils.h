@@ -0,0 +1,150 @@
+/**
+ * @file BenchUtils.h
+ * @brief Shared setup for the Google Benchmark suite.
+ * @date 2025-02-03
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "objects/CellContainer.h"
+#include "objects/Cuboid.h"
+#include "objects/ParticleContainer.h"
+#include "strategies/StrategyFactory.h"
+#include "utils/Arguments.h"
+#include "utils/CellUtils.h"
+#include "utils/OMPWrapper.h"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// @brief Namespace containing the synthetic workloads and helpers shared by all benchmarks.
+namespace BenchUtils {
+/// @brief Particles per side of the synthetic cuboids, in 2D.
+inline const std::vector<int64_t> sizes2D{20, 50, 100, 200};
+/// @brief Particles per side of the synthetic cuboids, in 3D.
+inline const std::vector<int64_t> sizes3D{10, 20, 40};
+/// @brief Reduced number densities of the synthetic cuboids, scaled by 100.
+inline const std::vector<int64_t> densities{50, 80};
+/// @brief OpenMP thread counts.
+inline const std::vector<int64_t> threads{1, 2, 4, 8};
+
+/**
+ * @brief A synthetic, densely packed Lennard-Jones cuboid inside a matching linked cell domain.
+ *
+ * The spacing follows from the requested density, the domain is one spacing larger than the cuboid in every
+ * dimension. Particles are initialized with the regular thermal motion of a cuboid.
+ */
+class Box {
+  public:
+    /// @brief The particles of the box.
+    ParticleContainer pc;
+    /// @brief The arguments describing the box (domain, cutoff, dimensions, ...).
+    Arguments args;
+    /// @brief The cell container, or nullptr for direct-sum benchmarks.
+    std::unique_ptr<CellContainer> lc;
+
+    /**
+     * @brief Construct a new box.
+     *
+     * @param perSide The number of particles per side.
+     * @param density The reduced number density, scaled by 100.
+     * @param dimensions The number of dimensions, 2 or 3.
+     * @param linkedCells Whether a cell container is created.
+     * @param condition The boundary condition applied at every side of the domain.
+     * @param membrane Whether the cuboid is a membrane (neighbours, constant upward force).
+     * @param skin The skin of the cell container.
+     */
+    Box(int64_t perSide, int64_t density, int64_t dimensions, bool linkedCells,
+        BoundaryCondition condition = BoundaryCondition::REFLECTIVE, bool membrane = false, double skin = 0.0) {
+        const double h = std::pow(100. / density, 1. / dimensions);
+        const size_t n = static_cast<size_t>(perSide);
+        const size_t nz = dimensions == 3 ? n : 1;
+        const double z = dimensions == 3 ? h / 2 : 0.5;
+        Cuboid c{pc, {h / 2, h / 2, z}, {n, n, nz}, {0., 0., 0.}, h, 1.0, 0, 1., 1., membrane ? 300. : 0.,
+                 membrane ? h : 0., membrane ? 0.8 : 0.};
+        if (membrane)
+            c.getSpecialCases() = {{static_cast<int>(n / 2), static_cast<int>(n / 2), 0}};
+        c.initialize(dimensions);
+        if (membrane)
+            c.initializeNeighbours();
+        pc.setSpecialForceLimit(1 << 30);
+
+        args.dimensions = dimensions;
+        args.delta_t = 0.0005;
+        args.cutoffRadius = 3.0;
+        args.linkedCells = linkedCells;
+        args.membrane = membrane;
+        args.domainSize = {n * h, n * h, dimensions == 3 ? nz * h : 1.};
+        args.conditions.fill(condition);
+        if (linkedCells)
+            lc = std::make_unique<CellContainer>(args.domainSize, args.conditions, args.cutoffRadius, pc, dimensions,
+                                                 1.0, 0.0, skin);
+    }
+
+    /// @brief Returns the cell container, or nullptr for direct-sum benchmarks.
+    CellContainer *cells() { return lc.get(); }
+
+    /**
+     * @brief Perform one time step (position, force, velocity), just like the main simulation loop.
+     *
+     * @param ti The time integration functions.
+     * @param f The force function.
+     */
+    void step(const TimeIntegrationFuncs &ti, StrategyFactory::FFunc f) {
+        ti.xf(pc, args.delta_t, args.gravity, cells(), args.membrane);
+        f(pc, args.cutoffRadius, cells());
+        ti.vf(pc, args.delta_t);
+    }
+};
+
+/**
+ * @brief Set the number of OpenMP threads used by the kernels, and the static schedule used by simulations. Has no
+ * effect without OpenMP.
+ *
+ * @param threads The number of threads.
+ */
+inline void setThreads(int64_t threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(static_cast<int>(threads));
+    omp_set_schedule(omp_sched_static, 0);
+#else
+    (void)threads;
+#endif
+}
+
+/**
+ * @brief Report the workload size alongside the timings, as the historical CSV results did.
+ *
+ * Items processed are particle updates, so items_per_second corresponds to molecule updates per second.
+ *
+ * @param state The benchmark state.
+ * @param particles The number of particles.
+ * @param steps The number of steps per iteration.
+ */
+inline void setCounters(benchmark::State &state, size_t particles, size_t steps = 1) {
+    state.counters["NumParticles"] = static_cast<double>(particles);
+    state.counters["Steps"] = static_cast<double>(steps);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * particles * steps));
+}
+
+/**
+ * @brief Apply the full synthetic parameter space (size, density, dimensions, threads) to a benchmark.
+ *
+ * @param b The benchmark.
+ */
+inline void syntheticArgs(benchmark::internal::Benchmark *b) {
+    b->ArgNames({"n", "density", "dim", "threads"});
+    for (int64_t t : threads) {
+        for (int64_t d : densities) {
+            for (int64_t n : sizes2D)
+                b->Args({n, d, 2, t});
+            for (int64_t n : sizes3D)
+                b->Args({n, d, 3, t});
+        }
+    }
+}
+} // namespace BenchUtils
@@ -0,0 +1,27 @@
+#include "BenchUtils.h"
+#include "io/output/FileWriter.h"
+#include "io/output/WriterFactory.h"
+
+using namespace BenchUtils;
+
+// writing one output frame with the given writer type, synchronously; files are written to the working directory.
+// the nil writer is left out, since it only logs to stdout
+static void BM_Writer(benchmark::State &state) {
+    Box box{state.range(0), 80, state.range(1), false};
+    auto writer = WriterFactory::createWriter(static_cast<WriterType>(state.range(2)), "bench", 0, false,
+                                              state.range(3) != 0);
+    int iteration = 0;
+    for (auto _ : state) {
+        writer->writeParticles(box.pc, iteration++, 1 << 30);
+    }
+    writer->flush();
+    setCounters(state, box.pc.size());
+}
+
+BENCHMARK(BM_Writer)
+    ->Name("Writer")
+    ->ArgNames({"n", "dim", "type", "compress"})
+    ->ArgsProduct({{50, 200}, {2}, {0, 1, 2, 3}, {0, 1}})
+    ->ArgsProduct({{10, 40}, {3}, {0, 1, 2, 3}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -313,6 +313,22 @@ if [[ "${can_check_for_pkgs}" = true ]]; then
     fi
   fi
 
+  echo -n "[BUILD] Checking if Google Benchmark is installed... "
+  if pkg-config --list-all | grep -qw benchmark; then
+    echo "found."
+  else
+    if [[ "${install_opt}" = true ]]; then
+      echo "not found! Installing using apt-get..."
+      if [[ "${has_updated_apt}" == "false" ]]; then
+        sudo apt-get update
+        has_updated_apt=true
+      fi
+      sudo apt-get install -y libbenchmark-dev || echo "[BUILD] Failed to get Google Benchmark, will be fetched during compilation."
+    else
+      echo "not found! Will be fetched during compilation..."
+    fi
+  fi
+
   echo -n "[BUILD] Checking if spdlog is installed... "
   if pkg-config --list-all | grep -qw spdlog; then
     echo "found."
@@ -7,4 +7,34 @@ if(ENABLE_BENCHMARKING)
     add_compile_definitions(DO_BENCHMARKING)
 else()
     message(STATUS "Benchmarking DISABLED")
+endif()
+
+# latest version as of 03.02.2025: 1.9.1
+set(BENCHMARK_VERSION 1.9.1)
+
+# by default, do not build the google benchmark suite (make target "bench")
+option(ENABLE_BENCH_SUITE "Build the Google Benchmark suite" OFF)
+
+if(ENABLE_BENCH_SUITE)
+    # if google benchmark is not installed, fetch via git repo
+    message(CHECK_START "Searching for Google Benchmark")
+    find_package(benchmark QUIET)
+
+    if (NOT benchmark_FOUND)
+        message(CHECK_FAIL "not found, fetching from GitHub...")
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+        include(FetchContent)
+        FetchContent_Declare(
+            googlebenchmark
+            GIT_REPOSITORY "https://github.com/google/benchmark.git"
+            GIT_TAG v${BENCHMARK_VERSION}
+        )
+        FetchContent_MakeAvailable(googlebenchmark)
+    else()
+        message(CHECK_PASS "found")
+    endif()
+else()
+    message(STATUS "Benchmark suite DISABLED")
 endif()
\ No newline at end of file
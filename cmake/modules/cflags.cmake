@@ -23,9 +23,17 @@ macro(check_and_set_flag flag var)
     endif()
 endmacro()
 
+# portable kernels for several x86-64 levels, selected at startup (GCC 12+), instead of tuning for the build machine
+option(ENABLE_CPU_DISPATCH "Build hot kernels for several x86-64 levels and select one at runtime" OFF)
+if(ENABLE_CPU_DISPATCH)
+    message(STATUS "Runtime CPU dispatch ENABLED")
+    add_compile_definitions(CPU_DISPATCH)
+else()
+    check_and_set_flag("-march=native" march_supported)
+    check_and_set_flag("-mtune=native" mtune_supported)
+endif()
+
 # typical optimizations
-check_and_set_flag("-march=native" march_supported)
-check_and_set_flag("-mtune=native" mtune_supported)
 check_and_set_flag("-fdata-sections" fdatasec_supported)
 check_and_set_flag("-ffunction-sections" ffuncsec_supported)
 check_and_set_flag("-fno-math-errno" fme_supported)
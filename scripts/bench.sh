@@ -0,0 +1,57 @@
+#!/bin/bash
+
+# NOTE:
+# this script is only for personal use and assumes that necessary dependencies are already available.
+# as such, there are no checks made that the script will run flawlessly on your machine.
+
+# usage: ./bench.sh [-b <baseline.json>] [-f <filter>] [-s]
+#   -b <file>   : compares the results against a previously stored baseline using google benchmark's compare.py.
+#   -f <filter> : only runs benchmarks matching the given regex (passed to --benchmark_filter).
+#   -s          : stores the results as the new baseline (bench/baselines/<hostname>.json).
+
+# get directory of script, regardless of where the script is called from
+# source: https://stackoverflow.com/a/246128
+SCRIPT_DIR=$(cd -- "$(dirname -- "${BASH_SOURCE[0]}")" &>/dev/null && pwd)
+cd "${SCRIPT_DIR}/.."
+
+baseline=""
+filter="."
+store=false
+while getopts "b:f:s" opt; do
+  case ${opt} in
+  b) baseline=$(realpath "${OPTARG}") ;;
+  f) filter="${OPTARG}" ;;
+  s) store=true ;;
+  *) exit 1 ;;
+  esac
+done
+
+if [[ ! -x build/bench/bench ]]; then
+  echo "[BENCH] build/bench/bench not found, configure with -DENABLE_BENCH_SUITE=ON and build the 'bench' target first."
+  exit 1
+fi
+
+# run from a scratch directory, since the writer benchmarks generate output files
+mkdir -p bench/results
+result="$(pwd)/bench/results/$(date +%Y%m%d-%H%M%S).json"
+scratch=$(mktemp -d)
+(cd "${scratch}" && "${OLDPWD}/build/bench/bench" --benchmark_filter="${filter}" --benchmark_out="${result}" \
+  --benchmark_out_format=json --benchmark_repetitions=3 --benchmark_report_aggregates_only=true) || exit 1
+rm -rf "${scratch}"
+echo "[BENCH] Results written to ${result}."
+
+if [[ "${store}" = true ]]; then
+  mkdir -p bench/baselines
+  cp "${result}" "bench/baselines/$(hostname).json"
+  echo "[BENCH] Stored results as baseline bench/baselines/$(hostname).json."
+fi
+
+if [[ -n "${baseline}" ]]; then
+  # compare.py is shipped with google benchmark; it is available once the library has been fetched
+  compare=$(find build/_deps /usr/share -path '*benchmark*' -name compare.py 2>/dev/null | head -1)
+  if [[ -z "${compare}" ]]; then
+    echo "[BENCH] compare.py not found, cannot compare against baseline."
+    exit 1
+  fi
+  python3 "${compare}" benchmarks "${baseline}" "${result}"
+fi
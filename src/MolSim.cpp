@@ -1,4 +1,5 @@
 #include "io/input/CLIParser.h"
+#include "io/input/CheckpointReader.h"
 #include "io/input/XMLReader.h"
 #include "objects/FlowSimulationAnalyzer.h"
 #include "objects/ParticleContainer.h"
@@ -47,9 +48,14 @@ int main(int argc, char *argv[]) {
     Thermostat t{pc};
     FlowSimulationAnalyzer fsa{pc};
 
-    // parse xml file first, then parse command line arguments
-    XMLReader r(argv[argc - 1]);
-    r.readXML(args, pc, t, fsa);
+    // parse input file (checkpoint or xml) first, then parse command line arguments
+    if (CheckpointReader::isCheckpoint(argv[argc - 1])) {
+        CheckpointReader r(argv[argc - 1]);
+        args.startIteration = r.readCheckpoint(args, pc, t, fsa);
+    } else {
+        XMLReader r(argv[argc - 1]);
+        r.readXML(args, pc, t, fsa);
+    }
     CLIParser::parseArguments(argc, argv, args);
 
     // create simulation and run with parsed arguments
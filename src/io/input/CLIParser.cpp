@@ -36,6 +36,8 @@ void CLIParser::checkValidity(const Arguments &args) {
     if (args.itFreq <= 0) {
         CLIUtils::error("Output frequency must be positive!");
     }
+    if (args.checkpointFreq < 0)
+        CLIUtils::error("Checkpoint frequency must not be negative!");
 }
 
 void CLIParser::setDefaults(Arguments &args) {
@@ -60,11 +62,15 @@ void CLIParser::setDefaults(Arguments &args) {
     // type-specific options
     switch (args.type) {
     case WriterType::VTK:
+    case WriterType::VTKB:
         args.basename = args.argsSet.test(3) ? args.basename : "MD_vtk";
         break;
     case WriterType::XYZ:
         args.basename = args.argsSet.test(3) ? args.basename : "MD_xyz";
         break;
+    case WriterType::TRAJ:
+        args.basename = args.argsSet.test(3) ? args.basename : "MD_traj";
+        break;
     case WriterType::NIL: /* ignored */
         args.basename = args.argsSet.test(3) ? args.basename : "MD_nil";
         break;
@@ -121,10 +127,26 @@ void CLIParser::parseArguments(int argc, char **argv, Arguments &args) {
             args.cutoffRadius = StringUtils::toDouble(optarg);
             SPDLOG_DEBUG("Set cutoff radius to {}.", args.cutoffRadius);
             break;
+        case 'C': /* cell size factor */
+            args.cellSizeFactor = StringUtils::toDouble(optarg);
+            if (args.cellSizeFactor <= 0)
+                CLIUtils::error("Cell size factor must be positive!");
+            SPDLOG_DEBUG("Set cell size factor to {}.", args.cellSizeFactor);
+            break;
+        case 'K': /* cell skin */
+            args.cellSkin = StringUtils::toDouble(optarg);
+            if (args.cellSkin < 0)
+                CLIUtils::error("Cell skin must not be negative!");
+            SPDLOG_DEBUG("Set cell skin to {}.", args.cellSkin);
+            break;
         case 'f': /* output frequency */
             args.itFreq = StringUtils::toInt(optarg);
             SPDLOG_DEBUG("Set output frequency to {}.", args.itFreq);
             break;
+        case 'c': /* checkpoint frequency */
+            args.checkpointFreq = StringUtils::toInt(optarg);
+            SPDLOG_DEBUG("Set checkpoint frequency to {}.", args.checkpointFreq);
+            break;
         case 'o': /* output type */
             args.type = StringUtils::toWriterType(optarg);
             SPDLOG_DEBUG("Set output type to {}.", optarg);
@@ -133,6 +155,53 @@ void CLIParser::parseArguments(int argc, char **argv, Arguments &args) {
             args.parallelization = StringUtils::toParallelizationType(optarg);
             SPDLOG_DEBUG("Set parallelization type to {}.", optarg);
             break;
+        case 'S': /* pair search type */
+            args.pairSearch = StringUtils::toPairSearchType(optarg);
+            SPDLOG_DEBUG("Set pair search type to {}.", optarg);
+            break;
+        case 'L': /* pair cutoff factor */
+            args.pairCutoffFactor = StringUtils::toDouble(optarg);
+            if (args.pairCutoffFactor <= 0)
+                CLIUtils::error("Pair cutoff factor must be positive!");
+            SPDLOG_DEBUG("Set pair cutoff factor to {}.", args.pairCutoffFactor);
+            break;
+        case 'A': /* auto-tuning */
+            args.autoTune = true;
+            args.tuneInterval = StringUtils::toInt(optarg);
+            if (args.tuneInterval < 0)
+                CLIUtils::error("Auto-tuning interval must not be negative!");
+            SPDLOG_DEBUG("Enabled auto-tuning with interval {}.", args.tuneInterval);
+            break;
+        case 'q': /* output queue depth */
+        {
+            const int depth = StringUtils::toInt(optarg);
+            if (depth < 0)
+                CLIUtils::error("Output queue depth must not be negative!");
+            args.outputQueue = static_cast<size_t>(depth);
+            SPDLOG_DEBUG("Set output queue depth to {}.", args.outputQueue);
+            break;
+        }
+        case 'P': /* output precision */
+        {
+            const int bits = StringUtils::toInt(optarg);
+            if (bits != 32 && bits != 64)
+                CLIUtils::error("Output precision must be either 32 or 64!");
+            args.doublePrecision = (bits == 64);
+            SPDLOG_DEBUG("Set output precision to {} bits.", bits);
+            break;
+        }
+        case 'z': /* output compression */
+            args.compressOutput = true;
+            SPDLOG_DEBUG("Enabled output compression.");
+            break;
+        case 'T': /* phase profiling */
+            args.profilePhases = true;
+            SPDLOG_DEBUG("Enabled phase profiling.");
+            break;
+        case 'H': /* hardware counters */
+            args.profileCounters = true;
+            SPDLOG_DEBUG("Enabled hardware performance counters.");
+            break;
         case 't': /* simulation type */
             args.sim = StringUtils::toSimulationType(optarg);
             SPDLOG_DEBUG("Set simulation type to {}.", optarg);
@@ -165,6 +234,7 @@ void CLIParser::parseArguments(int argc, char **argv, Arguments &args) {
     SPDLOG_TRACE("optind: {}, argc: {}", optind, argc);
     if (optind != (argc - 1))
         CLIUtils::error("Invalid syntax - no file input provided!");
+    args.inputFile = argv[argc - 1];
 
     // finally, set default values and check numerical argument validity and return arguments if all goes well
     setDefaults(args);
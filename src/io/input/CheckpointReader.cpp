@@ -0,0 +1,176 @@
+#include "CheckpointReader.h"
+#include "utils/CLIUtils.h"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace CheckpointFormat;
+
+CheckpointReader::CheckpointReader(const std::string &filename) : m_filename{filename} {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        CLIUtils::error("Error opening checkpoint file", filename, false);
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        CLIUtils::error("Not a checkpoint file", filename, false);
+    }
+    m_size = static_cast<size_t>(info.st_size);
+
+    void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping stays valid after closing the descriptor
+    if (data == MAP_FAILED)
+        CLIUtils::error("Failed to map checkpoint file into memory", filename, false);
+    madvise(data, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(data);
+    SPDLOG_TRACE("Generated CheckpointReader from file {} ({} bytes)", filename, m_size);
+}
+CheckpointReader::~CheckpointReader() {
+    if (m_data)
+        munmap(const_cast<char *>(m_data), m_size);
+    SPDLOG_TRACE("Destroyed CheckpointReader.");
+}
+
+bool CheckpointReader::isCheckpoint(const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(Magic)] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+const char *CheckpointReader::section(size_t offset, size_t size) const {
+    if (offset > m_size || size > m_size - offset)
+        CLIUtils::error("Checkpoint file is truncated", m_filename, false);
+    return m_data + offset;
+}
+
+int CheckpointReader::readCheckpoint(Arguments &args, ParticleContainer &pc, Thermostat &t,
+                                      FlowSimulationAnalyzer &fsa) {
+    SPDLOG_DEBUG("Reading from checkpoint file...");
+
+    // verify header
+    FileHeader header;
+    std::memcpy(&header, section(0, sizeof(header)), sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+        CLIUtils::error("Not a checkpoint file", m_filename, false);
+    if (header.byteOrder != ByteOrderMark)
+        CLIUtils::error("Checkpoint file was written with a different byte order", m_filename, false);
+    if (header.version != Version)
+        CLIUtils::error("Unsupported checkpoint version", std::to_string(header.version), false);
+
+    // locate sections
+    size_t offset = sizeof(FileHeader);
+    ArgsRecord a;
+    std::memcpy(&a, section(offset, sizeof(a)), sizeof(a));
+    offset += sizeof(a);
+    ThermostatRecord tr;
+    std::memcpy(&tr, section(offset, sizeof(tr)), sizeof(tr));
+    offset += sizeof(tr);
+    AnalyzerRecord ar;
+    std::memcpy(&ar, section(offset, sizeof(ar)), sizeof(ar));
+    offset += sizeof(ar);
+    if (header.particleCount > m_size / sizeof(ParticleRecord) || header.bondCount > m_size / sizeof(std::uint32_t) ||
+        ar.sumsCount > m_size / sizeof(double))
+        CLIUtils::error("Checkpoint file is truncated", m_filename, false);
+    const auto *records = reinterpret_cast<const ParticleRecord *>(
+        section(offset, header.particleCount * sizeof(ParticleRecord)));
+    offset += header.particleCount * sizeof(ParticleRecord);
+    const auto *bonds =
+        reinterpret_cast<const std::uint32_t *>(section(offset, header.bondCount * sizeof(std::uint32_t)));
+    offset += (header.bondCount + header.bondCount % 2) * sizeof(std::uint32_t);
+    const auto *sums = reinterpret_cast<const double *>(section(offset, 2 * ar.sumsCount * sizeof(double)));
+    offset += 2 * ar.sumsCount * sizeof(double);
+    const char *strings = section(offset, static_cast<size_t>(a.basenameLength) + ar.dirnameLength +
+                                              ar.basenameLength);
+
+    // arguments; mark times and basename as set so they are not replaced by defaults
+    args.startTime = header.time;
+    args.endTime = a.endTime;
+    args.delta_t = a.delta_t;
+    args.domainSize = a.domainSize;
+    args.cutoffRadius = a.cutoffRadius;
+    args.gravity = a.gravity;
+    args.cellSizeFactor = a.cellSizeFactor;
+    args.cellSkin = a.cellSkin;
+    args.pairCutoffFactor = a.pairCutoffFactor;
+    args.itFreq = a.itFreq;
+    args.checkpointFreq = a.checkpointFreq;
+    args.outputQueue = a.outputQueue;
+    args.dimensions = a.dimensions;
+    args.type = static_cast<WriterType>(a.type);
+    args.sim = static_cast<SimulationType>(a.sim);
+    args.parallelization = static_cast<ParallelizationType>(a.parallelization);
+    args.pairSearch = static_cast<PairSearchType>(a.pairSearch);
+    args.tuneInterval = a.tuneInterval;
+    for (size_t i = 0; i < a.conditions.size(); ++i)
+        args.conditions[i] = static_cast<BoundaryCondition>(a.conditions[i]);
+    args.linkedCells = a.linkedCells;
+    args.membrane = a.membrane;
+    args.doublePrecision = a.doublePrecision;
+    args.compressOutput = a.compressOutput;
+    args.autoTune = a.autoTune;
+    args.basename.assign(strings, a.basenameLength);
+    args.argsSet.set();
+    SPDLOG_DEBUG("Restored arguments: {}", args.toString());
+
+    // thermostat; velocities are never reinitialized when resuming
+    t.initialize(tr.dimension, tr.T_init, tr.n_thermostat, tr.T_target, tr.delta_T, false, tr.nanoFlow,
+                 tr.limitScaling);
+
+    // analyzer
+    if (ar.frequency > 0) {
+        if (ar.sumsCount != static_cast<std::uint64_t>(ar.binNumber))
+            CLIUtils::error("Checkpoint file contains inconsistent analyzer data", m_filename, false);
+        fsa.initialize(ar.binNumber, ar.leftWallPosX, ar.rightWallPosX, ar.frequency,
+                       std::string(strings + a.basenameLength, ar.dirnameLength),
+                       std::string(strings + a.basenameLength + ar.dirnameLength, ar.basenameLength), ar.accumulate);
+        fsa.restoreSamples(sums, sums + ar.sumsCount, ar.samples);
+    } else {
+        fsa.initialize(1, 0, 0, -1);
+    }
+
+    // particles, copied straight out of the mapping
+    pc.setSpecialForceLimit(header.specialForceLimit);
+    pc.reserve(pc.size() + header.particleCount);
+    std::vector<ParticleHandle> handles(header.particleCount);
+    for (std::uint64_t i = 0; i < header.particleCount; ++i) {
+        const ParticleRecord &r = records[i];
+        handles[i] = pc.addParticle(r.x, r.v, r.f, r.oldF, r.m, r.type, r.epsilon, r.sigma, r.k, r.r_0, r.fzup,
+                                    r.cellIndex);
+        pc.resolve(handles[i]).setThermalMotion(r.thermalMotion);
+    }
+
+    // bonds, translated from record indices to the newly assigned handles
+    if (header.bondCount > 0) {
+        std::vector<ParticleHandle> neighbours;
+        auto translate = [&](std::uint64_t first, std::uint32_t count) -> const std::vector<ParticleHandle> & {
+            if (first > header.bondCount || count > header.bondCount - first)
+                CLIUtils::error("Checkpoint file contains invalid bonds", m_filename, false);
+            neighbours.resize(count);
+            for (std::uint32_t j = 0; j < count; ++j) {
+                if (bonds[first + j] >= header.particleCount)
+                    CLIUtils::error("Checkpoint file contains invalid bonds", m_filename, false);
+                neighbours[j] = handles[bonds[first + j]];
+            }
+            return neighbours;
+        };
+        for (std::uint64_t i = 0; i < header.particleCount; ++i) {
+            const ParticleRecord &r = records[i];
+            Particle &p = pc.resolve(handles[i]);
+            p.setDirectNeighbours(translate(r.bondOffset, r.directCount));
+            p.setDiagonalNeighbours(translate(r.bondOffset + r.directCount, r.diagonalCount));
+        }
+    }
+
+    if (pc.size() == 0)
+        CLIUtils::error("No particles added!", "", false);
+
+    SPDLOG_INFO("Restored {} particles at t = {} (iteration {}) from checkpoint file {}.", header.particleCount,
+                header.time, header.iteration, m_filename);
+    return header.iteration;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file CheckpointReader.h
+ * @brief Class used to restore the simulation state from a binary checkpoint file.
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "io/output/CheckpointWriter.h"
+#include "objects/FlowSimulationAnalyzer.h"
+#include "objects/ParticleContainer.h"
+#include "objects/Thermostat.h"
+#include "utils/Arguments.h"
+#include <cstddef>
+#include <string>
+
+/// @brief Class used to restore the simulation state from a binary checkpoint file, which is mapped into memory.
+class CheckpointReader {
+  private:
+    /// @brief The name of the checkpoint file.
+    std::string m_filename;
+    /// @brief The memory mapping of the checkpoint file.
+    const char *m_data{nullptr};
+    /// @brief The size of the checkpoint file in bytes.
+    size_t m_size{0};
+
+    /**
+     * @brief Gets a pointer to a section of the mapped file. Terminates program execution if the file is too small.
+     *
+     * @param offset The offset of the section from the start of the file.
+     * @param size The size of the section in bytes.
+     * @return A pointer to the start of the section.
+     */
+    const char *section(size_t offset, size_t size) const;
+
+  public:
+    /**
+     * @brief Constructs a new CheckpointReader object and maps the checkpoint file into memory. Terminates program
+     * execution on error.
+     *
+     * @param filename The name of the checkpoint file.
+     */
+    explicit CheckpointReader(const std::string &filename);
+
+    /// @brief Unmaps the checkpoint file and destroys the CheckpointReader object.
+    ~CheckpointReader();
+
+    /**
+     * @brief Checks whether a file is a checkpoint file, i.e. starts with the checkpoint magic bytes.
+     *
+     * @param filename The name of the file to be checked.
+     * @return true if the file is a checkpoint file.
+     * @return false if the file cannot be opened or is not a checkpoint file.
+     */
+    static bool isCheckpoint(const std::string &filename);
+
+    /**
+     * @brief Restores the simulation state saved in the checkpoint file. Terminates program execution on error.
+     *
+     * @details The start time is set to the time at which the checkpoint was saved. The restored particles are appended
+     * to the given ParticleContainer in the order they were saved, together with their bonds.
+     *
+     * @param args The Arguments struct to be restored.
+     * @param pc The ParticleContainer to which the particles are added.
+     * @param t The thermostat to be restored.
+     * @param fsa The analyzer to be restored.
+     * @return The number of the iteration at which the checkpoint was saved, from which the simulation continues.
+     */
+    int readCheckpoint(Arguments &args, ParticleContainer &pc, Thermostat &t, FlowSimulationAnalyzer &fsa);
+};
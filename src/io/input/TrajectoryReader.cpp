@@ -0,0 +1,187 @@
+#include "TrajectoryReader.h"
+#include "utils/CLIUtils.h"
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <string>
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace TrajectoryFormat;
+
+TrajectoryReader::TrajectoryReader(const std::string &filename) {
+    m_infile.open(filename, std::ios::binary);
+    if (!m_infile.is_open())
+        CLIUtils::error("Error opening trajectory file", filename, false);
+
+    // verify header
+    readBytes(&m_header, sizeof(m_header));
+    if (std::memcmp(m_header.magic, Magic, sizeof(Magic)) != 0)
+        CLIUtils::error("Not a trajectory file", filename, false);
+    if (m_header.byteOrder != ByteOrderMark)
+        CLIUtils::error("Trajectory file was written with a different byte order", filename, false);
+#ifndef HAS_ZLIB
+    if (m_header.flags & FLAG_ZLIB)
+        CLIUtils::error("Reading compressed trajectories requires zlib, which was not found at compile time!", "",
+                        false);
+#endif
+
+    // load footer index if present, otherwise locate the frames manually
+    std::uint64_t frameCount = 0, indexOffset = 0;
+    char magic[sizeof(IndexMagic)] = {};
+    m_infile.seekg(0, std::ios::end);
+    const std::uint64_t fileSize = m_infile.tellg();
+    constexpr std::uint64_t trailerSize = 2 * sizeof(std::uint64_t) + sizeof(IndexMagic);
+    if (fileSize >= sizeof(m_header) + trailerSize) {
+        m_infile.seekg(fileSize - trailerSize);
+        readBytes(&frameCount, sizeof(frameCount));
+        readBytes(&indexOffset, sizeof(indexOffset));
+        readBytes(magic, sizeof(magic));
+    }
+    if (std::memcmp(magic, IndexMagic, sizeof(IndexMagic)) == 0) {
+        m_index.resize(frameCount);
+        m_infile.seekg(indexOffset);
+        readBytes(m_index.data(), frameCount * sizeof(IndexEntry));
+    } else {
+        SPDLOG_WARN("Trajectory file {} has no index, scanning frames...", filename);
+        scanFrames();
+    }
+    SPDLOG_DEBUG("Opened trajectory file {} with {} frames.", filename, m_index.size());
+}
+TrajectoryReader::~TrajectoryReader() = default;
+
+void TrajectoryReader::readBytes(void *data, size_t size) {
+    m_infile.read(static_cast<char *>(data), static_cast<std::streamsize>(size));
+    if (!m_infile)
+        CLIUtils::error("Failed to read from trajectory file!", "", false);
+}
+
+void TrajectoryReader::readChunk() {
+    std::uint64_t rawSize, storedSize;
+    readBytes(&rawSize, sizeof(rawSize));
+    readBytes(&storedSize, sizeof(storedSize));
+    m_raw.resize(rawSize);
+    if (!(m_header.flags & FLAG_ZLIB)) {
+        readBytes(m_raw.data(), rawSize);
+        return;
+    }
+#ifdef HAS_ZLIB
+    m_stored.resize(storedSize);
+    readBytes(m_stored.data(), storedSize);
+    uLongf size = rawSize;
+    if (uncompress(reinterpret_cast<Bytef *>(m_raw.data()), &size, reinterpret_cast<const Bytef *>(m_stored.data()),
+                   storedSize) != Z_OK ||
+        size != rawSize)
+        CLIUtils::error("Failed to decompress trajectory chunk!", "", false);
+#endif
+}
+
+void TrajectoryReader::readDoubles(std::vector<double> &data, bool delta) {
+    readChunk();
+    const size_t count = m_raw.size() / sizeof(double);
+    if (!delta) {
+        data.resize(count);
+        std::memcpy(data.data(), m_raw.data(), m_raw.size());
+        return;
+    }
+    if (data.size() != count)
+        CLIUtils::error("Corrupt delta frame in trajectory file!", "", false);
+    for (size_t i = 0; i < count; ++i) {
+        std::uint64_t current, last;
+        std::memcpy(&current, m_raw.data() + i * sizeof(double), sizeof(current));
+        std::memcpy(&last, data.data() + i, sizeof(last));
+        current ^= last;
+        std::memcpy(data.data() + i, &current, sizeof(current));
+    }
+}
+
+FrameHeader TrajectoryReader::readFrameAt(std::uint64_t offset, Frame &frame) {
+    m_infile.seekg(offset);
+    FrameHeader header;
+    readBytes(&header, sizeof(header));
+    if (header.columns != NUM_COLUMNS)
+        CLIUtils::error("Unsupported number of columns in trajectory frame!", "", false);
+
+    frame.iteration = header.iteration;
+    frame.total = header.total;
+    readDoubles(frame.positions, header.delta);
+    readDoubles(frame.velocities, header.delta);
+    readDoubles(frame.masses, false);
+
+    readChunk();
+    frame.types.resize(m_raw.size() / sizeof(std::int32_t));
+    for (size_t i = 0; i < frame.types.size(); ++i) {
+        std::int32_t type;
+        std::memcpy(&type, m_raw.data() + i * sizeof(type), sizeof(type));
+        frame.types[i] = type;
+    }
+
+    readChunk();
+    frame.ids.resize(m_raw.size() / sizeof(std::uint32_t));
+    std::memcpy(frame.ids.data(), m_raw.data(), m_raw.size());
+
+    frame.forces.assign(3 * header.size, 0.0);
+    return header;
+}
+
+void TrajectoryReader::scanFrames() {
+    m_index.clear();
+    m_infile.clear();
+    m_infile.seekg(0, std::ios::end);
+    const std::uint64_t fileSize = m_infile.tellg();
+    std::uint64_t offset = sizeof(m_header);
+    std::uint64_t keyframe = 0;
+
+    // walk the frames by skipping over their chunks; stop at the first incomplete frame
+    while (offset + sizeof(FrameHeader) <= fileSize) {
+        m_infile.seekg(offset);
+        FrameHeader header;
+        readBytes(&header, sizeof(header));
+        std::uint64_t next = offset + sizeof(header);
+        for (std::uint32_t c = 0; c < header.columns && next <= fileSize; ++c) {
+            std::uint64_t sizes[2];
+            if (next + sizeof(sizes) > fileSize) {
+                next = fileSize + 1;
+                break;
+            }
+            m_infile.seekg(next);
+            readBytes(sizes, sizeof(sizes));
+            next += sizeof(sizes) + sizes[1];
+        }
+        if (next > fileSize)
+            break;
+        if (!header.delta)
+            keyframe = m_index.size();
+        m_index.push_back({offset, keyframe, header.iteration});
+        offset = next;
+    }
+}
+
+size_t TrajectoryReader::frameCount() const { return m_index.size(); }
+
+int TrajectoryReader::getIteration(size_t index) const { return static_cast<int>(m_index.at(index).iteration); }
+
+void TrajectoryReader::readFrame(size_t index, Frame &frame) {
+    if (index >= m_index.size())
+        CLIUtils::error("Trajectory frame index out of range", std::to_string(index), false);
+
+    // reconstruct delta encoded frames starting from their keyframe
+    for (std::uint64_t i = m_index[index].keyframe; i <= index; ++i)
+        readFrameAt(m_index[i].offset, frame);
+}
+
+void TrajectoryReader::readFrames(size_t first, size_t last, const std::function<void(const Frame &)> &callback) {
+    if (first > last || last >= m_index.size())
+        CLIUtils::error("Trajectory frame range out of range", std::to_string(first) + ":" + std::to_string(last),
+                        false);
+
+    // only the first frame has to be reconstructed from its keyframe; delta encoded frames build on their predecessor
+    Frame frame;
+    readFrame(first, frame);
+    callback(frame);
+    for (size_t i = first + 1; i <= last; ++i) {
+        readFrameAt(m_index[i].offset, frame);
+        callback(frame);
+    }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file TrajectoryReader.h
+ * @brief Class used to read frames from a binary trajectory file.
+ * @date 2025-02-05
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "FileReader.h"
+#include "io/output/Frame.h"
+#include "io/output/TrajectoryWriter.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Class which implements random access to the frames of a trajectory file generated by the TrajectoryWriter.
+ *
+ * @details The frame offsets are taken from the footer index. If the index is missing (e.g. because the simulation was
+ * aborted), the frames are located by scanning the file once instead.
+ */
+class TrajectoryReader : public FileReader {
+  private:
+    /// @brief The header of the opened file.
+    TrajectoryFormat::FileHeader m_header{};
+    /// @brief The index entries of all frames in the file.
+    std::vector<TrajectoryFormat::IndexEntry> m_index;
+    /// @brief Reusable buffer for the stored bytes of a column.
+    std::vector<char> m_stored;
+    /// @brief Reusable buffer for the raw bytes of a column.
+    std::vector<char> m_raw;
+
+    /**
+     * @brief Reads raw bytes from the file. Terminates program execution on error.
+     *
+     * @param data The destination of the bytes.
+     * @param size The number of bytes to be read.
+     */
+    void readBytes(void *data, size_t size);
+
+    /// @brief Reads the next column chunk into m_raw, decompressing it if necessary.
+    void readChunk();
+
+    /**
+     * @brief Reads the next column chunk as floating point values, optionally XORing it with the current contents.
+     *
+     * @param data The column to be filled. For delta encoded chunks, this must contain the previous frame's column.
+     * @param delta Whether the chunk is delta encoded.
+     */
+    void readDoubles(std::vector<double> &data, bool delta);
+
+    /**
+     * @brief Reads the frame at the given file offset, applying it on top of the given frame if it is delta encoded.
+     *
+     * @param offset The offset of the frame from the start of the file.
+     * @param frame The frame to be filled.
+     * @return The header of the frame read.
+     */
+    TrajectoryFormat::FrameHeader readFrameAt(std::uint64_t offset, Frame &frame);
+
+    /// @brief Builds m_index by scanning all frames of the file.
+    void scanFrames();
+
+  public:
+    /**
+     * @brief Opens the trajectory file with the given name and loads its index. Terminates program execution on error.
+     *
+     * @param filename The name of the trajectory file.
+     */
+    explicit TrajectoryReader(const std::string &filename);
+
+    /// @brief Destroys the TrajectoryReader object and automatically closes the input stream.
+    virtual ~TrajectoryReader();
+
+    /**
+     * @brief Gets the number of frames in the trajectory file.
+     *
+     * @return The number of frames in the trajectory file.
+     */
+    size_t frameCount() const;
+
+    /**
+     * @brief Gets the iteration in which a given frame was captured.
+     *
+     * @param index The index of the frame.
+     * @return The iteration in which the frame was captured.
+     */
+    int getIteration(size_t index) const;
+
+    /**
+     * @brief Reads a given frame from the file. Terminates program execution on error.
+     *
+     * @details Delta encoded frames are reconstructed starting from their keyframe, i.e. at most KEYFRAME_INTERVAL
+     * frames are decoded. Forces are not stored in trajectories and are set to zero.
+     *
+     * @param index The index of the frame.
+     * @param frame The frame to be filled.
+     */
+    void readFrame(size_t index, Frame &frame);
+
+    /**
+     * @brief Reads a range of frames from the file in order. Terminates program execution on error.
+     *
+     * @details Unlike calling readFrame() for each index, only the first frame is reconstructed from its keyframe.
+     * Every following frame is decoded on top of its predecessor, so each frame in the range is decoded only once.
+     *
+     * @param first The index of the first frame.
+     * @param last The index of the last frame (inclusive).
+     * @param callback Function called with each frame, in order. The frame is overwritten afterwards.
+     */
+    void readFrames(size_t first, size_t last, const std::function<void(const Frame &)> &callback);
+};
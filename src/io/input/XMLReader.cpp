@@ -8,11 +8,21 @@
 #include "utils/CLIUtils.h"
 #include "utils/CellUtils.h"
 #include "utils/StringUtils.h"
+#include <algorithm>
 #include <array>
+#include <cstdlib>
+#include <exception>
 #include <memory>
 #include <spdlog/spdlog.h>
 #include <string>
 #include <vector>
+#include <xercesc/dom/DOM.hpp>
+#include <xercesc/framework/Wrapper4InputSource.hpp>
+#include <xsd/cxx/tree/error-handler.hxx>
+#include <xsd/cxx/xml/dom/bits/error-handler-proxy.hxx>
+#include <xsd/cxx/xml/elements.hxx>
+#include <xsd/cxx/xml/sax/std-input-source.hxx>
+#include <xsd/cxx/xml/string.hxx>
 
 #define LOAD_ARGS(_a, _b, _x)                                                                                          \
     if (_a._x().present()) {                                                                                           \
@@ -42,15 +52,6 @@
     }
 #define GET_IF_PRESENT(_a, _b, _c) (_a._b().present() ? _a._b().get() : _c)
 
-// helper function for reserving a certain amount of spaces in a particle container beforehand, if present
-static void reserveParticleContainer(ParticleContainer &pc, const std::unique_ptr<SimType> &xmlInput) {
-    if (xmlInput->totalParticles().present()) {
-        size_t totalParticles = static_cast<size_t>(xmlInput->totalParticles().get());
-        pc.reserve(totalParticles);
-        SPDLOG_DEBUG("Reserved space for {} particles...", totalParticles);
-    }
-}
-
 // helper function to read xml args into arguments struct
 static void readXMLArgs(Arguments &args, const std::unique_ptr<SimType> &xmlInput) {
     if (xmlInput->args().present()) {
@@ -115,108 +116,265 @@ static void initAnalyzer(const SimType::AnalyzerOptional &xmlAnalyzer, FlowSimul
     if (xmlAnalyzer.present()) {
         const auto &analyzer = xmlAnalyzer.get();
         fsa.initialize(analyzer.nBins(), analyzer.leftWallX(), analyzer.rightWallX(), analyzer.frequency(),
-                       GET_IF_PRESENT(analyzer, dirname, "statistics"), replaceExtensionsWithCSV(basename));
+                       GET_IF_PRESENT(analyzer, dirname, "statistics"), replaceExtensionsWithCSV(basename),
+                       GET_IF_PRESENT(analyzer, accumulate, false));
     } else {
         fsa.initialize(1, 0, 0, -1);
     }
 }
 
-// helper (wrapper) function to parse cuboids into a particle container
-static void parseCuboids(const SimType::ObjectsType &xmlObjects, const SimType::MembraneOptional &membrane,
-                         ParticleContainer &pc, size_t dimensions) {
-    for (const auto &cuboid : xmlObjects.cuboid()) {
-        std::array<double, 3> position{cuboid.position().x(), cuboid.position().y(), cuboid.position().z()};
-        std::array<double, 3> velocity{cuboid.velocity().x(), cuboid.velocity().y(), cuboid.velocity().z()};
-        std::array<size_t, 3> size{static_cast<size_t>(cuboid.size().x()), static_cast<size_t>(cuboid.size().y()),
-                                   static_cast<size_t>(cuboid.size().z())};
-        double distance = cuboid.distance();
-        double mass = cuboid.mass();
-        int type = cuboid.type().present() ? cuboid.type().get() : TYPE_DEFAULT;
-        double epsilon = cuboid.epsilon().present() ? cuboid.epsilon().get() : EPSILON_DEFAULT;
-        double sigma = cuboid.sigma().present() ? cuboid.sigma().get() : SIGMA_DEFAULT;
-        double k = membrane.present() ? membrane.get().stiffness() : K_DEFAULT;
-        double r_0 = membrane.present() ? membrane.get().avgBondLength() : R0_DEFAULT;
-        double fzup = membrane.present() ? membrane.get().zForce() : FZUP_DEFAULT;
-        std::vector<std::array<int, 3>> specialCases;
-        if (membrane.present()) {
-            for (const auto &scase : membrane.get().specialCase()) {
-                std::array<int, 3> caseArray = {scase.x(), scase.y(), scase.z()};
-                specialCases.push_back(caseArray);
-            }
-            if (membrane.get().scIterationLimit().present()) {
-                pc.setSpecialForceLimit(membrane.get().scIterationLimit().get());
-                SPDLOG_DEBUG("Set membrane upward force limit to {}", pc.getSpecialForceLimit());
-            }
+// helper (wrapper) function to parse a cuboid into a particle container
+static void parseCuboid(const CuboidType &cuboid, const SimType::MembraneOptional &membrane, ParticleContainer &pc,
+                        size_t dimensions) {
+    std::array<double, 3> position{cuboid.position().x(), cuboid.position().y(), cuboid.position().z()};
+    std::array<double, 3> velocity{cuboid.velocity().x(), cuboid.velocity().y(), cuboid.velocity().z()};
+    std::array<size_t, 3> size{static_cast<size_t>(cuboid.size().x()), static_cast<size_t>(cuboid.size().y()),
+                               static_cast<size_t>(cuboid.size().z())};
+    double distance = cuboid.distance();
+    double mass = cuboid.mass();
+    int type = cuboid.type().present() ? cuboid.type().get() : TYPE_DEFAULT;
+    double epsilon = cuboid.epsilon().present() ? cuboid.epsilon().get() : EPSILON_DEFAULT;
+    double sigma = cuboid.sigma().present() ? cuboid.sigma().get() : SIGMA_DEFAULT;
+    double k = membrane.present() ? membrane.get().stiffness() : K_DEFAULT;
+    double r_0 = membrane.present() ? membrane.get().avgBondLength() : R0_DEFAULT;
+    double fzup = membrane.present() ? membrane.get().zForce() : FZUP_DEFAULT;
+    std::vector<std::array<int, 3>> specialCases;
+    if (membrane.present()) {
+        for (const auto &scase : membrane.get().specialCase()) {
+            std::array<int, 3> caseArray = {scase.x(), scase.y(), scase.z()};
+            specialCases.push_back(caseArray);
         }
+        if (membrane.get().scIterationLimit().present()) {
+            pc.setSpecialForceLimit(membrane.get().scIterationLimit().get());
+            SPDLOG_DEBUG("Set membrane upward force limit to {}", pc.getSpecialForceLimit());
+        }
+    }
 
-        SPDLOG_DEBUG("Initializing cuboid with x: {}, v: {}, N: {}, h: {}, m: {}, eps: {}, sigma: {}, k: {}, r_0: {}, "
-                     "f_z-up: {}",
-                     ArrayUtils::to_string(position), ArrayUtils::to_string(velocity), ArrayUtils::to_string(size),
-                     distance, mass, epsilon, sigma, k, r_0, fzup);
+    SPDLOG_DEBUG("Initializing cuboid with x: {}, v: {}, N: {}, h: {}, m: {}, eps: {}, sigma: {}, k: {}, r_0: {}, "
+                 "f_z-up: {}",
+                 ArrayUtils::to_string(position), ArrayUtils::to_string(velocity), ArrayUtils::to_string(size),
+                 distance, mass, epsilon, sigma, k, r_0, fzup);
 
-        Cuboid cuboidObj{pc, position, size, velocity, distance, mass, type, epsilon, sigma, k, r_0, fzup};
-        cuboidObj.getSpecialCases() = specialCases;
-        cuboidObj.initialize(dimensions);
-        if (membrane.present()) {
-            cuboidObj.initializeNeighbours();
-        }
+    Cuboid cuboidObj{pc, position, size, velocity, distance, mass, type, epsilon, sigma, k, r_0, fzup};
+    cuboidObj.getSpecialCases() = specialCases;
+    cuboidObj.initialize(dimensions);
+    if (membrane.present()) {
+        cuboidObj.initializeNeighbours();
+    }
+}
+
+// helper (wrapper) function to parse a single particle into a particle container
+static void parseParticle(const ParticleType &particle, ParticleContainer &pc) {
+    std::array<double, 3> position{particle.position().x(), particle.position().y(), particle.position().z()};
+    std::array<double, 3> velocity{particle.velocity().x(), particle.velocity().y(), particle.velocity().z()};
+    std::array<double, 3> force, oldForce;
+
+    // ternary operators don't work with arrays :/
+    if (particle.force().present()) {
+        force = {particle.force().get().x(), particle.force().get().y(), particle.force().get().z()};
+    } else {
+        force = {0., 0., 0.};
     }
+    if (particle.oldForce().present()) {
+        oldForce = {particle.oldForce().get().x(), particle.oldForce().get().y(), particle.oldForce().get().z()};
+    } else {
+        oldForce = {0., 0., 0.};
+    }
+    double mass = particle.mass();
+    int type = particle.type().present() ? particle.type().get() : TYPE_DEFAULT;
+    double epsilon = particle.epsilon().present() ? particle.epsilon().get() : EPSILON_DEFAULT;
+    double sigma = particle.sigma().present() ? particle.sigma().get() : SIGMA_DEFAULT;
+    int cellIndex = particle.cellIndex().present() ? particle.cellIndex().get() : -1;
+
+    SPDLOG_TRACE(
+        "Adding particle with x: {}, v: {}, f: {}, old_f: {}, m: {}, type: {}, eps: {}, sigma: {}, index: {}",
+        ArrayUtils::to_string(position), ArrayUtils::to_string(velocity), ArrayUtils::to_string(force),
+        ArrayUtils::to_string(oldForce), mass, type, epsilon, sigma, cellIndex);
+
+    // membrane properties cannot be applied to singular particles
+    pc.addParticle(position, velocity, force, oldForce, mass, type, epsilon, sigma, K_DEFAULT, R0_DEFAULT,
+                   FZUP_DEFAULT, cellIndex);
+}
+
+// helper (wrapper) function to parse a disc into a particle container
+static void parseDisc(const DiscType &disc, ParticleContainer &pc) {
+    std::array<double, 3> position{disc.position().x(), disc.position().y(), disc.position().z()};
+    std::array<double, 3> velocity{disc.velocity().x(), disc.velocity().y(), disc.velocity().z()};
+    int radius = disc.radius();
+    double distance = disc.distance();
+    double mass = disc.mass();
+    int type = disc.type().present() ? disc.type().get() : TYPE_DEFAULT;
+    double epsilon = disc.epsilon().present() ? disc.epsilon().get() : EPSILON_DEFAULT;
+    double sigma = disc.sigma().present() ? disc.sigma().get() : SIGMA_DEFAULT;
+
+    SPDLOG_TRACE("Initializing disc with x: {}, v: {}, r: {}, h: {}, m: {}, eps: {}, sigma: {}",
+                 ArrayUtils::to_string(position), ArrayUtils::to_string(velocity), radius, distance, mass, epsilon,
+                 sigma);
+
+    Disc discObj{pc, position, radius, velocity, distance, mass, type, epsilon, sigma};
+    discObj.initialize();
 }
 
-// helper (wrapper) function to parse single particles into a particle container
-static void parseParticles(const SimType::ObjectsType &xmlObjects, ParticleContainer &pc) {
-    for (const auto &particle : xmlObjects.particle()) {
-        std::array<double, 3> position{particle.position().x(), particle.position().y(), particle.position().z()};
-        std::array<double, 3> velocity{particle.velocity().x(), particle.velocity().y(), particle.velocity().z()};
-        std::array<double, 3> force, oldForce;
-
-        // ternary operators don't work with arrays :/
-        if (particle.force().present()) {
-            force = {particle.force().get().x(), particle.force().get().y(), particle.force().get().z()};
-        } else {
-            force = {0., 0., 0.};
+// parser filter which turns each completed object element into particles and drops it from the dom tree.
+// this keeps memory bounded for huge particle lists; everything else is left for the typed binding.
+// objects are added grouped by kind (cuboids, then particles, then discs), so that handles and random velocities stay
+// the same for existing inputs. single particles are always added right away, so that continuation files, which only
+// contain particles, are streamed. only the (small) descriptions of discs and of cuboids following a single particle
+// are kept until the document is complete; such cuboids cannot be placed before the particles anymore
+class ObjectStreamFilter : public xercesc::DOMLSParserFilter {
+  private:
+    ParticleContainer &m_pc;
+    std::vector<CuboidType> m_cuboids;
+    std::vector<DiscType> m_discs;
+    bool m_particlesAdded{false};
+    SimType::MembraneOptional m_membrane;
+    size_t m_dimensions{2};
+    bool m_contextLoaded{false};
+    std::exception_ptr m_error;
+    xsd::cxx::xml::string m_objects{"objects"}, m_cuboid{"cuboid"}, m_particle{"particle"}, m_disc{"disc"},
+        m_membraneName{"membrane"}, m_dimensionsName{"dimensions"};
+
+    // membrane and dimensions precede the objects in the schema, so they are complete once the first object ends
+    void loadContext(const xercesc::DOMNode *sim) {
+        for (const xercesc::DOMNode *n = sim->getFirstChild(); n; n = n->getNextSibling()) {
+            if (n->getNodeType() != xercesc::DOMNode::ELEMENT_NODE)
+                continue;
+            const auto &e = static_cast<const xercesc::DOMElement &>(*n);
+            if (xercesc::XMLString::equals(e.getLocalName(), m_membraneName.c_str()))
+                m_membrane.set(MembraneType{e});
+            else if (xercesc::XMLString::equals(e.getLocalName(), m_dimensionsName.c_str()))
+                m_dimensions = SimType::DimensionsTraits::create(e, 0, nullptr);
         }
-        if (particle.oldForce().present()) {
-            oldForce = {particle.oldForce().get().x(), particle.oldForce().get().y(), particle.oldForce().get().z()};
-        } else {
-            oldForce = {0., 0., 0.};
+        m_contextLoaded = true;
+    }
+
+  public:
+    explicit ObjectStreamFilter(ParticleContainer &pc) : m_pc{pc} {}
+
+    FilterAction startElement(xercesc::DOMElement *) override { return FILTER_ACCEPT; }
+
+    FilterAction acceptNode(xercesc::DOMNode *node) override {
+        const xercesc::DOMNode *parent = node->getParentNode();
+        if (!parent || !xercesc::XMLString::equals(parent->getLocalName(), m_objects.c_str()))
+            return FILTER_ACCEPT;
+
+        try {
+            if (!m_contextLoaded)
+                loadContext(parent->getParentNode());
+            const auto &e = static_cast<const xercesc::DOMElement &>(*node);
+            const XMLCh *name = e.getLocalName();
+            if (xercesc::XMLString::equals(name, m_cuboid.c_str())) {
+                if (m_particlesAdded)
+                    m_cuboids.push_back(CuboidType{e});
+                else
+                    parseCuboid(CuboidType{e}, m_membrane, m_pc, m_dimensions);
+            } else if (xercesc::XMLString::equals(name, m_particle.c_str())) {
+                parseParticle(ParticleType{e}, m_pc);
+                m_particlesAdded = true;
+            } else if (xercesc::XMLString::equals(name, m_disc.c_str()))
+                m_discs.push_back(DiscType{e});
+            else
+                return FILTER_ACCEPT; // unknown element, let the typed binding report it
+        } catch (...) {
+            m_error = std::current_exception();
+            return FILTER_INTERRUPT;
         }
-        double mass = particle.mass();
-        int type = particle.type().present() ? particle.type().get() : TYPE_DEFAULT;
-        double epsilon = particle.epsilon().present() ? particle.epsilon().get() : EPSILON_DEFAULT;
-        double sigma = particle.sigma().present() ? particle.sigma().get() : SIGMA_DEFAULT;
-        int cellIndex = particle.cellIndex().present() ? particle.cellIndex().get() : -1;
-
-        SPDLOG_TRACE(
-            "Adding particle with x: {}, v: {}, f: {}, old_f: {}, m: {}, type: {}, eps: {}, sigma: {}, index: {}",
-            ArrayUtils::to_string(position), ArrayUtils::to_string(velocity), ArrayUtils::to_string(force),
-            ArrayUtils::to_string(oldForce), mass, type, epsilon, sigma, cellIndex);
-
-        // membrane properties cannot be applied to singular particles
-        pc.addParticle(position, velocity, force, oldForce, mass, type, epsilon, sigma, K_DEFAULT, R0_DEFAULT,
-                       FZUP_DEFAULT, cellIndex);
+        return FILTER_REJECT;
+    }
+
+    xercesc::DOMNodeFilter::ShowType getWhatToShow() const override {
+        return xercesc::DOMNodeFilter::SHOW_ELEMENT;
+    }
+
+    // rethrows the first error raised while converting an object, if any
+    void rethrowIfFailed() const {
+        if (m_error)
+            std::rethrow_exception(m_error);
+    }
+
+    // adds the remaining cuboids and all discs after the particles, once the whole document has been parsed
+    void addPendingObjects() {
+        if (!m_cuboids.empty())
+            SPDLOG_WARN("{} cuboid(s) following single particles in the input are added after all particles.",
+                        m_cuboids.size());
+        for (const CuboidType &cuboid : m_cuboids)
+            parseCuboid(cuboid, m_membrane, m_pc, m_dimensions);
+        for (const DiscType &disc : m_discs)
+            parseDisc(disc, m_pc);
+        m_cuboids.clear();
+        m_discs.clear();
+    }
+};
+
+// helper function to reserve space for the particles of the input file, if it states their total number.
+// the schema places <totalParticles> at the very end, after the objects, so only the tail of the file is searched
+// before parsing; the stream is rewound afterwards
+static void reserveParticleContainer(std::istream &is, ParticleContainer &pc) {
+    constexpr std::streamoff tailSize = 512;
+    const std::streampos start = is.tellg();
+    is.seekg(0, std::ios::end);
+    const std::streamoff size = is.tellg() - start;
+    if (start < 0 || size <= 0) {
+        is.clear();
+        is.seekg(start);
+        return;
+    }
+    is.seekg(start + std::max<std::streamoff>(0, size - tailSize));
+    std::string tail(static_cast<size_t>(std::min(size, tailSize)), '\0');
+    is.read(tail.data(), static_cast<std::streamsize>(tail.size()));
+    is.clear();
+    is.seekg(start);
+
+    const std::string tag = "<totalParticles>";
+    const size_t pos = tail.rfind(tag);
+    if (pos == std::string::npos)
+        return;
+    const long long totalParticles = std::strtoll(tail.c_str() + pos + tag.size(), nullptr, 10);
+    if (totalParticles > 0) {
+        pc.reserve(static_cast<size_t>(totalParticles));
+        SPDLOG_DEBUG("Reserved space for {} particles...", totalParticles);
     }
 }
 
-// helper (wrapper) function to parse discs into a particle container
-static void parseDiscs(const SimType::ObjectsType &xmlObjects, ParticleContainer &pc) {
-    for (const auto &disc : xmlObjects.disc()) {
-        std::array<double, 3> position{disc.position().x(), disc.position().y(), disc.position().z()};
-        std::array<double, 3> velocity{disc.velocity().x(), disc.velocity().y(), disc.velocity().z()};
-        int radius = disc.radius();
-        double distance = disc.distance();
-        double mass = disc.mass();
-        int type = disc.type().present() ? disc.type().get() : TYPE_DEFAULT;
-        double epsilon = disc.epsilon().present() ? disc.epsilon().get() : EPSILON_DEFAULT;
-        double sigma = disc.sigma().present() ? disc.sigma().get() : SIGMA_DEFAULT;
-
-        SPDLOG_TRACE("Initializing disc with x: {}, v: {}, r: {}, h: {}, m: {}, eps: {}, sigma: {}",
-                     ArrayUtils::to_string(position), ArrayUtils::to_string(velocity), radius, distance, mass, epsilon,
-                     sigma);
-
-        Disc discObj{pc, position, radius, velocity, distance, mass, type, epsilon, sigma};
-        discObj.initialize();
+// helper function to parse the input file while streaming objects into the particle container through the filter.
+// mirrors the parser configuration of the generated sim() functions for non-validating parsing
+static std::unique_ptr<SimType> parseStreaming(std::istream &is, ObjectStreamFilter &filter) {
+    using namespace xercesc;
+    const XMLCh ls[] = {chLatin_L, chLatin_S, chNull};
+    DOMImplementation *impl = DOMImplementationRegistry::getDOMImplementation(ls);
+    xml_schema::dom::unique_ptr<DOMLSParser> parser{impl->createLSParser(DOMImplementationLS::MODE_SYNCHRONOUS, 0)};
+
+    DOMConfiguration *conf = parser->getDomConfig();
+    conf->setParameter(XMLUni::fgDOMComments, false);
+    conf->setParameter(XMLUni::fgDOMDatatypeNormalization, true);
+    conf->setParameter(XMLUni::fgDOMEntities, false);
+    conf->setParameter(XMLUni::fgDOMNamespaces, true);
+    conf->setParameter(XMLUni::fgDOMElementContentWhitespace, false);
+    conf->setParameter(XMLUni::fgDOMValidate, false);
+    conf->setParameter(XMLUni::fgXercesSchema, false);
+    conf->setParameter(XMLUni::fgXercesSchemaFullChecking, false);
+    conf->setParameter(XMLUni::fgXercesUserAdoptsDOMDocument, true);
+
+    xsd::cxx::tree::error_handler<char> eh;
+    xsd::cxx::xml::dom::bits::error_handler_proxy<char> ehp{eh};
+    conf->setParameter(XMLUni::fgDOMErrorHandler, &ehp);
+    parser->setFilter(&filter);
+
+    xsd::cxx::xml::sax::std_input_source isrc{is};
+    Wrapper4InputSource wrap{&isrc, false};
+    xml_schema::dom::unique_ptr<DOMDocument> doc;
+    try {
+        doc.reset(parser->parse(&wrap));
+    } catch (const DOMLSException &) {
+        // interrupted by the filter or fatal parsing error, both of which are reported below
     }
+
+    filter.rethrowIfFailed();
+    eh.throw_if_failed<xml_schema::Parsing>();
+    if (!doc)
+        throw xml_schema::Parsing();
+    filter.addPendingObjects();
+    return sim(std::move(doc), xml_schema::Flags::dont_validate | xml_schema::Flags::own_dom);
 }
 
 /* main xml functionality starts here... */
@@ -231,9 +389,14 @@ void XMLReader::readXML(Arguments &args, ParticleContainer &pc, Thermostat &t, F
 
     try {
         SPDLOG_DEBUG("Reading from XML file...");
-        std::unique_ptr<SimType> xmlInput{sim(m_infile, xml_schema::Flags::dont_validate)};
+        size_t initialParticles = pc.size();
+
+        // objects are added to the particle container while parsing, everything else goes through the typed binding
+        xsd::cxx::xml::auto_initializer init;
+        ObjectStreamFilter filter{pc};
+        reserveParticleContainer(m_infile, pc);
+        std::unique_ptr<SimType> xmlInput = parseStreaming(m_infile, filter);
 
-        reserveParticleContainer(pc, xmlInput);
         readXMLArgs(args, xmlInput);
 
         args.sim = StringUtils::toSimulationType(xmlInput->type());
@@ -255,17 +418,9 @@ void XMLReader::readXML(Arguments &args, ParticleContainer &pc, Thermostat &t, F
         const auto &xmlAnalyzer = xmlInput->analyzer();
         initAnalyzer(xmlAnalyzer, fsa, args.basename);
 
-        const auto &xmlObjects = xmlInput->objects();
-        size_t initialParticles = pc.size(); // might come in handy?
-
-        SimType::MembraneOptional &membrane = xmlInput->membrane();
-        args.membrane = membrane.present();
+        args.membrane = xmlInput->membrane().present();
         SPDLOG_DEBUG("Membrane simulation?: {}", args.membrane);
 
-        parseCuboids(xmlObjects, membrane, pc, args.dimensions);
-        parseParticles(xmlObjects, pc);
-        parseDiscs(xmlObjects, pc);
-
         if (pc.size() == 0)
             CLIUtils::error("No particles added!", "", false);
 
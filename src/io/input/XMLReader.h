@@ -31,6 +31,8 @@ class XMLReader : public FileReader {
     /**
      * @brief Read and parse the contents of a valid XML file into the given Arguments and ParticleContainer references.
      *
+     * Objects (cuboids, particles, discs) are added to the ParticleContainer while the file is being parsed, and
+     * their DOM nodes are discarded right away, so large particle lists never have to be held in memory as a whole.
      * On error, the program will terminate.
      *
      * @param args A reference to the Arguments struct which will be modified.
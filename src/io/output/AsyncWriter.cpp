@@ -0,0 +1,128 @@
+#include "AsyncWriter.h"
+#include "utils/CLIUtils.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+AsyncWriter::AsyncWriter(std::unique_ptr<FileWriter> writer, size_t capacity)
+    : m_writer{std::move(writer)}, m_capacity{std::max<size_t>(capacity, 1)} {
+    m_thread = std::thread(&AsyncWriter::run, this);
+    SPDLOG_TRACE("Created new AsyncWriter with queue capacity {}.", m_capacity);
+}
+AsyncWriter::~AsyncWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_changed.notify_all();
+    if (m_thread.joinable())
+        m_thread.join();
+
+    // the simulation reports errors through flush() before tearing down the writer; exiting the program here could
+    // happen during stack unwinding, so any error left over is only logged
+    if (m_error) {
+        try {
+            std::rethrow_exception(m_error);
+        } catch (const std::exception &e) {
+            SPDLOG_ERROR("Failed to write output frame: {}", e.what());
+        } catch (...) {
+            SPDLOG_ERROR("Failed to write output frame.");
+        }
+    }
+    SPDLOG_TRACE("Destroyed AsyncWriter.");
+}
+
+void AsyncWriter::run() {
+    // errors of the wrapped writer must not exit the program from this thread
+    CLIUtils::throwOnError = true;
+    while (true) {
+        std::unique_ptr<Frame> frame;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_changed.wait(lock, [this] { return !m_queue.empty() || m_stop; });
+            if (m_queue.empty())
+                return;
+            frame = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_busy = true;
+        }
+        m_changed.notify_all();
+
+        // format and write outside of the lock, so that the simulation can capture the next frame meanwhile
+        // on failure, the error is handed to the simulation thread and no further frames are written
+        try {
+            m_writer->writeFrame(*frame);
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_busy = false;
+                m_error = std::current_exception();
+            }
+            m_changed.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busy = false;
+            m_pool.push_back(std::move(frame));
+        }
+        m_changed.notify_all();
+    }
+}
+
+std::unique_ptr<Frame> AsyncWriter::acquire() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_queue.size() >= m_capacity) {
+        SPDLOG_DEBUG("Output queue full, waiting for the writer thread...");
+        m_changed.wait(lock, [this] { return m_queue.size() < m_capacity || m_error; });
+    }
+    reportError(lock);
+    if (m_pool.empty())
+        return std::make_unique<Frame>();
+    std::unique_ptr<Frame> frame = std::move(m_pool.back());
+    m_pool.pop_back();
+    return frame;
+}
+
+void AsyncWriter::submit(std::unique_ptr<Frame> frame) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(frame));
+    }
+    m_changed.notify_all();
+}
+
+void AsyncWriter::writeParticles(const ParticleContainer &particles, int iteration, int total) {
+    std::unique_ptr<Frame> frame = acquire();
+    frame->capture(particles, iteration, total);
+    submit(std::move(frame));
+}
+
+void AsyncWriter::writeFrame(const Frame &frame) {
+    std::unique_ptr<Frame> copy = acquire();
+    *copy = frame;
+    submit(std::move(copy));
+}
+
+void AsyncWriter::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this] { return (m_queue.empty() && !m_busy) || m_error; });
+    reportError(lock);
+}
+
+void AsyncWriter::reportError(std::unique_lock<std::mutex> &lock) {
+    if (!m_error)
+        return;
+    // the background thread has already stopped writing, wait for it to exit before exiting the program
+    lock.unlock();
+    if (m_thread.joinable())
+        m_thread.join();
+    try {
+        std::rethrow_exception(m_error);
+    } catch (const std::exception &e) {
+        CLIUtils::error("Failed to write output frame", e.what(), false);
+    } catch (...) {
+        CLIUtils::error("Failed to write output frame", "", false);
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file AsyncWriter.h
+ * @brief Decorator which moves the formatting and writing of output files to a background thread.
+ * @date 2025-02-03
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "FileWriter.h"
+#include "Frame.h"
+#include "objects/ParticleContainer.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Class which wraps another FileWriter and writes its output on a dedicated background thread.
+ *
+ * @details The simulation thread only captures a Frame of the particle data into a pooled buffer and enqueues it. The
+ * background thread then passes each Frame to the wrapped writer in order. The queue is bounded: if it is full, the
+ * simulation thread blocks until the writer has caught up.
+ */
+class AsyncWriter : public FileWriter {
+  private:
+    /// @brief The writer which formats and writes the frames.
+    std::unique_ptr<FileWriter> m_writer;
+    /// @brief The maximum number of frames waiting to be written.
+    size_t m_capacity;
+    /// @brief Frames waiting to be written, in order of capture.
+    std::deque<std::unique_ptr<Frame>> m_queue;
+    /// @brief Previously written frames, reused for future captures.
+    std::vector<std::unique_ptr<Frame>> m_pool;
+    /// @brief Mutex protecting the queue, the pool and the state flags.
+    std::mutex m_mutex;
+    /// @brief Condition variable signaling any change of the queue or the state flags.
+    std::condition_variable m_changed;
+    /// @brief Determines whether the background thread is currently writing a frame.
+    bool m_busy{false};
+    /// @brief Determines whether the background thread should exit once the queue is empty.
+    bool m_stop{false};
+    /// @brief The error which stopped the background thread, if any. Reported by the simulation thread.
+    std::exception_ptr m_error;
+    /// @brief The background thread writing the queued frames.
+    std::thread m_thread;
+
+    /// @brief Main loop of the background thread.
+    void run();
+
+    /**
+     * @brief Gets a free frame buffer, blocking while the queue is full.
+     *
+     * @return A frame buffer owned by the caller.
+     */
+    std::unique_ptr<Frame> acquire();
+
+    /**
+     * @brief Reports the error of the background thread, if any, and exits the program.
+     *
+     * Must be called from the simulation thread with the mutex held by the given lock.
+     *
+     * @param lock The lock holding the mutex, released before joining the background thread.
+     */
+    void reportError(std::unique_lock<std::mutex> &lock);
+
+    /**
+     * @brief Enqueues a filled frame buffer for writing.
+     *
+     * @param frame The frame to be written.
+     */
+    void submit(std::unique_ptr<Frame> frame);
+
+  public:
+    /**
+     * @brief Creates a new AsyncWriter and starts its background thread.
+     *
+     * @param writer The writer which formats and writes the frames.
+     * @param capacity The maximum number of frames waiting to be written (at least 1).
+     */
+    AsyncWriter(std::unique_ptr<FileWriter> writer, size_t capacity);
+
+    /**
+     * @brief Writes all pending frames, stops the background thread and destroys the AsyncWriter object.
+     *
+     * Errors of the background thread are only logged here. Call flush() beforehand to report them.
+     */
+    virtual ~AsyncWriter();
+
+    /**
+     * @brief Captures the active particles of a ParticleContainer and enqueues them for writing.
+     *
+     * @param particles The ParticleContainer.
+     * @param iteration The number of the current iteration, used to generate a unique filename.
+     * @param total The total number of iterations, used to display the current percentage.
+     */
+    void writeParticles(const ParticleContainer &particles, int iteration, int total) override;
+
+    /**
+     * @brief Copies a Frame and enqueues it for writing.
+     *
+     * @param frame The Frame containing the particle data, the current and the total number of iterations.
+     */
+    void writeFrame(const Frame &frame) override;
+
+    /// @brief Blocks until all queued frames have been written. Exits the program if a frame could not be written.
+    void flush() override;
+};
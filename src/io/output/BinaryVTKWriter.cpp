@@ -0,0 +1,167 @@
+#include "BinaryVTKWriter.h"
+#include "utils/CLIUtils.h"
+#include "utils/StringUtils.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <string>
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
+
+// uncompressed size of a single block when compressing data arrays (same as VTK's default)
+static constexpr size_t BLOCK_SIZE = 1 << 15;
+
+// helper function for determining the byte order of the host, which is used for the binary data
+static inline bool isLittleEndian() {
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// helper function for appending the raw bytes of a trivially copyable value to a buffer
+template <typename T> static inline void appendBytes(std::vector<char> &buffer, const T &value) {
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+BinaryVTKWriter::BinaryVTKWriter() {
+    SPDLOG_TRACE("Created new BinaryVTKWriter (empty).");
+    initializeFolder(m_dirname);
+}
+BinaryVTKWriter::BinaryVTKWriter(const std::string &basename, bool doublePrecision, bool compress)
+    : m_basename{basename}, m_doublePrecision{doublePrecision}, m_compress{compress} {
+    SPDLOG_TRACE("Created new BinaryVTKWriter with base name {} (Float{}, compressed: {})", basename,
+                 doublePrecision ? 64 : 32, compress);
+#ifndef HAS_ZLIB
+    if (m_compress)
+        CLIUtils::error("Compressed VTK output requires zlib, which was not found at compile time!", "", false);
+#endif
+    initializeFolder(m_dirname);
+}
+BinaryVTKWriter::BinaryVTKWriter(const std::string &basename, const std::string &dirname, bool doublePrecision,
+                                 bool compress)
+    : m_basename{basename}, m_dirname{dirname}, m_doublePrecision{doublePrecision}, m_compress{compress} {
+    SPDLOG_TRACE("Created new BinaryVTKWriter with base name {} and directory name {} (Float{}, compressed: {})",
+                 basename, dirname, doublePrecision ? 64 : 32, compress);
+#ifndef HAS_ZLIB
+    if (m_compress)
+        CLIUtils::error("Compressed VTK output requires zlib, which was not found at compile time!", "", false);
+#endif
+    initializeFolder(m_dirname);
+}
+BinaryVTKWriter::~BinaryVTKWriter() { SPDLOG_TRACE("Destroyed BinaryVTKWriter."); }
+
+void BinaryVTKWriter::appendBlock() {
+    if (!m_compress) {
+        appendBytes(m_appended, static_cast<std::uint64_t>(m_raw.size()));
+        m_appended.insert(m_appended.end(), m_raw.begin(), m_raw.end());
+        return;
+    }
+#ifdef HAS_ZLIB
+    // reserve space for the header, which is filled in once the compressed sizes are known
+    const size_t numBlocks = (m_raw.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const size_t lastBlock = (numBlocks == 0) ? 0 : m_raw.size() - (numBlocks - 1) * BLOCK_SIZE;
+    const size_t headerPos = m_appended.size();
+    m_appended.resize(headerPos + (3 + numBlocks) * sizeof(std::uint64_t));
+    std::vector<std::uint64_t> header{numBlocks, BLOCK_SIZE, lastBlock};
+
+    for (size_t b = 0; b < numBlocks; ++b) {
+        const size_t blockSize = (b == numBlocks - 1) ? lastBlock : BLOCK_SIZE;
+        uLongf compressedSize = compressBound(blockSize);
+        const size_t blockPos = m_appended.size();
+        m_appended.resize(blockPos + compressedSize);
+        if (compress2(reinterpret_cast<Bytef *>(m_appended.data() + blockPos), &compressedSize,
+                      reinterpret_cast<const Bytef *>(m_raw.data() + b * BLOCK_SIZE), blockSize,
+                      Z_DEFAULT_COMPRESSION) != Z_OK)
+            CLIUtils::error("Failed to compress VTK data block!", "", false);
+        m_appended.resize(blockPos + compressedSize);
+        header.push_back(compressedSize);
+    }
+    std::memcpy(m_appended.data() + headerPos, header.data(), header.size() * sizeof(std::uint64_t));
+#endif
+}
+
+void BinaryVTKWriter::appendFloats(const std::vector<double> &data) {
+    m_raw.clear();
+    if (m_doublePrecision) {
+        m_raw.resize(data.size() * sizeof(double));
+        std::memcpy(m_raw.data(), data.data(), m_raw.size());
+    } else {
+        m_raw.resize(data.size() * sizeof(float));
+        float *out = reinterpret_cast<float *>(m_raw.data());
+        std::transform(data.begin(), data.end(), out, [](double d) { return static_cast<float>(d); });
+    }
+    appendBlock();
+}
+
+void BinaryVTKWriter::appendInts(const std::vector<int> &data) {
+    m_raw.clear();
+    m_raw.resize(data.size() * sizeof(std::int32_t));
+    std::int32_t *out = reinterpret_cast<std::int32_t *>(m_raw.data());
+    std::transform(data.begin(), data.end(), out, [](int i) { return static_cast<std::int32_t>(i); });
+    appendBlock();
+}
+
+void BinaryVTKWriter::writeFrame(const Frame &frame) {
+    const char *floatType = m_doublePrecision ? "Float64" : "Float32";
+    std::stringstream header;
+    m_appended.clear();
+
+    // helper for describing a data array and appending its contents
+    auto dataArray = [&](const char *type, const char *name, int components, auto &&append) {
+        header << "        <DataArray type=\"" << type << "\" Name=\"" << name << "\" NumberOfComponents=\""
+               << components << "\" format=\"appended\" offset=\"" << m_appended.size() << "\"/>\n";
+        append();
+    };
+
+    header << "<?xml version=\"1.0\"?>\n"
+           << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+           << (isLittleEndian() ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\""
+           << (m_compress ? " compressor=\"vtkZLibDataCompressor\"" : "") << ">\n"
+           << "  <UnstructuredGrid>\n"
+           << "    <Piece NumberOfPoints=\"" << frame.size() << "\" NumberOfCells=\"0\">\n"
+           << "      <PointData>\n";
+    dataArray(floatType, "mass", 1, [&] { appendFloats(frame.masses); });
+    dataArray(floatType, "velocity", 3, [&] { appendFloats(frame.velocities); });
+    dataArray(floatType, "force", 3, [&] { appendFloats(frame.forces); });
+    dataArray("Int32", "type", 1, [&] { appendInts(frame.types); });
+    header << "      </PointData>\n"
+           << "      <CellData/>\n"
+           << "      <Points>\n";
+    dataArray(floatType, "points", 3, [&] { appendFloats(frame.positions); });
+    header << "      </Points>\n"
+           << "      <Cells>\n";
+    // we don't have cells, but paraview expects the arrays to be present
+    // they are written with appendInts(), so they are declared as Int32 to match the width of the data
+    dataArray("Int32", "connectivity", 1, [&] { appendInts({}); });
+    dataArray("Int32", "offsets", 1, [&] { appendInts({}); });
+    dataArray("Int32", "types", 1, [&] { appendInts({}); });
+    header << "      </Cells>\n"
+           << "    </Piece>\n"
+           << "  </UnstructuredGrid>\n"
+           << "  <AppendedData encoding=\"raw\">\n"
+           << "   _";
+
+    // generate unique filename based on iteration
+    std::stringstream strstr;
+    strstr << m_dirname << "/" << m_basename << "_" << std::setfill('0') << std::setw(4) << frame.iteration
+           << ".vtu";
+    std::ofstream file(strstr.str(), std::ios::binary);
+    if (!file)
+        CLIUtils::error("Error opening output file", strstr.str(), false);
+
+    file << header.str();
+    file.write(m_appended.data(), static_cast<std::streamsize>(m_appended.size()));
+    file << "\n  </AppendedData>\n</VTKFile>\n";
+    if (file.bad())
+        CLIUtils::error("Failed to write contents to file stream!", "", false);
+
+    SPDLOG_INFO("Wrote contents to binary VTK file {} ({} / {}) ({}%).", strstr.str(),
+                StringUtils::fromNumber(frame.iteration), StringUtils::fromNumber(frame.total),
+                StringUtils::fromNumber(CLIUtils::getPercentage(frame.iteration, frame.total)));
+}
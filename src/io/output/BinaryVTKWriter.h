@@ -0,0 +1,99 @@
+/**
+ * @file BinaryVTKWriter.h
+ * @brief Class used to generate VTK output with binary appended data.
+ * @date 2025-02-04
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "FileWriter.h"
+#include "Frame.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Class which implements functionality to generate VTK Unstructured Grid (.vtu) files with raw binary appended
+ * data.
+ *
+ * @details Unlike the VTKWriter, this writer does not build an XSD object tree. Instead, the XML header is written
+ * directly and each data array is stored as a raw binary block in the `AppendedData` section. Data arrays are stored
+ * either in single (Float32) or double (Float64) precision and may optionally be compressed using zlib (if available at
+ * compile time).
+ */
+class BinaryVTKWriter : public FileWriter {
+  private:
+    /// @brief The base name of the generated files.
+    std::string m_basename = "MD_vtk";
+    /// @brief The name of the directory in which to store the generated files.
+    std::string m_dirname = "vtk";
+    /// @brief Determines whether floating point data is stored as Float64 instead of Float32.
+    bool m_doublePrecision{false};
+    /// @brief Determines whether the data arrays are compressed using zlib.
+    bool m_compress{false};
+    /// @brief Reusable buffer containing the (encoded) appended data of the current file.
+    std::vector<char> m_appended;
+    /// @brief Reusable buffer containing the raw bytes of the data array currently being encoded.
+    std::vector<char> m_raw;
+
+    /**
+     * @brief Encodes the raw bytes in m_raw as a data block at the end of m_appended.
+     *
+     * @details Uncompressed blocks consist of a UInt64 byte count followed by the data. Compressed blocks use the
+     * vtkZLibDataCompressor layout, i.e. a UInt64 header containing the number of blocks, the uncompressed block size,
+     * the size of the last block and the compressed size of each block, followed by the compressed blocks.
+     */
+    void appendBlock();
+
+    /**
+     * @brief Appends a floating point data array taken from a column of the frame, converting it to the configured
+     * precision.
+     *
+     * @param data The data to be appended.
+     */
+    void appendFloats(const std::vector<double> &data);
+
+    /**
+     * @brief Appends an integer data array taken from a column of the frame.
+     *
+     * @param data The data to be appended.
+     */
+    void appendInts(const std::vector<int> &data);
+
+  public:
+    /// @brief Creates a new uninitialized BinaryVTKWriter.
+    BinaryVTKWriter();
+
+    /**
+     * @brief Creates a new BinaryVTKWriter with the given basename for future file outputs.
+     *
+     * @param basename The base name of the generated files.
+     * @param doublePrecision Whether to store floating point data as Float64 instead of Float32.
+     * @param compress Whether to compress the data arrays using zlib.
+     */
+    explicit BinaryVTKWriter(const std::string &basename, bool doublePrecision = false, bool compress = false);
+
+    /**
+     * @brief Creates a new BinaryVTKWriter with the given basename for future file outputs in the specified directory.
+     *
+     * @param basename The base name of the generated files.
+     * @param dirname The directory name of the generated files.
+     * @param doublePrecision Whether to store floating point data as Float64 instead of Float32.
+     * @param compress Whether to compress the data arrays using zlib.
+     */
+    BinaryVTKWriter(const std::string &basename, const std::string &dirname, bool doublePrecision = false,
+                    bool compress = false);
+
+    /// @brief Destroys the current BinaryVTKWriter object.
+    virtual ~BinaryVTKWriter();
+
+    /**
+     * @brief Writes the type, mass, position, velocity and force of all particles in a Frame to a binary VTK file.
+     * Terminates program execution on error.
+     *
+     * @param frame The Frame containing the particle data, the current and the total number of iterations.
+     */
+    void writeFrame(const Frame &frame) override;
+};
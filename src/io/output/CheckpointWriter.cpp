@@ -0,0 +1,197 @@
+#include "CheckpointWriter.h"
+#include "utils/CLIUtils.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+using namespace CheckpointFormat;
+
+// the number of particle records buffered before they are written to the file
+static constexpr size_t BATCH_SIZE = 4096;
+
+CheckpointWriter::CheckpointWriter(const std::string &filename) : m_filename{filename} {
+    m_file.open(filename + ".tmp", std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+        CLIUtils::error("Failed to open file", filename + ".tmp", false);
+    SPDLOG_TRACE("Created new CheckpointWriter with file {}.", filename);
+}
+CheckpointWriter::~CheckpointWriter() {
+    if (m_file.is_open())
+        m_file.close();
+    SPDLOG_TRACE("Destroyed CheckpointWriter.");
+}
+
+void CheckpointWriter::writeBytes(const void *data, size_t size) {
+    m_file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    if (m_file.bad())
+        CLIUtils::error("Failed to write contents to file stream!", "", false);
+}
+
+void CheckpointWriter::write(const ParticleContainer &pc, const Arguments &args, const Thermostat &t,
+                             const FlowSimulationAnalyzer &fsa, double time, int iteration) {
+    if (!(m_file.is_open()))
+        CLIUtils::error("No output file opened!", "", false);
+
+    // assign consecutive record indices to the active particles, so that bonds can be stored independently of handles
+    ParticleHandle maxHandle = 0;
+    for (const auto &p : pc)
+        maxHandle = std::max(maxHandle, p.getHandle());
+    std::vector<std::uint32_t> recordIndex(pc.isEmpty() ? 0 : static_cast<size_t>(maxHandle) + 1, INVALID_HANDLE);
+    std::uint64_t particleCount = 0;
+    for (const auto &p : pc) {
+        CONTINUE_IF_INACTIVE(p);
+        recordIndex[p.getHandle()] = static_cast<std::uint32_t>(particleCount++);
+    }
+
+    // bonds to particles which are no longer part of the simulation are dropped
+    auto countBonds = [&](const std::vector<ParticleHandle> &neighbours) {
+        return static_cast<std::uint32_t>(std::count_if(neighbours.begin(), neighbours.end(), [&](ParticleHandle h) {
+            return h < recordIndex.size() && recordIndex[h] != INVALID_HANDLE;
+        }));
+    };
+    auto appendBonds = [&](const std::vector<ParticleHandle> &neighbours, std::vector<std::uint32_t> &bonds) {
+        for (ParticleHandle h : neighbours) {
+            if (h < recordIndex.size() && recordIndex[h] != INVALID_HANDLE)
+                bonds.push_back(recordIndex[h]);
+        }
+    };
+    std::uint64_t bondCount = 0;
+    for (const auto &p : pc) {
+        CONTINUE_IF_INACTIVE(p);
+        bondCount += countBonds(p.getDirectNeighbours()) + countBonds(p.getDiagonalNeighbours());
+    }
+
+    // header
+    FileHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.byteOrder = ByteOrderMark;
+    header.version = Version;
+    header.particleCount = particleCount;
+    header.bondCount = bondCount;
+    header.time = time;
+    header.specialForceLimit = pc.getSpecialForceLimit();
+    header.iteration = iteration;
+    writeBytes(&header, sizeof(header));
+
+    // arguments
+    ArgsRecord a{};
+    a.endTime = args.endTime;
+    a.delta_t = args.delta_t;
+    a.domainSize = args.domainSize;
+    a.cutoffRadius = args.cutoffRadius;
+    a.gravity = args.gravity;
+    a.cellSizeFactor = args.cellSizeFactor;
+    a.cellSkin = args.cellSkin;
+    a.pairCutoffFactor = args.pairCutoffFactor;
+    a.itFreq = args.itFreq;
+    a.checkpointFreq = args.checkpointFreq;
+    a.outputQueue = args.outputQueue;
+    a.dimensions = args.dimensions;
+    a.type = static_cast<std::int32_t>(args.type);
+    a.sim = static_cast<std::int32_t>(args.sim);
+    a.parallelization = static_cast<std::int32_t>(args.parallelization);
+    a.pairSearch = static_cast<std::int32_t>(args.pairSearch);
+    a.tuneInterval = args.tuneInterval;
+    a.basenameLength = static_cast<std::uint32_t>(args.basename.size());
+    for (size_t i = 0; i < a.conditions.size(); ++i)
+        a.conditions[i] = static_cast<std::uint8_t>(args.conditions[i]);
+    a.linkedCells = args.linkedCells;
+    a.membrane = args.membrane;
+    a.doublePrecision = args.doublePrecision;
+    a.compressOutput = args.compressOutput;
+    a.autoTune = args.autoTune;
+    writeBytes(&a, sizeof(a));
+
+    // thermostat
+    ThermostatRecord tr{};
+    tr.T_init = t.getInitTemp();
+    tr.T_target = t.getTargetTemp();
+    tr.delta_T = t.getDeltaT();
+    tr.dimension = t.getDimension();
+    tr.n_thermostat = t.getTimestep();
+    tr.limitScaling = t.doScalingLimit();
+    tr.nanoFlow = t.getNanoflow();
+    writeBytes(&tr, sizeof(tr));
+
+    // analyzer
+    AnalyzerRecord ar{};
+    ar.frequency = fsa.getFrequency();
+    if (ar.frequency > 0) {
+        ar.leftWallPosX = fsa.getLeftWallPosX();
+        ar.rightWallPosX = fsa.getRightWallPosX();
+        ar.binNumber = fsa.getBinNumber();
+        ar.samples = fsa.getSamples();
+        ar.accumulate = fsa.isAccumulating();
+        ar.sumsCount = fsa.getCountSums().size();
+        ar.dirnameLength = static_cast<std::uint32_t>(fsa.getDirname().size());
+        ar.basenameLength = static_cast<std::uint32_t>(fsa.getBasename().size());
+    }
+    writeBytes(&ar, sizeof(ar));
+
+    // particles, buffered in batches
+    std::vector<ParticleRecord> records;
+    records.reserve(std::min<std::uint64_t>(particleCount, BATCH_SIZE));
+    std::uint64_t bondOffset = 0;
+    for (const auto &p : pc) {
+        CONTINUE_IF_INACTIVE(p);
+        ParticleRecord r{};
+        r.x = p.getX();
+        r.v = p.getV();
+        r.f = p.getF();
+        r.oldF = p.getOldF();
+        r.thermalMotion = p.getThermalMotion();
+        r.m = p.getM();
+        r.epsilon = p.getEpsilon();
+        r.sigma = p.getSigma();
+        r.k = p.getK();
+        r.r_0 = p.getR0();
+        r.fzup = p.getFZUP();
+        r.type = p.getType();
+        r.cellIndex = p.getCellIndex();
+        r.directCount = countBonds(p.getDirectNeighbours());
+        r.diagonalCount = countBonds(p.getDiagonalNeighbours());
+        r.bondOffset = bondOffset;
+        bondOffset += r.directCount + r.diagonalCount;
+        records.push_back(r);
+        if (records.size() == BATCH_SIZE) {
+            writeBytes(records.data(), records.size() * sizeof(ParticleRecord));
+            records.clear();
+        }
+    }
+    writeBytes(records.data(), records.size() * sizeof(ParticleRecord));
+
+    // bonds, padded to 8 bytes
+    std::vector<std::uint32_t> bonds;
+    bonds.reserve(bondCount + 1);
+    for (const auto &p : pc) {
+        CONTINUE_IF_INACTIVE(p);
+        appendBonds(p.getDirectNeighbours(), bonds);
+        appendBonds(p.getDiagonalNeighbours(), bonds);
+    }
+    if (bonds.size() % 2 != 0)
+        bonds.push_back(0);
+    writeBytes(bonds.data(), bonds.size() * sizeof(std::uint32_t));
+
+    // analyzer sums and strings
+    if (ar.frequency > 0) {
+        writeBytes(fsa.getCountSums().data(), ar.sumsCount * sizeof(double));
+        writeBytes(fsa.getVelocitySums().data(), ar.sumsCount * sizeof(double));
+    }
+    writeBytes(args.basename.data(), args.basename.size());
+    if (ar.frequency > 0) {
+        writeBytes(fsa.getDirname().data(), ar.dirnameLength);
+        writeBytes(fsa.getBasename().data(), ar.basenameLength);
+    }
+
+    // replace the previous checkpoint only once the new one is complete
+    m_file.close();
+    if (m_file.fail())
+        CLIUtils::error("Failed to write contents to file stream!", "", false);
+    if (std::rename((m_filename + ".tmp").c_str(), m_filename.c_str()) != 0)
+        CLIUtils::error("Failed to replace checkpoint file", m_filename, false);
+    SPDLOG_INFO("Saved checkpoint with {} particles at t = {} (iteration {}) to file {}.", particleCount, time,
+                iteration, m_filename);
+}
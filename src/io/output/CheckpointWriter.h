@@ -0,0 +1,242 @@
+/**
+ * @file CheckpointWriter.h
+ * @brief Save the complete simulation state to a binary checkpoint file.
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "objects/FlowSimulationAnalyzer.h"
+#include "objects/ParticleContainer.h"
+#include "objects/Thermostat.h"
+#include "utils/Arguments.h"
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Constants and record layouts describing the binary checkpoint (.chk) format.
+ *
+ * @details A checkpoint file consists of the following sections, each starting at a multiple of 8 bytes:
+ * - FileHeader, ArgsRecord, ThermostatRecord and AnalyzerRecord.
+ * - One ParticleRecord per active particle.
+ * - The bonds of all particles (UInt32 indices into the particle records), padded to a multiple of 8 bytes.
+ * - The running count and velocity sums of the analyzer (AnalyzerRecord::sumsCount Float64 values each).
+ * - The argument base name, analyzer directory name and analyzer base name, without terminating null characters.
+ *
+ * Bonds are stored as record indices instead of particle handles, so that they stay valid regardless of the handles
+ * assigned when restoring. All values are stored in the byte order of the writing machine. The fixed-size sections can
+ * be used in place after mapping the file into memory.
+ */
+namespace CheckpointFormat {
+/// @brief Magic bytes at the start of a checkpoint file.
+inline constexpr char Magic[8] = {'M', 'D', 'C', 'H', 'E', 'C', 'K', 'P'};
+/// @brief Value used to detect a byte order mismatch between writer and reader.
+inline constexpr std::uint32_t ByteOrderMark = 0x01020304;
+/// @brief The version of the record layouts, increased on every incompatible change.
+inline constexpr std::uint32_t Version = 3;
+
+/// @brief Fixed-size file header.
+struct FileHeader {
+    /// @brief Magic bytes identifying the file format.
+    char magic[8];
+    /// @brief Byte order mark of the writing machine.
+    std::uint32_t byteOrder;
+    /// @brief Version of the record layouts.
+    std::uint32_t version;
+    /// @brief The number of particle records.
+    std::uint64_t particleCount;
+    /// @brief The total number of bonds of all particles.
+    std::uint64_t bondCount;
+    /// @brief The simulation time at which the checkpoint was saved.
+    double time;
+    /// @brief The remaining number of iterations in which the special upward force is applied (membranes).
+    std::int32_t specialForceLimit;
+    /// @brief The number of the iteration at which the simulation is resumed.
+    std::int32_t iteration;
+};
+
+/// @brief Simulation arguments.
+struct ArgsRecord {
+    /// @brief End time of the simulation.
+    double endTime;
+    /// @brief Duration of a timestep.
+    double delta_t;
+    /// @brief Domain size for linked cells.
+    std::array<double, 3> domainSize;
+    /// @brief Cutoff radius for linked cells.
+    double cutoffRadius;
+    /// @brief Gravity that the particles are exposed to.
+    double gravity;
+    /// @brief The minimum cell size relative to the cutoff radius.
+    double cellSizeFactor;
+    /// @brief The distance particles may move outside of their cell before being moved to another cell.
+    double cellSkin;
+    /// @brief The cutoff radius of each particle pair relative to its mixed sigma.
+    double pairCutoffFactor;
+    /// @brief Output frequency.
+    std::int32_t itFreq;
+    /// @brief Checkpoint frequency.
+    std::int32_t checkpointFreq;
+    /// @brief Maximum number of queued output frames.
+    std::uint64_t outputQueue;
+    /// @brief The dimensions of the simulation.
+    std::uint64_t dimensions;
+    /// @brief Output type (WriterType).
+    std::int32_t type;
+    /// @brief Simulation type (SimulationType).
+    std::int32_t sim;
+    /// @brief Parallelization type (ParallelizationType).
+    std::int32_t parallelization;
+    /// @brief Pair search scheme (PairSearchType).
+    std::int32_t pairSearch;
+    /// @brief The number of steps after which the configuration is tuned again.
+    std::int32_t tuneInterval;
+    /// @brief The length of the base name.
+    std::uint32_t basenameLength;
+    /// @brief The boundary conditions (BoundaryCondition).
+    std::array<std::uint8_t, 6> conditions;
+    /// @brief Whether the linked cell method is used.
+    std::uint8_t linkedCells;
+    /// @brief Whether the simulation is a membrane simulation.
+    std::uint8_t membrane;
+    /// @brief Whether binary VTK output uses Float64.
+    std::uint8_t doublePrecision;
+    /// @brief Whether output is compressed.
+    std::uint8_t compressOutput;
+    /// @brief Whether the linked cell configuration is auto-tuned.
+    std::uint8_t autoTune;
+    /// @brief Reserved for future use.
+    std::array<std::uint8_t, 5> reserved;
+};
+
+/// @brief Thermostat parameters.
+struct ThermostatRecord {
+    /// @brief Starting temperature.
+    double T_init;
+    /// @brief Target temperature.
+    double T_target;
+    /// @brief Maximum temperature difference in one thermostat application.
+    double delta_T;
+    /// @brief The dimensions for which the temperature regulation is applied.
+    std::int32_t dimension;
+    /// @brief The number of iterations after which the thermostat is applied.
+    std::int32_t n_thermostat;
+    /// @brief Whether gradual velocity scaling is applied.
+    std::uint8_t limitScaling;
+    /// @brief Whether the thermostat is used for the nano-scale flow simulation.
+    std::uint8_t nanoFlow;
+    /// @brief Reserved for future use.
+    std::array<std::uint8_t, 6> reserved;
+};
+
+/// @brief Analyzer parameters and sampling state.
+struct AnalyzerRecord {
+    /// @brief The x coordinate of the left wall.
+    double leftWallPosX;
+    /// @brief The x coordinate of the right wall.
+    double rightWallPosX;
+    /// @brief The number of bins.
+    std::int32_t binNumber;
+    /// @brief The output frequency, at most 0 if the analyzer is disabled.
+    std::int32_t frequency;
+    /// @brief The number of samples taken since the last output.
+    std::int32_t samples;
+    /// @brief Whether samples are accumulated between outputs.
+    std::uint32_t accumulate;
+    /// @brief The number of stored count and velocity sums.
+    std::uint64_t sumsCount;
+    /// @brief The length of the directory name.
+    std::uint32_t dirnameLength;
+    /// @brief The length of the base name.
+    std::uint32_t basenameLength;
+};
+
+/// @brief The complete state of a single particle.
+struct ParticleRecord {
+    /// @brief Position.
+    std::array<double, 3> x;
+    /// @brief Velocity.
+    std::array<double, 3> v;
+    /// @brief Force.
+    std::array<double, 3> f;
+    /// @brief Previous force.
+    std::array<double, 3> oldF;
+    /// @brief Thermal motion.
+    std::array<double, 3> thermalMotion;
+    /// @brief Mass.
+    double m;
+    /// @brief Lennard-Jones parameter epsilon.
+    double epsilon;
+    /// @brief Lennard-Jones parameter sigma.
+    double sigma;
+    /// @brief Stiffness constant.
+    double k;
+    /// @brief Average bond length.
+    double r_0;
+    /// @brief Constant upward force.
+    double fzup;
+    /// @brief Type.
+    std::int32_t type;
+    /// @brief Index of the cell containing the particle.
+    std::int32_t cellIndex;
+    /// @brief The number of direct neighbours.
+    std::uint32_t directCount;
+    /// @brief The number of diagonal neighbours.
+    std::uint32_t diagonalCount;
+    /// @brief Index of the first bond (direct neighbours, followed by diagonal neighbours) in the bond section.
+    std::uint64_t bondOffset;
+};
+
+static_assert(std::is_trivially_copyable_v<ParticleRecord>, "Particle records must be trivially copyable!");
+static_assert(sizeof(FileHeader) % 8 == 0 && sizeof(ArgsRecord) % 8 == 0 && sizeof(ThermostatRecord) % 8 == 0 &&
+                  sizeof(AnalyzerRecord) % 8 == 0 && sizeof(ParticleRecord) % 8 == 0,
+              "Checkpoint records must be padded to a multiple of 8 bytes!");
+} // namespace CheckpointFormat
+
+/// @brief Class used to save the complete simulation state to a binary checkpoint file, which can be used as input.
+class CheckpointWriter {
+  private:
+    /// @brief Output stream containing the temporary file, which replaces the checkpoint file once complete.
+    std::ofstream m_file;
+    /// @brief The name of the checkpoint file.
+    std::string m_filename;
+
+    /**
+     * @brief Writes raw bytes to the file.
+     *
+     * @param data The bytes to be written.
+     * @param size The number of bytes to be written.
+     */
+    void writeBytes(const void *data, size_t size);
+
+  public:
+    /**
+     * @brief Constructs a new CheckpointWriter object.
+     *
+     * @param filename The name of the checkpoint file to be written.
+     */
+    explicit CheckpointWriter(const std::string &filename);
+
+    /// @brief Destroys the current CheckpointWriter object.
+    ~CheckpointWriter();
+
+    /**
+     * @brief Saves the simulation state to the checkpoint file. Terminates program execution on error.
+     *
+     * @details The state is first written to a temporary file, which then replaces the checkpoint file. Thus, an
+     * interrupted write never destroys the previous checkpoint. Inactive particles are not saved.
+     *
+     * @param pc The ParticleContainer containing the simulation particles.
+     * @param args The Arguments struct containing simulation metadata.
+     * @param t The thermostat.
+     * @param fsa The analyzer.
+     * @param time The current simulation time, at which the simulation is resumed.
+     * @param iteration The number of the current iteration, at which the simulation is resumed.
+     */
+    void write(const ParticleContainer &pc, const Arguments &args, const Thermostat &t,
+               const FlowSimulationAnalyzer &fsa, double time, int iteration);
+};
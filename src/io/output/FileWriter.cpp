@@ -55,6 +55,13 @@ void FileWriter::writeFile(const std::string &content, const std::string &filena
                        StringUtils::fromNumber(CLIUtils::getPercentage(iteration, total)) + "%)"));
 }
 
+void FileWriter::writeParticles(const ParticleContainer &particles, int iteration, int total) {
+    m_frame.capture(particles, iteration, total);
+    writeFrame(m_frame);
+}
+
+void FileWriter::flush() {}
+
 void FileWriter::initializeFolder(const std::string &dirname) {
     // stat buffer for folder metadata
     struct stat buffer;
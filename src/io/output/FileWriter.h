@@ -8,6 +8,7 @@
  *
  */
 #pragma once
+#include "Frame.h"
 #include "objects/ParticleContainer.h"
 #include <fstream>
 #include <string>
@@ -18,6 +19,9 @@ class FileWriter {
     /// @brief Output stream containing the file to write contents to.
     std::ofstream m_file;
 
+    /// @brief Reusable snapshot buffer for synchronous writes.
+    Frame m_frame;
+
   public:
     /// @brief Creates a new FileWriter with no file initialized.
     FileWriter();
@@ -65,12 +69,25 @@ class FileWriter {
     void writeFile(const std::string &content, const std::string &filename = "", int iteration = -1, int total = -1);
 
     /**
-     * @brief Interface function for writing the type, mass, position, velocity and force of a ParticleContainer to a
-     * file. Terminates program execution on error.
+     * @brief Writes the type, mass, position, velocity and force of a ParticleContainer to a file. Terminates program
+     * execution on error.
+     *
+     * @details By default, this captures a Frame of the active particles and passes it to writeFrame().
      *
      * @param particles The ParticleContainer.
      * @param iteration The number of the current iteration, used to generate a unique filename.
      * @param total The total number of iterations, used to display the current percentage.
      */
-    virtual void writeParticles(const ParticleContainer &particles, int iteration, int total) = 0;
+    virtual void writeParticles(const ParticleContainer &particles, int iteration, int total);
+
+    /**
+     * @brief Interface function for writing a previously captured Frame to a file. Terminates program execution on
+     * error.
+     *
+     * @param frame The Frame containing the particle data, the current and the total number of iterations.
+     */
+    virtual void writeFrame(const Frame &frame) = 0;
+
+    /// @brief Blocks until all pending output has been written. Does nothing for synchronous writers.
+    virtual void flush();
 };
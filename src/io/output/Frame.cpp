@@ -0,0 +1,35 @@
+#include "Frame.h"
+#include <algorithm>
+
+void Frame::capture(const ParticleContainer &particles, int iteration, int total) {
+    this->iteration = iteration;
+    this->total = total;
+
+    // size for the whole container first and trim afterwards, so that only one pass over the particles is needed
+    const size_t capacity = particles.size();
+    positions.resize(3 * capacity);
+    velocities.resize(3 * capacity);
+    forces.resize(3 * capacity);
+    masses.resize(capacity);
+    types.resize(capacity);
+    ids.resize(capacity);
+
+    size_t n = 0;
+    for (auto &p : particles) {
+        CONTINUE_IF_INACTIVE(p);
+        std::copy(p.getX().begin(), p.getX().end(), positions.begin() + 3 * n);
+        std::copy(p.getV().begin(), p.getV().end(), velocities.begin() + 3 * n);
+        std::copy(p.getOldF().begin(), p.getOldF().end(), forces.begin() + 3 * n);
+        masses[n] = p.getM();
+        types[n] = p.getType();
+        ids[n] = p.getHandle();
+        ++n;
+    }
+
+    positions.resize(3 * n);
+    velocities.resize(3 * n);
+    forces.resize(3 * n);
+    masses.resize(n);
+    types.resize(n);
+    ids.resize(n);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file Frame.h
+ * @brief Snapshot of the particle data written by the output writers.
+ * @date 2025-02-03
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "objects/ParticleContainer.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Columnar copy of all data needed to write a single output frame.
+ *
+ * @details Only active particles are captured. Vector quantities are stored interleaved, i.e. the components of
+ * particle i are located at indices 3i, 3i + 1 and 3i + 2. The buffers keep their capacity between captures, so a
+ * reused Frame does not allocate once it has grown to the size of the system.
+ */
+struct Frame {
+    /// @brief The iteration in which the frame was captured.
+    int iteration{0};
+    /// @brief The total number of iterations of the simulation.
+    int total{0};
+    /// @brief The positions of the particles.
+    std::vector<double> positions;
+    /// @brief The velocities of the particles.
+    std::vector<double> velocities;
+    /// @brief The (old) forces of the particles.
+    std::vector<double> forces;
+    /// @brief The masses of the particles.
+    std::vector<double> masses;
+    /// @brief The types of the particles.
+    std::vector<int> types;
+    /// @brief The stable handles of the particles, used to identify them across frames.
+    std::vector<std::uint32_t> ids;
+
+    /**
+     * @brief Copies the data of all active particles of a ParticleContainer into this frame.
+     *
+     * @param particles The ParticleContainer to capture.
+     * @param iteration The current iteration of the simulation.
+     * @param total The total number of iterations of the simulation.
+     */
+    void capture(const ParticleContainer &particles, int iteration, int total);
+
+    /**
+     * @brief Gets the number of particles stored in this frame.
+     *
+     * @return The number of particles stored in this frame.
+     */
+    inline size_t size() const { return masses.size(); }
+};
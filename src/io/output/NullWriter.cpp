@@ -15,4 +15,14 @@ void NullWriter::writeParticles(const ParticleContainer &particles, int iteratio
     SPDLOG_INFO("Iteration: {} ({}%)", iteration, percentage);
     for (size_t i = 0; i < particles.size(); ++i)
         SPDLOG_INFO("Particle {}: {}", i, particles[i].toString());
+}
+void NullWriter::writeFrame(const Frame &frame) {
+    const int percentage = CLIUtils::getPercentage(frame.iteration, frame.total);
+    SPDLOG_INFO("Iteration: {} ({}%)", frame.iteration, percentage);
+    for (size_t i = 0; i < frame.size(); ++i)
+        SPDLOG_INFO("Particle {}: {{ x: [{}, {}, {}], v: [{}, {}, {}], old_f: [{}, {}, {}], m: {}, type: {} }}", i,
+                    frame.positions[3 * i], frame.positions[3 * i + 1], frame.positions[3 * i + 2],
+                    frame.velocities[3 * i], frame.velocities[3 * i + 1], frame.velocities[3 * i + 2],
+                    frame.forces[3 * i], frame.forces[3 * i + 1], frame.forces[3 * i + 2], frame.masses[i],
+                    frame.types[i]);
 }
\ No newline at end of file
@@ -42,4 +42,13 @@ class NullWriter : public FileWriter {
      * @param total The total number of iterations, used to display the current percentage.
      */
     void writeParticles(const ParticleContainer &particles, int iteration, int total) override;
+
+    /**
+     * @brief Logs the type, mass, position, velocity and force of all particles in a Frame.
+     *
+     * For debugging purposes only.
+     *
+     * @param frame The Frame containing the particle data, the current and the total number of iterations.
+     */
+    void writeFrame(const Frame &frame) override;
 };
\ No newline at end of file
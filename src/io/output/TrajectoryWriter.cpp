@@ -0,0 +1,152 @@
+#include "TrajectoryWriter.h"
+#include "utils/CLIUtils.h"
+#include "utils/StringUtils.h"
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <string>
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace TrajectoryFormat;
+
+TrajectoryWriter::TrajectoryWriter() {
+    SPDLOG_TRACE("Created new TrajectoryWriter (empty).");
+    initializeFolder(m_dirname);
+    initializeOutput();
+}
+TrajectoryWriter::TrajectoryWriter(const std::string &basename, bool compress)
+    : m_basename{basename}, m_compress{compress} {
+    SPDLOG_TRACE("Created new TrajectoryWriter with base name {} (compressed: {})", basename, compress);
+    initializeFolder(m_dirname);
+    initializeOutput();
+}
+TrajectoryWriter::TrajectoryWriter(const std::string &basename, const std::string &dirname, bool compress)
+    : m_basename{basename}, m_dirname{dirname}, m_compress{compress} {
+    SPDLOG_TRACE("Created new TrajectoryWriter with base name {} and directory name {} (compressed: {})", basename,
+                 dirname, compress);
+    initializeFolder(m_dirname);
+    initializeOutput();
+}
+TrajectoryWriter::~TrajectoryWriter() {
+    writeIndex();
+    closeFile();
+    SPDLOG_TRACE("Destroyed TrajectoryWriter.");
+}
+
+void TrajectoryWriter::initializeOutput() {
+#ifndef HAS_ZLIB
+    if (m_compress)
+        CLIUtils::error("Compressed trajectory output requires zlib, which was not found at compile time!", "", false);
+#endif
+    m_file.open(getFilePath(), std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+        CLIUtils::error("Failed to open file", getFilePath(), false);
+
+    FileHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.byteOrder = ByteOrderMark;
+    header.flags = m_compress ? (FLAG_DELTA | FLAG_ZLIB) : 0;
+    header.keyframeInterval = KEYFRAME_INTERVAL;
+    writeBytes(&header, sizeof(header));
+    SPDLOG_DEBUG("Opened trajectory file {} for writing.", getFilePath());
+}
+
+void TrajectoryWriter::writeBytes(const void *data, size_t size) {
+    m_file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    if (m_file.bad())
+        CLIUtils::error("Failed to write contents to file stream!", "", false);
+    m_offset += size;
+}
+
+void TrajectoryWriter::writeChunk() {
+    const std::uint64_t rawSize = m_raw.size();
+    if (!m_compress) {
+        writeBytes(&rawSize, sizeof(rawSize));
+        writeBytes(&rawSize, sizeof(rawSize));
+        writeBytes(m_raw.data(), m_raw.size());
+        return;
+    }
+#ifdef HAS_ZLIB
+    uLongf storedSize = compressBound(m_raw.size());
+    m_stored.resize(storedSize);
+    if (compress2(reinterpret_cast<Bytef *>(m_stored.data()), &storedSize,
+                  reinterpret_cast<const Bytef *>(m_raw.data()), m_raw.size(), Z_DEFAULT_COMPRESSION) != Z_OK)
+        CLIUtils::error("Failed to compress trajectory chunk!", "", false);
+    const std::uint64_t stored = storedSize;
+    writeBytes(&rawSize, sizeof(rawSize));
+    writeBytes(&stored, sizeof(stored));
+    writeBytes(m_stored.data(), storedSize);
+#endif
+}
+
+void TrajectoryWriter::writeDoubles(const std::vector<double> &data, const std::vector<double> *previous) {
+    m_raw.resize(data.size() * sizeof(double));
+    std::memcpy(m_raw.data(), data.data(), m_raw.size());
+    if (previous) {
+        // xor the bit patterns with the previous frame; unchanged leading bits become zero
+        for (size_t i = 0; i < data.size(); ++i) {
+            std::uint64_t current, last;
+            std::memcpy(&current, m_raw.data() + i * sizeof(double), sizeof(current));
+            std::memcpy(&last, previous->data() + i, sizeof(last));
+            current ^= last;
+            std::memcpy(m_raw.data() + i * sizeof(double), &current, sizeof(current));
+        }
+    }
+    writeChunk();
+}
+
+void TrajectoryWriter::writeFrame(const Frame &frame) {
+    // frames are delta encoded if they contain the same particles as the previous frame
+    const bool isKeyframe = !m_compress || m_index.empty() || m_index.size() % KEYFRAME_INTERVAL == 0 ||
+                            frame.ids != m_prevIds;
+    const std::uint64_t keyframe = isKeyframe ? m_index.size() : m_index.back().keyframe;
+    m_index.push_back({m_offset, keyframe, frame.iteration});
+
+    FrameHeader header{};
+    header.iteration = frame.iteration;
+    header.total = frame.total;
+    header.size = frame.size();
+    header.delta = isKeyframe ? 0 : 1;
+    header.columns = NUM_COLUMNS;
+    writeBytes(&header, sizeof(header));
+
+    writeDoubles(frame.positions, isKeyframe ? nullptr : &m_prevPositions);
+    writeDoubles(frame.velocities, isKeyframe ? nullptr : &m_prevVelocities);
+    writeDoubles(frame.masses, nullptr);
+
+    m_raw.resize(frame.types.size() * sizeof(std::int32_t));
+    for (size_t i = 0; i < frame.types.size(); ++i) {
+        const std::int32_t type = frame.types[i];
+        std::memcpy(m_raw.data() + i * sizeof(type), &type, sizeof(type));
+    }
+    writeChunk();
+
+    m_raw.resize(frame.ids.size() * sizeof(std::uint32_t));
+    std::memcpy(m_raw.data(), frame.ids.data(), m_raw.size());
+    writeChunk();
+
+    if (m_compress) {
+        m_prevPositions = frame.positions;
+        m_prevVelocities = frame.velocities;
+        m_prevIds = frame.ids;
+    }
+
+    SPDLOG_INFO("Appended frame {} to trajectory file {} ({} / {}) ({}%).", m_index.size() - 1, getFilePath(),
+                StringUtils::fromNumber(frame.iteration), StringUtils::fromNumber(frame.total),
+                StringUtils::fromNumber(CLIUtils::getPercentage(frame.iteration, frame.total)));
+}
+
+void TrajectoryWriter::writeIndex() {
+    if (!m_file.is_open())
+        return;
+    const std::uint64_t indexOffset = m_offset;
+    const std::uint64_t frameCount = m_index.size();
+    writeBytes(m_index.data(), m_index.size() * sizeof(IndexEntry));
+    writeBytes(&frameCount, sizeof(frameCount));
+    writeBytes(&indexOffset, sizeof(indexOffset));
+    writeBytes(IndexMagic, sizeof(IndexMagic));
+    SPDLOG_DEBUG("Wrote trajectory index with {} frames.", frameCount);
+}
+
+std::string TrajectoryWriter::getFilePath() const { return m_dirname + "/" + m_basename + ".traj"; }
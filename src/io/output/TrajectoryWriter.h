@@ -0,0 +1,173 @@
+/**
+ * @file TrajectoryWriter.h
+ * @brief Class used to generate a single columnar binary trajectory file per simulation run.
+ * @date 2025-02-05
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "FileWriter.h"
+#include "Frame.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Constants and record layouts describing the binary trajectory (.traj) format.
+ *
+ * @details A trajectory file consists of a header, a sequence of frames and a footer index:
+ * - Header: Magic, ByteOrderMark, flags (see FLAG_DELTA and FLAG_ZLIB) and the keyframe interval.
+ * - Frame: FrameHeader, followed by one chunk per column (positions, velocities, masses, types, ids). Each chunk
+ * consists of its uncompressed and stored size (both UInt64), followed by the stored bytes.
+ * - Footer: One IndexEntry per frame, the number of frames and the offset of the index (both UInt64) and IndexMagic.
+ *
+ * If delta encoding is enabled, the bit patterns of the positions and velocities of a frame are XORed with the ones of
+ * the previous frame. This is lossless and produces long runs of zero bits, which compress well. Every frame whose
+ * particle ids differ from the previous frame, as well as every KEYFRAME_INTERVAL-th frame, is stored as a keyframe
+ * without delta encoding. All values are stored in the byte order of the writing machine.
+ */
+namespace TrajectoryFormat {
+/// @brief Magic bytes at the start of a trajectory file.
+inline constexpr char Magic[8] = {'M', 'D', 'T', 'R', 'A', 'J', '0', '1'};
+/// @brief Magic bytes at the end of a trajectory file with a complete footer index.
+inline constexpr char IndexMagic[8] = {'M', 'D', 'T', 'R', 'A', 'J', 'I', 'X'};
+/// @brief Value used to detect a byte order mismatch between writer and reader.
+inline constexpr std::uint32_t ByteOrderMark = 0x01020304;
+/// @brief Flag set if frames may be delta encoded.
+inline constexpr std::uint32_t FLAG_DELTA = 1;
+/// @brief Flag set if the column chunks are compressed using zlib.
+inline constexpr std::uint32_t FLAG_ZLIB = 2;
+/// @brief The maximum number of frames between two keyframes.
+inline constexpr std::uint32_t KEYFRAME_INTERVAL = 16;
+/// @brief The number of column chunks per frame.
+inline constexpr std::uint32_t NUM_COLUMNS = 5;
+
+/// @brief Fixed-size file header.
+struct FileHeader {
+    /// @brief Magic bytes identifying the file format.
+    char magic[8];
+    /// @brief Byte order mark of the writing machine.
+    std::uint32_t byteOrder;
+    /// @brief Combination of FLAG_DELTA and FLAG_ZLIB.
+    std::uint32_t flags;
+    /// @brief The maximum number of frames between two keyframes.
+    std::uint32_t keyframeInterval;
+    /// @brief Reserved for future use.
+    std::uint32_t reserved;
+};
+
+/// @brief Fixed-size header preceding the column chunks of each frame.
+struct FrameHeader {
+    /// @brief The iteration in which the frame was captured.
+    std::int32_t iteration;
+    /// @brief The total number of iterations of the simulation.
+    std::int32_t total;
+    /// @brief The number of particles in the frame.
+    std::uint64_t size;
+    /// @brief 1 if the positions and velocities are delta encoded, 0 for keyframes.
+    std::uint32_t delta;
+    /// @brief The number of column chunks following the header.
+    std::uint32_t columns;
+};
+
+/// @brief Entry of the footer index, one per frame.
+struct IndexEntry {
+    /// @brief The offset of the frame from the start of the file.
+    std::uint64_t offset;
+    /// @brief The index of the keyframe this frame depends on (its own index for keyframes).
+    std::uint64_t keyframe;
+    /// @brief The iteration in which the frame was captured.
+    std::int64_t iteration;
+};
+} // namespace TrajectoryFormat
+
+/// @brief Class which implements functionality to write all output frames of a run into a single trajectory file.
+class TrajectoryWriter : public FileWriter {
+  private:
+    /// @brief The base name of the generated file.
+    std::string m_basename = "MD_traj";
+    /// @brief The name of the directory in which to store the generated file.
+    std::string m_dirname = "traj";
+    /// @brief Determines whether frames are delta encoded and their chunks compressed using zlib.
+    bool m_compress{false};
+    /// @brief The current write position in the file.
+    std::uint64_t m_offset{0};
+    /// @brief The index entries of all frames written so far.
+    std::vector<TrajectoryFormat::IndexEntry> m_index;
+    /// @brief The positions of the previous frame, used for delta encoding.
+    std::vector<double> m_prevPositions;
+    /// @brief The velocities of the previous frame, used for delta encoding.
+    std::vector<double> m_prevVelocities;
+    /// @brief The ids of the previous frame, used to decide whether a frame may be delta encoded.
+    std::vector<std::uint32_t> m_prevIds;
+    /// @brief Reusable buffer for the (delta encoded) raw bytes of a column.
+    std::vector<char> m_raw;
+    /// @brief Reusable buffer for the compressed bytes of a column.
+    std::vector<char> m_stored;
+
+    /// @brief Opens the trajectory file and writes the file header.
+    void initializeOutput();
+
+    /**
+     * @brief Writes raw bytes to the file and advances the write position.
+     *
+     * @param data The bytes to be written.
+     * @param size The number of bytes to be written.
+     */
+    void writeBytes(const void *data, size_t size);
+
+    /// @brief Writes the contents of m_raw as a column chunk, compressing it if enabled.
+    void writeChunk();
+
+    /**
+     * @brief Writes a floating point column, optionally XORing it with the previous frame's column.
+     *
+     * @param data The column to be written.
+     * @param previous The same column of the previous frame, or nullptr if the column is not delta encoded.
+     */
+    void writeDoubles(const std::vector<double> &data, const std::vector<double> *previous);
+
+    /// @brief Writes the footer index, completing the trajectory file.
+    void writeIndex();
+
+  public:
+    /// @brief Creates a new uninitialized TrajectoryWriter.
+    TrajectoryWriter();
+
+    /**
+     * @brief Creates a new TrajectoryWriter with the given basename for the generated file.
+     *
+     * @param basename The base name of the generated file.
+     * @param compress Whether frames are delta encoded and compressed using zlib.
+     */
+    explicit TrajectoryWriter(const std::string &basename, bool compress = false);
+
+    /**
+     * @brief Creates a new TrajectoryWriter with the given basename for the generated file in the specified directory.
+     *
+     * @param basename The base name of the generated file.
+     * @param dirname The directory name of the generated file.
+     * @param compress Whether frames are delta encoded and compressed using zlib.
+     */
+    TrajectoryWriter(const std::string &basename, const std::string &dirname, bool compress = false);
+
+    /// @brief Writes the footer index, closes the trajectory file and destroys the TrajectoryWriter object.
+    virtual ~TrajectoryWriter();
+
+    /**
+     * @brief Appends the positions, velocities, masses, types and ids of all particles in a Frame to the trajectory
+     * file. Terminates program execution on error.
+     *
+     * @param frame The Frame containing the particle data, the current and the total number of iterations.
+     */
+    void writeFrame(const Frame &frame) override;
+
+    /**
+     * @brief Gets the path of the generated trajectory file.
+     *
+     * @return The path of the generated trajectory file.
+     */
+    std::string getFilePath() const;
+};
@@ -86,7 +86,7 @@ void VTKWriter::writeFile(int iteration, int total) {
     SPDLOG_TRACE("Deleted VTK object.");
 }
 
-void VTKWriter::plotParticle(const Particle &p) {
+void VTKWriter::plotParticle(const Frame &frame, size_t i) {
     // check for valid vtk file
     if (!m_vtkFile || !(m_vtkFile->UnstructuredGrid().present()))
         CLIUtils::error("VTK file incorrectly initialized!", "", false);
@@ -95,37 +95,36 @@ void VTKWriter::plotParticle(const Particle &p) {
     PointData::DataArray_sequence &pointDataSequence = m_vtkFile->UnstructuredGrid()->Piece().PointData().DataArray();
     PointData::DataArray_iterator dataIterator = pointDataSequence.begin();
 
-    dataIterator->push_back(p.getM());
+    dataIterator->push_back(frame.masses[i]);
 
     dataIterator++;
-    dataIterator->push_back(p.getV()[0]);
-    dataIterator->push_back(p.getV()[1]);
-    dataIterator->push_back(p.getV()[2]);
+    dataIterator->push_back(frame.velocities[3 * i]);
+    dataIterator->push_back(frame.velocities[3 * i + 1]);
+    dataIterator->push_back(frame.velocities[3 * i + 2]);
 
     dataIterator++;
-    dataIterator->push_back(p.getOldF()[0]);
-    dataIterator->push_back(p.getOldF()[1]);
-    dataIterator->push_back(p.getOldF()[2]);
+    dataIterator->push_back(frame.forces[3 * i]);
+    dataIterator->push_back(frame.forces[3 * i + 1]);
+    dataIterator->push_back(frame.forces[3 * i + 2]);
 
     dataIterator++;
-    dataIterator->push_back(p.getType());
+    dataIterator->push_back(frame.types[i]);
 
     Points::DataArray_sequence &pointsSequence = m_vtkFile->UnstructuredGrid()->Piece().Points().DataArray();
     Points::DataArray_iterator pointsIterator = pointsSequence.begin();
-    pointsIterator->push_back(p.getX()[0]);
-    pointsIterator->push_back(p.getX()[1]);
-    pointsIterator->push_back(p.getX()[2]);
+    pointsIterator->push_back(frame.positions[3 * i]);
+    pointsIterator->push_back(frame.positions[3 * i + 1]);
+    pointsIterator->push_back(frame.positions[3 * i + 2]);
 
-    SPDLOG_TRACE("Plotted Particle - {}", p.toString());
+    SPDLOG_TRACE("Plotted Particle {} of frame {}", i, frame.iteration);
 }
 
-void VTKWriter::writeParticles(const ParticleContainer &particles, int iteration, int total) {
-    initializeOutput(particles.activeSize());
+void VTKWriter::writeFrame(const Frame &frame) {
+    initializeOutput(frame.size());
 
-    for (auto &p : particles) {
-        CONTINUE_IF_INACTIVE(p);
-        plotParticle(p);
+    for (size_t i = 0; i < frame.size(); ++i) {
+        plotParticle(frame, i);
     }
 
-    writeFile(iteration, total);
+    writeFile(frame.iteration, frame.total);
 }
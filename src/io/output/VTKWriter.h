@@ -43,9 +43,10 @@ class VTKWriter : public FileWriter {
     /**
      * @brief Plots a single particle to m_vtkFile. Terminates program execution on error.
      *
-     * @param p The particle to be plotted.
+     * @param frame The Frame containing the particle data.
+     * @param i The index of the particle to be plotted inside the frame.
      */
-    void plotParticle(const Particle &p);
+    void plotParticle(const Frame &frame, size_t i);
 
   public:
     /// @brief Creates a new uninitialized VTKWriter.
@@ -70,12 +71,10 @@ class VTKWriter : public FileWriter {
     virtual ~VTKWriter();
 
     /**
-     * @brief Writes the type, mass, position, velocity and force of a ParticleContainer to a VTK file. Terminates
+     * @brief Writes the type, mass, position, velocity and force of all particles in a Frame to a VTK file. Terminates
      * program execution on error.
      *
-     * @param particles The ParticleContainer.
-     * @param iteration The number of the current iteration, used to generate a unique filename.
-     * @param total The total number of iterations, used to display the current percentage.
+     * @param frame The Frame containing the particle data, the current and the total number of iterations.
      */
-    void writeParticles(const ParticleContainer &particles, int iteration, int total) override;
+    void writeFrame(const Frame &frame) override;
 };
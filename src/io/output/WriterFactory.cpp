@@ -1,15 +1,31 @@
 #include "WriterFactory.h"
 #include <memory>
 #include <string>
+#include <utility>
 
-std::unique_ptr<FileWriter> WriterFactory::createWriter(WriterType type, const std::string &basename) {
+// helper function to optionally move file output to a background thread
+static std::unique_ptr<FileWriter> wrapAsync(std::unique_ptr<FileWriter> writer, size_t queueDepth) {
+    if (queueDepth == 0)
+        return writer;
+    SPDLOG_DEBUG("Writing output asynchronously (queue depth: {})...", queueDepth);
+    return std::make_unique<AsyncWriter>(std::move(writer), queueDepth);
+}
+
+std::unique_ptr<FileWriter> WriterFactory::createWriter(WriterType type, const std::string &basename,
+                                                        size_t queueDepth, bool doublePrecision, bool compress) {
     switch (type) {
     case WriterType::XYZ:
         SPDLOG_DEBUG("Generating XYZWriter...");
-        return std::make_unique<XYZWriter>(basename);
+        return wrapAsync(std::make_unique<XYZWriter>(basename), queueDepth);
     case WriterType::VTK:
         SPDLOG_DEBUG("Generating VTKWriter...");
-        return std::make_unique<VTKWriter>(basename);
+        return wrapAsync(std::make_unique<VTKWriter>(basename), queueDepth);
+    case WriterType::VTKB:
+        SPDLOG_DEBUG("Generating BinaryVTKWriter...");
+        return wrapAsync(std::make_unique<BinaryVTKWriter>(basename, doublePrecision, compress), queueDepth);
+    case WriterType::TRAJ:
+        SPDLOG_DEBUG("Generating TrajectoryWriter...");
+        return wrapAsync(std::make_unique<TrajectoryWriter>(basename, compress), queueDepth);
     case WriterType::NIL:
         SPDLOG_DEBUG("Generating NullWriter...");
         return std::make_unique<NullWriter>(basename);
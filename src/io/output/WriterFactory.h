@@ -8,8 +8,11 @@
  */
 #pragma once
 
+#include "AsyncWriter.h"
+#include "BinaryVTKWriter.h"
 #include "FileWriter.h"
 #include "NullWriter.h"
+#include "TrajectoryWriter.h"
 #include "VTKWriter.h"
 #include "XYZWriter.h"
 #include "utils/Arguments.h"
@@ -25,7 +28,13 @@ class WriterFactory {
      *
      * @param type The specified WriterType of the writer object to be instantiated.
      * @param basename The basename of the generated files.
+     * @param queueDepth The maximum number of frames queued for a background writer thread. If this is 0, or for the
+     * NIL writer, output is written synchronously.
+     * @param doublePrecision Whether binary VTK output stores floating point data as Float64 instead of Float32.
+     * @param compress Whether binary VTK and trajectory output is compressed using zlib.
      * @return A std::unique_ptr<FileWriter> instance matching the desired type.
      */
-    static std::unique_ptr<FileWriter> createWriter(WriterType type, const std::string &basename);
+    static std::unique_ptr<FileWriter> createWriter(WriterType type, const std::string &basename,
+                                                    size_t queueDepth = 0, bool doublePrecision = false,
+                                                    bool compress = false);
 };
@@ -94,6 +94,7 @@ void XMLWriter::serialize(const ParticleContainer &pc, const Arguments &args, co
     if (fsa.getFrequency() > 0) {
         AnalyzerType aa{fsa.getBinNumber(), fsa.getLeftWallPosX(), fsa.getRightWallPosX(), fsa.getFrequency()};
         aa.dirname() = fsa.getDirname();
+        aa.accumulate() = fsa.isAccumulating();
         s.analyzer() = aa;
     }
 
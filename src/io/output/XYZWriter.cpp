@@ -23,34 +23,33 @@ XYZWriter::~XYZWriter() {
     SPDLOG_TRACE("Destroyed XYZWriter.");
 }
 
-void XYZWriter::writeParticles(const ParticleContainer &particles, int iteration, int total) {
+void XYZWriter::writeFrame(const Frame &frame) {
     // define file name
     std::stringstream strstr, content;
-    strstr << m_dirname << "/" << m_basename << "_" << std::setfill('0') << std::setw(4) << iteration << ".xyz";
+    strstr << m_dirname << "/" << m_basename << "_" << std::setfill('0') << std::setw(4) << frame.iteration << ".xyz";
 
     openFile(strstr.str());
 
     // write content to preliminary string stream
-    content << particles.size() << std::endl;
+    content << frame.size() << std::endl;
     content << "Generated by MolSim 2024-25. See "
                "http://openbabel.org/wiki/XYZ_(format) for "
                "file format documentation."
             << std::endl;
 
-    for (auto &p : particles) {
-        std::array<double, 3> x = p.getX();
+    for (size_t i = 0; i < frame.size(); ++i) {
         content << "Ar ";
         content.setf(std::ios_base::showpoint);
 
-        for (auto &xi : x) {
-            content << xi << " ";
+        for (size_t d = 0; d < 3; ++d) {
+            content << frame.positions[3 * i + d] << " ";
         }
 
         content << std::endl;
 
-        SPDLOG_TRACE("Plotted Particle - {}", p.toString());
+        SPDLOG_TRACE("Plotted Particle {} of frame {}", i, frame.iteration);
     }
 
     // finalize output
-    writeFile(content.str(), strstr.str(), iteration, total);
+    writeFile(content.str(), strstr.str(), frame.iteration, frame.total);
 }
@@ -46,12 +46,9 @@ class XYZWriter : public FileWriter {
     virtual ~XYZWriter();
 
     /**
-     * @brief Writes the type, mass, position, velocity and force of a ParticleContainer to a XYZ file. Terminates
-     * program execution on error.
+     * @brief Writes the positions of all particles in a Frame to an XYZ file. Terminates program execution on error.
      *
-     * @param particles The ParticleContainer.
-     * @param iteration The number of the current iteration, used to generate a unique filename.
-     * @param total The total number of iterations, used to display the current percentage.
+     * @param frame The Frame containing the particle data, the current and the total number of iterations.
      */
-    void writeParticles(const ParticleContainer &particles, int iteration, int total) override;
+    void writeFrame(const Frame &frame) override;
 };
@@ -632,6 +632,14 @@ void AnalyzerType::dirname(const DirnameOptional &x) { this->dirname_ = x; }
 
 void AnalyzerType::dirname(::std::unique_ptr<DirnameType> x) { this->dirname_.set(std::move(x)); }
 
+const AnalyzerType::AccumulateOptional &AnalyzerType::accumulate() const { return this->accumulate_; }
+
+AnalyzerType::AccumulateOptional &AnalyzerType::accumulate() { return this->accumulate_; }
+
+void AnalyzerType::accumulate(const AccumulateType &x) { this->accumulate_.set(x); }
+
+void AnalyzerType::accumulate(const AccumulateOptional &x) { this->accumulate_ = x; }
+
 // SimType
 //
 
@@ -2213,15 +2221,16 @@ MembraneType::~MembraneType() {}
 AnalyzerType::AnalyzerType(const NBinsType &nBins, const LeftWallXType &leftWallX, const RightWallXType &rightWallX,
                            const FrequencyType &frequency)
     : ::xml_schema::Type(), nBins_(nBins, this), leftWallX_(leftWallX, this), rightWallX_(rightWallX, this),
-      frequency_(frequency, this), dirname_(this) {}
+      frequency_(frequency, this), dirname_(this), accumulate_(this) {}
 
 AnalyzerType::AnalyzerType(const AnalyzerType &x, ::xml_schema::Flags f, ::xml_schema::Container *c)
     : ::xml_schema::Type(x, f, c), nBins_(x.nBins_, f, this), leftWallX_(x.leftWallX_, f, this),
-      rightWallX_(x.rightWallX_, f, this), frequency_(x.frequency_, f, this), dirname_(x.dirname_, f, this) {}
+      rightWallX_(x.rightWallX_, f, this), frequency_(x.frequency_, f, this), dirname_(x.dirname_, f, this),
+      accumulate_(x.accumulate_, f, this) {}
 
 AnalyzerType::AnalyzerType(const ::xercesc::DOMElement &e, ::xml_schema::Flags f, ::xml_schema::Container *c)
     : ::xml_schema::Type(e, f | ::xml_schema::Flags::base, c), nBins_(this), leftWallX_(this), rightWallX_(this),
-      frequency_(this), dirname_(this) {
+      frequency_(this), dirname_(this), accumulate_(this) {
     if ((f & ::xml_schema::Flags::base) == 0) {
         ::xsd::cxx::xml::dom::parser<char> p(e, true, false, false);
         this->parse(p, f);
@@ -2280,6 +2289,15 @@ void AnalyzerType::parse(::xsd::cxx::xml::dom::parser<char> &p, ::xml_schema::Fl
             }
         }
 
+        // accumulate
+        //
+        if (n.name() == "accumulate" && n.namespace_().empty()) {
+            if (!this->accumulate_) {
+                this->accumulate_.set(AccumulateTraits::create(i, f, this));
+                continue;
+            }
+        }
+
         break;
     }
 
@@ -2312,6 +2330,7 @@ AnalyzerType &AnalyzerType::operator=(const AnalyzerType &x) {
         this->rightWallX_ = x.rightWallX_;
         this->frequency_ = x.frequency_;
         this->dirname_ = x.dirname_;
+        this->accumulate_ = x.accumulate_;
     }
 
     return *this;
@@ -3478,6 +3497,14 @@ void operator<<(::xercesc::DOMElement &e, const AnalyzerType &i) {
 
         s << *i.dirname();
     }
+
+    // accumulate
+    //
+    if (i.accumulate()) {
+        ::xercesc::DOMElement &s(::xsd::cxx::xml::dom::create_element("accumulate", e));
+
+        s << *i.accumulate();
+    }
 }
 
 void operator<<(::xercesc::DOMElement &e, const SimType &i) {
@@ -5752,6 +5752,67 @@ class AnalyzerType : public ::xml_schema::Type {
 
     //@}
 
+    /**
+     * @name accumulate
+     *
+     * @brief Accessor and modifier functions for the %accumulate
+     * optional element.
+     */
+    //@{
+
+    /**
+     * @brief Element type.
+     */
+    typedef ::xml_schema::Boolean AccumulateType;
+
+    /**
+     * @brief Element optional container type.
+     */
+    typedef ::xsd::cxx::tree::optional<AccumulateType> AccumulateOptional;
+
+    /**
+     * @brief Element traits type.
+     */
+    typedef ::xsd::cxx::tree::traits<AccumulateType, char> AccumulateTraits;
+
+    /**
+     * @brief Return a read-only (constant) reference to the element
+     * container.
+     *
+     * @return A constant reference to the optional container.
+     */
+    const AccumulateOptional &accumulate() const;
+
+    /**
+     * @brief Return a read-write reference to the element container.
+     *
+     * @return A reference to the optional container.
+     */
+    AccumulateOptional &accumulate();
+
+    /**
+     * @brief Set the element value.
+     *
+     * @param x A new value to set.
+     *
+     * This function makes a copy of its argument and sets it as
+     * the new value of the element.
+     */
+    void accumulate(const AccumulateType &x);
+
+    /**
+     * @brief Set the element value.
+     *
+     * @param x An optional container with the new value to set.
+     *
+     * If the value is present in @a x then this function makes a copy
+     * of this value and sets it as the new value of the element.
+     * Otherwise the element container is set the 'not present' state.
+     */
+    void accumulate(const AccumulateOptional &x);
+
+    //@}
+
     /**
      * @name Constructors
      */
@@ -5828,6 +5889,7 @@ class AnalyzerType : public ::xml_schema::Type {
     ::xsd::cxx::tree::one<RightWallXType> rightWallX_;
     ::xsd::cxx::tree::one<FrequencyType> frequency_;
     DirnameOptional dirname_;
+    AccumulateOptional accumulate_;
 
     //@endcond
 };
@@ -8,38 +8,82 @@
 #include <string>
 #include <vector>
 
-#define RETURN_DIAG_CONDITION(cond1, cond2, adCond, loc1, loc2, loc3, loc4)                                            \
-    if ((cond1) || (cond2)) {                                                                                          \
-        bool aboveDiagonal = (adCond);                                                                                 \
-        if ((cond1)) {                                                                                                 \
-            return aboveDiagonal ? (loc1) : (loc2);                                                                    \
-        }                                                                                                              \
-        return aboveDiagonal ? (loc3) : (loc4);                                                                        \
-    }
-#define RETURN_TRIPLE_DIAG_CONDITION(cond0, cond1, cond2, loc1, loc2, loc3)                                            \
-    if ((cond0)) {                                                                                                     \
-        bool b1 = (cond1);                                                                                             \
-        bool b2 = (cond2);                                                                                             \
-        if (b1)                                                                                                        \
-            return b2 ? (loc1) : (loc2);                                                                               \
-        return (loc3);                                                                                                 \
-    }
-#define RETURN_TRIPLE_DIAG_REVERSE(cond0, cond1, cond2, loc1, loc2, loc3)                                              \
-    if ((cond0)) {                                                                                                     \
-        bool b1 = (cond1);                                                                                             \
-        bool b2 = (cond2);                                                                                             \
-        if (b1)                                                                                                        \
-            return (loc1);                                                                                             \
-        return b2 ? (loc2) : (loc3);                                                                                   \
-    }
+// rule for a cell with two halo locations: the first location applies if relPos[a] <= relPos[b] (or relPos[a] >
+// relPos[b] if greater is set), otherwise the second one
+struct DiagonalRule {
+    size_t a{0};
+    size_t b{0};
+    bool greater{false};
+    HaloLocation first{HaloLocation::NORTH};
+    HaloLocation second{HaloLocation::NORTH};
+};
+
+// rule for a cell with three halo locations: a plane test kx*sx*relX + kz*sz*relZ + c*sy*relY >= kr*sr*sr with the
+// coefficients k = p + q*c and cell sizes s, followed by comparing relX and relZ
+// unless reverse is set, the result is plane ? (compare ? first : second) : third
+// otherwise, the result is plane ? first : (compare ? second : third)
+struct TripleRule {
+    std::array<double, 2> xCoef{0.0, 0.0};
+    std::array<double, 2> zCoef{0.0, 0.0};
+    size_t zSize{2};
+    std::array<double, 2> rhsCoef{0.0, 0.0};
+    size_t rhsSize{0};
+    bool greater{false};
+    bool reverse{false};
+    HaloLocation first{HaloLocation::NORTH};
+    HaloLocation second{HaloLocation::NORTH};
+    HaloLocation third{HaloLocation::NORTH};
+};
+
+// masks of the single halo locations, for indexing the lookup tables
+static constexpr LocationMask N = CellUtils::toMask(HaloLocation::NORTH), S = CellUtils::toMask(HaloLocation::SOUTH),
+                              W = CellUtils::toMask(HaloLocation::WEST), E = CellUtils::toMask(HaloLocation::EAST),
+                              A = CellUtils::toMask(HaloLocation::ABOVE), B = CellUtils::toMask(HaloLocation::BELOW);
+
+// lookup table of the diagonal rules, indexed by the halo locations of the cell (see the report for worksheet 3 and 5)
+static constexpr std::array<DiagonalRule, 64> makeDiagonalRules() {
+    using HL = HaloLocation;
+    std::array<DiagonalRule, 64> rules{};
+    rules[N | E] = {0, 1, false, HL::NORTH, HL::EAST};
+    rules[S | W] = {0, 1, false, HL::WEST, HL::SOUTH};
+    rules[N | W] = {0, 1, true, HL::NORTH, HL::WEST};
+    rules[S | E] = {0, 1, true, HL::EAST, HL::SOUTH};
+    rules[B | W] = {0, 2, false, HL::WEST, HL::BELOW};
+    rules[A | E] = {0, 2, false, HL::ABOVE, HL::EAST};
+    rules[B | E] = {0, 2, true, HL::EAST, HL::BELOW};
+    rules[A | W] = {0, 2, true, HL::ABOVE, HL::WEST};
+    rules[B | S] = {2, 1, false, HL::BELOW, HL::SOUTH};
+    rules[A | N] = {2, 1, false, HL::NORTH, HL::ABOVE};
+    rules[B | N] = {2, 1, true, HL::NORTH, HL::BELOW};
+    rules[A | S] = {2, 1, true, HL::ABOVE, HL::SOUTH};
+    return rules;
+}
+static constexpr std::array<DiagonalRule, 64> diagonalRules = makeDiagonalRules();
+
+// lookup table of the triple corner rules, indexed by the halo locations of the cell (see the report for worksheet 5)
+// coefficients: {0, 1} is c, {-1, 1} is c - 1, {1, -1} is 1 - c
+static constexpr std::array<TripleRule, 64> makeTripleRules() {
+    using HL = HaloLocation;
+    std::array<TripleRule, 64> rules{};
+    rules[B | S | E] = {{0, 1}, {-1, 1}, 2, {1, -1}, 0, true, false, HL::EAST, HL::BELOW, HL::SOUTH};
+    rules[B | S | W] = {{-1, 1}, {-1, 1}, 2, {0, 0}, 0, false, false, HL::WEST, HL::BELOW, HL::SOUTH};
+    rules[B | N | E] = {{-1, 1}, {1, -1}, 2, {1, -1}, 2, true, true, HL::NORTH, HL::EAST, HL::BELOW};
+    rules[B | N | W] = {{1, -1}, {1, -1}, 0, {0, 1}, 1, false, true, HL::NORTH, HL::WEST, HL::BELOW};
+    rules[A | S | E] = {{1, -1}, {1, -1}, 0, {0, 1}, 1, false, false, HL::ABOVE, HL::EAST, HL::SOUTH};
+    rules[A | S | W] = {{-1, 1}, {1, -1}, 2, {1, -1}, 2, true, false, HL::ABOVE, HL::WEST, HL::SOUTH};
+    rules[A | N | E] = {{-1, 1}, {-1, 1}, 2, {0, 0}, 0, false, true, HL::NORTH, HL::ABOVE, HL::EAST};
+    rules[A | N | W] = {{0, 1}, {-1, 1}, 2, {1, -1}, 0, true, true, HL::NORTH, HL::ABOVE, HL::WEST};
+    return rules;
+}
+static constexpr std::array<TripleRule, 64> tripleRules = makeTripleRules();
 
 /* internals */
 Cell::Cell(const std::array<double, 3> &size, const std::array<double, 3> &position, CellType type, int index,
-           const std::vector<HaloLocation> &haloLocation, const std::vector<BorderLocation> &borderLocation)
-    : m_type{type}, m_size{size}, m_position{position}, m_index{index}, m_haloLocation{haloLocation},
-      m_borderLocation{borderLocation} {};
-std::forward_list<std::reference_wrapper<Particle>>::iterator Cell::begin() { return m_particles.begin(); }
-std::forward_list<std::reference_wrapper<Particle>>::iterator Cell::end() { return m_particles.end(); }
+           LocationMask haloMask, LocationMask borderMask)
+    : m_size{size}, m_position{position}, m_index{index}, m_haloMask{haloMask}, m_borderMask{borderMask},
+      m_type{type} {};
+std::vector<ParticleHandle>::iterator Cell::begin() { return m_particles.begin(); }
+std::vector<ParticleHandle>::iterator Cell::end() { return m_particles.end(); }
 
 /* corner region helper functions */
 std::array<double, 3> Cell::getRelativePosition(const Particle &p) const {
@@ -53,127 +97,75 @@ void Cell::validatePosition(const std::array<double, 3> &relPos) const {
         assert(relPos[2] >= 0 && relPos[2] <= m_size[2]);
     }
 }
-bool Cell::isCorner(HaloLocation loc1, HaloLocation loc2) const {
-    return VEC_CONTAINS(m_haloLocation, loc1) && VEC_CONTAINS(m_haloLocation, loc2);
-}
-HaloLocation Cell::handle2DCorner(const std::array<double, 3> &relPos) const {
-    bool NW = isCorner(HaloLocation::NORTH, HaloLocation::WEST);
-    bool SE = isCorner(HaloLocation::SOUTH, HaloLocation::EAST);
-    bool NE = isCorner(HaloLocation::NORTH, HaloLocation::EAST);
-    bool SW = isCorner(HaloLocation::SOUTH, HaloLocation::WEST);
-    bool NW_SE = NW || SE;
-    bool NE_SW = NE || SW;
-    assert(NW_SE || NE_SW);
-
-    bool aboveDiagonal = NE_SW ? (relPos[0] <= relPos[1]) : (relPos[0] > relPos[1]);
-    if (NE)
-        return aboveDiagonal ? HaloLocation::NORTH : HaloLocation::EAST;
-    if (SW)
-        return aboveDiagonal ? HaloLocation::WEST : HaloLocation::SOUTH;
-    if (NW)
-        return aboveDiagonal ? HaloLocation::NORTH : HaloLocation::WEST;
-    if (SE)
-        return aboveDiagonal ? HaloLocation::EAST : HaloLocation::SOUTH;
-
-    CLIUtils::error("Invalid corner cell! This should NOT happen.", "", false);
-    return HaloLocation::NORTH; // fallback
-}
-HaloLocation Cell::handle3DCorner(const std::array<double, 3> &relPos) const {
-    return m_haloLocation.size() == 2 ? handle3DDiagonal(relPos) : handle3DTripleCorner(relPos);
-}
-HaloLocation Cell::handle3DDiagonal(const std::array<double, 3> &relPos) const {
-    bool NW = isCorner(HaloLocation::NORTH, HaloLocation::WEST);
-    bool SE = isCorner(HaloLocation::SOUTH, HaloLocation::EAST);
-    bool NE = isCorner(HaloLocation::NORTH, HaloLocation::EAST);
-    bool SW = isCorner(HaloLocation::SOUTH, HaloLocation::WEST);
-    bool BW = isCorner(HaloLocation::BELOW, HaloLocation::WEST);
-    bool BE = isCorner(HaloLocation::BELOW, HaloLocation::EAST);
-    bool BS = isCorner(HaloLocation::BELOW, HaloLocation::SOUTH);
-    bool BN = isCorner(HaloLocation::BELOW, HaloLocation::NORTH);
-    bool AW = isCorner(HaloLocation::ABOVE, HaloLocation::WEST);
-    bool AE = isCorner(HaloLocation::ABOVE, HaloLocation::EAST);
-    bool AS = isCorner(HaloLocation::ABOVE, HaloLocation::SOUTH);
-    bool AN = isCorner(HaloLocation::ABOVE, HaloLocation::NORTH);
-    RETURN_DIAG_CONDITION(NE, SW, (relPos[0] <= relPos[1]), HaloLocation::NORTH, HaloLocation::EAST, HaloLocation::WEST,
-                          HaloLocation::SOUTH);
-    RETURN_DIAG_CONDITION(NW, SE, (relPos[0] > relPos[1]), HaloLocation::NORTH, HaloLocation::WEST, HaloLocation::EAST,
-                          HaloLocation::SOUTH);
-    RETURN_DIAG_CONDITION(BW, AE, (relPos[0] <= relPos[2]), HaloLocation::WEST, HaloLocation::BELOW,
-                          HaloLocation::ABOVE, HaloLocation::EAST);
-    RETURN_DIAG_CONDITION(BE, AW, (relPos[0] > relPos[2]), HaloLocation::EAST, HaloLocation::BELOW, HaloLocation::ABOVE,
-                          HaloLocation::WEST);
-    RETURN_DIAG_CONDITION(BS, AN, (relPos[2] <= relPos[1]), HaloLocation::BELOW, HaloLocation::SOUTH,
-                          HaloLocation::NORTH, HaloLocation::ABOVE);
-    RETURN_DIAG_CONDITION(BN, AS, (relPos[2] > relPos[1]), HaloLocation::NORTH, HaloLocation::BELOW,
-                          HaloLocation::ABOVE, HaloLocation::SOUTH);
-    CLIUtils::error("Invalid diagonal corner! This should NOT happen.", "", false);
-    return HaloLocation::NORTH; // fallback
+HaloLocation Cell::handleDiagonal(const std::array<double, 3> &relPos) const {
+    const DiagonalRule &rule = diagonalRules[m_haloMask];
+    if (rule.a == rule.b) {
+        CLIUtils::error("Invalid diagonal corner! This should NOT happen.", "", false);
+        return HaloLocation::NORTH; // fallback
+    }
+    const bool aboveDiagonal = rule.greater ? (relPos[rule.a] > relPos[rule.b]) : (relPos[rule.a] <= relPos[rule.b]);
+    return aboveDiagonal ? rule.first : rule.second;
 }
-HaloLocation Cell::handle3DTripleCorner(const std::array<double, 3> &relPos) const {
-    bool BSE = isCorner(HaloLocation::BELOW, HaloLocation::SOUTH) && VEC_CONTAINS(m_haloLocation, HaloLocation::EAST);
-    bool BSW = isCorner(HaloLocation::BELOW, HaloLocation::SOUTH) && VEC_CONTAINS(m_haloLocation, HaloLocation::WEST);
-    bool BNE = isCorner(HaloLocation::BELOW, HaloLocation::NORTH) && VEC_CONTAINS(m_haloLocation, HaloLocation::EAST);
-    bool BNW = isCorner(HaloLocation::BELOW, HaloLocation::NORTH) && VEC_CONTAINS(m_haloLocation, HaloLocation::WEST);
-    bool ASE = isCorner(HaloLocation::ABOVE, HaloLocation::SOUTH) && VEC_CONTAINS(m_haloLocation, HaloLocation::EAST);
-    bool ASW = isCorner(HaloLocation::ABOVE, HaloLocation::SOUTH) && VEC_CONTAINS(m_haloLocation, HaloLocation::WEST);
-    bool ANE = isCorner(HaloLocation::ABOVE, HaloLocation::NORTH) && VEC_CONTAINS(m_haloLocation, HaloLocation::EAST);
-    bool ANW = isCorner(HaloLocation::ABOVE, HaloLocation::NORTH) && VEC_CONTAINS(m_haloLocation, HaloLocation::WEST);
-    double relX = relPos[0], relY = relPos[1], relZ = relPos[2];
-
-    double x = m_size[0];
-    double y = m_size[1];
-    double z = m_size[2];
-    double c = (m_size[0] * m_size[0] + m_size[2] * m_size[2]) /
-               (m_size[0] * m_size[0] + m_size[1] * m_size[1] + m_size[2] * m_size[2]);
-
-    RETURN_TRIPLE_DIAG_CONDITION(BSE, ((1 * c) * x * relX + (c - 1) * z * relZ + c * y * relY >= (1 - c) * x * x),
-                                 (relX > relZ), HaloLocation::EAST, HaloLocation::BELOW, HaloLocation::SOUTH);
-    RETURN_TRIPLE_DIAG_CONDITION(BSW, ((c - 1) * x * relX + (c - 1) * z * relZ + c * y * relY >= 0), (relX <= relZ),
-                                 HaloLocation::WEST, HaloLocation::BELOW, HaloLocation::SOUTH);
-    RETURN_TRIPLE_DIAG_REVERSE(BNE, ((c - 1) * x * relX + (1 - c) * z * relZ + c * y * relY >= (1 - c) * z * z),
-                               (relX > relZ), HaloLocation::NORTH, HaloLocation::EAST, HaloLocation::BELOW);
-    RETURN_TRIPLE_DIAG_REVERSE(BNW, ((1 - c) * x * relX + (1 - c) * x * relZ + c * y * relY >= c * y * y),
-                               (relX <= relZ), HaloLocation::NORTH, HaloLocation::WEST, HaloLocation::BELOW);
-    RETURN_TRIPLE_DIAG_CONDITION(ASE, ((1 - c) * x * relX + (1 - c) * x * relZ + c * y * relY >= c * y * y),
-                                 (relX <= relZ), HaloLocation::ABOVE, HaloLocation::EAST, HaloLocation::SOUTH);
-    RETURN_TRIPLE_DIAG_CONDITION(ASW, ((c - 1) * x * relX + (1 - c) * z * relZ + c * y * relY >= (1 - c) * z * z),
-                                 (relX > relZ), HaloLocation::ABOVE, HaloLocation::WEST, HaloLocation::SOUTH);
-    RETURN_TRIPLE_DIAG_REVERSE(ANE, ((c - 1) * x * relX + (c - 1) * z * relZ + c * y * relY >= 0), (relX <= relZ),
-                               HaloLocation::NORTH, HaloLocation::ABOVE, HaloLocation::EAST);
-    RETURN_TRIPLE_DIAG_REVERSE(ANW, ((1 * c) * x * relX + (c - 1) * z * relZ + c * y * relY >= (1 - c) * x * x),
-                               (relX > relZ), HaloLocation::NORTH, HaloLocation::ABOVE, HaloLocation::WEST);
-    CLIUtils::error("Invalid triple corner! This should NOT happen.", "", false);
-    return HaloLocation::NORTH; // fallback
+HaloLocation Cell::handleTripleCorner(const std::array<double, 3> &relPos) const {
+    const TripleRule &rule = tripleRules[m_haloMask];
+    if (rule.first == rule.third) {
+        CLIUtils::error("Invalid triple corner! This should NOT happen.", "", false);
+        return HaloLocation::NORTH; // fallback
+    }
+    const double c = (m_size[0] * m_size[0] + m_size[2] * m_size[2]) /
+                     (m_size[0] * m_size[0] + m_size[1] * m_size[1] + m_size[2] * m_size[2]);
+    const double kx = rule.xCoef[0] + rule.xCoef[1] * c;
+    const double kz = rule.zCoef[0] + rule.zCoef[1] * c;
+    const double kr = rule.rhsCoef[0] + rule.rhsCoef[1] * c;
+    const bool plane = kx * m_size[0] * relPos[0] + kz * m_size[rule.zSize] * relPos[2] + c * m_size[1] * relPos[1] >=
+                       kr * m_size[rule.rhsSize] * m_size[rule.rhsSize];
+    const bool compare = rule.greater ? (relPos[0] > relPos[2]) : (relPos[0] <= relPos[2]);
+    if (!rule.reverse)
+        return plane ? (compare ? rule.first : rule.second) : rule.third;
+    return plane ? rule.first : (compare ? rule.second : rule.third);
 }
 /* main corner region dispatch function */
 HaloLocation Cell::getCornerRegion(const Particle &p) const {
     // verify that this is a corner cell
-    assert(!(this->m_haloLocation.empty()));
+    assert(CellUtils::countLocations(m_haloMask) > 1);
     auto relPos = getRelativePosition(p);
     SPDLOG_DEBUG("posX: {}, posY: {}, posZ: {}, relX: {}, relY: {}, relZ: {}, sizeX: {}, sizeY: {}, sizeZ: {}",
                  m_position[0], m_position[1], m_position[2], relPos[0], relPos[1], relPos[2], m_size[0], m_size[1],
                  m_size[2]);
     validatePosition(relPos);
 
-    // handle 2D or 3D simulation respectively
-    return m_size[2] == 0 ? handle2DCorner(relPos) : handle3DCorner(relPos);
+    // edges (and corners in 2D) or triple corners in 3D respectively
+    return CellUtils::countLocations(m_haloMask) == 2 ? handleDiagonal(relPos) : handleTripleCorner(relPos);
 }
 
 /* functionality */
-void Cell::addParticle(Particle &particle) { m_particles.push_front(std::ref(particle)); }
-void Cell::removeParticle(Particle &particle) {
-    m_particles.remove_if([&particle](const std::reference_wrapper<Particle> &p) { return &p.get() == &particle; });
+void Cell::addParticle(ParticleHandle handle, bool isStatic) {
+    (isStatic ? m_staticParticles : m_particles).push_back(handle);
 }
+void Cell::removeParticle(ParticleHandle handle, bool isStatic) {
+    // swap with the last handle and pop, since the order of particles inside a cell is irrelevant
+    ContainerType &handles = isStatic ? m_staticParticles : m_particles;
+    auto it = std::find(handles.begin(), handles.end(), handle);
+    if (it != handles.end()) {
+        *it = handles.back();
+        handles.pop_back();
+    }
+}
+bool Cell::isEmpty() const { return m_particles.empty() && m_staticParticles.empty(); }
 const std::array<double, 3> &Cell::getSize() const { return m_size; }
 const std::array<double, 3> &Cell::getX() const { return m_position; }
 CellType Cell::getType() const { return m_type; }
 int Cell::getIndex() const { return m_index; }
-const std::vector<HaloLocation> &Cell::getHaloLocation() const { return m_haloLocation; }
-const std::vector<BorderLocation> &Cell::getBorderLocation() const { return m_borderLocation; }
-std::vector<int> &Cell::getNeighbors() { return m_neighbors; }
-const std::vector<int> &Cell::getNeighbors() const { return m_neighbors; }
-std::forward_list<std::reference_wrapper<Particle>> &Cell::getParticles() { return m_particles; }
-const std::forward_list<std::reference_wrapper<Particle>> &Cell::getParticles() const { return m_particles; }
+std::vector<HaloLocation> Cell::getHaloLocation() const { return CellUtils::fromMask<HaloLocation>(m_haloMask); }
+std::vector<BorderLocation> Cell::getBorderLocation() const {
+    return CellUtils::fromMask<BorderLocation>(m_borderMask);
+}
+LocationMask Cell::getHaloMask() const { return m_haloMask; }
+LocationMask Cell::getBorderMask() const { return m_borderMask; }
+std::vector<ParticleHandle> &Cell::getParticles() { return m_particles; }
+const std::vector<ParticleHandle> &Cell::getParticles() const { return m_particles; }
+std::vector<ParticleHandle> &Cell::getStaticParticles() { return m_staticParticles; }
+const std::vector<ParticleHandle> &Cell::getStaticParticles() const { return m_staticParticles; }
 std::string Cell::toString() const {
     const std::array<double, 3> to{m_position[0] + m_size[0], m_position[1] + m_size[1], m_position[2] + m_size[2]};
     std::stringstream ss;
@@ -181,6 +173,6 @@ std::string Cell::toString() const {
        << ", Size: " << ArrayUtils::to_string(m_size)
        << ", Positions (from (incl.) -> to (excl.)): " << ArrayUtils::to_string(m_position) << " -> "
        << ArrayUtils::to_string(to)
-       << (!m_haloLocation.empty() ? (", Halo: " + CellUtils::fromHaloVec(m_haloLocation)) : "") << "]";
+       << (m_haloMask != 0 ? (", Halo: " + CellUtils::fromHaloVec(getHaloLocation())) : "") << "]";
     return ss.str();
 }
\ No newline at end of file
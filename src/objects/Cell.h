@@ -13,7 +13,6 @@
 #include <algorithm>
 #include <array>
 #include <bitset>
-#include <forward_list>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -21,31 +20,34 @@
 
 /// @brief Class for storing data of a single Cell in a domain split into cells.
 class Cell {
-    /// @brief Typedef for the container type used to store pointers to a Cell's Particle objects.
-    using ContainerType = std::forward_list<std::reference_wrapper<Particle>>;
+    /// @brief Typedef for the container type used to store handles to a Cell's Particle objects.
+    using ContainerType = std::vector<ParticleHandle>;
 
   private:
-    /// @brief A forward list of pointers to Particle objects contained within the current Cell.
+    /// @brief A vector of handles to Particle objects contained within the current Cell.
     ContainerType m_particles{};
+    /// @brief A vector of handles to static (wall) Particle objects contained within the current Cell. These never move
+    /// and receive no force, so they are kept apart from the regular Particle objects.
+    ContainerType m_staticParticles{};
     /// @brief The size of the Cell in each dimension.
     std::array<double, 3> m_size;
     /// @brief The lower-left coordinates of the Cell.
     std::array<double, 3> m_position;
-    /// @brief If this is a halo cell, the locations of this cell (North, South, West, East, Above, Below) are stored
-    /// here.
-    std::vector<HaloLocation> m_haloLocation;
-    /// @brief If this is a border cell, the locations of this cell (North, South, West, East, Above, Below) are stored
+    /// @brief The index of this Cell in the overarching CellContainer.
+    int m_index{-1};
+    /// @brief If this is a halo cell, the locations of this cell (North, South, West, East, Above, Below) are set here.
+    LocationMask m_haloMask{0};
+    /// @brief If this is a border cell, the locations of this cell (North, South, West, East, Above, Below) are set
     /// here.
-    std::vector<BorderLocation> m_borderLocation;
-    /// @brief The neighboring Cell indices.
-    std::vector<int> m_neighbors;
+    LocationMask m_borderMask{0};
     /// @brief The type of this Cell. May be INNER, BORDER or HALO.
-    CellType m_type;
-    /// @brief The index of this Cell in the overarching CellContainer.
-    int m_index;
+    CellType m_type{CellType::INNER};
 
   public:
     /* constructor */
+    /// @brief Constructs an empty placeholder Cell, to be overwritten by a CellContainer.
+    Cell() = default;
+
     /**
      * @brief Constructs a new Cell object.
      *
@@ -55,24 +57,24 @@ class Cell {
      * @param position The lower-left coordinates of the Cell.
      * @param type The type of this Cell.
      * @param index The index of this Cell in the CellContainer.
-     * @param haloLocation The cardinal direction(s) of this cell if this is a halo Cell.
-     * @param borderLocation The cardinal direction(s) of this cell if this is a border Cell.
+     * @param haloMask The cardinal direction(s) of this cell if this is a halo Cell.
+     * @param borderMask The cardinal direction(s) of this cell if this is a border Cell.
      */
     Cell(const std::array<double, 3> &size, const std::array<double, 3> &position, CellType type, int index,
-         const std::vector<HaloLocation> &haloLocation, const std::vector<BorderLocation> &borderLocation);
+         LocationMask haloMask, LocationMask borderMask);
 
     /* iterator */
     /**
-     * @brief Gets an iterator to the beginning of the Particle* forward list.
+     * @brief Gets an iterator to the beginning of the Particle handle vector.
      *
-     * @return An iterator to the beginning of the Cell's forward list.
+     * @return An iterator to the beginning of the Cell's handle vector.
      */
     ContainerType::iterator begin();
 
     /**
-     * @brief Gets an iterator to one past the end of the Particle* forward list.
+     * @brief Gets an iterator to one past the end of the Particle handle vector.
      *
-     * @return An iterator to one past the end of the Cell's forward list.
+     * @return An iterator to one past the end of the Cell's handle vector.
      */
     ContainerType::iterator end();
 
@@ -95,84 +97,59 @@ class Cell {
     void validatePosition(const std::array<double, 3> &relPos) const;
 
     /**
-     * @brief Checks if two HaloLocation values correspond to a corner.
-     *
-     * This function determines if the two given `HaloLocation` values represent opposite corners of the cell.
-     *
-     * @param loc1 The first HaloLocation to check.
-     * @param loc2 The second HaloLocation to check.
-     * @return true if the two locations represent a corner.
-     * @return false if the two locations do not represent a corner.
-     */
-    bool isCorner(HaloLocation loc1, HaloLocation loc2) const;
-
-    /**
-     * @brief Handles the logic for 2D corner cell handling.
+     * @brief Handles the logic for determining the diagonal region of a cell with two halo locations.
      *
-     * This function handles the determination of the corner region in a 2D context based on the relative position
-     * within the cell. It returns the appropriate HaloLocation (NORTH, SOUTH, EAST, or WEST) based on the position.
+     * This function handles the corners of 2D simulations as well as the edges of 3D simulations, where the diagonal
+     * through the cell separates the regions of both locations. The axes of the diagonal and the resulting locations
+     * are looked up from a table indexed by the halo locations of the cell.
      *
-     * See the report for Worksheet 3 for more info.
+     * See the reports for Worksheet 3 and 5 for a detailed explanation.
      *
-     * @param relPos The relative position of the particle in 2D within the cell, represented as a 3D array.
-     * @return The appropriate HaloLocation for the 2D corner (e.g., NORTH, SOUTH, EAST, WEST).
+     * @param relPos The relative position of the particle within the cell, represented as a 3D array.
+     * @return The appropriate HaloLocation for the diagonal region.
      */
-    HaloLocation handle2DCorner(const std::array<double, 3> &relPos) const;
+    HaloLocation handleDiagonal(const std::array<double, 3> &relPos) const;
 
     /**
-     * @brief Handles the logic for 3D corner cell handling.
+     * @brief Handles the logic for determining the 3D triple corner region.
      *
-     * This function handles the determination of the corner region in a 3D context based on the relative position
-     * within the cell. It returns the appropriate HaloLocation based on the position in the 3D corner regions.
+     * This function handles the 3D triple corner region case, where the relative position is used to determine the
+     * specific triple corner region in 3D (e.g. NORTH, WEST and ABOVE). The separating planes and the resulting
+     * locations are looked up from a table indexed by the halo locations of the cell.
      *
      * See the report for Worksheet 5 for a detailed explanation.
      *
      * @param relPos The relative position of the particle in 3D within the cell, represented as a 3D array.
-     * @return The appropriate HaloLocation for the 3D corner (e.g., NORTH, SOUTH, EAST, WEST, ABOVE, BELOW).
+     * @return The appropriate HaloLocation for the 3D triple corner region.
      */
-    HaloLocation handle3DCorner(const std::array<double, 3> &relPos) const;
+    HaloLocation handleTripleCorner(const std::array<double, 3> &relPos) const;
 
+    /* main functionality */
     /**
-     * @brief Handles the logic for determining the 3D diagonal region.
-     *
-     * This function handles the determination of the diagonal region in a 3D context, where the relative position
-     * determines if the corner is on the diagonal. It returns the appropriate HaloLocation based on the diagonal logic.
+     * @brief Adds a Particle handle to the back of the handle vector.
      *
-     * See the report for Worksheet 5 for a detailed explanation.
-     *
-     * @param relPos The relative position of the particle in 3D within the cell, represented as a 3D array.
-     * @return The appropriate HaloLocation for the 3D diagonal region.
+     * @param handle The handle of the Particle to be added.
+     * @param isStatic Determines whether the handle is added to the static handle vector instead.
      */
-    HaloLocation handle3DDiagonal(const std::array<double, 3> &relPos) const;
+    void addParticle(ParticleHandle handle, bool isStatic = false);
 
     /**
-     * @brief Handles the logic for determining the 3D triple corner region.
+     * @brief Removes a Particle handle from the handle vector.
      *
-     * This function handles the 3D triple corner region case, where the relative position is used to determine the
-     * specific triple corner region in 3D (e.g. NORTH, WEST and ABOVE). It returns the appropriate HaloLocation for the
-     * triple corner.
-     *
-     * See the report for Worksheet 5 for a detailed explanation.
-     *
-     * @param relPos The relative position of the particle in 3D within the cell, represented as a 3D array.
-     * @return The appropriate HaloLocation for the 3D triple corner region.
-     */
-    HaloLocation handle3DTripleCorner(const std::array<double, 3> &relPos) const;
-
-    /* main functionality */
-    /**
-     * @brief Adds a Particle reference to the front of the forward list.
+     * The order of the remaining handles is not preserved.
      *
-     * @param particle The Particle reference to be added.
+     * @param handle The handle of the Particle to be removed.
+     * @param isStatic Determines whether the handle is removed from the static handle vector instead.
      */
-    void addParticle(Particle &particle);
+    void removeParticle(ParticleHandle handle, bool isStatic = false);
 
     /**
-     * @brief Removes a Particle reference from the forward list.
+     * @brief Checks if the Cell contains neither regular nor static Particle handles.
      *
-     * @param particle The Particle reference to be removed.
+     * @return true if the Cell is empty.
+     * @return false otherwise.
      */
-    void removeParticle(Particle &particle);
+    bool isEmpty() const;
 
     /**
      * @brief Dispatch function to handle a corner cell.
@@ -200,46 +177,60 @@ class Cell {
     const std::array<double, 3> &getSize() const;
 
     /**
-     * @brief Gets a const reference to the halo location (cardinal direction) vector of this Cell.
+     * @brief Gets the halo locations (cardinal directions) of this Cell.
      *
-     * @return A const reference to the halo location vector of this Cell.
+     * @return The halo locations of this Cell, in the order North, South, West, East, Above, Below.
      */
-    const std::vector<HaloLocation> &getHaloLocation() const;
+    std::vector<HaloLocation> getHaloLocation() const;
 
     /**
-     * @brief Gets a const reference to the border location (cardinal direction) vector of this Cell.
+     * @brief Gets the border locations (cardinal directions) of this Cell.
      *
-     * @return A const reference to the border location vector of this Cell.
+     * @return The border locations of this Cell, in the order North, South, West, East, Above, Below.
      */
-    const std::vector<BorderLocation> &getBorderLocation() const;
+    std::vector<BorderLocation> getBorderLocation() const;
 
     /**
-     * @brief Gets a reference to the Cell's neighbors.
+     * @brief Gets the halo locations (cardinal directions) of this Cell as a bitmask.
      *
-     * @return A const reference to the Cell's neighbors.
+     * @return The LocationMask of the halo locations, empty if this is not a halo Cell.
      */
-    std::vector<int> &getNeighbors();
+    LocationMask getHaloMask() const;
 
     /**
-     * @brief Gets a const reference to the Cell's neighbors.
+     * @brief Gets the border locations (cardinal directions) of this Cell as a bitmask.
      *
-     * @return A const reference to the Cell's neighbors.
+     * @return The LocationMask of the border locations, empty if this Cell is not adjacent to a boundary.
      */
-    const std::vector<int> &getNeighbors() const;
+    LocationMask getBorderMask() const;
 
     /**
-     * @brief Gets a reference to the Cell's Particle pointer forward list.
+     * @brief Gets a reference to the Cell's Particle handle vector.
+     *
+     * @return A reference to the Cell's Particle handle vector.
+     */
+    std::vector<ParticleHandle> &getParticles();
 
-     * @return A reference to the Cell's Particle pointer forward list.
+    /**
+     * @brief Gets a const reference to the Cell's Particle handle vector.
+     *
+     * @return A const reference to the Cell's Particle handle vector.
+     */
+    const std::vector<ParticleHandle> &getParticles() const;
+
+    /**
+     * @brief Gets a reference to the Cell's static Particle handle vector.
+     *
+     * @return A reference to the Cell's static Particle handle vector.
      */
-    std::forward_list<std::reference_wrapper<Particle>> &getParticles();
+    std::vector<ParticleHandle> &getStaticParticles();
 
     /**
-     * @brief Gets a const reference to the Cell's Particle pointer forward list.
+     * @brief Gets a const reference to the Cell's static Particle handle vector.
      *
-     * @return A const reference to the Cell's Particle pointer forward list.
+     * @return A const reference to the Cell's static Particle handle vector.
      */
-    const std::forward_list<std::reference_wrapper<Particle>> &getParticles() const;
+    const std::vector<ParticleHandle> &getStaticParticles() const;
 
     /**
      * @brief Gets the type of this Cell.
@@ -1,8 +1,12 @@
 #include "CellContainer.h"
+#include "ClusterPairList.h"
+#include "HierarchicalGrid.h"
+#include "Octree.h"
 #include "utils/Arguments.h"
 #include "utils/ArrayUtils.h"
 #include "utils/CLIUtils.h"
 #include "utils/StringUtils.h"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iomanip>
@@ -18,14 +22,29 @@
 #define PRINT_CELL_CONTENTS() (void)0
 #endif
 
+// the axis along which each location (in enum order) lies, and whether it lies at the upper end of that axis
+static constexpr std::array<size_t, 6> locationAxis{1, 1, 0, 0, 2, 2};
+static constexpr std::array<bool, 6> locationIsHigh{true, false, false, true, true, false};
+// the locations at the lower and upper end of each axis
+static constexpr std::array<BorderLocation, 3> lowLocation{BorderLocation::WEST, BorderLocation::SOUTH,
+                                                           BorderLocation::BELOW};
+static constexpr std::array<BorderLocation, 3> highLocation{BorderLocation::EAST, BorderLocation::NORTH,
+                                                            BorderLocation::ABOVE};
+
 /* constructor and destructor */
 CellContainer::CellContainer(const std::array<double, 3> &domainSize,
                              const std::array<BoundaryCondition, 6> &conditions, double cutoff,
-                             ParticleContainer &particles, size_t dim)
-    : domainSize{domainSize}, conditions{conditions}, cutoff{cutoff}, particles{particles}, dim{dim} {
+                             ParticleContainer &particles, size_t dim, double cellSizeFactor,
+                             double pairCutoffFactor, double skin)
+    : domainSize{domainSize}, conditions{conditions}, cutoff{cutoff}, pairCutoffFactor{pairCutoffFactor}, skin{skin},
+      particles{particles}, dim{dim} {
     // check correct dimensions (could probably be a boolean instead...)
     if (dim < 2 || dim > 3)
         CLIUtils::error("Invalid cell container dimensions! (must be 2 or 3)", StringUtils::fromNumber(dim));
+    if (pairCutoffFactor < 0)
+        CLIUtils::error("Pair cutoff factor must not be negative!", StringUtils::fromNumber(pairCutoffFactor));
+    if (skin < 0)
+        CLIUtils::error("Cell skin must not be negative!", StringUtils::fromNumber(skin));
 
     // check that domain size and cutoff are initialized
     // NOTE: when compiling using fast math, the user must ensure that these values are initialized!
@@ -34,116 +53,115 @@ CellContainer::CellContainer(const std::array<double, 3> &domainSize,
         CLIUtils::error("Cutoff radius not initialized!");
     if (std::isinf(domainSize[0]) || std::isinf(domainSize[1]) || std::isinf(domainSize[2]))
         CLIUtils::error("Domain size not initialized!");
+    if (cellSizeFactor <= 0.0)
+        CLIUtils::error("Cell size factor must be positive!", StringUtils::fromNumber(cellSizeFactor));
+
+    // cells smaller than the cutoff radius need as many halo layers as there are cells per cutoff radius
+    if (cellSizeFactor < 1.0) {
+        const double perCutoff = std::round(1.0 / cellSizeFactor);
+        if (std::fabs(perCutoff * cellSizeFactor - 1.0) > 1e-3)
+            CLIUtils::error("Cell size factors below 1 must be of the form 1/k!",
+                            StringUtils::fromNumber(cellSizeFactor));
+        haloWidth = static_cast<size_t>(perCutoff);
+        cellSizeFactor = 1.0 / perCutoff;
+    }
 
     SPDLOG_TRACE("Generating CellContainer with domain size {} and cutoff radius {} (in {} dimensions)",
                  ArrayUtils::to_string(domainSize), cutoff, dim);
 
     // determining cell size
+    // particles of neighbouring cells may each be up to the skin outside of their cell, so the stencil has to cover
+    // the cutoff radius plus twice the skin
+    const double minCellSize = std::max(cutoff * cellSizeFactor, (cutoff + 2 * skin) / haloWidth);
     for (size_t i = 0; i < dim; i++) {
-        if (std::fabs(std::fmod(domainSize[i], cutoff)) < 1e-9) {
+        if (std::fabs(std::fmod(domainSize[i], minCellSize)) < 1e-9) {
             // perfect fit
-            cellSize[i] = cutoff;
-            numCells[i] = std::round(domainSize[i] / cellSize[i]) + 2;
+            cellSize[i] = minCellSize;
+            numCells[i] = std::round(domainSize[i] / cellSize[i]) + 2 * haloWidth;
             SPDLOG_DEBUG("Cutoff perfectly divides domain size, using cutoff radius {} as cell size for dimension {}.",
-                         cutoff, i);
+                         minCellSize, i);
         } else {
             // we round up cellsize so that cell > cutoff and we only search adjacent cells
-            cellSize[i] = domainSize[i] / std::floor(domainSize[i] / cutoff);
-            numCells[i] = std::round(domainSize[i] / cellSize[i]) + 2;
+            // larger factors may not fit into the domain at all, in which case the whole domain is a single cell
+            cellSize[i] = domainSize[i] / std::max(1.0, std::floor(domainSize[i] / minCellSize));
+            numCells[i] = std::round(domainSize[i] / cellSize[i]) + 2 * haloWidth;
             SPDLOG_DEBUG("Cutoff does NOT perfectly divide domain size, using {} as cell size for dimension {}.",
                          cellSize[i], i);
         }
+
+        // the domain starts where it would with cells of the cutoff radius and a single halo layer, so that changing
+        // the cell size does not move the domain
+        const double baseCellSize = std::fabs(std::fmod(domainSize[i], cutoff)) < 1e-9
+                                        ? cutoff
+                                        : domainSize[i] / std::max(1.0, std::floor(domainSize[i] / cutoff));
+        offset[i] = baseCellSize - haloWidth * cellSize[i];
+        domainMin[i] = offset[i] + haloWidth * cellSize[i];
+        domainMax[i] = offset[i] + (numCells[i] - haloWidth) * cellSize[i];
     }
 
-    // reserve space for all cells and cell locks
-    size_t totalNumCells = numCells[0] * numCells[1] * numCells[2];
-    cells.reserve(totalNumCells);
-    cellLocks.reserve(totalNumCells);
-    SPDLOG_DEBUG("Reserved space for {} cells (X: {}, Y: {}, Z: {}).", totalNumCells, numCells[0], numCells[1],
-                 numCells[2]);
+    // allocate all cells and cell locks
+    const size_t totalNumCells = numCells[0] * numCells[1] * numCells[2];
+    cells.resize(totalNumCells);
+    cellLocks.resize(totalNumCells);
+    SPDLOG_DEBUG("Allocated {} cells (X: {}, Y: {}, Z: {}).", totalNumCells, numCells[0], numCells[1], numCells[2]);
 
     // creating cells
-    size_t index = 0;
-    for (int z = 0; z < numCells[2]; z++) {
-        for (int y = 0; y < numCells[1]; y++) {
-            for (int x = 0; x < numCells[0]; x++) {
-                // set type of cell
-                bool aboveHalo = z == (numCells[2] - 1);
-                bool belowHalo = z == 0;
-                bool northHalo = y == (numCells[1] - 1);
-                bool southHalo = y == 0;
-                bool westHalo = x == 0;
-                bool eastHalo = x == (numCells[0] - 1);
-
-                bool aboveBorder = z == (numCells[2] - 2);
-                bool belowBorder = z == 1;
-                bool northBorder = y == (numCells[1] - 2);
-                bool southBorder = y == 1;
-                bool westBorder = x == 1;
-                bool eastBorder = x == (numCells[0] - 2);
-
-                std::vector<HaloLocation> haloLocation;
-                if (northHalo)
-                    haloLocation.push_back(HaloLocation::NORTH);
-                if (southHalo)
-                    haloLocation.push_back(HaloLocation::SOUTH);
-                if (westHalo)
-                    haloLocation.push_back(HaloLocation::WEST);
-                if (eastHalo)
-                    haloLocation.push_back(HaloLocation::EAST);
-                if (dim == 3) {
-                    if (aboveHalo)
-                        haloLocation.push_back(HaloLocation::ABOVE);
-                    if (belowHalo)
-                        haloLocation.push_back(HaloLocation::BELOW);
-                }
+    // the outermost haloWidth layers are halo cells, the next haloWidth layers inside the domain are border cells
+    // every cell only depends on its coordinates, so the grid is built in parallel
+    const int k = static_cast<int>(haloWidth);
+    const int nx = static_cast<int>(numCells[0]);
+    const int ny = static_cast<int>(numCells[1]);
+    const int total = static_cast<int>(totalNumCells);
+#pragma omp parallel for schedule(static)
+    for (int index = 0; index < total; ++index) {
+        const std::array<int, 3> coords{index % nx, (index / nx) % ny, index / (nx * ny)};
+
+        // set type of cell
+        LocationMask haloMask = 0;
+        LocationMask borderMask = 0;
+        for (size_t axis = 0; axis < dim; ++axis) {
+            const int c = coords[axis];
+            const int n = static_cast<int>(numCells[axis]);
+            if (c < k)
+                haloMask |= CellUtils::toMask(lowLocation[axis]);
+            if (c >= n - k)
+                haloMask |= CellUtils::toMask(highLocation[axis]);
+            if (c >= k && c < 2 * k)
+                borderMask |= CellUtils::toMask(lowLocation[axis]);
+            if (c >= n - 2 * k && c < n - k)
+                borderMask |= CellUtils::toMask(highLocation[axis]);
+        }
 
-                std::vector<BorderLocation> borderLocation;
-                if (northBorder)
-                    borderLocation.push_back(BorderLocation::NORTH);
-                if (southBorder)
-                    borderLocation.push_back(BorderLocation::SOUTH);
-                if (westBorder)
-                    borderLocation.push_back(BorderLocation::WEST);
-                if (eastBorder)
-                    borderLocation.push_back(BorderLocation::EAST);
-                if (dim == 3) {
-                    if (aboveBorder)
-                        borderLocation.push_back(BorderLocation::ABOVE);
-                    if (belowBorder)
-                        borderLocation.push_back(BorderLocation::BELOW);
-                }
+        // we don't care about which type of border it is, for now...
+        const CellType type = haloMask != 0 ? CellType::HALO : (borderMask != 0 ? CellType::BORDER : CellType::INNER);
 
-                // this should be deleted and borderLocation condition added, but I'm afraid to break everything (who
-                // wrote this? - in any case I agree)
-                // we don't care about which type of border it is, for now...
-                bool border = dim == 3 ? (z == 1 || z == (numCells[2] - 2) || y == 1 || y == (numCells[1] - 2) ||
-                                          x == 1 || x == (numCells[0] - 2))
-                                       : (y == 1 || y == (numCells[1] - 2) || x == 1 || x == (numCells[0] - 2));
-                CellType type = !haloLocation.empty() ? CellType::HALO : (border ? CellType::BORDER : CellType::INNER);
-
-                // position of lower left corner
-                std::array<double, 3> position = {x * cellSize[0], y * cellSize[1], z * cellSize[2]};
-                cells.emplace_back(cellSize, position, type, index, haloLocation, borderLocation);
-                calculateNeighbors(cells.size() - 1);
-
-                // add to cell ref. containers
-                // we can do this in here because we reserved the size of the vector beforehand...
-                if (type == CellType::HALO) {
-                    haloCells.push_back(std::ref(cells[cells.size() - 1]));
-                } else if (type == CellType::BORDER) {
-                    borderCells.push_back(std::ref(cells[cells.size() - 1]));
-                    iterableCells.push_back(std::ref(cells[cells.size() - 1]));
-                } else {
-                    iterableCells.push_back(std::ref(cells[cells.size() - 1]));
-                }
+        // position of lower left corner
+        const std::array<double, 3> position = {offset[0] + coords[0] * cellSize[0],
+                                                offset[1] + coords[1] * cellSize[1],
+                                                offset[2] + coords[2] * cellSize[2]};
+        cells[index] = Cell(cellSize, position, type, index, haloMask, borderMask);
 
-                SPDLOG_TRACE("Created new cell ({}, {}) (index: {})", x, y, index);
+        // initialize corresponding cell lock
+        omp_init_lock(&cellLocks[index]);
+    }
 
-                // initialize corresponding cell lock
-                omp_init_lock(&cellLocks[index]);
+    // add to cell ref. containers in ascending order
+    for (Cell &c : cells) {
+        if (c.getType() == CellType::HALO) {
+            haloCells.push_back(std::ref(c));
+        } else {
+            if (c.getType() == CellType::BORDER)
+                borderCells.push_back(std::ref(c));
+            iterableCells.push_back(std::ref(c));
+        }
+    }
 
-                index++;
+    // the stencil reaches as many cells in each direction as there are cells per cutoff radius, i.e. (2k+1)^d cells
+    // here we check whether we have a 3rd dimension
+    for (int dz = (dim == 2 ? 0 : -k); dz <= (dim == 2 ? 0 : k); ++dz) {
+        for (int dy = -k; dy <= k; ++dy) {
+            for (int dx = -k; dx <= k; ++dx) {
+                stencil.push_back((dz * static_cast<int>(numCells[1]) + dy) * static_cast<int>(numCells[0]) + dx);
             }
         }
     }
@@ -153,9 +171,30 @@ CellContainer::CellContainer(const std::array<double, 3> &domainSize,
     anyPeriodic = std::any_of(conditions.begin(), conditions.end(),
                               [](BoundaryCondition condition) { return condition == BoundaryCondition::PERIODIC; });
 
-    // add particles to corresponding cells
+    // lookup tables for the cells on the opposite side of the domain, used by the periodic boundaries
+    const std::array<int, 3> strides{1, nx, nx * ny};
+    for (size_t location = 0; location < 6; ++location) {
+        const size_t axis = locationAxis[location];
+        const int shift = (static_cast<int>(numCells[axis]) - 2 * k) * strides[axis];
+        periodicShift[location] = locationIsHigh[location] ? -shift : shift;
+        if (location < 2 * dim && conditions[location] == BoundaryCondition::PERIODIC)
+            periodicMask |= CellUtils::toMask(static_cast<BorderLocation>(location));
+    }
+    for (LocationMask mask = 0; mask < cornerShifts.size(); ++mask) {
+        for (LocationMask combination : getBorderCombinations(mask)) {
+            int shift = 0;
+            for (size_t location = 0; location < 6; ++location) {
+                if (combination & CellUtils::toMask(static_cast<BorderLocation>(location)))
+                    shift += periodicShift[location];
+            }
+            cornerShifts[mask].push_back(shift);
+        }
+    }
+
+    // add (active) particles to corresponding cells
     for (Particle &p : particles) {
-        addParticle(p);
+        if (p.isActive())
+            addParticle(p);
     }
 
     // debug print
@@ -178,8 +217,9 @@ CellContainer::ContainerType::const_iterator CellContainer::begin() const { retu
 CellContainer::ContainerType::const_iterator CellContainer::end() const { return cells.end(); }
 
 CellContainer::SpecialParticleIterator::SpecialParticleIterator(
-    std::vector<std::reference_wrapper<Cell>>::iterator start, std::vector<std::reference_wrapper<Cell>>::iterator end)
-    : outerIt(start), outerEnd(end) {
+    std::vector<std::reference_wrapper<Cell>>::iterator start, std::vector<std::reference_wrapper<Cell>>::iterator end,
+    ParticleContainer &particles)
+    : outerIt(start), outerEnd(end), particles(&particles) {
     if (outerIt != outerEnd) {
         innerIt = outerIt->get().begin();
         innerEnd = outerIt->get().end();
@@ -187,7 +227,7 @@ CellContainer::SpecialParticleIterator::SpecialParticleIterator(
     }
 }
 
-Particle &CellContainer::SpecialParticleIterator::operator*() { return *innerIt; }
+Particle &CellContainer::SpecialParticleIterator::operator*() { return particles->resolve(*innerIt); }
 CellContainer::SpecialParticleIterator &CellContainer::SpecialParticleIterator::operator++() {
     ++innerIt;
     advance();
@@ -209,43 +249,34 @@ bool CellContainer::SpecialParticleIterator::operator==(const SpecialParticleIte
     return !((*this) != other);
 }
 CellContainer::SpecialParticleIterator CellContainer::boundaryBegin() {
-    return SpecialParticleIterator(borderCells.begin(), borderCells.end());
+    return SpecialParticleIterator(borderCells.begin(), borderCells.end(), particles);
 }
 CellContainer::SpecialParticleIterator CellContainer::boundaryEnd() {
-    return SpecialParticleIterator(borderCells.end(), borderCells.end());
+    return SpecialParticleIterator(borderCells.end(), borderCells.end(), particles);
 }
 CellContainer::SpecialParticleIterator CellContainer::haloBegin() {
-    return SpecialParticleIterator(haloCells.begin(), haloCells.end());
+    return SpecialParticleIterator(haloCells.begin(), haloCells.end(), particles);
 }
 CellContainer::SpecialParticleIterator CellContainer::haloEnd() {
-    return SpecialParticleIterator(haloCells.end(), haloCells.end());
+    return SpecialParticleIterator(haloCells.end(), haloCells.end(), particles);
 }
 
 /* functionality */
 int CellContainer::getCellIndex(const std::array<double, 3> &position) {
-    std::array<int, 3> coords{0, 0, 0};
-    for (int i = 0; i < 3; ++i) {
-        // prevent division by zero for 2D; could also simply check dim here if it were stored.
-        if (cellSize[i] == 0) {
-            coords[i] = 0;
-            continue;
-        }
-        // get coordinates based on position
-        coords[i] = static_cast<int>(std::floor(position[i] / cellSize[i])); // +1 for halo offset
-        if (coords[i] < 0 || coords[i] >= numCells[i]) {
-            SPDLOG_DEBUG("Position {} is out of bounds!", ArrayUtils::to_string(position));
-            return -1; // out of bounds
-        }
-    }
-    int idx = coords[2] * numCells[0] * numCells[1] + coords[1] * numCells[0] + coords[0];
+    int idx = dim == 2 ? getCellIndex<2>(position) : getCellIndex<3>(position);
+    if (idx == -1)
+        SPDLOG_DEBUG("Position {} is out of bounds!", ArrayUtils::to_string(position));
     return idx;
 }
 bool CellContainer::addParticle(Particle &p) {
+    assert(p.getHandle() != INVALID_HANDLE);
     int cellIndex = p.getCellIndex() == -1 ? getCellIndex(p.getX()) : p.getCellIndex();
     if (cellIndex >= 0 && cellIndex < static_cast<int>(cells.size())) {
         p.setCellIndex(cellIndex);
         omp_set_lock(&cellLocks[cellIndex]);
-        cells[cellIndex].addParticle(p);
+        if (cells[cellIndex].isEmpty())
+            occupancyChanged.store(true, std::memory_order_relaxed);
+        cells[cellIndex].addParticle(p.getHandle(), IS_WALL(p));
         omp_unset_lock(&cellLocks[cellIndex]);
         SPDLOG_TRACE("Added particle {}", p.toString());
         return true;
@@ -258,7 +289,9 @@ void CellContainer::deleteParticle(Particle &p) {
     int cellIndex = p.getCellIndex();
     assert(cellIndex != -1);
     omp_set_lock(&cellLocks[cellIndex]);
-    cells[cellIndex].removeParticle(p);
+    cells[cellIndex].removeParticle(p.getHandle(), IS_WALL(p));
+    if (cells[cellIndex].isEmpty())
+        occupancyChanged.store(true, std::memory_order_relaxed);
     omp_unset_lock(&cellLocks[cellIndex]);
     p.setCellIndex(-1);
     SPDLOG_TRACE("Removed particle from cell {}: {}", cellIndex, p.toString());
@@ -282,46 +315,25 @@ void CellContainer::removeHaloCellParticles() {
 std::array<int, 3> CellContainer::getVirtualCellCoordinates(int index) const {
     int x = index % numCells[0];
     int y = (index / numCells[0]) % numCells[1];
-    int z = cellSize[2] == 0 ? 0 : index / (numCells[0] * numCells[1]);
+    int z = dim == 2 ? 0 : index / (numCells[0] * numCells[1]);
     return {x, y, z};
 }
 int CellContainer::getOppositeNeighbor(int cellIndex, HaloLocation direction) const {
-    switch (direction) {
-    case HaloLocation::NORTH:
-        SPDLOG_TRACE("North set, getting southern cell index...");
-        return cellIndex - numCells[0];
-    case HaloLocation::SOUTH:
-        SPDLOG_TRACE("South set, getting northern cell index...");
-        return cellIndex + numCells[0];
-        break;
-    case HaloLocation::EAST:
-        SPDLOG_TRACE("East set, getting western cell index...");
-        return cellIndex - 1;
-        break;
-    case HaloLocation::WEST:
-        SPDLOG_TRACE("West set, getting eastern cell index...");
-        return cellIndex + 1;
-        break;
-    case HaloLocation::ABOVE:
-        SPDLOG_TRACE("Above set, getting below cell index...");
-        if (dim == 3) {
-            return cellIndex - numCells[0] * numCells[1];
-        } else {
-            return -1;
-        }
-        break;
-    case HaloLocation::BELOW:
-        SPDLOG_TRACE("Below set, getting above cell index...");
-        if (dim == 3) {
-            return cellIndex + numCells[0] * numCells[1];
-        } else {
-            return -1;
-        }
-        break;
-    default:
-        SPDLOG_WARN("Not yet implemented! Come back later.\n");
+    // for halo cells, the opposite cell is the mirror image across the boundary, i.e. a halo cell d layers past the
+    // boundary maps to the border cell d layers before it; for single-layer halos, this is simply the adjacent cell
+    const size_t location = static_cast<size_t>(direction);
+    const size_t axis = locationAxis[location];
+    if (axis >= dim)
         return -1;
-    }
+    const std::array<int, 3> coords = getVirtualCellCoordinates(cellIndex);
+    const int k = static_cast<int>(haloWidth);
+    const int c = coords[axis];
+    const int n = static_cast<int>(numCells[axis]);
+    const std::array<int, 3> strides{1, static_cast<int>(numCells[0]), static_cast<int>(numCells[0] * numCells[1])};
+    const int stride = strides[axis];
+    if (locationIsHigh[location])
+        return cellIndex - (2 * std::max(0, c - (n - k)) + 1) * stride;
+    return cellIndex + (2 * std::max(0, k - 1 - c) + 1) * stride;
 }
 std::array<double, 3> CellContainer::getMirrorPosition(const std::array<double, 3> &position, const Cell &from,
                                                        const Cell &to, int direction) const {
@@ -341,15 +353,17 @@ std::array<double, 3> CellContainer::getMirrorPosition(const std::array<double,
     }
 }
 
-void CellContainer::calculateNeighbors(int cellIndex) {
+std::vector<int> CellContainer::getNeighbors(int cellIndex) const {
+    std::vector<int> neighbors;
     std::array<int, 3> coords = getVirtualCellCoordinates(cellIndex);
+    const int k = static_cast<int>(haloWidth);
     // here we check whether we have a 3rd dimension
-    for (int dz = (cellSize[2] == 0 ? 0 : -1); dz <= (cellSize[2] == 0 ? 0 : 1); ++dz) {
-        for (int dy = -1; dy <= 1; ++dy) {
-            for (int dx = -1; dx <= 1; ++dx) {
+    for (int dz = (dim == 2 ? 0 : -k); dz <= (dim == 2 ? 0 : k); ++dz) {
+        for (int dy = -k; dy <= k; ++dy) {
+            for (int dx = -k; dx <= k; ++dx) {
                 if (dx == 0 && dy == 0 && dz == 0) {
                     // cell itself is also a neighbor
-                    cells[cellIndex].getNeighbors().push_back(cellIndex);
+                    neighbors.push_back(cellIndex);
                     continue;
                 }
                 // coords[2] + dz = 0 if in 2D
@@ -358,98 +372,100 @@ void CellContainer::calculateNeighbors(int cellIndex) {
                     neighborCoords[1] < numCells[1] && neighborCoords[2] >= 0 && neighborCoords[2] < numCells[2]) {
                     int neighborIndex = neighborCoords[2] * numCells[1] * numCells[0] +
                                         neighborCoords[1] * numCells[0] + neighborCoords[0];
-                    cells[cellIndex].getNeighbors().push_back(neighborIndex);
+                    neighbors.push_back(neighborIndex);
                 }
             }
         }
     }
+    return neighbors;
 }
 
-const std::vector<int> &CellContainer::getNeighbors(int cellIndex) const { return cells[cellIndex].getNeighbors(); }
-std::vector<std::reference_wrapper<Cell>> CellContainer::getNeighborCells(int cellIndex) {
-    std::vector<std::reference_wrapper<Cell>> neighbors;
-    for (size_t idx : getNeighbors(cellIndex)) {
-        neighbors.push_back(std::ref(cells[idx]));
+const std::vector<int> &CellContainer::getStencil() const { return stencil; }
+
+const std::vector<int> &CellContainer::getOccupiedCells() {
+    if (!occupancyChanged.exchange(false))
+        return occupiedCells;
+
+    occupiedCells.clear();
+    if (particles.size() >= iterableCells.size()) {
+        // dense domain: scanning the cells is cheaper than sorting, and they are already in ascending order
+        for (const Cell &c : iterableCells) {
+            if (!c.isEmpty())
+                occupiedCells.push_back(c.getIndex());
+        }
+    } else {
+        // sparse domain: every occupied cell is found exactly once through the first particle stored in it
+        for (const Particle &p : particles) {
+            CONTINUE_IF_INACTIVE(p);
+            const int cellIndex = p.getCellIndex();
+            if (cellIndex == -1 || cells[cellIndex].getType() == CellType::HALO)
+                continue;
+            const Cell &c = cells[cellIndex];
+            const std::vector<ParticleHandle> &handles =
+                c.getParticles().empty() ? c.getStaticParticles() : c.getParticles();
+            if (handles.front() == p.getHandle())
+                occupiedCells.push_back(cellIndex);
+        }
+        std::sort(occupiedCells.begin(), occupiedCells.end());
     }
-    return neighbors;
+    SPDLOG_TRACE("Collected {} occupied cells out of {}.", occupiedCells.size(), iterableCells.size());
+    return occupiedCells;
 }
 
-int CellContainer::getOppositeOfHalo(const Cell &from, HaloLocation location) {
-    // coincidentally works just as well for getting the opposite halo cell for a border cell; currently in 2D
-    int cellIndex = from.getIndex();
-    if (location == HaloLocation::NORTH) {
-        return cellIndex - numCells[0] * (numCells[1] - 2);
-    } else if (location == HaloLocation::SOUTH) {
-        return cellIndex + numCells[0] * (numCells[1] - 2);
-    } else if (location == HaloLocation::WEST) {
-        return cellIndex + (numCells[0] - 2);
-    } else if (location == HaloLocation::EAST) {
-        return cellIndex - (numCells[0] - 2);
-    } else if (location == HaloLocation::BELOW) {
-        return cellIndex + numCells[0] * numCells[1] * (numCells[2] - 2);
-    } else if (location == HaloLocation::ABOVE) {
-        return cellIndex - numCells[0] * numCells[1] * (numCells[2] - 2);
+// helper function to create the state of a pair search on first use
+template <typename T> static T &lazy(std::unique_ptr<T> &state) {
+    if (!state)
+        state = std::make_unique<T>();
+    return *state;
+}
+ClusterPairList &CellContainer::getClusterPairs() { return lazy(clusterPairs); }
+Octree &CellContainer::getTree() { return lazy(tree); }
+HierarchicalGrid &CellContainer::getGrid() { return lazy(grid); }
+
+void CellContainer::addGhostParticle(int cellIndex, ParticleHandle handle, bool isStatic) {
+    if (cells[cellIndex].isEmpty())
+        ghostCells.push_back(cellIndex);
+    cells[cellIndex].addParticle(handle, isStatic);
+}
+
+void CellContainer::clearGhostParticles() {
+    for (int cellIndex : ghostCells) {
+        cells[cellIndex].getParticles().clear();
+        cells[cellIndex].getStaticParticles().clear();
     }
-    return -1;
+    ghostCells.clear();
+}
+
+const std::vector<int> &CellContainer::getGhostCells() const { return ghostCells; }
+
+int CellContainer::getOppositeOfHalo(const Cell &from, HaloLocation location) {
+    // coincidentally works just as well for getting the opposite halo cell for a border cell
+    return from.getIndex() + periodicShift[static_cast<size_t>(location)];
 }
 
 int CellContainer::getOppositeOfBorder(const Cell &from, BorderLocation location) {
-    // currently in 2D
-    int cellIndex = from.getIndex();
-    if (location == BorderLocation::NORTH) {
-        return cellIndex - numCells[0] * (numCells[1] - 2);
-    } else if (location == BorderLocation::SOUTH) {
-        return cellIndex + numCells[0] * (numCells[1] - 2);
-    } else if (location == BorderLocation::WEST) {
-        return cellIndex + (numCells[0] - 2);
-    } else if (location == BorderLocation::EAST) {
-        return cellIndex - (numCells[0] - 2);
-    } else if (location == BorderLocation::BELOW) {
-        return cellIndex + numCells[0] * numCells[1] * (numCells[2] - 2);
-    } else if (location == BorderLocation::ABOVE) {
-        return cellIndex - numCells[0] * numCells[1] * (numCells[2] - 2);
-    }
-    return -1;
+    return from.getIndex() + periodicShift[static_cast<size_t>(location)];
 }
 
-std::vector<int> CellContainer::getOppositeOfBorderCorner(const Cell &from, std::vector<BorderLocation> &locations) {
+std::vector<int> CellContainer::getOppositeOfBorderCorner(const Cell &from, LocationMask locations) const {
     // switched to 3D, should still work in 2D
     std::vector<int> ghostCorners;
-    for (auto &pair : getBorderCombinations(locations)) {
-        int cellIndex = from.getIndex();
-        for (auto &loc : pair) {
-            if (loc == BorderLocation::NORTH) {
-                cellIndex = cellIndex - numCells[0] * (numCells[1] - 2);
-            } else if (loc == BorderLocation::SOUTH) {
-                cellIndex = cellIndex + numCells[0] * (numCells[1] - 2);
-            } else if (loc == BorderLocation::WEST) {
-                cellIndex = cellIndex + (numCells[0] - 2);
-            } else if (loc == BorderLocation::EAST) {
-                cellIndex = cellIndex - (numCells[0] - 2);
-            } else if (loc == BorderLocation::ABOVE) {
-                cellIndex = cellIndex - numCells[0] * numCells[1] * (numCells[2] - 2);
-            } else if (loc == BorderLocation::BELOW) {
-                cellIndex = cellIndex + numCells[0] * numCells[1] * (numCells[2] - 2);
-            }
-        }
-        ghostCorners.push_back(cellIndex);
-    }
+    for (int shift : cornerShifts[locations])
+        ghostCorners.push_back(from.getIndex() + shift);
     return ghostCorners;
 }
 
-std::vector<std::vector<BorderLocation>> CellContainer::getBorderCombinations(std::vector<BorderLocation> &locations) {
-    std::vector<std::vector<BorderLocation>> pairs;
-    int n = locations.size();
-
-    for (int i = 0; i < n - 1; ++i) {
-        for (int j = i + 1; j < n; ++j) {
-            pairs.push_back({locations[i], locations[j]});
-        }
+std::vector<LocationMask> CellContainer::getBorderCombinations(LocationMask locations) {
+    std::vector<LocationMask> pairs;
+    for (LocationMask rest = locations; rest != 0; rest &= rest - 1) {
+        const LocationMask first = rest & -rest;
+        for (LocationMask others = rest & (rest - 1); others != 0; others &= others - 1)
+            pairs.push_back(first | (others & -others));
     }
 
     // if we have a triple corner, I have come to the conclusion we should also mirror across all 3 dimensions
     // it's just intuition tho, I wouldn't stake my life on it
-    if (locations.size() == 3) {
+    if (CellUtils::countLocations(locations) == 3) {
         pairs.push_back(locations);
     }
 
@@ -471,8 +487,14 @@ const std::array<double, 3> &CellContainer::getCellSize() const { return cellSiz
 const std::array<size_t, 3> &CellContainer::getNumCells() const { return numCells; }
 const std::array<BoundaryCondition, 6> &CellContainer::getConditions() const { return conditions; }
 double CellContainer::getCutoff() const { return cutoff; }
+double CellContainer::getPairCutoffFactor() const { return pairCutoffFactor; }
+double CellContainer::getSkin() const { return skin; }
+size_t CellContainer::getHaloWidth() const { return haloWidth; }
 size_t CellContainer::getDim() const { return dim; }
 bool CellContainer::getAnyPeriodic() const { return anyPeriodic; }
+bool CellContainer::getParticlesDeactivated() const { return particlesDeactivated; }
+void CellContainer::setParticlesDeactivated(bool deactivated) { particlesDeactivated = deactivated; }
+LocationMask CellContainer::getPeriodicMask() const { return periodicMask; }
 ParticleContainer &CellContainer::getParticles() { return particles; }
 const ParticleContainer &CellContainer::getParticles() const { return particles; }
 size_t CellContainer::size() const { return particles.size(); }
@@ -513,8 +535,11 @@ void CellContainer::printCellContents() const {
                   << cells[i].getX()[2] << "] - [" << (cells[i].getX()[0] + cells[i].getSize()[0]) << ", "
                   << (cells[i].getX()[1] + cells[i].getSize()[1]) << ", "
                   << (cells[i].getX()[2] + cells[i].getSize()[2]) << "]): " << BOLD_OFF << "\n";
-        for (auto &p : cells[i].getParticles()) {
-            std::cout << "\t" << p.get().toString() << "\n";
+        for (ParticleHandle h : cells[i].getParticles()) {
+            std::cout << "\t" << particles.resolve(h).toString() << "\n";
+        }
+        for (ParticleHandle h : cells[i].getStaticParticles()) {
+            std::cout << "\t(static) " << particles.resolve(h).toString() << "\n";
         }
     }
     std::cout << BOLD_OFF;
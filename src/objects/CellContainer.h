@@ -15,17 +15,34 @@
 #include "utils/CellUtils.h"
 #include "utils/OMPWrapper.h"
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+class ClusterPairList;
+class HierarchicalGrid;
+class Octree;
+
 // NOTE 1: you could probably use arrays instead of vectors and make this a template class,
 // since we can compute the number of cells beforehand.
 
-// NOTE 2: i only extended halo cells one cell past the boundary. theoretically, they could continue infinitely, but
-// that would be a nightmare to manage.
+// NOTE 2: halo cells extend as many cells past the boundary as there are cells per cutoff radius (usually one).
+// the border cells are the same number of layers inside the domain.
+
+// NOTE 3: empty cells are cheap: their halo and border locations are stored as bitmasks, so no cell owns any heap
+// memory until a particle enters it.
+// the neighbors of a cell are given by a single stencil of index offsets shared by all cells, and the force and ghost
+// passes only visit the occupied cells, so that mostly empty domains (e.g. falling drops) cost little time.
+
+// NOTE 4: wall particles never move, so each cell stores them separately as static particles. they are only ever
+// visited as the second particle of a pair, which means that wall-wall pairs are never generated.
+
+// NOTE 5: with a skin, particles are only moved to another cell once they are more than the skin outside of their
+// cell or leave the domain. the cells are enlarged by twice the skin, so that the stencil still covers all pairs.
 
 /// @brief Cell encapsulation class for implementing the linked cell method.
 class CellContainer {
@@ -43,22 +60,58 @@ class CellContainer {
     std::vector<std::reference_wrapper<Cell>> haloCells;
     /// @brief Container of references to cells to iterate over when calculating the forces between particles.
     std::vector<std::reference_wrapper<Cell>> iterableCells;
+    /// @brief The index offsets of all cells within the cutoff radius of an iterable cell, including the cell itself.
+    std::vector<int> stencil;
+    /// @brief The indices of all iterable cells containing at least one particle, in ascending order.
+    std::vector<int> occupiedCells;
+    /// @brief The indices of all halo cells containing ghost particles.
+    std::vector<int> ghostCells;
+    /// @brief Determines if a cell has become empty or non-empty since the occupied cells were last collected.
+    std::atomic<bool> occupancyChanged{true};
+    /// @brief Determines if a step specialized for simulations without outflow has deactivated a particle.
+    bool particlesDeactivated{false};
     /// @brief The size of the domain in each dimension.
     std::array<double, 3> domainSize;
     /// @brief The size of each cell in each dimension (default: 0, 0, 0).
     std::array<double, 3> cellSize{0, 0, 0};
     /// @brief The number of cells in each dimension (default: 1, 1, 1).
     std::array<size_t, 3> numCells{1, 1, 1};
+    /// @brief The position of the lower left corner of the first (halo) cell (default: 0, 0, 0).
+    std::array<double, 3> offset{0, 0, 0};
     /// @brief An array of boundary conditions to be applied at each boundary (North, South, West, East, Above, Below).
     std::array<BoundaryCondition, 6> conditions;
     /// @brief The cutoff radius.
     double cutoff;
+    /// @brief The cutoff radius of each particle pair relative to its mixed sigma, 0 if all pairs use the cutoff radius
+    /// (default: 0).
+    double pairCutoffFactor{0.0};
+    /// @brief The distance particles may move outside of their cell before being moved to another cell (default: 0).
+    double skin{0.0};
+    /// @brief The lower corner of the domain, i.e. of the first non-halo cell (default: 0, 0, 0).
+    std::array<double, 3> domainMin{0, 0, 0};
+    /// @brief The upper corner of the domain, i.e. of the last non-halo cell (default: 0, 0, 0).
+    std::array<double, 3> domainMax{0, 0, 0};
+    /// @brief The number of halo and border layers at each boundary, i.e. the number of cells per cutoff radius
+    /// (default: 1).
+    size_t haloWidth{1};
     /// @brief The number of dimensions (2/3)
     size_t dim;
     /// @brief Determines if there are any periodic halo cells.
     bool anyPeriodic{false};
+    /// @brief The locations of all periodic boundaries.
+    LocationMask periodicMask{0};
+    /// @brief The index offset from a cell to the cell on the opposite side of the domain, for each location.
+    std::array<int, 6> periodicShift{};
+    /// @brief The index offsets from a border cell to the opposite corner cells, indexed by its periodic locations.
+    std::array<std::vector<int>, 64> cornerShifts;
     /// @brief A reference to the overarching ParticleContainer.
     ParticleContainer &particles;
+    /// @brief The cluster pair lists of the cluster pair search, created on first use.
+    std::unique_ptr<ClusterPairList> clusterPairs;
+    /// @brief The octree of the tree pair search, created on first use.
+    std::unique_ptr<Octree> tree;
+    /// @brief The hierarchical grid of the levels pair search, created on first use.
+    std::unique_ptr<HierarchicalGrid> grid;
 
   public:
     /**
@@ -69,9 +122,18 @@ class CellContainer {
      * @param cutoff The cutoff radius.
      * @param particles The main ParticleContainer.
      * @param dim The dimension of the container. May either be two- (2) or three-dimensional (3).
+     * @param cellSizeFactor The minimum cell size relative to the cutoff radius. Either at least 1, or 1/k for an
+     * integer k, in which case the stencil reaches k cells in each direction and the halo and border are k cells thick.
+     * Larger cells contain more particles outside of the cutoff radius, but fewer cells have to be visited; smaller
+     * cells shrink the searched volume at the cost of more cells.
+     * @param pairCutoffFactor The cutoff radius of each particle pair relative to its mixed sigma, or 0 if all pairs
+     * use the cutoff radius. Per-pair cutoff radii must not exceed the cutoff radius, which determines the cell size.
+     * @param skin The distance particles may move outside of their Cell before being moved to another Cell, or 0 to
+     * move them as soon as they leave it. The cells are enlarged by twice the skin.
      */
     CellContainer(const std::array<double, 3> &domainSize, const std::array<BoundaryCondition, 6> &conditions,
-                  double cutoff, ParticleContainer &particles, size_t dim = 3);
+                  double cutoff, ParticleContainer &particles, size_t dim = 3, double cellSizeFactor = 1.0,
+                  double pairCutoffFactor = 0.0, double skin = 0.0);
 
     /// @brief Destroys the CellContainer object and frees the reserved locks.
     ~CellContainer();
@@ -130,10 +192,12 @@ class CellContainer {
         std::vector<std::reference_wrapper<Cell>>::iterator outerIt;
         /// @brief The end of the outer iterator, iterating over each Cell pointer.
         std::vector<std::reference_wrapper<Cell>>::iterator outerEnd;
-        /// @brief The inner iterator, iterating over each Particle pointer in a Cell.
-        std::forward_list<std::reference_wrapper<Particle>>::iterator innerIt;
-        /// @brief The end of the inner iterator, iterating over each Particle pointer in a Cell.
-        std::forward_list<std::reference_wrapper<Particle>>::iterator innerEnd;
+        /// @brief The inner iterator, iterating over each Particle handle in a Cell.
+        std::vector<ParticleHandle>::iterator innerIt;
+        /// @brief The end of the inner iterator, iterating over each Particle handle in a Cell.
+        std::vector<ParticleHandle>::iterator innerEnd;
+        /// @brief The ParticleContainer used to resolve the Particle handles.
+        ParticleContainer *particles;
         /// @brief Helper function to move to the next Cell which contains at least one particle. Stops when no further
         /// cells can be searched.
         void advance();
@@ -145,9 +209,10 @@ class CellContainer {
          * @param start The beginning of the iterator. Automatically progresses to the first cell with at least one
          * particle.
          * @param end The end of the iterator (one past the final cell).
+         * @param particles The ParticleContainer used to resolve the Particle handles stored in each Cell.
          */
         SpecialParticleIterator(std::vector<std::reference_wrapper<Cell>>::iterator start,
-                                std::vector<std::reference_wrapper<Cell>>::iterator end);
+                                std::vector<std::reference_wrapper<Cell>>::iterator end, ParticleContainer &particles);
 
         /**
          * @brief Overload of the dereference operator.
@@ -307,12 +372,55 @@ class CellContainer {
      */
     int getCellIndex(const std::array<double, 3> &position);
 
+    /**
+     * @brief Gets the 1D index in the Cell container based on the given position for a fixed number of dimensions.
+     *
+     * @details The number of dimensions must match the one of the container. In 2D, the z-coordinate is skipped at
+     * compile time instead of checking the cell size at runtime, which matters for the position update.
+     *
+     * @tparam DIM The number of dimensions, either 2 or 3.
+     * @param position The position from which to compute the corresponding 1D index.
+     * @return The 1D index in the Cell container, or -1 if the position is out of bounds.
+     */
+    template <size_t DIM> int getCellIndex(const std::array<double, 3> &position) const {
+        static_assert(DIM == 2 || DIM == 3, "Only 2D and 3D cell containers are supported!");
+        std::array<int, 3> coords{0, 0, 0};
+        for (size_t i = 0; i < DIM; ++i) {
+            coords[i] = static_cast<int>(std::floor((position[i] - offset[i]) / cellSize[i]));
+            if (coords[i] < 0 || coords[i] >= static_cast<int>(numCells[i]))
+                return -1; // out of bounds
+        }
+        return (coords[2] * static_cast<int>(numCells[1]) + coords[1]) * static_cast<int>(numCells[0]) + coords[0];
+    }
+
+    /**
+     * @brief Checks whether a position may still belong to a given Cell, i.e. whether it is at most the skin outside of
+     * the Cell and inside the domain.
+     *
+     * @details Positions for which this holds do not have to be sorted into a new Cell, since the enlarged cells still
+     * find all of their neighbours. Cheaper than getCellIndex(), since it only compares coordinates.
+     *
+     * @tparam DIM The number of dimensions, either 2 or 3.
+     * @param position The position to be checked.
+     * @param cellIndex The index of the (non-halo) Cell the position currently belongs to.
+     * @return true if the position may stay in the Cell, false if it has to be sorted into a Cell again.
+     */
+    template <size_t DIM> bool isWithinSkin(const std::array<double, 3> &position, int cellIndex) const {
+        const std::array<double, 3> &corner = cells[cellIndex].getX();
+        for (size_t i = 0; i < DIM; ++i) {
+            if (position[i] < corner[i] - skin || position[i] >= corner[i] + cellSize[i] + skin ||
+                position[i] < domainMin[i] || position[i] >= domainMax[i])
+                return false;
+        }
+        return true;
+    }
+
     /**
      * @brief Removes a Particle from a Cell and marks it inactive.
      *
      * First, the function finds the 1D index of the Particle's Cell. From there, it is removed, then marked as
      * inactive. Note that, in order for this function to work, the Particle must have its correct index stored, and the
-     * index must be valid (i.e. not -1).
+     * index must be valid (i.e. not -1). The Particle must belong to the overarching ParticleContainer.
      *
      * @param p The Particle to remove.
      */
@@ -321,8 +429,9 @@ class CellContainer {
     /**
      * @brief Adds a Particle to the Cell container.
      *
-     * The 1D container index is computed from the Particle's current position. If the index is valid, the Particle is
-     * added there, otherwise nothing happens.
+     * The 1D container index is computed from the Particle's current position. If the index is valid, the Particle's
+     * handle is added there, otherwise nothing happens. Wall particles are added to the static handles of the Cell. The
+     * Particle must belong to the overarching ParticleContainer.
      *
      * @param p
      * @return true if the Particle was successfully added.
@@ -367,7 +476,8 @@ class CellContainer {
     /**
      * @brief Gets the index of the opposing Cell in the specified direction.
      *
-     * For example, if the direction is NORTH, this function will return the southern neighbor.
+     * For example, if the direction is NORTH, this function will return the southern neighbor. For halo Cells more than
+     * one layer past the boundary, the mirror image of the Cell across the boundary is returned instead.
      *
      * @param cellIndex The Cell from which to get the opposing Cell index.
      * @param direction The opposite direction of the desired neighbor Cell.
@@ -378,19 +488,83 @@ class CellContainer {
     /**
      * @brief Computes the vector of neighbouring Cell indices, including the Cell itself.
      *
+     * The stencil is clipped at the edges of the container, so this also works for halo Cells. For iterable Cells,
+     * adding the offsets from getStencil() to the Cell index is equivalent and cheaper.
+     *
      * @param cellIndex The index of the Cell for which the neighbours should be determined.
+     * @return A vector of neighbouring Cell indices, including the Cell itself, in ascending order.
      */
-    void calculateNeighbors(int cellIndex);
+    std::vector<int> getNeighbors(int cellIndex) const;
 
     /**
-     * @brief Gets a vector of neighbouring Cell indices, including the Cell itself.
+     * @brief Gets the index offsets of all neighbouring Cells of an iterable Cell, including the Cell itself.
      *
-     * @param cellIndex The index of the Cell for which the neighbours should be determined.
-     * @return A vector of neighbouring Cell indices, including the Cell itself.
+     * Since the halo is as thick as the stencil reaches, the neighbours of iterable Cells never leave the container.
+     *
+     * @return A const reference to the index offsets, in ascending order.
      */
-    const std::vector<int> &getNeighbors(int cellIndex) const;
+    const std::vector<int> &getStencil() const;
 
-    std::vector<std::reference_wrapper<Cell>> getNeighborCells(int cellIndex);
+    /**
+     * @brief Gets the indices of all iterable Cells containing at least one (regular or static) Particle.
+     *
+     * The indices are only collected again if a Cell has become empty or non-empty through the CellContainer since the
+     * last call. Depending on the number of particles, they are either collected by scanning the iterable Cells or
+     * from the Particle objects themselves, so that mostly empty domains do not pay for their empty cells. Must not be
+     * called from inside a parallel region.
+     *
+     * @return A const reference to the indices of the occupied Cells, in ascending order.
+     */
+    const std::vector<int> &getOccupiedCells();
+
+    /**
+     * @brief Gets the cluster pair lists of the cluster pair search, creating them on first use.
+     *
+     * The lists are kept between steps, so that their memory is reused, and belong to this CellContainer, so that they
+     * never refer to the Cell objects of another one. Must not be called from inside a parallel region.
+     *
+     * @return A reference to the cluster pair lists.
+     */
+    ClusterPairList &getClusterPairs();
+
+    /**
+     * @brief Gets the octree of the tree pair search, creating it on first use.
+     *
+     * Like the cluster pair lists, the tree is kept between steps and belongs to this CellContainer. Must not be called
+     * from inside a parallel region.
+     *
+     * @return A reference to the octree.
+     */
+    Octree &getTree();
+
+    /**
+     * @brief Gets the hierarchical grid of the levels pair search, creating it on first use.
+     *
+     * Like the cluster pair lists, the grid is kept between steps and belongs to this CellContainer. Must not be called
+     * from inside a parallel region.
+     *
+     * @return A reference to the hierarchical grid.
+     */
+    HierarchicalGrid &getGrid();
+
+    /**
+     * @brief Adds a ghost Particle to a halo Cell and remembers the Cell for clearGhostParticles().
+     *
+     * @param cellIndex The index of the halo Cell.
+     * @param handle The handle of the Particle to be mirrored into the halo Cell.
+     * @param isStatic Determines whether the Particle is a static (wall) Particle.
+     */
+    void addGhostParticle(int cellIndex, ParticleHandle handle, bool isStatic = false);
+
+    /// @brief Removes all ghost Particle handles from the halo Cells they were added to.
+    void clearGhostParticles();
+
+    /**
+     * @brief Gets the indices of all halo Cells which ghost Particle objects have been added to.
+     *
+     * @return A const reference to the indices of the halo Cells containing ghost Particle objects.
+     */
+    const std::vector<int> &getGhostCells() const;
 
     /**
      * @brief For a halo cell returns the index of the border cell on the opposite side of the domain
@@ -413,22 +587,24 @@ class CellContainer {
     /**
      * @brief For a border cell returns the indices of the corner cells on the opposite sides of the domain
      *
+     * The index offsets are looked up from a table which is filled once for all combinations of locations.
+     *
      * @param from The Cell for which the opposite halo cell should be determined
      * @param locations The orientations of the Border Cell
      * @return The indices of the opposite halo cells
      */
-    std::vector<int> getOppositeOfBorderCorner(const Cell &from, std::vector<BorderLocation> &locations);
+    std::vector<int> getOppositeOfBorderCorner(const Cell &from, LocationMask locations) const;
 
     /**
      * @brief For a collection of border locations, returns all combinations of size 2.
      *
-     * For example, given the vector of border locations `N`, `W`, `A` (abbreviated), the function returns the pairs
-     * `(N,W)`, `(N,A)`, `(W,A)`.
+     * For example, given the border locations `N`, `W`, `A` (abbreviated), the function returns the pairs `(N,W)`,
+     * `(N,A)`, `(W,A)`. For three locations, the combination of all three is returned as well.
      *
      * @param locations The border locations/directions which form the combinations.
-     * @return A vector of vectors representing the combinations of size 2.
+     * @return A vector of masks representing the combinations of size 2 (and 3).
      */
-    std::vector<std::vector<BorderLocation>> getBorderCombinations(std::vector<BorderLocation> &locations);
+    static std::vector<LocationMask> getBorderCombinations(LocationMask locations);
 
     /**
      * @brief Gets a const reference to the CellContainer's domain size.
@@ -465,6 +641,27 @@ class CellContainer {
      */
     double getCutoff() const;
 
+    /**
+     * @brief Gets the cutoff radius of each particle pair relative to its mixed sigma.
+     *
+     * @return The per-pair cutoff factor, or 0 if all pairs use the cutoff radius.
+     */
+    double getPairCutoffFactor() const;
+
+    /**
+     * @brief Gets the distance particles may move outside of their Cell before being moved to another Cell.
+     *
+     * @return The skin, or 0 if particles are moved as soon as they leave their Cell.
+     */
+    double getSkin() const;
+
+    /**
+     * @brief Gets the number of halo and border layers at each boundary.
+     *
+     * @return The number of cells per cutoff radius.
+     */
+    size_t getHaloWidth() const;
+
     /**
      * @brief Gets the number of dimensions of the linked cells.
      *
@@ -480,6 +677,29 @@ class CellContainer {
      */
     bool getAnyPeriodic() const;
 
+    /**
+     * @brief Checks if a step specialized for simulations without outflow has deactivated a Particle, e.g. because it
+     * got out of bounds. Such steps skip the check for inactive particles, so they must not be used afterwards.
+     *
+     * @return true if a Particle has been deactivated since the flag was last reset.
+     * @return false otherwise.
+     */
+    bool getParticlesDeactivated() const;
+
+    /**
+     * @brief Sets whether a step specialized for simulations without outflow has deactivated a Particle.
+     *
+     * @param deactivated The new value of the flag.
+     */
+    void setParticlesDeactivated(bool deactivated);
+
+    /**
+     * @brief Gets the locations of all periodic boundaries.
+     *
+     * @return The LocationMask of the periodic boundaries.
+     */
+    LocationMask getPeriodicMask() const;
+
     /**
      * @brief Gets a reference to the primary ParticleContainer.
      *
@@ -0,0 +1,193 @@
+#include "ClusterPairList.h"
+#include "utils/OMPWrapper.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+// helper function to get the squared distance between the bounding boxes of two clusters
+static inline double boxDistanceSquared(const ParticleCluster &a, const ParticleCluster &b) {
+    double dist = 0.0;
+    for (size_t d = 0; d < 3; ++d) {
+        const double gap = std::max({0.0, b.boxMin[d] - a.boxMax[d], a.boxMin[d] - b.boxMax[d]});
+        dist += gap * gap;
+    }
+    return dist;
+}
+
+/* building */
+void ClusterPairList::fillCell(CellContainer &lc, int cellIndex) {
+    ParticleContainer &particles = lc.getParticles();
+    Cell &cell = lc[cellIndex];
+    const bool ghost = cell.getType() == CellType::HALO;
+    const size_t axis = lc.getDim() - 1;
+
+    // ghost particles are placed inside the halo cell as if they were there, like in the regular force calculation
+    auto getPosition = [&](const Particle &p) -> std::array<double, 3> {
+        if (!ghost)
+            return p.getX();
+        const Cell &trueCell = lc[p.getCellIndex()];
+        return {cell.getX()[0] + p.getX()[0] - trueCell.getX()[0], cell.getX()[1] + p.getX()[1] - trueCell.getX()[1],
+                cell.getX()[2] + p.getX()[2] - trueCell.getX()[2]};
+    };
+
+    std::uint32_t next = m_cellBegin[cellIndex];
+    for (bool isStatic : {false, true}) {
+        std::vector<ParticleHandle> &handles = isStatic ? cell.getStaticParticles() : cell.getParticles();
+
+        // sorting along the last dimension turns each cluster into a thin slab with a tight bounding box
+        std::sort(handles.begin(), handles.end(), [&](ParticleHandle a, ParticleHandle b) {
+            return getPosition(particles.resolve(a))[axis] < getPosition(particles.resolve(b))[axis];
+        });
+
+        for (size_t start = 0; start < handles.size(); start += CLUSTER_SIZE) {
+            ParticleCluster &cluster = m_clusters[next++];
+            cluster.cellIndex = cellIndex;
+            cluster.isStatic = isStatic;
+            cluster.isGhost = ghost;
+            cluster.boxMin.fill(std::numeric_limits<double>::max());
+            cluster.boxMax.fill(std::numeric_limits<double>::lowest());
+            for (size_t lane = 0; lane < CLUSTER_SIZE; ++lane) {
+                if (start + lane >= handles.size()) {
+                    cluster.x[lane] = cluster.y[lane] = cluster.z[lane] = CLUSTER_PADDING;
+                    cluster.sqrtEpsilon[lane] = cluster.halfSigma[lane] = 0.0;
+                    cluster.handles[lane] = INVALID_HANDLE;
+                    continue;
+                }
+                const Particle &p = particles.resolve(handles[start + lane]);
+                const std::array<double, 3> x = getPosition(p);
+                cluster.x[lane] = x[0];
+                cluster.y[lane] = x[1];
+                cluster.z[lane] = x[2];
+                cluster.sqrtEpsilon[lane] = std::sqrt(p.getEpsilon());
+                cluster.halfSigma[lane] = p.getSigma() / 2;
+                cluster.handles[lane] = p.getHandle();
+                for (size_t d = 0; d < 3; ++d) {
+                    cluster.boxMin[d] = std::min(cluster.boxMin[d], x[d]);
+                    cluster.boxMax[d] = std::max(cluster.boxMax[d], x[d]);
+                }
+            }
+        }
+    }
+}
+
+void ClusterPairList::build(CellContainer &lc) {
+    // forget the clusters of the previous build; a different container may have a different number of cells
+    const size_t numCells = lc.getCells().size();
+    if (m_cellBegin.size() != numCells) {
+        m_cellBegin.assign(numCells, 0);
+        m_cellEnd.assign(numCells, 0);
+    } else {
+        for (int c : m_cells)
+            m_cellBegin[c] = m_cellEnd[c] = 0;
+    }
+
+    // the occupied iterable cells come first, so that their clusters are the first m_numIterable ones
+    const std::vector<int> &occupied = lc.getOccupiedCells();
+    m_cells.assign(occupied.begin(), occupied.end());
+    m_cells.insert(m_cells.end(), lc.getGhostCells().begin(), lc.getGhostCells().end());
+    std::uint32_t total = 0;
+    auto addClusters = [&](int cellIndex) {
+        auto numClusters = [](size_t n) { return static_cast<std::uint32_t>((n + CLUSTER_SIZE - 1) / CLUSTER_SIZE); };
+        m_cellBegin[cellIndex] = total;
+        total += numClusters(lc[cellIndex].getParticles().size()) +
+                 numClusters(lc[cellIndex].getStaticParticles().size());
+        m_cellEnd[cellIndex] = total;
+    };
+    for (int c : occupied)
+        addClusters(c);
+    m_numIterable = total;
+    for (int c : lc.getGhostCells())
+        addClusters(c);
+    m_clusters.resize(total);
+
+    const size_t lists = static_cast<size_t>(omp_get_max_threads());
+    m_pairs.resize(lists);
+    m_forces.resize(lists);
+    const std::vector<int> &stencil = lc.getStencil();
+    const double cutoffSquared = lc.getCutoff() * lc.getCutoff();
+
+#pragma omp parallel
+    {
+        // fill the clusters of each cell
+#pragma omp for schedule(dynamic, 16)
+        for (size_t k = 0; k < m_cells.size(); ++k)
+            fillCell(lc, m_cells[k]);
+
+        // clear all lists and buffers, including those of threads which may not take part in this region
+        for (size_t l = omp_get_thread_num(); l < lists; l += omp_get_num_threads()) {
+            m_pairs[l].clear();
+            m_forces[l].assign(m_clusters.size(), ClusterForces{});
+        }
+#pragma omp barrier
+
+        // pair each cluster of regular particles with all clusters of the neighbouring cells within the cutoff radius
+        // pairs of regular clusters are only listed from the cluster with the lower index
+        std::vector<ClusterPair> &pairs = m_pairs[omp_get_thread_num()];
+#pragma omp for schedule(static)
+        for (std::uint32_t ci = 0; ci < m_numIterable; ++ci) {
+            const ParticleCluster &a = m_clusters[ci];
+            if (a.isStatic)
+                continue;
+            for (int offset : stencil) {
+                const int neighbor = a.cellIndex + offset;
+                for (std::uint32_t cj = m_cellBegin[neighbor]; cj < m_cellEnd[neighbor]; ++cj) {
+                    const ParticleCluster &b = m_clusters[cj];
+                    ClusterPairMask mask;
+                    if (b.isStatic)
+                        mask = ClusterPairMask::STATIC;
+                    else if (b.isGhost)
+                        mask = ClusterPairMask::HANDLES;
+                    else if (ci < cj)
+                        mask = ClusterPairMask::ALL;
+                    else if (ci == cj)
+                        mask = ClusterPairMask::TRIANGLE;
+                    else
+                        continue;
+                    if (boxDistanceSquared(a, b) <= cutoffSquared)
+                        pairs.push_back({ci, cj, mask});
+                }
+            }
+        }
+    }
+    SPDLOG_TRACE("Built {} clusters ({} in iterable cells) with {} cluster pairs.", m_clusters.size(), m_numIterable,
+                 getNumPairs());
+}
+
+/* forces */
+void ClusterPairList::applyForces(ParticleContainer &particles) {
+#pragma omp parallel for schedule(static)
+    for (size_t c = 0; c < m_clusters.size(); ++c) {
+        const ParticleCluster &cluster = m_clusters[c];
+        if (cluster.isStatic)
+            continue;
+        for (size_t lane = 0; lane < CLUSTER_SIZE && cluster.handles[lane] != INVALID_HANDLE; ++lane) {
+            std::array<double, 3> f{0.0, 0.0, 0.0};
+            for (const std::vector<ClusterForces> &forces : m_forces) {
+                f[0] += forces[c].x[lane];
+                f[1] += forces[c].y[lane];
+                f[2] += forces[c].z[lane];
+            }
+
+            // ghost clusters refer to the same particles as the clusters of their border cells
+            Particle &p = particles.resolve(cluster.handles[lane]);
+            omp_set_lock(&p.getLock());
+            p.getF()[0] += f[0];
+            p.getF()[1] += f[1];
+            p.getF()[2] += f[2];
+            omp_unset_lock(&p.getLock());
+        }
+    }
+}
+
+/* getters */
+const std::vector<ParticleCluster> &ClusterPairList::getClusters() const { return m_clusters; }
+size_t ClusterPairList::getNumLists() const { return m_pairs.size(); }
+const std::vector<ClusterPair> &ClusterPairList::getPairs(size_t list) const { return m_pairs[list]; }
+std::vector<ClusterForces> &ClusterPairList::getForces(size_t list) { return m_forces[list]; }
+size_t ClusterPairList::getNumPairs() const {
+    size_t pairs = 0;
+    for (const auto &list : m_pairs)
+        pairs += list.size();
+    return pairs;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file ClusterPairList.h
+ * @brief Class for grouping the particles of each cell into fixed-size clusters and pairing them for SIMD kernels.
+ * @date 2025-02-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "CellContainer.h"
+#include "Particle.h"
+#include "ParticleContainer.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#ifdef __AVX512F__
+/// @brief The number of particles per cluster, i.e. the number of double precision lanes of an AVX-512 register.
+#define CLUSTER_SIZE 8
+#else
+/// @brief The number of particles per cluster, i.e. the number of double precision lanes of an AVX register.
+#define CLUSTER_SIZE 4
+#endif
+
+/// @brief The coordinates of unused cluster slots, far enough away to never be within the cutoff radius of anything.
+#define CLUSTER_PADDING 1e100
+
+/// @brief Enum describing which particle pairs of a cluster pair have to be evaluated.
+enum class ClusterPairMask : std::uint8_t {
+    /// @brief All pairs (two distinct clusters of regular particles).
+    ALL,
+    /// @brief Only the pairs above the diagonal (a cluster paired with itself).
+    TRIANGLE,
+    /// @brief Only the pairs where the handle of the first particle is smaller (ghost particles in the second cluster).
+    HANDLES,
+    /// @brief All pairs, without any force on the second cluster (static particles in the second cluster).
+    STATIC
+};
+
+/// @brief Up to CLUSTER_SIZE particles of the same cell, stored as structure of arrays. Unused slots are padded.
+struct alignas(64) ParticleCluster {
+    /// @brief The x coordinates of the particles.
+    std::array<double, CLUSTER_SIZE> x;
+    /// @brief The y coordinates of the particles.
+    std::array<double, CLUSTER_SIZE> y;
+    /// @brief The z coordinates of the particles.
+    std::array<double, CLUSTER_SIZE> z;
+    /// @brief The square roots of the particles' epsilons, so that mixing is a single multiplication.
+    std::array<double, CLUSTER_SIZE> sqrtEpsilon;
+    /// @brief Half of the particles' sigmas, so that mixing is a single addition.
+    std::array<double, CLUSTER_SIZE> halfSigma;
+    /// @brief The handles of the particles, INVALID_HANDLE for unused slots.
+    std::array<ParticleHandle, CLUSTER_SIZE> handles;
+    /// @brief The lower corner of the bounding box of the particles.
+    std::array<double, 3> boxMin;
+    /// @brief The upper corner of the bounding box of the particles.
+    std::array<double, 3> boxMax;
+    /// @brief The index of the cell the particles belong to.
+    int cellIndex;
+    /// @brief Determines whether the cluster contains static (wall) particles.
+    bool isStatic;
+    /// @brief Determines whether the cluster contains ghost particles of a halo cell.
+    bool isGhost;
+};
+
+/// @brief The forces accumulated on the particles of a cluster, stored as structure of arrays.
+struct alignas(64) ClusterForces {
+    /// @brief The x components of the forces.
+    std::array<double, CLUSTER_SIZE> x{};
+    /// @brief The y components of the forces.
+    std::array<double, CLUSTER_SIZE> y{};
+    /// @brief The z components of the forces.
+    std::array<double, CLUSTER_SIZE> z{};
+};
+
+/// @brief A pair of clusters within the cutoff radius of each other.
+struct ClusterPair {
+    /// @brief The index of the first cluster, which always contains regular particles of an iterable cell.
+    std::uint32_t i;
+    /// @brief The index of the second cluster.
+    std::uint32_t j;
+    /// @brief The particle pairs to be evaluated.
+    ClusterPairMask mask;
+};
+
+/**
+ * @brief Class grouping the particles of a CellContainer into clusters and listing all cluster pairs within the cutoff
+ * radius, similar to the cluster pair scheme of GROMACS.
+ *
+ * @details The particles of each occupied cell (and each halo cell containing ghost particles) are sorted along the
+ * last dimension and split into clusters of CLUSTER_SIZE particles, so that each cluster covers a thin slab of the
+ * cell. Each pair of clusters in neighbouring cells whose bounding boxes are within the cutoff radius is listed once.
+ * A force kernel can then evaluate every cluster pair as a dense CLUSTER_SIZE x CLUSTER_SIZE tile, masking out the
+ * pairs described by its ClusterPairMask, instead of chasing the particles of each cell one by one.
+ *
+ * The pairs are split into one list per thread, each with its own force buffer, so that the kernel does not need any
+ * locks. The buffers are summed up and added to the particles by applyForces().
+ */
+class ClusterPairList {
+  private:
+    /// @brief The clusters of all iterable cells, followed by the clusters of the halo cells.
+    std::vector<ParticleCluster> m_clusters;
+    /// @brief The number of clusters belonging to iterable cells.
+    std::uint32_t m_numIterable{0};
+    /// @brief The index of the first cluster of each cell. Only valid for the cells in m_cells.
+    std::vector<std::uint32_t> m_cellBegin;
+    /// @brief The index one past the last cluster of each cell. Only valid for the cells in m_cells.
+    std::vector<std::uint32_t> m_cellEnd;
+    /// @brief The indices of all cells containing clusters.
+    std::vector<int> m_cells;
+    /// @brief The cluster pairs, split into one list per thread.
+    std::vector<std::vector<ClusterPair>> m_pairs;
+    /// @brief The forces accumulated on each cluster, one buffer per pair list.
+    std::vector<std::vector<ClusterForces>> m_forces;
+
+    /**
+     * @brief Sorts the particles of a cell and fills its clusters.
+     *
+     * @param lc The CellContainer containing the cell.
+     * @param cellIndex The index of the cell.
+     */
+    void fillCell(CellContainer &lc, int cellIndex);
+
+  public:
+    /**
+     * @brief Rebuilds the clusters and cluster pairs from the current contents of a CellContainer and clears the force
+     * buffers.
+     *
+     * Ghost particles must already have been mirrored into the halo cells. The particles of each cell are reordered.
+     *
+     * @param lc The CellContainer whose particles should be clustered.
+     */
+    void build(CellContainer &lc);
+
+    /**
+     * @brief Gets all clusters.
+     *
+     * @return A const reference to the clusters.
+     */
+    const std::vector<ParticleCluster> &getClusters() const;
+
+    /**
+     * @brief Gets the number of cluster pair lists.
+     *
+     * @return The number of cluster pair lists, which is the maximum number of threads during the last build.
+     */
+    size_t getNumLists() const;
+
+    /**
+     * @brief Gets a cluster pair list.
+     *
+     * @param list The index of the list.
+     * @return A const reference to the cluster pairs of the list.
+     */
+    const std::vector<ClusterPair> &getPairs(size_t list) const;
+
+    /**
+     * @brief Gets the force buffer belonging to a cluster pair list.
+     *
+     * @param list The index of the list.
+     * @return A reference to the forces accumulated on each cluster by the pairs of the list.
+     */
+    std::vector<ClusterForces> &getForces(size_t list);
+
+    /**
+     * @brief Gets the total number of cluster pairs.
+     *
+     * @return The number of cluster pairs in all lists.
+     */
+    size_t getNumPairs() const;
+
+    /**
+     * @brief Adds the forces accumulated in all buffers to the regular particles. Ghost particles pass their forces on
+     * to the particles they mirror.
+     *
+     * @param particles The ParticleContainer of the clustered CellContainer.
+     */
+    void applyForces(ParticleContainer &particles);
+};
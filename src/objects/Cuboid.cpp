@@ -13,7 +13,7 @@
 
 #define ADD_NEIGHBOUR(cond, nv, offset)                                                                                \
     if (cond)                                                                                                          \
-        (nv).emplace_back(particles.get(ownIndex + (offset)));
+        (nv).push_back(particles.get(ownIndex + (offset)).getHandle());
 
 Cuboid::Cuboid(ParticleContainer &particles, const std::array<double, 3> &x, const std::array<size_t, 3> &N,
                const std::array<double, 3> &v, double h, double m, int type, double epsilon, double sigma, double k,
@@ -25,40 +25,43 @@ Cuboid::Cuboid(ParticleContainer &particles, const std::array<double, 3> &x, con
 
 void Cuboid::initialize(size_t dimensions) {
     SPDLOG_TRACE("Initializing Particles for Cuboid {}...", this->toString());
-    // we don't initialize with special forces
-    if (fzup == 0.0) {
-        std::array<double, 3> xyz;
-        for (size_t i = 0; i < N[2]; i++) {         // z
-            for (size_t j = 0; j < N[1]; j++) {     // y
-                for (size_t k = 0; k < N[0]; k++) { // x
-                    xyz = {x[0] + k * h, x[1] + j * h, x[2] + i * h};
-                    v = ArrayUtils::elementWisePairOp(v, maxwellBoltzmannDistributedVelocity(mean_velocity, dimensions),
-                                                      std::plus<>());
-                    particles.addParticle(xyz, v, m, type, epsilon, sigma, this->k, r_0, fzup);
-                }
-            }
-        }
-        // we deal with membrane case
-    } else {
-        std::array<double, 3> xyz;
-        for (size_t i = 0; i < N[2]; i++) {         // z
-            for (size_t j = 0; j < N[1]; j++) {     // y
-                for (size_t k = 0; k < N[0]; k++) { // x
-                    xyz = {x[0] + k * h, x[1] + j * h, x[2] + i * h};
-                    // note: velocity randomization has been disabled to allow the particles to be pulled upwards
-                    // correctly; leaving this on would result in particles being pulled to the bottom left corner and
-                    // interacting strangely with eachother...
-                    // perhaps using a different initialization strategy would work better?
-                    // type 5 means membrane for extension to mixed membrane-non_membrane simulations
-                    if (specialCase(k, j, i)) {
-                        particles.addParticle(xyz, v, m, 5, epsilon, sigma, this->k, r_0, fzup);
-                    } else {
-                        particles.addParticle(xyz, v, m, 5, epsilon, sigma, this->k, r_0, 0);
-                    }
-                }
-            }
+    // particles are generated in parallel; each one draws its velocity from a counter-based generator keyed by its
+    // handle, so the result is the same regardless of the number of threads
+    // the mass is validated here once, since errors must not be raised from inside the parallel region
+    const size_t count = N[0] * N[1] * N[2];
+    if (count > 0 && m <= 0)
+        CLIUtils::error(MASS_ERROR, "", false);
+    const bool membrane = fzup != 0.0;
+    particles.generateParticles(count, [&](size_t index, Particle &p) {
+        const size_t ix = index % N[0];          // x
+        const size_t iy = (index / N[0]) % N[1]; // y
+        const size_t iz = index / (N[0] * N[1]); // z
+        p.setX({x[0] + ix * h, x[1] + iy * h, x[2] + iz * h});
+        p.setMUnchecked(m);
+        p.setEpsilon(epsilon);
+        p.setSigma(sigma);
+        p.setK(k);
+        p.setR0(r_0);
+        if (!membrane) {
+            p.setV(ArrayUtils::elementWisePairOp(
+                v,
+                maxwellBoltzmannDistributedVelocity(mean_velocity, dimensions, p.getHandle(),
+                                                    RandomStream::INITIAL_VELOCITY),
+                std::plus<>()));
+            p.setType(type);
+            p.setFZUP(fzup);
+        } else {
+            // we deal with membrane case
+            // note: velocity randomization has been disabled to allow the particles to be pulled upwards
+            // correctly; leaving this on would result in particles being pulled to the bottom left corner and
+            // interacting strangely with eachother...
+            // perhaps using a different initialization strategy would work better?
+            // type 5 means membrane for extension to mixed membrane-non_membrane simulations
+            p.setV(v);
+            p.setType(5);
+            p.setFZUP(specialCase(ix, iy, iz) ? fzup : 0);
         }
-    }
+    });
 }
 
 void Cuboid::initializeNeighbours() {
@@ -70,8 +73,8 @@ void Cuboid::initializeNeighbours() {
     for (size_t i = 0; i < N[2]; i++) {
         for (size_t j = 0; j < N[1]; j++) {
             for (size_t k = 0; k < N[0]; k++) {
-                std::vector<std::reference_wrapper<Particle>> direct;
-                std::vector<std::reference_wrapper<Particle>> diagonal;
+                std::vector<ParticleHandle> direct;
+                std::vector<ParticleHandle> diagonal;
                 int ownIndex = startIndex + i * (N[0] * N[1]) + j * N[0] + k;
 
                 // add direct neighbours, minding edge particles
@@ -43,12 +43,23 @@ std::vector<std::array<double, 3>> Disc::getCircleCoordinates(double centerX, do
 /* documented functions start here  */
 void Disc::initialize(size_t dimensions) {
     SPDLOG_TRACE("Initializing Particles for Disc {}...", this->toString());
+    // the mass is validated here once, since errors must not be raised from inside the parallel region
     std::vector<std::array<double, 3>> positions = getCircleCoordinates(x[0], x[1], r, h);
-    for (auto &p : positions) {
-        std::array<double, 3> vel = ArrayUtils::elementWisePairOp(
-            v, maxwellBoltzmannDistributedVelocity(mean_velocity, dimensions), std::plus<>());
-        particles.addParticle(p, vel, m, type, epsilon, sigma);
-    }
+    if (!positions.empty() && m <= 0)
+        CLIUtils::error(MASS_ERROR, "", false);
+    // velocities are keyed by particle handle, so parallel generation stays reproducible
+    particles.generateParticles(positions.size(), [&](size_t index, Particle &p) {
+        p.setX(positions[index]);
+        p.setV(ArrayUtils::elementWisePairOp(v,
+                                             maxwellBoltzmannDistributedVelocity(mean_velocity, dimensions,
+                                                                                 p.getHandle(),
+                                                                                 RandomStream::INITIAL_VELOCITY),
+                                             std::plus<>()));
+        p.setMUnchecked(m);
+        p.setType(type);
+        p.setEpsilon(epsilon);
+        p.setSigma(sigma);
+    });
 }
 
 int Disc::getR() const { return r; }
@@ -1,9 +1,11 @@
 #include "FlowSimulationAnalyzer.h"
 #include "io/output/FileWriter.h"
+#include "utils/OMPWrapper.h"
 #include <fstream>
 #include <iostream>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <sys/stat.h>
 #include <vector>
 
 /* constructors */
@@ -12,53 +14,88 @@ FlowSimulationAnalyzer::FlowSimulationAnalyzer(ParticleContainer &particles) : p
 };
 FlowSimulationAnalyzer::FlowSimulationAnalyzer(ParticleContainer &particles, int binNumber, double leftWallPosX,
                                                double rightWallPosX, int n_analyzer, const std::string &dirname,
-                                               const std::string &basename)
+                                               const std::string &basename, bool accumulate)
     : particles{particles}, binNumber{binNumber}, leftWallPosX{leftWallPosX}, rightWallPosX{rightWallPosX},
-      n_analyzer{n_analyzer}, dirname{dirname}, basename{basename} {
-    SPDLOG_TRACE("Created new Analyzer - binNumber: {}, leftWallX: {}, rightWallX: {}, freq: {}, dirname: {}",
-                 binNumber, leftWallPosX, rightWallPosX, n_analyzer, dirname);
+      accumulate{accumulate}, n_analyzer{n_analyzer}, dirname{dirname}, basename{basename} {
+    SPDLOG_TRACE(
+        "Created new Analyzer - binNumber: {}, leftWallX: {}, rightWallX: {}, freq: {}, dirname: {}, accumulate: {}",
+        binNumber, leftWallPosX, rightWallPosX, n_analyzer, dirname, accumulate);
     binSize = (rightWallPosX - leftWallPosX) / binNumber;
     densities.resize(binNumber);
     velocities.resize(binNumber);
+    countSums.resize(binNumber);
+    velocitySums.resize(binNumber);
     FileWriter::initializeFolder(dirname);
 }
 
 /* functionality */
 void FlowSimulationAnalyzer::initialize(int binNumber, double leftWallPosX, double rightWallPosX, int n_analyzer,
-                                        const std::string &dirname, const std::string &basename) {
+                                        const std::string &dirname, const std::string &basename, bool accumulate) {
     this->binNumber = binNumber;
     this->leftWallPosX = leftWallPosX;
     this->rightWallPosX = rightWallPosX;
     this->n_analyzer = n_analyzer;
     this->dirname = dirname;
     this->basename = basename;
+    this->accumulate = accumulate;
 
-    SPDLOG_TRACE("Initialized Analyzer - binNumber: {}, leftWallX: {}, rightWallX: {}, freq: {}, dirname: {}",
-                 binNumber, leftWallPosX, rightWallPosX, n_analyzer, dirname);
+    SPDLOG_TRACE(
+        "Initialized Analyzer - binNumber: {}, leftWallX: {}, rightWallX: {}, freq: {}, dirname: {}, accumulate: {}",
+        binNumber, leftWallPosX, rightWallPosX, n_analyzer, dirname, accumulate);
 
     binSize = (rightWallPosX - leftWallPosX) / binNumber;
-    densities.resize(binNumber);
-    velocities.resize(binNumber);
+    densities.assign(binNumber, 0);
+    velocities.assign(binNumber, 0);
+    countSums.assign(binNumber, 0);
+    velocitySums.assign(binNumber, 0);
+    samples = 0;
+    headerWritten = false;
     FileWriter::initializeFolder(dirname);
 }
-void FlowSimulationAnalyzer::calculateDensitiesAndVelocities() {
-    double leftRange = leftWallPosX;
-    double rightRange = leftRange + binSize;
-    for (int i = 0; i < binNumber; i++) {
-        for (auto &p : particles) {
-            if (p.getX()[0] >= leftRange && p.getX()[0] < rightRange) {
-                densities[i]++;
-                velocities[i] += p.getV()[1];
+void FlowSimulationAnalyzer::sample() {
+    const double invBinSize = 1.0 / binSize;
+#pragma omp parallel
+    {
+        // each thread bins its share of the particles into a private histogram
+        std::vector<double> localCounts(binNumber, 0.0);
+        std::vector<double> localVelocities(binNumber, 0.0);
+
+#pragma omp for nowait
+        CONTAINER_LOOP(particles, it) {
+            auto &p = CONTAINER_REF(it);
+            CONTINUE_IF_INACTIVE(p);
+            SKIP_IF_WALL(p);
+
+            // bins are half-open, so particles directly at the right wall are not counted
+            const double offset = (p.getX()[0] - leftWallPosX) * invBinSize;
+            if (offset < 0 || offset >= binNumber)
+                continue;
+            const int bin = static_cast<int>(offset);
+            localCounts[bin]++;
+            localVelocities[bin] += p.getV()[1];
+        }
+
+#pragma omp critical
+        {
+            for (int i = 0; i < binNumber; i++) {
+                countSums[i] += localCounts[i];
+                velocitySums[i] += localVelocities[i];
             }
         }
-        leftRange = rightRange;
-        rightRange += binSize;
     }
+    samples++;
+}
+void FlowSimulationAnalyzer::calculateDensitiesAndVelocities() {
+    sample();
     for (int i = 0; i < binNumber; i++) {
-        if (densities[i] > 0) {
-            velocities[i] /= densities[i];
-        }
+        densities[i] = countSums[i] / samples;
+        velocities[i] = countSums[i] > 0 ? velocitySums[i] / countSums[i] : 0;
     }
+
+    // reset running sums for the next output interval
+    std::fill(countSums.begin(), countSums.end(), 0);
+    std::fill(velocitySums.begin(), velocitySums.end(), 0);
+    samples = 0;
 }
 void FlowSimulationAnalyzer::analyzeFlow(int currentStep) {
     if (n_analyzer <= 0)
@@ -66,36 +103,51 @@ void FlowSimulationAnalyzer::analyzeFlow(int currentStep) {
     if (currentStep % n_analyzer == 0) {
         calculateDensitiesAndVelocities();
         writeToCSV(currentStep);
+    } else if (accumulate) {
+        sample();
     }
 }
-int FlowSimulationAnalyzer::writeToCSV(int fileNumber) {
-    // write analysis to csv file
-    std::string filePath = dirname + "/" + basename + "_" + std::to_string(fileNumber) + ".csv";
-    std::ofstream csvFile(filePath);
+void FlowSimulationAnalyzer::restoreSamples(const double *counts, const double *velocities, int samples) {
+    std::copy(counts, counts + binNumber, countSums.begin());
+    std::copy(velocities, velocities + binNumber, velocitySums.begin());
+    this->samples = samples;
+    struct stat info;
+    headerWritten = stat(getFilePath().c_str(), &info) == 0;
+    SPDLOG_DEBUG("Restored {} analyzer samples, appending to existing file: {}", samples, headerWritten);
+}
+int FlowSimulationAnalyzer::writeToCSV(int iteration) {
+    // append analysis to csv file, truncating any leftovers from previous runs on first write
+    const std::string filePath = getFilePath();
+    std::ofstream csvFile(filePath, headerWritten ? std::ios::app : std::ios::trunc);
     if (!csvFile.is_open()) {
         SPDLOG_ERROR("Failed to create or open the file at {}", filePath);
         return EXIT_FAILURE;
     }
-    csvFile << "binNr,density,velAvg\n";
+    if (!headerWritten) {
+        csvFile << "iteration,binNr,density,velAvg\n";
+        headerWritten = true;
+    }
     for (int i = 0; i < binNumber; i++) {
-        csvFile << i << "," << densities[i] << "," << velocities[i] << "\n";
+        csvFile << iteration << "," << i << "," << densities[i] << "," << velocities[i] << "\n";
     }
 
-    // reset densities and velocities to zero
-    std::fill(densities.begin(), densities.end(), 0);
-    std::fill(velocities.begin(), velocities.end(), 0);
-
     // cleanup
-    SPDLOG_INFO("Wrote analysis to CSV file {}.", filePath);
+    SPDLOG_INFO("Appended analysis of iteration {} to CSV file {}.", iteration, filePath);
     csvFile.close();
     return EXIT_SUCCESS;
 }
+std::string FlowSimulationAnalyzer::getFilePath() const { return dirname + "/" + basename + ".csv"; }
 int FlowSimulationAnalyzer::getBinNumber() const { return binNumber; }
 double FlowSimulationAnalyzer::getLeftWallPosX() const { return leftWallPosX; }
 double FlowSimulationAnalyzer::getRightWallPosX() const { return rightWallPosX; }
 double FlowSimulationAnalyzer::getBinSize() const { return binSize; }
 int FlowSimulationAnalyzer::getFrequency() const { return n_analyzer; }
 const std::string &FlowSimulationAnalyzer::getDirname() const { return dirname; }
+const std::string &FlowSimulationAnalyzer::getBasename() const { return basename; }
+bool FlowSimulationAnalyzer::isAccumulating() const { return accumulate; }
 const std::vector<double> &FlowSimulationAnalyzer::getDensities() const { return densities; }
 const std::vector<double> &FlowSimulationAnalyzer::getVelocities() const { return velocities; }
+const std::vector<double> &FlowSimulationAnalyzer::getCountSums() const { return countSums; }
+const std::vector<double> &FlowSimulationAnalyzer::getVelocitySums() const { return velocitySums; }
+int FlowSimulationAnalyzer::getSamples() const { return samples; }
 ParticleContainer &FlowSimulationAnalyzer::getParticles() const { return particles; }
\ No newline at end of file
@@ -36,6 +36,21 @@ class FlowSimulationAnalyzer {
     /// @brief The vector corresponding to the average velocity on the y axis of the particles resided in this bin.
     std::vector<double> velocities;
 
+    /// @brief The number of particles counted in each bin since the last output, summed over all samples.
+    std::vector<double> countSums;
+
+    /// @brief The y velocities of the particles counted in each bin since the last output, summed over all samples.
+    std::vector<double> velocitySums;
+
+    /// @brief The number of samples gathered since the last output.
+    int samples{0};
+
+    /// @brief Determines whether the statistics are sampled every iteration and averaged between outputs.
+    bool accumulate{false};
+
+    /// @brief Determines whether the header of the .csv file has already been written.
+    bool headerWritten{false};
+
     /// @brief The number of simulation iterations after which to apply the Analyzer functionality (default: 1000).
     int n_analyzer{1000};
 
@@ -43,7 +58,7 @@ class FlowSimulationAnalyzer {
     std::string dirname{"statistics"};
 
     /**
-     * @brief The base name of the generated .csv files (default: "MD_csv").
+     * @brief The base name of the generated .csv file (default: "MD_csv").
      *
      * @details During initialization using an XML input, if the substring "vtk" or "xyz" is found in the base name of
      * the output files, it will automatically be replaced with "csv" and used as the base name for the .csv files.
@@ -66,12 +81,13 @@ class FlowSimulationAnalyzer {
      * @param leftWallPosX The X coordinate of the left wall of the simulation.
      * @param rightWallPosX The X coordinate of the right wall of the simulation.
      * @param n_analyzer The number of simulation iterations after which to apply the analyzer functionality.
-     * @param dirname The name of the directory containing the generated .csv files.
-     * @param basename The base name of the generated .csv files.
+     * @param dirname The name of the directory containing the generated .csv file.
+     * @param basename The base name of the generated .csv file.
+     * @param accumulate Whether to sample every iteration and average the statistics between outputs.
      */
     FlowSimulationAnalyzer(ParticleContainer &particles, int binNumber, double leftWallPosX, double rightWallPosX,
                            int n_analyzer, const std::string &dirname = "statistics",
-                           const std::string &basename = "MD_csv");
+                           const std::string &basename = "MD_csv", bool accumulate = false);
 
     /**
      * @brief Initializes the current object with the given parameters.
@@ -80,18 +96,28 @@ class FlowSimulationAnalyzer {
      * @param leftWallPosX The X coordinate of the left wall of the simulation.
      * @param rightWallPosX The X coordinate of the right wall of the simulation.
      * @param n_analyzer The number of simulation iterations after which to apply the analyzer functionality.
-     * @param dirname The name of the directory containing the generated .csv files.
-     * @param basename The base name of the generated .csv files.
+     * @param dirname The name of the directory containing the generated .csv file.
+     * @param basename The base name of the generated .csv file.
+     * @param accumulate Whether to sample every iteration and average the statistics between outputs.
      */
     void initialize(int binNumber, double leftWallPosX, double rightWallPosX, int n_analyzer,
-                    const std::string &dirname = "statistics", const std::string &basename = "MD_csv");
+                    const std::string &dirname = "statistics", const std::string &basename = "MD_csv",
+                    bool accumulate = false);
 
     /**
-     * @brief Computes the densities and average velocities of the particles resided in each bin.
+     * @brief Adds the current particle counts and y velocities of each bin to the running sums.
      *
-     * @details The function iterates over each bin and looks at each particle in order to modify the density and
-     * velocity vectors accordingly.
+     * @details The bin of each active, non-wall particle is computed directly from its x coordinate in a single
+     * parallel pass. Each thread fills its own histogram, which are merged at the end.
+     */
+    void sample();
+
+    /**
+     * @brief Computes the densities and average velocities of the particles resided in each bin.
      *
+     * @details Takes a sample of the current state and averages all samples taken since the last computation. The
+     * density of a bin is the average number of particles per sample, the velocity is the average y velocity over all
+     * particles counted in the bin. Afterwards, the running sums are reset.
      */
     void calculateDensitiesAndVelocities();
 
@@ -103,13 +129,23 @@ class FlowSimulationAnalyzer {
     void analyzeFlow(int currentStep);
 
     /**
-     * @brief Writes the gathered information from the density and velocity vectors into the corresponding .csv file as
-     * statistics based on the simulation's state.
+     * @brief Appends the gathered information from the density and velocity vectors to the .csv file as statistics
+     * based on the simulation's state.
      *
-     * @param fileNumber The iteration number to be appended to the filename.
+     * @details All outputs are stored in a single file, one row per bin and output iteration. The header is written
+     * when the file is first created during the simulation.
+     *
+     * @param iteration The current iteration, stored in the first column.
      * @return `EXIT_SUCCESS` if the file was successfully written, `EXIT_FAILURE` otherwise.
      */
-    int writeToCSV(int fileNumber);
+    int writeToCSV(int iteration);
+
+    /**
+     * @brief Gets the path of the generated .csv file.
+     *
+     * @return The path of the generated .csv file.
+     */
+    std::string getFilePath() const;
 
     /**
      * @brief Gets the bin number of the analyzer.
@@ -153,6 +189,20 @@ class FlowSimulationAnalyzer {
      */
     const std::string &getDirname() const;
 
+    /**
+     * @brief Gets the base name of the generated .csv file.
+     *
+     * @return The base name of the generated .csv file.
+     */
+    const std::string &getBasename() const;
+
+    /**
+     * @brief Checks whether the statistics are sampled every iteration and averaged between outputs.
+     *
+     * @return true if the statistics are accumulated between outputs, false otherwise.
+     */
+    bool isAccumulating() const;
+
     /**
      * @brief Gets a reference to the analyzed ParticleContainer.
      *
@@ -173,4 +223,37 @@ class FlowSimulationAnalyzer {
      * @return The const vector containing the the average velocities of the particles from each bin.
      */
     const std::vector<double> &getVelocities() const;
+
+    /**
+     * @brief Gets the running sums of the particle counts of each bin since the last output (const).
+     *
+     * @return The const vector containing the running sums of the particle counts of each bin.
+     */
+    const std::vector<double> &getCountSums() const;
+
+    /**
+     * @brief Gets the running sums of the y velocities of each bin since the last output (const).
+     *
+     * @return The const vector containing the running sums of the y velocities of each bin.
+     */
+    const std::vector<double> &getVelocitySums() const;
+
+    /**
+     * @brief Gets the number of samples taken since the last output.
+     *
+     * @return The number of samples taken since the last output.
+     */
+    int getSamples() const;
+
+    /**
+     * @brief Restores the running sums of a previous run, e.g. when resuming from a checkpoint.
+     *
+     * @details Must be called after initialize(). If the .csv file already exists, new statistics are appended to it
+     * instead of overwriting it.
+     *
+     * @param counts The running sums of the particle counts of each bin (binNumber entries).
+     * @param velocities The running sums of the y velocities of each bin (binNumber entries).
+     * @param samples The number of samples taken since the last output.
+     */
+    void restoreSamples(const double *counts, const double *velocities, int samples);
 };
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "HierarchicalGrid.h"
+#include "utils/CLIUtils.h"
+#include "utils/StringUtils.h"
+#include <cmath>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+/* building */
+void HierarchicalGrid::build(CellContainer &lc) {
+    const ParticleContainer &particles = lc.getParticles();
+    const double factor = lc.getPairCutoffFactor();
+    std::vector<GridEntry> entries;
+    entries.swap(m_entries);
+    entries.clear();
+
+    // helper function to get the cutoff radius of a single particle
+    auto getCutoff = [&](const Particle &p) {
+        if (factor == 0.0)
+            return lc.getCutoff();
+        const double cutoff = factor * p.getSigma();
+        if (cutoff > lc.getCutoff() * (1 + 1e-12))
+            CLIUtils::error("Pair cutoff radius exceeds the cutoff radius of the linked cells!",
+                            StringUtils::fromNumber(cutoff), false);
+        return cutoff;
+    };
+
+    // regular and static particles of all occupied cells
+    for (int c : lc.getOccupiedCells()) {
+        for (bool isStatic : {false, true}) {
+            for (ParticleHandle h : isStatic ? lc[c].getStaticParticles() : lc[c].getParticles()) {
+                const Particle &p = particles.resolve(h);
+                entries.push_back({p.getX(), getCutoff(p), h, isStatic, false});
+            }
+        }
+    }
+
+    // ghost particles are placed inside the halo cell as if they were there, like in the regular force calculation
+    for (int c : lc.getGhostCells()) {
+        const Cell &cell = lc[c];
+        for (bool isStatic : {false, true}) {
+            for (ParticleHandle h : isStatic ? cell.getStaticParticles() : cell.getParticles()) {
+                const Particle &p = particles.resolve(h);
+                const Cell &trueCell = lc[p.getCellIndex()];
+                entries.push_back({{cell.getX()[0] + p.getX()[0] - trueCell.getX()[0],
+                                    cell.getX()[1] + p.getX()[1] - trueCell.getX()[1],
+                                    cell.getX()[2] + p.getX()[2] - trueCell.getX()[2]},
+                                   getCutoff(p),
+                                   h,
+                                   isStatic,
+                                   true});
+            }
+        }
+    }
+    build(std::move(entries), lc.getDim(), lc.getCutoff());
+}
+
+void HierarchicalGrid::build(std::vector<GridEntry> entries, size_t dim, double cutoff) {
+    m_entries = std::move(entries);
+    m_buffer.resize(m_entries.size());
+    m_dim = dim;
+
+    // all levels share the same origin, so that a position maps to nested cells on each level
+    m_origin.fill(std::numeric_limits<double>::max());
+    for (const GridEntry &e : m_entries)
+        for (size_t d = 0; d < 3; ++d)
+            m_origin[d] = std::min(m_origin[d], e.x[d]);
+    std::array<double, 3> extent{0.0, 0.0, 0.0};
+    for (const GridEntry &e : m_entries)
+        for (size_t d = 0; d < 3; ++d)
+            extent[d] = std::max(extent[d], e.x[d] - m_origin[d]);
+
+    // only as many levels as needed by the smallest particle
+    size_t numLevels = 1;
+    for (const GridEntry &e : m_entries)
+        numLevels = std::max(numLevels, getLevel(e.cutoff, cutoff) + 1);
+    m_levels.resize(numLevels);
+
+    // sort the entries by level and cell with a single counting sort over the cells of all levels
+    std::vector<std::uint32_t> levelOffset(numLevels + 1, 0);
+    for (size_t l = 0; l < numLevels; ++l) {
+        GridLevel &grid = m_levels[l];
+        grid.cellSize = cutoff / static_cast<double>(1u << l);
+        for (size_t d = 0; d < 3; ++d)
+            grid.numCells[d] = d < m_dim ? static_cast<int>(extent[d] / grid.cellSize) + 1 : 1;
+        levelOffset[l + 1] = levelOffset[l] + grid.numCells[0] * grid.numCells[1] * grid.numCells[2];
+    }
+    auto getCell = [&](const GridEntry &e) {
+        const size_t l = getLevel(e.cutoff, cutoff);
+        const GridLevel &grid = m_levels[l];
+        std::array<int, 3> c{0, 0, 0};
+        for (size_t d = 0; d < m_dim; ++d)
+            c[d] = std::min(static_cast<int>((e.x[d] - m_origin[d]) / grid.cellSize), grid.numCells[d] - 1);
+        return levelOffset[l] + (c[2] * grid.numCells[1] + c[1]) * grid.numCells[0] + c[0];
+    };
+    std::vector<std::uint32_t> start(levelOffset[numLevels] + 1, 0);
+    for (const GridEntry &e : m_entries)
+        ++start[getCell(e) + 1];
+    for (size_t c = 1; c < start.size(); ++c)
+        start[c] += start[c - 1];
+    std::vector<std::uint32_t> next(start.begin(), start.end() - 1);
+    for (const GridEntry &e : m_entries)
+        m_buffer[next[getCell(e)]++] = e;
+    m_entries.swap(m_buffer);
+
+    for (size_t l = 0; l < numLevels; ++l) {
+        GridLevel &grid = m_levels[l];
+        grid.cellStart.assign(start.begin() + levelOffset[l], start.begin() + levelOffset[l + 1] + 1);
+        grid.begin = grid.cellStart.front();
+        grid.end = grid.cellStart.back();
+        SPDLOG_TRACE("Grid level {}: cell size {}, {} particles.", l, grid.cellSize, grid.end - grid.begin);
+    }
+}
+
+size_t HierarchicalGrid::getLevel(double cutoff, double maxCutoff) {
+    size_t level = 0;
+    while (level + 1 < HGRID_MAX_LEVELS && maxCutoff / static_cast<double>(2u << level) >= cutoff)
+        ++level;
+    return level;
+}
+
+/* getters */
+const std::vector<GridEntry> &HierarchicalGrid::getEntries() const { return m_entries; }
+const std::vector<GridLevel> &HierarchicalGrid::getLevels() const { return m_levels; }
@@ -0,0 +1,147 @@
+/**
+ * @file HierarchicalGrid.h
+ * @brief Class for finding particle neighbours in mixtures with different cutoff radii using multiple grid levels.
+ * @date 2025-02-20
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "CellContainer.h"
+#include "Particle.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// @brief The maximum number of grid levels. Level \f$ l \f$ uses cells of \f$ 2^{-l} \f$ times the cutoff radius.
+#define HGRID_MAX_LEVELS 8
+
+/// @brief A single particle stored in the grid, with the position it has from the point of view of the domain.
+struct GridEntry {
+    /// @brief The position of the particle. Ghost particles are placed inside the halo cell they were mirrored to.
+    std::array<double, 3> x;
+    /// @brief The cutoff radius of the particle with another particle of the same kind.
+    double cutoff;
+    /// @brief The handle of the particle.
+    ParticleHandle handle;
+    /// @brief Determines whether the particle is a static (wall) particle.
+    bool isStatic;
+    /// @brief Determines whether the entry is a ghost particle of a halo cell.
+    bool isGhost;
+};
+
+/// @brief A single uniform grid level, covering a contiguous range of entries sorted by cell.
+struct GridLevel {
+    /// @brief The size of the cells in each dimension.
+    double cellSize{0.0};
+    /// @brief The number of cells in each dimension.
+    std::array<int, 3> numCells{0, 0, 0};
+    /// @brief The index of the first entry of each cell, followed by the index one past the last entry of the level.
+    std::vector<std::uint32_t> cellStart;
+    /// @brief The index of the first entry of the level.
+    std::uint32_t begin{0};
+    /// @brief The index one past the last entry of the level.
+    std::uint32_t end{0};
+};
+
+/**
+ * @brief Class sorting the particles of a CellContainer into a hierarchy of uniform grids for mixtures whose species
+ * have very different cutoff radii.
+ *
+ * @details The cutoff radius of a pair is the mean of the cutoff radii of both particles, which matches the
+ * Lorentz-Berthelot rule for cutoff radii proportional to sigma. Each particle lives on the finest level whose cells
+ * are at least as large as its own cutoff radius, i.e. level \f$ l \f$ has cells of \f$ r_c / 2^l \f$. Since the cutoff
+ * radius of a pair never exceeds the larger cutoff radius of its particles, all partners of a particle on the same or a
+ * coarser level are found within the neighbouring cells of its position on that level. Pairs on the same level are
+ * therefore found like in the regular linked cell method, while pairs across levels are always visited from the
+ * particle on the finer level, so that each pair is only visited once. Small particles thus only search a small
+ * neighbourhood for other small particles instead of the volume required by the largest species.
+ *
+ * The grids are built from the contents of a CellContainer, including static and ghost particles, so that boundary
+ * conditions are still handled by the CellContainer.
+ */
+class HierarchicalGrid {
+  private:
+    /// @brief The particles, sorted by level and by cell within each level.
+    std::vector<GridEntry> m_entries;
+    /// @brief Scratch buffer used for sorting the entries.
+    std::vector<GridEntry> m_buffer;
+    /// @brief The grid levels, from coarsest to finest.
+    std::vector<GridLevel> m_levels;
+    /// @brief The lower corner of all grids.
+    std::array<double, 3> m_origin{0.0, 0.0, 0.0};
+    /// @brief The number of dimensions.
+    size_t m_dim{3};
+
+  public:
+    /**
+     * @brief Rebuilds the grids from the current contents of a CellContainer.
+     *
+     * The cutoff radius of each particle is its sigma times the pair cutoff factor of the CellContainer, or the cutoff
+     * radius of the CellContainer if the factor is 0. Terminates with an error if a particle's cutoff radius exceeds
+     * the cutoff radius of the CellContainer. Ghost particles must already have been mirrored into the halo Cells.
+     *
+     * @param lc The CellContainer whose particles should be sorted into the grids.
+     */
+    void build(CellContainer &lc);
+
+    /**
+     * @brief Rebuilds the grids from a given set of entries.
+     *
+     * @param entries The entries to be sorted into the grids.
+     * @param dim The number of dimensions, either 2 or 3.
+     * @param cutoff The maximum cutoff radius, i.e. the cell size of the coarsest level.
+     */
+    void build(std::vector<GridEntry> entries, size_t dim, double cutoff);
+
+    /**
+     * @brief Gets the level a particle with the given cutoff radius lives on.
+     *
+     * @param cutoff The cutoff radius of the particle.
+     * @param maxCutoff The maximum cutoff radius, i.e. the cell size of the coarsest level.
+     * @return The index of the finest level whose cells are at least as large as the cutoff radius.
+     */
+    static size_t getLevel(double cutoff, double maxCutoff);
+
+    /**
+     * @brief Calls a function for the entries of all cells surrounding a position on a level, including the cell
+     * containing the position itself. Neighbouring cells along the x-axis are contiguous and passed as a single range.
+     *
+     * @tparam F The type of the function, taking the first and one past the last index of a range of entries.
+     * @param level The index of the level.
+     * @param x The position.
+     * @param f The function to be called.
+     */
+    template <typename F> void forEachNeighborCell(size_t level, const std::array<double, 3> &x, F f) const {
+        const GridLevel &grid = m_levels[level];
+        if (grid.begin == grid.end)
+            return;
+        std::array<int, 3> lo{0, 0, 0}, hi{0, 0, 0};
+        for (size_t d = 0; d < m_dim; ++d) {
+            const int c = static_cast<int>((x[d] - m_origin[d]) / grid.cellSize);
+            lo[d] = std::max(c - 1, 0);
+            hi[d] = std::min(c + 1, grid.numCells[d] - 1);
+        }
+        for (int z = lo[2]; z <= hi[2]; ++z) {
+            for (int y = lo[1]; y <= hi[1]; ++y) {
+                const int row = (z * grid.numCells[1] + y) * grid.numCells[0];
+                f(grid.cellStart[row + lo[0]], grid.cellStart[row + hi[0] + 1]);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the entries, sorted by level and by cell within each level.
+     *
+     * @return A const reference to the entries.
+     */
+    const std::vector<GridEntry> &getEntries() const;
+
+    /**
+     * @brief Gets the grid levels.
+     *
+     * @return A const reference to the levels, from coarsest to finest.
+     */
+    const std::vector<GridLevel> &getLevels() const;
+};
@@ -0,0 +1,163 @@
+#include "Octree.h"
+#include <algorithm>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+// helper function to get the squared distance between the bounding boxes of two nodes
+static inline double boxDistanceSquared(const OctreeNode &a, const OctreeNode &b) {
+    double dist = 0.0;
+    for (size_t d = 0; d < 3; ++d) {
+        const double gap = std::max({0.0, b.boxMin[d] - a.boxMax[d], a.boxMin[d] - b.boxMax[d]});
+        dist += gap * gap;
+    }
+    return dist;
+}
+
+/* building */
+void Octree::computeBox(std::uint32_t node) {
+    OctreeNode &n = m_nodes[node];
+    n.boxMin.fill(std::numeric_limits<double>::max());
+    n.boxMax.fill(std::numeric_limits<double>::lowest());
+    for (std::uint32_t e = n.begin; e < n.end; ++e) {
+        for (size_t d = 0; d < 3; ++d) {
+            n.boxMin[d] = std::min(n.boxMin[d], m_entries[e].x[d]);
+            n.boxMax[d] = std::max(n.boxMax[d], m_entries[e].x[d]);
+        }
+    }
+}
+
+void Octree::split(std::uint32_t node, int depth) {
+    const std::uint32_t begin = m_nodes[node].begin;
+    const std::uint32_t end = m_nodes[node].end;
+    if (end - begin <= OCTREE_LEAF_CAPACITY || depth >= OCTREE_MAX_DEPTH) {
+        m_leaves.push_back(node);
+        return;
+    }
+
+    // sort the entries into the octants around the center of the bounding box (counting sort)
+    std::array<double, 3> center;
+    for (size_t d = 0; d < 3; ++d)
+        center[d] = (m_nodes[node].boxMin[d] + m_nodes[node].boxMax[d]) / 2;
+    auto octant = [&](const OctreeEntry &e) {
+        size_t o = 0;
+        for (size_t d = 0; d < m_dim; ++d)
+            o |= static_cast<size_t>(e.x[d] > center[d]) << d;
+        return o;
+    };
+    std::array<std::uint32_t, 9> offsets{};
+    for (std::uint32_t e = begin; e < end; ++e)
+        ++offsets[octant(m_entries[e]) + 1];
+    for (size_t o = 1; o < offsets.size(); ++o)
+        offsets[o] += offsets[o - 1];
+    const std::array<std::uint32_t, 9> bounds = offsets;
+    for (std::uint32_t e = begin; e < end; ++e)
+        m_buffer[begin + offsets[octant(m_entries[e])]++] = m_entries[e];
+    std::copy(m_buffer.begin() + begin, m_buffer.begin() + end, m_entries.begin() + begin);
+
+    // with a tight bounding box, all entries only end up in the same octant if they share a single position along
+    // each split axis; nothing left to split
+    const size_t numOctants = size_t{1} << m_dim;
+    for (size_t o = 0; o < numOctants; ++o) {
+        if (bounds[o + 1] - bounds[o] == end - begin) {
+            m_leaves.push_back(node);
+            return;
+        }
+    }
+
+    // create the non-empty children next to each other, then split them
+    const auto firstChild = static_cast<std::uint32_t>(m_nodes.size());
+    for (size_t o = 0; o < numOctants; ++o) {
+        if (bounds[o] == bounds[o + 1])
+            continue;
+        OctreeNode child;
+        child.begin = begin + bounds[o];
+        child.end = begin + bounds[o + 1];
+        m_nodes.push_back(child);
+        computeBox(static_cast<std::uint32_t>(m_nodes.size() - 1));
+    }
+    m_nodes[node].firstChild = firstChild;
+    m_nodes[node].numChildren = static_cast<std::uint8_t>(m_nodes.size() - firstChild);
+    for (std::uint32_t child = firstChild; child < firstChild + m_nodes[node].numChildren; ++child)
+        split(child, depth + 1);
+}
+
+void Octree::build(CellContainer &lc) {
+    const ParticleContainer &particles = lc.getParticles();
+    std::vector<OctreeEntry> entries;
+    entries.swap(m_entries);
+    entries.clear();
+
+    // regular and static particles of all occupied cells
+    for (int c : lc.getOccupiedCells()) {
+        for (ParticleHandle h : lc[c].getParticles())
+            entries.push_back({particles.resolve(h).getX(), h, false, false});
+        for (ParticleHandle h : lc[c].getStaticParticles())
+            entries.push_back({particles.resolve(h).getX(), h, true, false});
+    }
+
+    // ghost particles are placed inside the halo cell as if they were there, like in the regular force calculation
+    for (int c : lc.getGhostCells()) {
+        const Cell &cell = lc[c];
+        for (bool isStatic : {false, true}) {
+            for (ParticleHandle h : isStatic ? cell.getStaticParticles() : cell.getParticles()) {
+                const Particle &p = particles.resolve(h);
+                const Cell &trueCell = lc[p.getCellIndex()];
+                entries.push_back({{cell.getX()[0] + p.getX()[0] - trueCell.getX()[0],
+                                    cell.getX()[1] + p.getX()[1] - trueCell.getX()[1],
+                                    cell.getX()[2] + p.getX()[2] - trueCell.getX()[2]},
+                                   h,
+                                   isStatic,
+                                   true});
+            }
+        }
+    }
+    build(std::move(entries), lc.getDim());
+}
+
+void Octree::build(std::vector<OctreeEntry> entries, size_t dim) {
+    m_entries = std::move(entries);
+    m_buffer.resize(m_entries.size());
+    m_nodes.clear();
+    m_leaves.clear();
+    m_dim = dim;
+
+    OctreeNode root;
+    root.begin = 0;
+    root.end = static_cast<std::uint32_t>(m_entries.size());
+    m_nodes.push_back(root);
+    computeBox(0);
+    split(0, 0);
+    SPDLOG_TRACE("Built octree with {} entries, {} nodes and {} leaves.", m_entries.size(), m_nodes.size(),
+                 m_leaves.size());
+}
+
+/* queries */
+void Octree::getNeighborLeaves(std::uint32_t node, double cutoff, std::vector<std::uint32_t> &leaves) const {
+    leaves.clear();
+    if (m_entries.empty())
+        return;
+
+    // depth-first traversal, skipping all subtrees whose bounding boxes are too far away
+    const OctreeNode &target = m_nodes[node];
+    const double cutoffSquared = cutoff * cutoff;
+    std::array<std::uint32_t, OCTREE_MAX_DEPTH * 8 + 1> stack;
+    size_t size = 0;
+    stack[size++] = 0;
+    while (size > 0) {
+        const std::uint32_t index = stack[--size];
+        const OctreeNode &current = m_nodes[index];
+        if (boxDistanceSquared(target, current) > cutoffSquared)
+            continue;
+        if (current.numChildren == 0) {
+            leaves.push_back(index);
+            continue;
+        }
+        for (std::uint32_t child = current.firstChild; child < current.firstChild + current.numChildren; ++child)
+            stack[size++] = child;
+    }
+}
+
+/* getters */
+const std::vector<OctreeEntry> &Octree::getEntries() const { return m_entries; }
+const std::vector<OctreeNode> &Octree::getNodes() const { return m_nodes; }
+const std::vector<std::uint32_t> &Octree::getLeaves() const { return m_leaves; }
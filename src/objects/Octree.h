@@ -0,0 +1,139 @@
+/**
+ * @file Octree.h
+ * @brief Class for finding particle neighbours using an adaptive octree (or quadtree in 2D).
+ * @date 2025-02-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "CellContainer.h"
+#include "Particle.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// @brief The maximum number of particles in a leaf of the tree, unless it cannot be split any further.
+#define OCTREE_LEAF_CAPACITY 16
+/// @brief The maximum depth of the tree, preventing endless splitting of particles at (nearly) identical positions.
+#define OCTREE_MAX_DEPTH 20
+
+/// @brief A single particle stored in the tree, with the position it has from the point of view of the domain.
+struct OctreeEntry {
+    /// @brief The position of the particle. Ghost particles are placed inside the halo cell they were mirrored to.
+    std::array<double, 3> x;
+    /// @brief The handle of the particle.
+    ParticleHandle handle;
+    /// @brief Determines whether the particle is a static (wall) particle.
+    bool isStatic;
+    /// @brief Determines whether the entry is a ghost particle of a halo cell.
+    bool isGhost;
+};
+
+/// @brief A node of the tree, covering a contiguous range of entries.
+struct OctreeNode {
+    /// @brief The lower corner of the bounding box of the node's particles.
+    std::array<double, 3> boxMin;
+    /// @brief The upper corner of the bounding box of the node's particles.
+    std::array<double, 3> boxMax;
+    /// @brief The index of the first entry of the node.
+    std::uint32_t begin;
+    /// @brief The index one past the last entry of the node.
+    std::uint32_t end;
+    /// @brief The index of the first child node, whose siblings follow directly. Only valid for inner nodes.
+    std::uint32_t firstChild{0};
+    /// @brief The number of (non-empty) children, 0 for leaves.
+    std::uint8_t numChildren{0};
+};
+
+/**
+ * @brief Class sorting the particles of a CellContainer into an adaptive octree (quadtree in 2D) for neighbour
+ * searches.
+ *
+ * @details Nodes are split into up to \f$ 2^d \f$ children around the center of their bounding box until they contain
+ * at most OCTREE_LEAF_CAPACITY particles. Contrary to the uniform grid of the CellContainer, the leaves follow the
+ * particle density: dense regions such as droplets are split finely, while nearly empty regions are covered by a few
+ * large leaves. All leaves within the cutoff radius of a leaf are found by descending from the root and pruning nodes
+ * whose bounding boxes are too far away.
+ *
+ * The tree is built from the contents of a CellContainer, including static and ghost particles, so that boundary
+ * conditions are still handled by the CellContainer. The entries are stored in tree order, so that the particles of
+ * each node are contiguous in memory.
+ */
+class Octree {
+  private:
+    /// @brief The particles, sorted so that each node covers a contiguous range.
+    std::vector<OctreeEntry> m_entries;
+    /// @brief Scratch buffer used for sorting the entries of a node into its children.
+    std::vector<OctreeEntry> m_buffer;
+    /// @brief The nodes of the tree. The root is the first node.
+    std::vector<OctreeNode> m_nodes;
+    /// @brief The indices of all leaves.
+    std::vector<std::uint32_t> m_leaves;
+    /// @brief The number of dimensions the tree is split in.
+    size_t m_dim{3};
+
+    /**
+     * @brief Computes the bounding box of a node from its entries.
+     *
+     * @param node The index of the node.
+     */
+    void computeBox(std::uint32_t node);
+
+    /**
+     * @brief Recursively splits a node until all leaves contain at most OCTREE_LEAF_CAPACITY entries.
+     *
+     * @param node The index of the node.
+     * @param depth The depth of the node.
+     */
+    void split(std::uint32_t node, int depth);
+
+  public:
+    /**
+     * @brief Rebuilds the tree from the current contents of a CellContainer.
+     *
+     * Ghost particles must already have been mirrored into the halo Cells if they should be part of the tree.
+     *
+     * @param lc The CellContainer whose particles should be sorted into the tree.
+     */
+    void build(CellContainer &lc);
+
+    /**
+     * @brief Rebuilds the tree from a given set of entries.
+     *
+     * @param entries The entries to be sorted into the tree.
+     * @param dim The number of dimensions, either 2 or 3.
+     */
+    void build(std::vector<OctreeEntry> entries, size_t dim);
+
+    /**
+     * @brief Gets all leaves whose bounding boxes are within a given distance of the bounding box of a node, including
+     * the node itself.
+     *
+     * @param node The index of the node.
+     * @param cutoff The maximum distance.
+     * @param leaves The vector the indices of the leaves are written to. Previous contents are discarded.
+     */
+    void getNeighborLeaves(std::uint32_t node, double cutoff, std::vector<std::uint32_t> &leaves) const;
+
+    /**
+     * @brief Gets the entries in tree order.
+     *
+     * @return A const reference to the entries.
+     */
+    const std::vector<OctreeEntry> &getEntries() const;
+
+    /**
+     * @brief Gets the nodes of the tree.
+     *
+     * @return A const reference to the nodes. The root is the first node.
+     */
+    const std::vector<OctreeNode> &getNodes() const;
+
+    /**
+     * @brief Gets the indices of all leaves.
+     *
+     * @return A const reference to the indices of the leaves.
+     */
+    const std::vector<std::uint32_t> &getLeaves() const;
+};
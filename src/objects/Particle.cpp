@@ -23,8 +23,10 @@ Particle::Particle(int type_arg)
 }
 
 Particle::Particle(const Particle &other)
-    : x{other.x}, v{other.v}, f{other.f}, old_f{other.old_f}, m{other.m}, type{other.type}, epsilon{other.epsilon},
-      sigma{other.sigma}, k{other.k}, r_0{other.r_0}, fzup{other.fzup}, cellIndex{other.cellIndex}, id{ids++} {
+    : x{other.x}, v{other.v}, f{other.f}, old_f{other.old_f}, direct_neighbours{other.direct_neighbours},
+      diagonal_neighbours{other.diagonal_neighbours}, m{other.m}, type{other.type}, epsilon{other.epsilon},
+      sigma{other.sigma}, k{other.k}, r_0{other.r_0}, fzup{other.fzup}, cellIndex{other.cellIndex},
+      active{other.active}, id{ids++}, handle{other.handle} {
     SPDLOG_TRACE("Generated Particle {} (copy) - x: {}, v: {}, f: {}, m: {}, eps: {}, sigma: {}, k: {}, r_0: {}, "
                  "f_z-up: {}, cellIndex: {}",
                  id, ArrayUtils::to_string(x), ArrayUtils::to_string(v), ArrayUtils::to_string(f), m, epsilon, sigma, k,
@@ -78,10 +80,8 @@ void Particle::setThermalMotion(const std::array<double, 3> &new_thermal_motion)
 void Particle::setF(const std::array<double, 3> &new_f) { f = new_f; }
 void Particle::setOldF(const std::array<double, 3> &new_old_f) { old_f = new_old_f; }
 void Particle::setFToZero() { std::fill(std::begin(f), std::end(f), 0); }
-void Particle::setDirectNeighbours(const std::vector<std::reference_wrapper<Particle>> &neighbours) {
-    direct_neighbours = neighbours;
-}
-void Particle::setDiagonalNeighbours(const std::vector<std::reference_wrapper<Particle>> &neighbours) {
+void Particle::setDirectNeighbours(const std::vector<ParticleHandle> &neighbours) { direct_neighbours = neighbours; }
+void Particle::setDiagonalNeighbours(const std::vector<ParticleHandle> &neighbours) {
     diagonal_neighbours = neighbours;
 }
 void Particle::setM(double new_m) {
@@ -89,6 +89,7 @@ void Particle::setM(double new_m) {
         CLIUtils::error(MASS_ERROR, "", false);
     m = new_m;
 }
+void Particle::setMUnchecked(double new_m) { m = new_m; }
 void Particle::setType(double new_type) { type = new_type; }
 void Particle::setEpsilon(double new_eps) { epsilon = new_eps; }
 void Particle::setK(double new_k) { k = new_k; }
@@ -96,6 +97,7 @@ void Particle::setR0(double new_r_0) { r_0 = new_r_0; }
 void Particle::setSigma(double new_sigma) { sigma = new_sigma; }
 void Particle::setFZUP(double new_fzup) { fzup = new_fzup; }
 void Particle::setCellIndex(int new_index) { cellIndex = new_index; }
+void Particle::setHandle(ParticleHandle new_handle) { handle = new_handle; }
 void Particle::markInactive() {
     SPDLOG_TRACE("Marking particle {} as inactive...", this->toString());
     v = {0, 0, 0};
@@ -12,6 +12,8 @@
 
 #include "utils/OMPWrapper.h"
 #include <array>
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -23,19 +25,33 @@
 #define FZUP_DEFAULT 0
 #define MASS_ERROR "The mass of a particle must be positive for the currently available simulations!"
 
+/**
+ * @brief Stable 32-bit handle addressing a Particle inside a ParticleContainer.
+ *
+ * Unlike references or pointers, handles stay valid when the underlying storage grows, is reordered or is compacted.
+ * They are resolved to the current Particle via ParticleContainer::resolve().
+ */
+using ParticleHandle = std::uint32_t;
+
+/// @brief Handle value of a Particle which does not (yet) belong to any ParticleContainer.
+inline constexpr ParticleHandle INVALID_HANDLE = std::numeric_limits<ParticleHandle>::max();
+
 // note: because these are macros, they could also be wrapped in such a way that compiles them out if not needed,
 // similarly to what is done below with outflow condition checks; but, since this is not part of any
 // performance evaluation environment (see older commit), these are left on by default...
 
+/// @brief Checks if the particle is a wall particle (if the type is 1). Wall particles never move.
+#define IS_WALL(_p) ((_p).getType() == 1)
+
 /// @brief Executes a piece of code if the particle is not a wall particle (if the type is not 1).
 #define DO_IF_NOT_WALL(_p, _expr)                                                                                      \
-    if ((_p).getType() != 1) {                                                                                         \
+    if (!IS_WALL(_p)) {                                                                                                \
         _expr;                                                                                                         \
     }
 
 /// @brief Executes a piece of code if the particle is a wall particle (if the type is 1).
 #define SKIP_IF_WALL(_p)                                                                                               \
-    if ((_p).getType() == 1)                                                                                           \
+    if (IS_WALL(_p))                                                                                                   \
         continue;
 
 #ifdef NOUTFLOW
@@ -66,11 +82,11 @@ class Particle {
     /// @brief Force \f$ F_\text{old} \f$ which was effective on this particle.
     std::array<double, 3> old_f;
 
-    /// @brief Direct (up-down, left-right) neighbours of the particle (for membranes).
-    std::vector<std::reference_wrapper<Particle>> direct_neighbours;
+    /// @brief Handles of the direct (up-down, left-right) neighbours of the particle (for membranes).
+    std::vector<ParticleHandle> direct_neighbours;
 
-    /// @brief Diagonal neighbours of the particle (for membranes).
-    std::vector<std::reference_wrapper<Particle>> diagonal_neighbours;
+    /// @brief Handles of the diagonal neighbours of the particle (for membranes).
+    std::vector<ParticleHandle> diagonal_neighbours;
 
     /// @brief Mass \f$ m \f$ of this particle.
     double m;
@@ -111,6 +127,9 @@ class Particle {
     /// @brief A unique ID for this particle. Currently only used for debug purposes.
     int id;
 
+    /// @brief The stable handle of this particle inside its ParticleContainer (INVALID_HANDLE if not yet added).
+    ParticleHandle handle{INVALID_HANDLE};
+
   public:
     /**
      * @brief Construct a new Particle object by optionally passing its type. Prevents implicit conversions.
@@ -205,34 +224,30 @@ class Particle {
     /**
      * @brief Gets the direct neighbours of this particle.
      *
-     * @return A reference to the vector of direct neighbour particle references of this particle.
+     * @return A reference to the vector of direct neighbour particle handles of this particle.
      */
-    inline std::vector<std::reference_wrapper<Particle>> &getDirectNeighbours() { return direct_neighbours; }
+    inline std::vector<ParticleHandle> &getDirectNeighbours() { return direct_neighbours; }
 
     /**
      * @brief Gets the direct neighbours of this particle (const).
      *
-     * @return A const reference to the vector of direct neighbour particle references of this particle.
+     * @return A const reference to the vector of direct neighbour particle handles of this particle.
      */
-    inline const std::vector<std::reference_wrapper<Particle>> &getDirectNeighbours() const {
-        return direct_neighbours;
-    }
+    inline const std::vector<ParticleHandle> &getDirectNeighbours() const { return direct_neighbours; }
 
     /**
      * @brief Gets the diagonal neighbours of this particle.
      *
-     * @return A reference to the vector of diagonal neighbour particle references of this particle.
+     * @return A reference to the vector of diagonal neighbour particle handles of this particle.
      */
-    inline std::vector<std::reference_wrapper<Particle>> &getDiagonalNeighbours() { return diagonal_neighbours; }
+    inline std::vector<ParticleHandle> &getDiagonalNeighbours() { return diagonal_neighbours; }
 
     /**
      * @brief Gets the diagonal neighbours of this particle (const).
      *
-     * @return A const reference to the vector of diagonal neighbour particle references of this particle.
+     * @return A const reference to the vector of diagonal neighbour particle handles of this particle.
      */
-    inline const std::vector<std::reference_wrapper<Particle>> &getDiagonalNeighbours() const {
-        return diagonal_neighbours;
-    }
+    inline const std::vector<ParticleHandle> &getDiagonalNeighbours() const { return diagonal_neighbours; }
 
     /**
      * @brief Gets the position \f$ x \f$ of this particle (const).
@@ -344,6 +359,13 @@ class Particle {
      */
     inline int getId() const { return id; }
 
+    /**
+     * @brief Get the stable handle of this particle inside its ParticleContainer.
+     *
+     * @return The handle of this particle, or INVALID_HANDLE if it has not been added to a container.
+     */
+    inline ParticleHandle getHandle() const { return handle; }
+
     /**
      * @brief Get a reference to the Lock object.
      *
@@ -368,16 +390,16 @@ class Particle {
     /**
      * @brief Sets the direct neighbours of the particle.
      *
-     * @param neighbours A reference to the vector of references to the neighbours.
+     * @param neighbours A reference to the vector of handles of the neighbours.
      */
-    void setDirectNeighbours(const std::vector<std::reference_wrapper<Particle>> &neighbours);
+    void setDirectNeighbours(const std::vector<ParticleHandle> &neighbours);
 
     /**
      * @brief Sets the diagonal neighbours of the particle.
      *
-     * @param neighbours A reference to the vector of references to the neighbours.
+     * @param neighbours A reference to the vector of handles of the neighbours.
      */
-    void setDiagonalNeighbours(const std::vector<std::reference_wrapper<Particle>> &neighbours);
+    void setDiagonalNeighbours(const std::vector<ParticleHandle> &neighbours);
 
     /**
      * @brief Sets the new thermal motion \f$ \hat v \f$ of the particle to a given value.
@@ -413,6 +435,16 @@ class Particle {
      */
     void setM(double new_m);
 
+    /**
+     * @brief Sets the new mass \f$ m \f$ of the particle without validating it.
+     *
+     * Meant for bulk generation inside parallel regions, where the mass has already been validated once beforehand and
+     * exiting from a worker thread must be avoided.
+     *
+     * @param new_m The new (positive) mass of this particle.
+     */
+    void setMUnchecked(double new_m);
+
     /**
      * @brief Sets the new type of the particle to a given value.
      *
@@ -464,6 +496,13 @@ class Particle {
      */
     void setCellIndex(int new_index);
 
+    /**
+     * @brief Sets the stable handle of this particle. Should only be called by the owning ParticleContainer.
+     *
+     * @param new_handle The new handle of this particle.
+     */
+    void setHandle(ParticleHandle new_handle);
+
     /// @brief Sets the Particle's active status to "inactive".
     void markInactive();
 
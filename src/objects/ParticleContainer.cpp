@@ -11,6 +11,7 @@
 ParticleContainer::ParticleContainer() { SPDLOG_TRACE("Generated ParticleContainer (empty)."); }
 ParticleContainer::ParticleContainer(size_t numParticles) {
     m_particles.reserve(numParticles);
+    m_slots.reserve(numParticles);
     SPDLOG_TRACE("Generated ParticleContainer with {} spaces.", numParticles);
 }
 ParticleContainer::~ParticleContainer() { SPDLOG_TRACE("Destroyed ParticleContainer."); }
@@ -65,24 +66,51 @@ ParticleContainer::PairIterator ParticleContainer::endPairs() {
 /* container functions */
 Particle &ParticleContainer::operator[](size_t index) { return m_particles[index]; }
 const Particle &ParticleContainer::operator[](size_t index) const { return m_particles[index]; }
-void ParticleContainer::addParticle(const Particle &particle) {
+ParticleHandle ParticleContainer::registerLast() {
+    if (m_slots.size() >= INVALID_HANDLE)
+        CLIUtils::error("Too many particles for 32-bit particle handles", StringUtils::fromNumber(m_slots.size()),
+                        false);
+    ParticleHandle handle = static_cast<ParticleHandle>(m_slots.size());
+    m_slots.push_back(static_cast<ParticleHandle>(m_particles.size() - 1));
+    m_particles.back().setHandle(handle);
+    return handle;
+}
+ParticleHandle ParticleContainer::addParticle(const Particle &particle) {
     m_particles.push_back(particle);
     SPDLOG_TRACE("Added Particle to ParticleContainer - {}", particle.toString());
+    return registerLast();
 }
-void ParticleContainer::addParticle(const std::array<double, 3> &x, const std::array<double, 3> &v, double m, int type,
-                                    double eps, double sigma, double k, double r_0, double fzup) {
+ParticleHandle ParticleContainer::addParticle(const std::array<double, 3> &x, const std::array<double, 3> &v, double m,
+                                              int type, double eps, double sigma, double k, double r_0, double fzup) {
     m_particles.emplace_back(x, v, m, type, eps, sigma, k, r_0, fzup);
     SPDLOG_TRACE("Created and added Particle to ParticleContainer - {}", m_particles.back().toString());
+    return registerLast();
 }
-void ParticleContainer::addParticle(const std::array<double, 3> &x, const std::array<double, 3> &v,
-                                    const std::array<double, 3> &f, const std::array<double, 3> &old_f, double m,
-                                    int type, double eps, double sigma, double k, double r_0, double fzup,
-                                    int cellIndex) {
+ParticleHandle ParticleContainer::addParticle(const std::array<double, 3> &x, const std::array<double, 3> &v,
+                                              const std::array<double, 3> &f, const std::array<double, 3> &old_f,
+                                              double m, int type, double eps, double sigma, double k, double r_0,
+                                              double fzup, int cellIndex) {
     m_particles.emplace_back(x, v, f, old_f, m, type, eps, sigma, k, r_0, fzup, cellIndex);
     SPDLOG_TRACE("Created and added Particle to ParticleContainer - {}", m_particles.back().toString());
+    return registerLast();
+}
+size_t ParticleContainer::appendDefaultParticles(size_t count) {
+    const size_t first = m_particles.size();
+    if (m_slots.size() + count >= INVALID_HANDLE)
+        CLIUtils::error("Too many particles for 32-bit particle handles",
+                        StringUtils::fromNumber(m_slots.size() + count), false);
+    m_particles.resize(first + count);
+    m_slots.reserve(m_slots.size() + count);
+    for (size_t i = first; i < m_particles.size(); ++i) {
+        m_particles[i].setHandle(static_cast<ParticleHandle>(m_slots.size()));
+        m_slots.push_back(static_cast<ParticleHandle>(i));
+    }
+    SPDLOG_TRACE("Appended {} default particles to ParticleContainer", count);
+    return first;
 }
 void ParticleContainer::reserve(size_t capacity) {
     m_particles.reserve(capacity);
+    m_slots.reserve(capacity);
     SPDLOG_TRACE("Reserved {} spaces for ParticleContainer", capacity);
 }
 Particle &ParticleContainer::get(size_t index) {
@@ -95,10 +123,32 @@ const Particle &ParticleContainer::get(size_t index) const {
         CLIUtils::error("Index out of bounds for ParticleContainer", StringUtils::fromNumber(index), false);
     return m_particles[index];
 }
+size_t ParticleContainer::indexOf(ParticleHandle handle) const {
+    return handle < m_slots.size() ? m_slots[handle] : INVALID_HANDLE;
+}
+bool ParticleContainer::isValid(ParticleHandle handle) const {
+    return handle < m_slots.size() && m_slots[handle] != INVALID_HANDLE;
+}
+void ParticleContainer::removeInactiveParticles() {
+    // rebuild the storage instead of erasing in place, since particles are not assignable (locks)
+    ContainerType compacted;
+    compacted.reserve(activeSize());
+    for (const Particle &p : m_particles) {
+        if (p.isActive()) {
+            m_slots[p.getHandle()] = static_cast<ParticleHandle>(compacted.size());
+            compacted.push_back(p);
+        } else {
+            m_slots[p.getHandle()] = INVALID_HANDLE;
+        }
+    }
+    SPDLOG_DEBUG("Compacted ParticleContainer from {} to {} particles.", m_particles.size(), compacted.size());
+    m_particles.swap(compacted);
+}
 int ParticleContainer::getSpecialForceLimit() const { return m_specialForceLimit; }
 void ParticleContainer::setSpecialForceLimit(int limit) { m_specialForceLimit = limit; }
 void ParticleContainer::decrementSpecialForceLimit() { --m_specialForceLimit; }
 size_t ParticleContainer::size() const { return m_particles.size(); }
+size_t ParticleContainer::capacity() const { return m_particles.capacity(); }
 size_t ParticleContainer::activeSize() const {
     return std::count_if(m_particles.begin(), m_particles.end(), [](const Particle &p) { return p.isActive(); });
 }
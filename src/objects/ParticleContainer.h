@@ -22,10 +22,29 @@ class ParticleContainer {
     /// @brief A ContainerType storing multiple Particle objects, forming the base of this class.
     ContainerType m_particles;
 
+    /// @brief Slot map translating each ParticleHandle into the current position of its Particle in m_particles.
+    /// Removed particles keep their slot, which is set to INVALID_HANDLE.
+    std::vector<ParticleHandle> m_slots;
+
     /// @brief The number of iterations after which the special upward force will no longer be applied, for membrane
     /// simulations.
     int m_specialForceLimit;
 
+    /**
+     * @brief Assigns a new handle to the most recently added Particle and registers it in the slot map.
+     *
+     * @return The handle of the most recently added Particle.
+     */
+    ParticleHandle registerLast();
+
+    /**
+     * @brief Appends the given number of default-constructed Particle objects and registers their handles.
+     *
+     * @param count The number of Particle objects to append.
+     * @return The index of the first appended Particle.
+     */
+    size_t appendDefaultParticles(size_t count);
+
     /* iterator definitions */
   public:
     /// @brief Standard library iterator function for marking the beginning of the iteration process.
@@ -156,8 +175,9 @@ class ParticleContainer {
      * @brief Adds an already existing Particle to the container.
      *
      * @param particle The Particle to be added to m_particles.
+     * @return The stable handle of the added Particle.
      */
-    void addParticle(const Particle &particle);
+    ParticleHandle addParticle(const Particle &particle);
 
     /**
      * @brief Creates and adds a new particle to the container.
@@ -171,10 +191,11 @@ class ParticleContainer {
      * @param k The stiffness constant \f$ k \f$, used for membrane simulations.
      * @param r_0 The average bond length \f$ r_0 \f$, used for membrane simulations.
      * @param fzup The constant upward force \f$ F_{Z-UP} \f$, used for membrane simulations.
+     * @return The stable handle of the added Particle.
      */
-    void addParticle(const std::array<double, 3> &x, const std::array<double, 3> &v, double m, int type = TYPE_DEFAULT,
-                     double eps = EPSILON_DEFAULT, double sigma = SIGMA_DEFAULT, double k = K_DEFAULT,
-                     double r_0 = R0_DEFAULT, double fzup = FZUP_DEFAULT);
+    ParticleHandle addParticle(const std::array<double, 3> &x, const std::array<double, 3> &v, double m,
+                               int type = TYPE_DEFAULT, double eps = EPSILON_DEFAULT, double sigma = SIGMA_DEFAULT,
+                               double k = K_DEFAULT, double r_0 = R0_DEFAULT, double fzup = FZUP_DEFAULT);
 
     /**
      * @brief Creates and adds a new complete particle to the container.
@@ -192,10 +213,11 @@ class ParticleContainer {
      * @param fzup The constant upward force \f$ F_{Z-UP} \f$, used for membrane simulations.
 
      * @param cellIndex The index of this particle inside a cell. For use with the linked cell method.
+     * @return The stable handle of the added Particle.
      */
-    void addParticle(const std::array<double, 3> &x, const std::array<double, 3> &v, const std::array<double, 3> &f,
-                     const std::array<double, 3> &old_f, double m, int type, double eps, double sigma, double k,
-                     double r_0, double fzup, int cellIndex);
+    ParticleHandle addParticle(const std::array<double, 3> &x, const std::array<double, 3> &v,
+                               const std::array<double, 3> &f, const std::array<double, 3> &old_f, double m, int type,
+                               double eps, double sigma, double k, double r_0, double fzup, int cellIndex);
 
     /**
      * @brief Reserves a certain amount of spaces inside the Particle vector.
@@ -204,6 +226,27 @@ class ParticleContainer {
      */
     void reserve(size_t capacity);
 
+    /**
+     * @brief Appends the given number of particles and initializes them in parallel.
+     *
+     * The storage is sized once up front; afterwards, the generator is called exactly once for every new particle,
+     * potentially from multiple threads. It must therefore only modify the particle it is given. Handles are assigned
+     * before the generator runs, so they can be used as thread-count independent keys for random number generation.
+     * The generator must not report errors (e.g. through validating setters such as Particle::setM()), since it runs
+     * inside a parallel region; its inputs should be validated before calling this function.
+     *
+     * @tparam Generator A callable with the signature void(size_t, Particle &).
+     * @param count The number of particles to add.
+     * @param generator Called with the index of the new particle relative to the first added one and the particle.
+     */
+    template <typename Generator> void generateParticles(size_t count, Generator generator) {
+        const size_t first = appendDefaultParticles(count);
+#pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < count; ++i) {
+            generator(i, m_particles[first + i]);
+        }
+    }
+
     /**
      * @brief Gets a Particle by index. Performs bounds checking and terminates on invalid index.
      *
@@ -220,6 +263,47 @@ class ParticleContainer {
      */
     const Particle &get(size_t index) const;
 
+    /**
+     * @brief Gets a Particle by its stable handle. Does NOT perform validity checking.
+     *
+     * @param handle The handle of the Particle to get.
+     * @return A reference to the Particle with the specified handle.
+     */
+    inline Particle &resolve(ParticleHandle handle) { return m_particles[m_slots[handle]]; }
+
+    /**
+     * @brief Gets a const Particle by its stable handle. Does NOT perform validity checking.
+     *
+     * @param handle The handle of the Particle to get.
+     * @return A const reference to the Particle with the specified handle.
+     */
+    inline const Particle &resolve(ParticleHandle handle) const { return m_particles[m_slots[handle]]; }
+
+    /**
+     * @brief Gets the current position of a Particle in the container by its stable handle.
+     *
+     * @param handle The handle of the Particle.
+     * @return The index of the Particle in the container, or INVALID_HANDLE if the Particle has been removed.
+     */
+    size_t indexOf(ParticleHandle handle) const;
+
+    /**
+     * @brief Checks if a handle refers to a Particle which is currently stored in this container.
+     *
+     * @param handle The handle to check.
+     * @return true if the handle can be resolved.
+     * @return false if the handle was never assigned or its Particle has been removed.
+     */
+    bool isValid(ParticleHandle handle) const;
+
+    /**
+     * @brief Removes all inactive Particle objects from the container and compacts the remaining ones.
+     *
+     * Handles of the remaining particles stay valid; handles of removed particles become invalid. Inactive particles
+     * must no longer be referenced by any Cell.
+     */
+    void removeInactiveParticles();
+
     /**
      * @brief Gets the number of iterations after which the special upward force will no longer be applied.
      *
@@ -245,6 +329,13 @@ class ParticleContainer {
      */
     size_t size() const;
 
+    /**
+     * @brief Returns the number of particles the container can hold without reallocating.
+     *
+     * @return The capacity of the container.
+     */
+    size_t capacity() const;
+
     /**
      * @brief Returns the amount of active particles in the container.
      *
@@ -1,7 +1,9 @@
 #include "Thermostat.h"
 #include "utils/ArrayUtils.h"
+#include "utils/CPUDispatch.h"
 #include "utils/MaxwellBoltzmannDistribution.h"
 #include "utils/OMPWrapper.h"
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <functional>
@@ -46,32 +48,52 @@ void Thermostat::initialize(int dimension, double T_init, int n_thermostat, doub
 }
 void Thermostat::initializeBrownianMotion() {
     SPDLOG_TRACE("0-th iteration, initializing velocities with Brownian motion...");
-    for (auto &p : particles) {
+    // each particle draws from its own counter-based stream, so the loop can run in parallel reproducibly
+#pragma omp parallel for schedule(static)
+    CONTAINER_LOOP(particles, it) {
+        auto &p = CONTAINER_REF(it);
         // should probably check for active particles here, but we can assume that all of them are active at the
         // beginning of a simulation
-        DO_IF_NOT_WALL(p, p.setV(maxwellBoltzmannDistributedVelocity(std::sqrt(T_init / p.getM()), dimension)));
+        DO_IF_NOT_WALL(p, p.setV(maxwellBoltzmannDistributedVelocity(std::sqrt(T_init / p.getM()), dimension,
+                                                                     p.getHandle(), RandomStream::BROWNIAN_MOTION)));
     }
 }
-void Thermostat::calculateKineticEnergy() {
-    double sum = 0;
+DISPATCH_KERNEL
+KineticSums Thermostat::calculateKineticSums() const {
+    KineticSums sums;
+#pragma omp parallel for reduction(+ : sums)
+    CONTAINER_LOOP(particles, it) {
+        auto &p = CONTAINER_REF(it);
+        CONTINUE_IF_INACTIVE(p);
+        sums.accumulate(p);
+    }
+    return sums;
+}
+void Thermostat::applyKineticSums(const KineticSums &sums) {
+    mobileParticles = sums.mobileCount;
     if (!nanoFlow) {
         // standard thermostat: use velocity of ALL particles
-        for (auto &p : particles) {
-            CONTINUE_IF_INACTIVE(p);
-            sum += p.getM() * ArrayUtils::L2NormSquared(p.getV());
-        }
+        kineticEnergy = sums.energy / 2;
     } else {
         // nanoflow thermostat: use thermal motion of MOBILE particles
-        for (auto &p : particles) {
-            CONTINUE_IF_INACTIVE(p);
-            DO_IF_NOT_WALL(p, sum += p.getM() * ArrayUtils::L2NormSquared(p.getThermalMotion()));
-        }
+        // note: this assumes the simulation has at least one active mobile particle
+        assert(mobileParticles != 0 && "No non-wall particles found!");
+        avg_velocity = {sums.velocity[0] / mobileParticles, sums.velocity[1] / mobileParticles,
+                        sums.velocity[2] / mobileParticles};
+        const double uDotP = avg_velocity[0] * sums.momentum[0] + avg_velocity[1] * sums.momentum[1] +
+                             avg_velocity[2] * sums.momentum[2];
+        const double sum = sums.mobileEnergy - 2 * uDotP + ArrayUtils::L2NormSquared(avg_velocity) * sums.mass;
+        kineticEnergy = std::max(sum, 0.0) / 2;
     }
-    kineticEnergy = sum / 2;
     SPDLOG_TRACE("New kinetic energy: {}", kineticEnergy);
 }
+void Thermostat::setKineticSums(const KineticSums &sums) {
+    precomputedSums = sums;
+    hasPrecomputedSums = true;
+}
+void Thermostat::calculateKineticEnergy() { applyKineticSums(calculateKineticSums()); }
 void Thermostat::calculateTemp() {
-    temperature = 2 * kineticEnergy / (dimension * particles.nonWallSize());
+    temperature = 2 * kineticEnergy / (dimension * mobileParticles);
     SPDLOG_TRACE("New temperature: {}", temperature);
 }
 void Thermostat::calculateScalingFactor() {
@@ -95,29 +117,21 @@ void Thermostat::calculateScalingFactor() {
 
 void Thermostat::calculateThermalMotions() {
     // calculate average velocity of active, mobile particles
-    // note: this assumes the simulation has at least one active mobile particle
-    const size_t mobileParticles = particles.nonWallSize();
-    assert(mobileParticles != 0 && "No non-wall particles found!");
-    avg_velocity = {0., 0., 0.};
-    for (auto &p : particles) {
-        CONTINUE_IF_INACTIVE(p);
-        DO_IF_NOT_WALL(p, {
-            avg_velocity[0] += p.getV()[0];
-            avg_velocity[1] += p.getV()[1];
-            avg_velocity[2] += p.getV()[2];
-        });
-    }
-    avg_velocity[0] /= mobileParticles;
-    avg_velocity[1] /= mobileParticles;
-    avg_velocity[2] /= mobileParticles;
+    const KineticSums sums = calculateKineticSums();
+    assert(sums.mobileCount != 0 && "No non-wall particles found!");
+    avg_velocity = {sums.velocity[0] / sums.mobileCount, sums.velocity[1] / sums.mobileCount,
+                    sums.velocity[2] / sums.mobileCount};
 
     // calculate thermal motion for each particle
-    for (auto &p : particles) {
+#pragma omp parallel for
+    CONTAINER_LOOP(particles, it) {
+        auto &p = CONTAINER_REF(it);
         CONTINUE_IF_INACTIVE(p);
         DO_IF_NOT_WALL(p, p.setThermalMotion(ArrayUtils::elementWisePairOp(p.getV(), avg_velocity, std::minus<>())));
     }
 }
 
+DISPATCH_KERNEL
 void Thermostat::updateSystemTemp(int currentStep) {
     if (currentStep % n_thermostat != 0)
         return;
@@ -133,13 +147,11 @@ void Thermostat::updateSystemTemp(int currentStep) {
         return;
     }
 
-    // calculate the thermal motions of the particles for a nano flow simulation
-    if (nanoFlow) {
-        calculateThermalMotions();
-    }
+    // gather average velocity and kinetic energy in one fused pass (or reuse the sums from the velocity update)
+    applyKineticSums(hasPrecomputedSums ? precomputedSums : calculateKineticSums());
+    hasPrecomputedSums = false;
 
     // calculate temperature based on kinetic energy and scale temperature
-    calculateKineticEnergy();
     calculateTemp();
 
     // if the current temp. is the same as the target temp., skip updating velocities
@@ -166,9 +178,12 @@ void Thermostat::updateSystemTemp(int currentStep) {
             auto &p = CONTAINER_REF(it);
             // update particle thermal motion to set new temperature
             CONTINUE_IF_INACTIVE(p);
+            SKIP_IF_WALL(p);
+            std::array<double, 3> thermalMotion = p.getV() - avg_velocity;
+            p.setThermalMotion(thermalMotion);
             std::array<double, 3> newV =
-                ArrayUtils::elementWiseScalarOp(scalingFactor, p.getThermalMotion(), std::multiplies<>());
-            DO_IF_NOT_WALL(p, p.setV(newV + avg_velocity));
+                ArrayUtils::elementWiseScalarOp(scalingFactor, thermalMotion, std::multiplies<>());
+            p.setV(newV + avg_velocity);
         }
     }
     SPDLOG_TRACE("Finished temperature update for iteration {}", currentStep);
@@ -180,6 +195,7 @@ double Thermostat::getTargetTemp() const { return T_target; }
 double Thermostat::getDeltaT() const { return delta_T; }
 double Thermostat::getScalingFactor() const { return scalingFactor; }
 int Thermostat::getTimestep() const { return n_thermostat; }
+int Thermostat::getDimension() const { return dimension; }
 bool Thermostat::getNanoflow() const { return nanoFlow; }
 bool Thermostat::doScalingLimit() const { return limitScaling; }
 ParticleContainer &Thermostat::getParticles() const { return particles; }
@@ -8,7 +8,70 @@
  */
 #pragma once
 #include "ParticleContainer.h"
+#include <array>
 #include <cmath>
+#include <cstddef>
+
+/**
+ * @brief Per-pass accumulators needed by the Thermostat, gathered in a single (parallel) sweep over all particles.
+ *
+ * From these sums, both the average velocity and the kinetic energy of the thermal motions can be derived without
+ * another pass, using \f$ \sum_i m_i |v_i - \tilde v|^2 = \sum_i m_i |v_i|^2 - 2 \langle \tilde v, \sum_i m_i v_i
+ * \rangle + |\tilde v|^2 \sum_i m_i \f$.
+ */
+struct KineticSums {
+    /// @brief Sum of the velocities of all active, mobile (non-wall) particles.
+    std::array<double, 3> velocity{0., 0., 0.};
+    /// @brief Sum of the momenta of all active, mobile (non-wall) particles.
+    std::array<double, 3> momentum{0., 0., 0.};
+    /// @brief Sum of the masses of all active, mobile (non-wall) particles.
+    double mass{0.};
+    /// @brief Sum of \f$ m_i \langle v_i, v_i \rangle \f$ over all active particles.
+    double energy{0.};
+    /// @brief Sum of \f$ m_i \langle v_i, v_i \rangle \f$ over all active, mobile (non-wall) particles.
+    double mobileEnergy{0.};
+    /// @brief The number of active, mobile (non-wall) particles.
+    size_t mobileCount{0};
+
+    /**
+     * @brief Adds the contribution of a single (active) Particle to the sums.
+     *
+     * @param p The Particle to accumulate.
+     */
+    inline void accumulate(const Particle &p) {
+        const auto &v = p.getV();
+        const double mv2 = p.getM() * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        energy += mv2;
+        if (!IS_WALL(p)) {
+            for (int d = 0; d < 3; ++d) {
+                velocity[d] += v[d];
+                momentum[d] += p.getM() * v[d];
+            }
+            mass += p.getM();
+            mobileEnergy += mv2;
+            ++mobileCount;
+        }
+    }
+
+    /**
+     * @brief Merges the partial sums of another pass (e.g. from another thread) into these sums.
+     *
+     * @param other The partial sums to merge.
+     * @return A reference to these sums.
+     */
+    inline KineticSums &operator+=(const KineticSums &other) {
+        for (int d = 0; d < 3; ++d) {
+            velocity[d] += other.velocity[d];
+            momentum[d] += other.momentum[d];
+        }
+        mass += other.mass;
+        energy += other.energy;
+        mobileEnergy += other.mobileEnergy;
+        mobileCount += other.mobileCount;
+        return *this;
+    }
+};
+#pragma omp declare reduction(+ : KineticSums : omp_out += omp_in) initializer(omp_priv = KineticSums{})
 
 /// @brief Class modeling a thermostat which regulates the temperature of a Particle system.
 class Thermostat {
@@ -68,6 +131,16 @@ class Thermostat {
     /// @brief Average velocity of the system
     std::array<double, 3> avg_velocity{0, 0, 0};
 
+    /// @brief The number of active, mobile (non-wall) particles, as of the last reduction.
+    size_t mobileParticles{0};
+
+    /// @brief Sums gathered ahead of time (e.g. during the velocity update), consumed by the next thermostat
+    /// application.
+    KineticSums precomputedSums;
+
+    /// @brief Determines whether precomputedSums is up to date and may be used instead of a separate pass.
+    bool hasPrecomputedSums{false};
+
     /// @brief A reference to the Particle system.
     ParticleContainer &particles;
 
@@ -121,6 +194,40 @@ class Thermostat {
      */
     void initializeBrownianMotion();
 
+    /**
+     * @brief Gathers all sums needed for one thermostat application in a single parallel pass over the particles.
+     *
+     * @return The accumulated sums of all active particles.
+     */
+    KineticSums calculateKineticSums() const;
+
+    /**
+     * @brief Derives the average velocity, the number of mobile particles and the kinetic energy from the given sums.
+     *
+     * @details For nanoscale flow simulations, the kinetic energy is computed from the thermal motions of the mobile
+     * particles; otherwise, the velocities of all active particles are used.
+     *
+     * @param sums The sums gathered over all active particles.
+     */
+    void applyKineticSums(const KineticSums &sums);
+
+    /**
+     * @brief Hands over sums gathered elsewhere (i.e. during the velocity update preceding the next thermostat
+     * application), so that updateSystemTemp() does not need a separate pass over the particles.
+     *
+     * @param sums The sums gathered over all active particles after the latest velocity update.
+     */
+    void setKineticSums(const KineticSums &sums);
+
+    /**
+     * @brief Checks whether the Thermostat scales the particle velocities in the given iteration.
+     *
+     * @param step The iteration to check.
+     * @return true if updateSystemTemp() would scale the velocities in this iteration.
+     * @return false otherwise.
+     */
+    inline bool isDue(int step) const { return step > 0 && step % n_thermostat == 0; }
+
     /**
      * @brief Calculates the kinetic energy \f$ E_{kin} \f$ for all Particle objects in the system.
      *
@@ -193,6 +300,9 @@ class Thermostat {
     /// @brief Gets the number of simulation iterations after which to apply the Thermostat functionality.
     int getTimestep() const;
 
+    /// @brief Gets the dimensions for which the Thermostat temperature regulation is applied.
+    int getDimension() const;
+
     /// @brief Determines whether the thermostat is used for the nano-scale flow simulation.
     bool getNanoflow() const;
 
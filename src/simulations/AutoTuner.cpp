@@ -0,0 +1,202 @@
+#include "AutoTuner.h"
+#include "utils/ArrayUtils.h"
+#include "utils/CellUtils.h"
+#include "utils/CLIUtils.h"
+#include "utils/StringUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <spdlog/spdlog.h>
+#include <sstream>
+
+// helper function to get the name of an OpenMP schedule
+static const char *scheduleName(omp_sched_t schedule) {
+    switch (schedule) {
+    case omp_sched_dynamic:
+        return "dynamic";
+    case omp_sched_guided:
+        return "guided";
+    default:
+        return "static";
+    }
+}
+
+/* configuration */
+std::string TuningConfiguration::toString() const {
+    std::stringstream ss;
+    ss << StringUtils::fromParallelizationType(parallelization) << ", cell size factor " << cellSizeFactor;
+    if (parallelization == ParallelizationType::COARSE)
+        ss << ", schedule " << scheduleName(schedule) << "," << chunk;
+    return ss.str();
+}
+
+bool TuningConfiguration::operator==(const TuningConfiguration &other) const {
+    return parallelization == other.parallelization && cellSizeFactor == other.cellSizeFactor &&
+           schedule == other.schedule && chunk == other.chunk;
+}
+
+/* constructor */
+AutoTuner::AutoTuner(std::vector<TuningConfiguration> candidates, int interval, std::string key)
+    : m_candidates{std::move(candidates)}, m_interval{interval}, m_key{std::move(key)} {
+    if (m_candidates.empty())
+        CLIUtils::error("Cannot auto-tune without any candidate configurations!");
+    m_results.assign(m_candidates.size(), std::numeric_limits<std::int64_t>::max());
+    if (m_key.empty())
+        return;
+
+    // look for a cached winner; entries are stored as "<key> <parallelization> <factor> <schedule> <chunk>"
+    std::ifstream cache(TUNING_CACHE_FILE);
+    std::string line;
+    while (std::getline(cache, line)) {
+        std::istringstream ss(line);
+        std::string key;
+        int parallelization, schedule;
+        TuningConfiguration config;
+        if (!(ss >> key >> parallelization >> config.cellSizeFactor >> schedule >> config.chunk) || key != m_key)
+            continue;
+        config.parallelization = static_cast<ParallelizationType>(parallelization);
+        config.schedule = static_cast<omp_sched_t>(schedule);
+
+        // the cached configuration may not be a candidate anymore (e.g. different simulation type)
+        auto it = std::find(m_candidates.begin(), m_candidates.end(), config);
+        if (it != m_candidates.end()) {
+            m_best = static_cast<size_t>(it - m_candidates.begin());
+            m_tuning = false;
+            SPDLOG_INFO("Using cached auto-tuning result: {}", config.toString());
+        }
+    }
+}
+
+/* tuning */
+const TuningConfiguration &AutoTuner::getConfiguration() const {
+    return m_tuning ? m_candidates[m_current] : m_candidates[m_best];
+}
+
+bool AutoTuner::addSample(int iteration, std::int64_t stepTime, const std::function<double()> &density) {
+    if (!m_tuning) {
+        const bool periodic = m_interval > 0 && iteration - m_lastTuning >= m_interval;
+        bool changed = false;
+        if (!periodic && (iteration - m_lastTuning) % TUNING_DENSITY_INTERVAL == 0) {
+            const double current = density();
+            if (m_density < 0)
+                m_density = current; // started from the cache
+            else
+                changed = std::fabs(current / m_density - 1.0) > TUNING_DENSITY_THRESHOLD;
+        }
+        if (!periodic && !changed)
+            return false;
+
+        SPDLOG_DEBUG("Auto-tuning again at iteration {} ({}).", iteration, periodic ? "periodic" : "density changed");
+        m_tuning = true;
+        m_current = 0;
+        m_samples.clear();
+        std::fill(m_results.begin(), m_results.end(), std::numeric_limits<std::int64_t>::max());
+        return !(m_candidates[m_current] == m_candidates[m_best]);
+    }
+
+    // the median is robust against single slow steps, e.g. the first one after rebuilding the cells
+    m_samples.push_back(stepTime);
+    if (m_samples.size() < TUNING_SAMPLES)
+        return false;
+    std::nth_element(m_samples.begin(), m_samples.begin() + m_samples.size() / 2, m_samples.end());
+    m_results[m_current] = m_samples[m_samples.size() / 2];
+    SPDLOG_DEBUG("Auto-tuning: {} took {} ns per step.", m_candidates[m_current].toString(), m_results[m_current]);
+    m_samples.clear();
+    if (++m_current < m_candidates.size())
+        return true;
+
+    // all candidates have been measured, choose the fastest
+    const size_t last = m_candidates.size() - 1;
+    m_best = static_cast<size_t>(std::min_element(m_results.begin(), m_results.end()) - m_results.begin());
+    m_tuning = false;
+    m_current = 0;
+    m_lastTuning = iteration;
+    m_density = density();
+    SPDLOG_INFO("Auto-tuning chose {} at iteration {}.", m_candidates[m_best].toString(), iteration);
+
+    // update the cache entry of this input, keeping all others
+    if (!m_key.empty()) {
+        std::vector<std::string> lines;
+        {
+            std::ifstream cache(TUNING_CACHE_FILE);
+            std::string line;
+            while (std::getline(cache, line)) {
+                if (line.compare(0, m_key.size() + 1, m_key + " ") != 0)
+                    lines.push_back(line);
+            }
+        }
+        const TuningConfiguration &best = m_candidates[m_best];
+        std::ofstream cache(TUNING_CACHE_FILE, std::ios::trunc);
+        if (!cache) {
+            CLIUtils::error("Could not write auto-tuning cache", TUNING_CACHE_FILE, false, false);
+        } else {
+            for (const std::string &line : lines)
+                cache << line << "\n";
+            cache << std::setprecision(17) << m_key << " " << static_cast<int>(best.parallelization) << " "
+                  << best.cellSizeFactor << " " << static_cast<int>(best.schedule) << " " << best.chunk << "\n";
+        }
+    }
+    return !(m_candidates[last] == m_candidates[m_best]);
+}
+
+/* static helpers */
+// helper function to add bytes to a 64-bit FNV-1a hash
+static void hashBytes(std::uint64_t &hash, const char *data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+}
+
+std::vector<TuningConfiguration> AutoTuner::getCandidates(const Arguments &args) {
+    std::vector<TuningConfiguration> candidates;
+    for (double factor : {1.0 / 3.0, 0.5, 1.0, 1.5, 2.0}) {
+        // the alternative pair searches ignore the parallelization strategy and use fixed schedules, and without
+        // OpenMP, only the cell size has an effect
+#ifdef _OPENMP
+        if (args.pairSearch != PairSearchType::CELLS) {
+            candidates.push_back({ParallelizationType::COARSE, factor, omp_sched_static, 0});
+            continue;
+        }
+        candidates.push_back({ParallelizationType::COARSE, factor, omp_sched_static, 0});
+        candidates.push_back({ParallelizationType::COARSE, factor, omp_sched_dynamic, 1});
+        candidates.push_back({ParallelizationType::COARSE, factor, omp_sched_dynamic, 8});
+        candidates.push_back({ParallelizationType::COARSE, factor, omp_sched_guided, 0});
+        // the task-based strategy does not support membranes
+        if (!args.membrane)
+            candidates.push_back({ParallelizationType::FINE, factor, omp_sched_static, 0});
+#else
+        (void)args;
+        candidates.push_back({ParallelizationType::COARSE, factor, omp_sched_static, 0});
+#endif
+    }
+    return candidates;
+}
+
+std::string AutoTuner::getCacheKey(const Arguments &args) {
+    std::ifstream file(args.inputFile, std::ios::binary);
+    if (!file)
+        return "";
+
+    // 64-bit FNV-1a hash of the input file
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    char buffer[4096];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        hashBytes(hash, buffer, static_cast<size_t>(file.gcount()));
+
+    // command line options may override the input file, so the effective arguments which affect the force
+    // calculation are part of the key as well
+    std::stringstream effective;
+    effective << std::setprecision(17) << static_cast<int>(args.sim) << " " << static_cast<int>(args.pairSearch) << " "
+              << args.pairCutoffFactor << " " << args.cellSkin << " " << args.cutoffRadius << " " << args.dimensions
+              << " " << args.membrane << " " << ArrayUtils::to_string(args.domainSize) << " "
+              << CellUtils::fromBoundaryConditionArray(args.conditions);
+    const std::string s = effective.str();
+    hashBytes(hash, s.data(), s.size());
+
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << "-t" << omp_get_max_threads();
+    return ss.str();
+}
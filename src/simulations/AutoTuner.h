@@ -0,0 +1,143 @@
+/**
+ * @file AutoTuner.h
+ * @brief Class for choosing the fastest linked cell configuration at runtime.
+ * @date 2025-02-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "utils/Arguments.h"
+#include "utils/OMPWrapper.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// @brief The name of the file the tuning results are cached in, relative to the working directory.
+#define TUNING_CACHE_FILE "MolSim_tuning.cache"
+/// @brief The number of steps each configuration is measured for.
+#define TUNING_SAMPLES 3
+/// @brief The relative change in density after which the configuration is tuned again.
+#define TUNING_DENSITY_THRESHOLD 0.25
+/// @brief The number of steps between two density checks outside of tuning phases.
+#define TUNING_DENSITY_INTERVAL 100
+
+/// @brief A single configuration of the linked cell simulation which may be chosen by the AutoTuner.
+struct TuningConfiguration {
+    /// @brief The parallelization strategy of the force calculation.
+    ParallelizationType parallelization{ParallelizationType::COARSE};
+    /// @brief The minimum cell size relative to the cutoff radius.
+    double cellSizeFactor{1.0};
+    /// @brief The OpenMP schedule of the coarse-grained force calculation.
+    omp_sched_t schedule{omp_sched_static};
+    /// @brief The chunk size of the schedule, 0 for the default.
+    int chunk{0};
+
+    /**
+     * @brief Returns a string representation of the configuration.
+     *
+     * @return A string representation of the configuration.
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Checks if two configurations are the same.
+     *
+     * @param other The configuration to compare the current one with.
+     * @return true if both configurations are the same.
+     * @return false otherwise.
+     */
+    bool operator==(const TuningConfiguration &other) const;
+};
+
+/**
+ * @brief Class choosing the fastest linked cell configuration by measuring each candidate during the simulation.
+ *
+ * @details While tuning, every candidate configuration is used for a few steps of the actual simulation, and the
+ * candidate with the lowest median step time wins. Tuning is repeated after a fixed number of steps and whenever the
+ * density of the occupied part of the domain changes significantly, e.g. due to outflow or condensation. Winners are
+ * cached per input file, effective arguments and thread count, so that subsequent runs of the same input start with
+ * the best configuration right away.
+ */
+class AutoTuner {
+  private:
+    /// @brief The configurations to choose from.
+    std::vector<TuningConfiguration> m_candidates;
+    /// @brief The step times of the current candidate in nanoseconds.
+    std::vector<std::int64_t> m_samples;
+    /// @brief The median step time of each candidate in nanoseconds.
+    std::vector<std::int64_t> m_results;
+    /// @brief The index of the candidate currently being measured.
+    size_t m_current{0};
+    /// @brief The index of the best candidate.
+    size_t m_best{0};
+    /// @brief Determines whether the candidates are currently being measured.
+    bool m_tuning{true};
+    /// @brief The number of steps after which the configuration is tuned again, 0 to only re-tune on density changes.
+    int m_interval;
+    /// @brief The step in which the last tuning phase ended.
+    int m_lastTuning{0};
+    /// @brief The density at the end of the last tuning phase, or a negative value if unknown.
+    double m_density{-1.0};
+    /// @brief The key identifying the input in the cache.
+    std::string m_key;
+
+  public:
+    /**
+     * @brief Constructs a new AutoTuner. If a cached result exists for the given key, it is used and the initial tuning
+     * phase is skipped.
+     *
+     * @param candidates The configurations to choose from. Must not be empty.
+     * @param interval The number of steps after which the configuration is tuned again, 0 to only re-tune on density
+     * changes.
+     * @param key The key identifying the input in the cache, empty to disable caching.
+     */
+    AutoTuner(std::vector<TuningConfiguration> candidates, int interval, std::string key = "");
+
+    /**
+     * @brief Gets the configuration to be used for the next step.
+     *
+     * @return The configuration currently being measured while tuning, otherwise the best configuration.
+     */
+    const TuningConfiguration &getConfiguration() const;
+
+    /**
+     * @brief Checks whether the candidates are currently being measured.
+     *
+     * @return true if tuning is in progress.
+     * @return false otherwise.
+     */
+    inline bool isTuning() const { return m_tuning; }
+
+    /**
+     * @brief Adds the time of a completed step and advances the tuning process.
+     *
+     * The density is only evaluated at the end of a tuning phase and every TUNING_DENSITY_INTERVAL steps otherwise.
+     *
+     * @param iteration The step which has just been completed.
+     * @param stepTime The time of the step in nanoseconds.
+     * @param density Function returning the current density of the occupied part of the domain.
+     * @return true if the configuration for the next step differs from the one of the completed step.
+     * @return false otherwise.
+     */
+    bool addSample(int iteration, std::int64_t stepTime, const std::function<double()> &density);
+
+    /**
+     * @brief Gets the candidate configurations available for the given simulation.
+     *
+     * @param args The simulation arguments.
+     * @return All combinations of parallelization strategy, schedule and cell size factor which have an effect on the
+     * selected pair search.
+     */
+    static std::vector<TuningConfiguration> getCandidates(const Arguments &args);
+
+    /**
+     * @brief Gets the key identifying a simulation in the cache, based on a hash of its input file, the effective
+     * arguments affecting the force calculation and the number of threads.
+     *
+     * @param args The simulation arguments, including command line overrides.
+     * @return The key, or an empty string if the input file cannot be read.
+     */
+    static std::string getCacheKey(const Arguments &args);
+};
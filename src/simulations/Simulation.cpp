@@ -1,7 +1,10 @@
 #include "Simulation.h"
+#include "utils/CPUDispatch.h"
 #include "utils/OMPWrapper.h"
+#include "utils/PhaseProfiler.h"
 #include "utils/StringUtils.h"
 #include <algorithm>
+#include <chrono>
 
 Simulation::Simulation(ParticleContainer &pc, Arguments &args, Thermostat &t, FlowSimulationAnalyzer &analyzer)
     : m_particles{pc}, m_args{args}, m_thermostat{t}, m_analyzer{analyzer} {
@@ -10,19 +13,38 @@ Simulation::Simulation(ParticleContainer &pc, Arguments &args, Thermostat &t, Fl
 Simulation::~Simulation() = default;
 
 void Simulation::initializeBase() {
-    // get total number of iterations
-    m_totalIt = static_cast<int>((m_args.endTime - m_args.startTime) / m_args.delta_t);
+    // get total number of iterations, including the ones before resuming from a checkpoint
+    m_totalIt = m_args.startIteration + static_cast<int>((m_args.endTime - m_args.startTime) / m_args.delta_t);
 
     // initialize output writer
-    SIM_INIT_WRITER(m_writer, m_args.type, m_args.basename);
+    SIM_INIT_WRITER(m_writer, m_args);
 
     // initialize physics functions
-    auto [cvx, cf] = StrategyFactory::getSimulationFunctions(m_args);
+    setFunctions(m_args);
+
+    // the coarse-grained linked cell force calculation uses the runtime schedule, which is static unless auto-tuned
+    omp_set_schedule(omp_sched_static, 0);
+}
+
+void Simulation::setFunctions(Arguments &args) {
+    auto [cvx, cf] = StrategyFactory::getSimulationFunctions(args, m_particles);
     m_calculateX = cvx.xf;
     m_calculateV = cvx.vf;
+    m_calculateVThermostat = cvx.vtf;
     m_calculateF = cf;
 }
 
+void Simulation::chooseFunctions() { setFunctions(m_args); }
+
+void Simulation::writeCheckpoint(double time, int iteration) {
+    if (m_args.checkpointFreq <= 0)
+        return;
+    SIM_WRITE_CHECKPOINT(m_args.basename + "_checkpoint.chk", m_particles, m_args, m_thermostat, m_analyzer, time,
+                         iteration);
+}
+
+void Simulation::autoTune(int, std::int64_t, CellContainer *&) {}
+
 void Simulation::runSimulationLoop(CellContainer *lc) {
     // verify that the particle container is not empty
     assert(!(m_particles.isEmpty()) && "Cannot run simulation without particles!");
@@ -31,29 +53,70 @@ void Simulation::runSimulationLoop(CellContainer *lc) {
     SPDLOG_WARN("Benchmarking ENABLED! No output files will be generated.");
 #endif
 
+    // start recording phase timings, if requested
+    if (m_args.profilePhases || m_args.profileCounters)
+        PhaseProfiler::start(m_args.basename, m_args.profileCounters);
+
     // reset (start) timer
     TIMER_RESET(m_timer);
 
     // perform time integration
+    // a resumed simulation continues the iteration count, so that output files and cadences line up with the original
     double currentTime = m_args.startTime;
-    int iteration = 0;
+    int iteration = m_args.startIteration;
 
     while (currentTime < m_args.endTime) {
         SPDLOG_DEBUG("Iteration: {}", iteration);
 
         // compute statistics of the flow of the nano scale flow simulation
-        SIM_ANALYZE_FLOW(m_analyzer, iteration);
+        {
+            PROFILE_PHASE(Phase::ANALYZER);
+            SIM_ANALYZE_FLOW(m_analyzer, iteration);
+        }
 
         // update system temperature using thermostat
-        m_thermostat.updateSystemTemp(iteration);
+        {
+            PROFILE_PHASE(Phase::THERMOSTAT);
+            m_thermostat.updateSystemTemp(iteration);
+        }
 
         // update position, force and velocity
-        m_calculateX(m_particles, m_args.delta_t, m_args.gravity, lc, m_args.membrane);
-        m_calculateF(m_particles, m_args.cutoffRadius, lc);
-        m_calculateV(m_particles, m_args.delta_t);
+        const auto stepStart = std::chrono::steady_clock::now();
+        {
+            PROFILE_PHASE(Phase::POSITION);
+            m_calculateX(m_particles, m_args.delta_t, m_args.gravity, lc, m_args.membrane);
+        }
+        if (lc && lc->getParticlesDeactivated()) {
+            // a particle left the simulation without outflow, so the loops have to check for inactive ones from now on
+            SPDLOG_DEBUG("Particles were deactivated, switching to the outflow step policy.");
+            lc->setParticlesDeactivated(false);
+            chooseFunctions();
+        }
+        {
+            PROFILE_PHASE(Phase::FORCE);
+            m_calculateF(m_particles, m_args.cutoffRadius, lc);
+        }
+        {
+            PROFILE_PHASE(Phase::VELOCITY);
+            if (m_thermostat.isDue(iteration + 1)) {
+                // the thermostat is applied at the start of the next iteration; gather its sums now to skip a pass
+                KineticSums sums;
+                m_calculateVThermostat(m_particles, m_args.delta_t, sums);
+                m_thermostat.setKineticSums(sums);
+            } else {
+                m_calculateV(m_particles, m_args.delta_t);
+            }
+        }
+        if (m_args.autoTune) {
+            const auto stepTime = std::chrono::steady_clock::now() - stepStart;
+            autoTune(iteration, std::chrono::duration_cast<std::chrono::nanoseconds>(stepTime).count(), lc);
+        }
 
         // for standard builds, generate output files
-        SIM_WRITE_OUTPUT(iteration, m_args.itFreq, m_writer, m_particles, m_totalIt);
+        {
+            PROFILE_PHASE(Phase::OUTPUT);
+            SIM_WRITE_OUTPUT(iteration, m_args.itFreq, m_writer, m_particles, m_totalIt);
+        }
 
         currentTime += m_args.delta_t;
 
@@ -61,8 +124,25 @@ void Simulation::runSimulationLoop(CellContainer *lc) {
         // we do this since we update each active molecule during one iteration
         TIMER_UPDATE_MOLECULES(m_timer, m_particles.activeSize());
         iteration++;
+
+        // periodically save the state to resume from
+        if (m_args.checkpointFreq > 0 && iteration % m_args.checkpointFreq == 0 && currentTime < m_args.endTime) {
+            PROFILE_PHASE(Phase::OUTPUT);
+            writeCheckpoint(currentTime, iteration);
+        }
+
+        // write the phase timings of this step, if profiling is enabled
+        if (PhaseProfiler::isEnabled())
+            PhaseProfiler::endStep(iteration - 1, m_particles.activeSize());
     }
 
+    // save the final state, so that the simulation may be extended later on
+    writeCheckpoint(currentTime, iteration);
+
+    // wait for any output still being written in the background
+    SIM_FLUSH_OUTPUT(m_writer);
+    PhaseProfiler::stop();
+
     // print total elapsed time and molecule updates per second
     TIMER_PRINT_ELAPSED(m_timer);
     TIMER_PRINT_MUPS(m_timer);
@@ -77,6 +157,7 @@ void Simulation::runSimulation() {
     SPDLOG_INFO("output freq.: {}", m_args.itFreq);
     SPDLOG_INFO("basename    : {}", m_args.basename);
     SPDLOG_INFO("output type : {}", StringUtils::fromWriterType(m_args.type));
+    SPDLOG_INFO("output queue: {}", m_args.outputQueue);
     SPDLOG_INFO("nanoflow?   : {}", m_thermostat.getNanoflow());
     SPDLOG_INFO("membrane?   : {}", m_args.membrane);
     SPDLOG_INFO("analyzer?   : {}", m_analyzer.getFrequency() > 0);
@@ -86,6 +167,7 @@ void Simulation::runSimulation() {
         SPDLOG_INFO("a: rwall    : {}", m_analyzer.getRightWallPosX());
         SPDLOG_INFO("a: freq.    : {}", m_analyzer.getFrequency());
         SPDLOG_INFO("a: dirname  : {}", m_analyzer.getDirname());
+        SPDLOG_INFO("a: accum.   : {}", m_analyzer.isAccumulating());
     }
 #ifdef _OPENMP
     SPDLOG_INFO("p. strat.   : {}", StringUtils::fromParallelizationType(m_args.parallelization));
@@ -93,6 +175,7 @@ void Simulation::runSimulation() {
 #else
     SPDLOG_WARN("Parallelization is DISABLED!");
 #endif
+    SPDLOG_INFO("cpu kernels : {}", CPUDispatch::getKernelLevel());
 
     initializeBase();
     runSimulationLoop(nullptr); // "nullptr" isn't necessary here, but it shows the diff between this and lc
@@ -7,6 +7,7 @@
  *
  */
 #pragma once
+#include "io/output/CheckpointWriter.h"
 #include "io/output/FileWriter.h"
 #include "io/output/WriterFactory.h"
 #include "io/output/XMLWriter.h"
@@ -17,6 +18,7 @@
 #include "utils/Arguments.h"
 #include "utils/Timer.h"
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -27,21 +29,30 @@
         XMLWriter xmlw{_a};                                                                                            \
         xmlw.serialize(_b, _c, _d, _e);                                                                                \
     } while (0)
-#define SIM_INIT_WRITER(_a, _b, _c) _a = WriterFactory::createWriter(_b, _c)
+#define SIM_WRITE_CHECKPOINT(_a, _b, _c, _d, _e, _f, _g)                                                               \
+    do {                                                                                                               \
+        CheckpointWriter cw{_a};                                                                                       \
+        cw.write(_b, _c, _d, _e, _f, _g);                                                                              \
+    } while (0)
+#define SIM_INIT_WRITER(_a, _b)                                                                                        \
+    _a = WriterFactory::createWriter(_b.type, _b.basename, _b.outputQueue, _b.doublePrecision, _b.compressOutput)
 #define SIM_WRITE_OUTPUT(_a, _b, _c, _d, _e)                                                                           \
     do {                                                                                                               \
         if (_a % _b == 0) {                                                                                            \
             _c->writeParticles(_d, _a, _e);                                                                            \
         }                                                                                                              \
     } while (0)
+#define SIM_FLUSH_OUTPUT(_a) _a->flush()
 #define SIM_ANALYZE_FLOW(_a, _b)                                                                                       \
     do {                                                                                                               \
         _a.analyzeFlow(_b);                                                                                            \
     } while (0)
 #else
 #define SIM_SERIALIZE_XML(_a, _b, _c, _d, _e) (void)0
-#define SIM_INIT_WRITER(_a, _b, _c) (void)0
+#define SIM_WRITE_CHECKPOINT(_a, _b, _c, _d, _e, _f, _g) (void)0
+#define SIM_INIT_WRITER(_a, _b) (void)0
 #define SIM_WRITE_OUTPUT(_a, _b, _c, _d, _e) (void)0
+#define SIM_FLUSH_OUTPUT(_a) (void)0
 #define SIM_ANALYZE_FLOW(_a, _b) (void)0
 #endif
 
@@ -80,6 +91,9 @@ class Simulation {
     /// @brief Function for calculating the Particle velocities.
     TimeIntegrationFuncs::VFunc m_calculateV;
 
+    /// @brief Function for calculating the Particle velocities and gathering the sums needed by the Thermostat.
+    TimeIntegrationFuncs::VTFunc m_calculateVThermostat;
+
     /// @brief Function for calculating the Particle positions.
     TimeIntegrationFuncs::XFunc m_calculateX;
 
@@ -92,6 +106,38 @@ class Simulation {
     /// @brief Base function for initializing Simulation parameters.
     void initializeBase();
 
+    /**
+     * @brief Chooses the time integration and force calculation functions for the given Arguments and the current
+     * particles.
+     *
+     * @param args The Arguments used for choosing the functions.
+     */
+    void setFunctions(Arguments &args);
+
+    /**
+     * @brief Chooses all physics functions again for the current particles, e.g. once particles have been deactivated,
+     * so that the step policy checks for inactive particles from then on.
+     */
+    virtual void chooseFunctions();
+
+    /**
+     * @brief Saves the current simulation state to the checkpoint file, if checkpointing is enabled.
+     *
+     * @param time The current simulation time.
+     * @param iteration The number of the current iteration.
+     */
+    void writeCheckpoint(double time, int iteration);
+
+    /**
+     * @brief Passes the time of a completed step to the auto-tuner and applies its next configuration. Does nothing
+     * for simulations without linked cells.
+     *
+     * @param iteration The step which has just been completed.
+     * @param stepTime The time spent on the position, force and velocity calculation of the step, in nanoseconds.
+     * @param lc The CellContainer used by the simulation loop, which may be replaced by the auto-tuner.
+     */
+    virtual void autoTune(int iteration, std::int64_t stepTime, CellContainer *&lc);
+
     /**
      * @brief Runs a basic simulation loop.
      *
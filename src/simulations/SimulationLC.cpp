@@ -2,13 +2,16 @@
 #include "io/output/XMLWriter.h"
 #include "utils/ArrayUtils.h"
 #include "utils/CellUtils.h"
+#include "utils/CPUDispatch.h"
 #include "utils/OMPWrapper.h"
 #include "utils/StringUtils.h"
 
 SimulationLC::SimulationLC(ParticleContainer &pc, Arguments &args, Thermostat &t, FlowSimulationAnalyzer &analyzer)
     : Simulation(pc, args, t, analyzer),
-      m_cellContainer{
-          CellContainer(args.domainSize, args.conditions, args.cutoffRadius, m_particles, args.dimensions)} {
+      m_cellContainer{std::make_unique<CellContainer>(args.domainSize, args.conditions, args.cutoffRadius, m_particles,
+                                                      args.dimensions, args.cellSizeFactor, args.pairCutoffFactor,
+                                                      args.cellSkin)},
+      m_cellSizeFactor{args.cellSizeFactor} {
     SPDLOG_TRACE("Created new linked cells Simulation.");
 }
 SimulationLC::~SimulationLC() = default;
@@ -23,11 +26,13 @@ void SimulationLC::runSimulation() {
     SPDLOG_INFO("output freq.: {}", m_args.itFreq);
     SPDLOG_INFO("dimensions  : {}", m_args.dimensions);
     SPDLOG_INFO("domain size : {}", ArrayUtils::to_string(m_args.domainSize));
-    SPDLOG_INFO("cell size   : {}", ArrayUtils::to_string(m_cellContainer.getCellSize()));
+    SPDLOG_INFO("cell size   : {}", ArrayUtils::to_string(m_cellContainer->getCellSize()));
     SPDLOG_INFO("cutoff      : {}", m_args.cutoffRadius);
+    SPDLOG_INFO("cell skin   : {}", m_args.cellSkin);
     SPDLOG_INFO("gravity     : {}", m_args.gravity);
     SPDLOG_INFO("basename    : {}", m_args.basename);
     SPDLOG_INFO("output type : {}", StringUtils::fromWriterType(m_args.type));
+    SPDLOG_INFO("output queue: {}", m_args.outputQueue);
     SPDLOG_INFO("bd. cond.   : {}", CellUtils::fromBoundaryConditionArray(m_args.conditions));
     SPDLOG_INFO("#particles  : {}", m_particles.size());
     SPDLOG_INFO("nanoflow?   : {}", m_thermostat.getNanoflow());
@@ -39,19 +44,78 @@ void SimulationLC::runSimulation() {
         SPDLOG_INFO("a: rwall    : {}", m_analyzer.getRightWallPosX());
         SPDLOG_INFO("a: freq.    : {}", m_analyzer.getFrequency());
         SPDLOG_INFO("a: dirname  : {}", m_analyzer.getDirname());
+        SPDLOG_INFO("a: accum.   : {}", m_analyzer.isAccumulating());
     }
+    SPDLOG_INFO("auto-tune?  : {}", m_args.autoTune);
+    SPDLOG_INFO("pair search : {}", StringUtils::fromPairSearchType(m_args.pairSearch));
+    SPDLOG_INFO("pair cutoff : {}", m_args.pairCutoffFactor);
 #ifdef _OPENMP
     SPDLOG_INFO("p. strat.   : {}", StringUtils::fromParallelizationType(m_args.parallelization));
     SPDLOG_INFO("max threads : {}", omp_get_max_threads());
 #else
     SPDLOG_WARN("Parallelization is DISABLED!");
 #endif
+    SPDLOG_INFO("cpu kernels : {}", CPUDispatch::getKernelLevel());
 
     initializeBase();
-    runSimulationLoop(&m_cellContainer);
+    if (m_args.autoTune) {
+        m_tuner = std::make_unique<AutoTuner>(AutoTuner::getCandidates(m_args), m_args.tuneInterval,
+                                              AutoTuner::getCacheKey(m_args));
+        applyConfiguration(m_tuner->getConfiguration());
+    }
+    runSimulationLoop(m_cellContainer.get());
 
     // serialize output for future runs
     SIM_SERIALIZE_XML(m_args.basename + "_results.xml", m_particles, m_args, m_thermostat, m_analyzer);
 
     SPDLOG_INFO("Completed {} linked cell simulation.", StringUtils::fromSimulationType(m_args.sim));
-}
\ No newline at end of file
+}
+void SimulationLC::applyConfiguration(const TuningConfiguration &config) {
+    // rebuild the cells if their size changes; particles are sorted into the new cells by position
+    if (config.cellSizeFactor != m_cellSizeFactor) {
+        for (Particle &p : m_particles)
+            p.setCellIndex(-1);
+        m_cellContainer.reset();
+        m_cellContainer = std::make_unique<CellContainer>(m_args.domainSize, m_args.conditions, m_args.cutoffRadius,
+                                                          m_particles, m_args.dimensions, config.cellSizeFactor,
+                                                          m_args.pairCutoffFactor, m_args.cellSkin);
+        m_cellSizeFactor = config.cellSizeFactor;
+        SPDLOG_DEBUG("Rebuilt cells with cell size {}.", ArrayUtils::to_string(m_cellContainer->getCellSize()));
+    }
+
+    // choose the force calculation and its schedule
+    Arguments args = m_args;
+    args.parallelization = config.parallelization;
+    setFunctions(args);
+    omp_set_schedule(config.schedule, config.chunk);
+}
+
+void SimulationLC::chooseFunctions() {
+    if (m_tuner)
+        applyConfiguration(m_tuner->getConfiguration());
+    else
+        Simulation::chooseFunctions();
+}
+
+double SimulationLC::getDensity() const {
+    const std::vector<int> &cells = m_cellContainer->getOccupiedCells();
+    const size_t occupied = cells.size();
+    size_t particles = 0;
+    for (int index : cells)
+        particles += (*m_cellContainer)[index].getParticles().size() +
+                     (*m_cellContainer)[index].getStaticParticles().size();
+    if (occupied == 0)
+        return 0.0;
+    const std::array<double, 3> &cellSize = m_cellContainer->getCellSize();
+    double volume = 1.0;
+    for (size_t i = 0; i < m_args.dimensions; ++i)
+        volume *= cellSize[i];
+    return static_cast<double>(particles) / (static_cast<double>(occupied) * volume);
+}
+
+void SimulationLC::autoTune(int iteration, std::int64_t stepTime, CellContainer *&lc) {
+    if (m_tuner->addSample(iteration, stepTime, [this]() { return getDensity(); })) {
+        applyConfiguration(m_tuner->getConfiguration());
+        lc = m_cellContainer.get();
+    }
+}
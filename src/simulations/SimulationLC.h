@@ -7,13 +7,42 @@
  *
  */
 #pragma once
+#include "AutoTuner.h"
 #include "Simulation.h"
+#include <memory>
 
 /// @brief Class defining a time-integration simulation using the linked cells method.
 class SimulationLC : public Simulation {
   private:
     /// @brief The CellContainer used to store and manage cells.
-    CellContainer m_cellContainer;
+    std::unique_ptr<CellContainer> m_cellContainer;
+
+    /// @brief The AutoTuner choosing the configuration, if auto-tuning is enabled.
+    std::unique_ptr<AutoTuner> m_tuner;
+
+    /// @brief The minimum cell size relative to the cutoff radius the cells have been built with.
+    double m_cellSizeFactor;
+
+    /**
+     * @brief Applies a configuration chosen by the AutoTuner, rebuilding the cells if the cell size changes.
+     *
+     * @param config The configuration to be applied.
+     */
+    void applyConfiguration(const TuningConfiguration &config);
+
+    /**
+     * @brief Gets the density of the occupied part of the domain, i.e. the number of particles per volume of all
+     * non-empty cells.
+     *
+     * @return The density of the occupied cells.
+     */
+    double getDensity() const;
+
+  protected:
+    void autoTune(int iteration, std::int64_t stepTime, CellContainer *&lc) override;
+
+    /// @brief Chooses all physics functions again, keeping the parallelization chosen by the AutoTuner, if any.
+    void chooseFunctions() override;
 
   public:
     /**
@@ -3,6 +3,7 @@
 #include "objects/CellContainer.h"
 #include "objects/Particle.h"
 #include "utils/CellUtils.h"
+#include "utils/PhaseProfiler.h"
 #include <spdlog/spdlog.h>
 #include <utility>
 #include <vector>
@@ -37,10 +38,10 @@ bool handleHaloCell(Particle &p, Cell &targetCell, CellContainer *lc) {
 std::pair<HaloLocation, BoundaryCondition> determineBoundaryCondition(Particle &p, Cell &targetCell,
                                                                       CellContainer *lc) {
     // get cardinal direction(s) of halo cell
-    const std::vector<HaloLocation> &haloLocations = targetCell.getHaloLocation();
+    const LocationMask haloLocations = targetCell.getHaloMask();
 
     // if there is more than one cardinal direction, the cell is a _corner_ halo cell
-    if (haloLocations.size() > 1) {
+    if (CellUtils::countLocations(haloLocations) > 1) {
         SPDLOG_DEBUG("Found multiple for (corner) cell {}...", targetCell.toString());
         HaloLocation location = targetCell.getCornerRegion(p);
         BoundaryCondition condition = lc->getConditions()[static_cast<int>(location)];
@@ -48,7 +49,7 @@ std::pair<HaloLocation, BoundaryCondition> determineBoundaryCondition(Particle &
     }
 
     // otherwise, just go with the first (and only) one
-    HaloLocation location = haloLocations[0];
+    HaloLocation location = CellUtils::firstLocation<HaloLocation>(haloLocations);
     BoundaryCondition condition = lc->getConditions()[static_cast<int>(location)];
     SPDLOG_DEBUG("Choosing boundary condition for cell {}: {} (cast: {})...", targetCell.toString(),
                  CellUtils::fromHalo(location), static_cast<int>(location));
@@ -95,12 +96,12 @@ void handleReflectiveCondition(Particle &p, Cell &fromCell, HaloLocation locatio
 void handlePeriodicCondition(Particle &p, Cell &targetCell, CellContainer *lc) {
     // this function ought to be called after particles have made it into the halo cells and should be moved to the
     // opposite border cell
-    const std::vector<HaloLocation> &haloLocations = targetCell.getHaloLocation();
+    const int numLocations = CellUtils::countLocations(targetCell.getHaloMask());
     HaloLocation location;
 
-    if (haloLocations.size() == 1) {
-        location = haloLocations[0];
-    } else if (haloLocations.size() > 1) {
+    if (numLocations == 1) {
+        location = CellUtils::firstLocation<HaloLocation>(targetCell.getHaloMask());
+    } else if (numLocations > 1) {
         location = targetCell.getCornerRegion(p);
     } else {
         location = HaloLocation::NORTH; // just something so location is initialized
@@ -123,7 +124,7 @@ void handlePeriodicCondition(Particle &p, Cell &targetCell, CellContainer *lc) {
 
     // if it was a corner halo, we need to recalculate boundary conditions because the particle still in another halo
     // cell
-    if (haloLocations.size() > 1) {
+    if (numLocations > 1) {
         SPDLOG_DEBUG("Found another boundary in cell {} for particle {}", p.getCellIndex(), p.toString());
         handleHaloCell(p, lc->getCells()[p.getCellIndex()], lc);
     }
@@ -131,60 +132,56 @@ void handlePeriodicCondition(Particle &p, Cell &targetCell, CellContainer *lc) {
 }
 
 void mirrorGhostParticles(CellContainer *lc) {
-    std::vector<std::reference_wrapper<Cell>> borderCells = lc->getBorderCells();
-
+    PROFILE_PHASE(Phase::GHOSTS);
     // we add references to the particles to the halo cells on the opposite side (sides if corner)
-    for (auto bc : borderCells) {
-        std::vector<BorderLocation> location = bc.get().getBorderLocation();
+    // only occupied border cells have anything to mirror
+    for (int index : lc->getOccupiedCells()) {
+        Cell &bc = lc->getCells()[index];
+        if (bc.getType() != CellType::BORDER)
+            continue;
+        // only the periodic borders of the cell are mirrored
+        const LocationMask periodicBorders = bc.getBorderMask() & lc->getPeriodicMask();
+        if (periodicBorders == 0)
+            continue;
 
         // I'm starting to think it should be 1 even for 3D (imagine a cross section)
-        if (location.size() > 1) {
+        if (CellUtils::countLocations(bc.getBorderMask()) > 1) {
             // At least 2 edges should be periodic for us to mirror in corner (intuition)
-            int doCorner = 0;
-            std::vector<BorderLocation> periodicBorders;
-            for (auto direction : location) {
-                if (lc->getConditions()[static_cast<int>(direction)] == BoundaryCondition::PERIODIC) {
-                    periodicBorders.push_back(direction);
-                    doCorner += 1;
-                }
-            }
-
-            if (doCorner >= 2) {
+            if (CellUtils::countLocations(periodicBorders) >= 2) {
                 std::vector<int> corners = lc->getOppositeOfBorderCorner(bc, periodicBorders);
                 // in every corner add the ghost particles
                 for (auto corner : corners) {
-                    for (auto &p : bc.get().getParticles()) {
-                        lc->getCells()[corner].addParticle(p.get());
-                        SPDLOG_DEBUG("Mirror in corner {} with corner {} and actual {}.", p.get().toString(), corner,
-                                     p.get().getCellIndex());
+                    for (ParticleHandle p : bc.getParticles()) {
+                        lc->addGhostParticle(corner, p);
+                        SPDLOG_DEBUG("Mirror in corner {} with corner {} and actual {}.",
+                                     lc->getParticles().resolve(p).toString(), corner,
+                                     lc->getParticles().resolve(p).getCellIndex());
                     }
+                    for (ParticleHandle p : bc.getStaticParticles())
+                        lc->addGhostParticle(corner, p, true);
                 }
             }
         }
 
         // case for edges: you need to mirror across every edge
-        for (auto direction : location) {
-            // check whether we should be applying periodic boundary conditions in this direction
-            if (lc->getConditions()[static_cast<int>(direction)] != BoundaryCondition::PERIODIC) {
-                continue;
-            }
-
+        for (BorderLocation direction : CellUtils::fromMask<BorderLocation>(periodicBorders)) {
             int haloIndex = lc->getOppositeOfBorder(bc, direction);
 
-            for (auto &p : bc.get().getParticles()) {
-                lc->getCells()[haloIndex].addParticle(p.get());
-                SPDLOG_DEBUG("Mirror along edge {} in {} and in actual {}.", p.get().toString(), haloIndex,
-                             p.get().getCellIndex());
+            for (ParticleHandle p : bc.getParticles()) {
+                lc->addGhostParticle(haloIndex, p);
+                SPDLOG_DEBUG("Mirror along edge {} in {} and in actual {}.", lc->getParticles().resolve(p).toString(),
+                             haloIndex, lc->getParticles().resolve(p).getCellIndex());
             }
+            for (ParticleHandle p : bc.getStaticParticles())
+                lc->addGhostParticle(haloIndex, p, true);
         }
     }
 }
 
 void deleteGhostParticles(CellContainer *lc) {
-    // remove all particles (they are only ghost particles) from the halo cells, they should be empty
-    for (auto &cell : lc->getHaloCells()) {
-        cell.get().getParticles().clear();
-    }
+    PROFILE_PHASE(Phase::GHOSTS);
+    // remove all particles (they are only ghost particles) from the halo cells they were mirrored into
+    lc->clearGhostParticles();
 }
 
 void reflectParticle(Particle &p, Cell &fromCell, Cell &toCell, CellContainer *lc, int direction) {
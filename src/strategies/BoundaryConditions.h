@@ -85,7 +85,7 @@ void reflectParticle(Particle &p, Cell &fromCell, Cell &toCell, CellContainer *l
 void mirrorGhostParticles(CellContainer *lc);
 
 /**
- * @brief Deletes references to ghost particles from the halo cells (i.e all particle references in halo cells).
+ * @brief Deletes references to ghost particles from the halo cells they were mirrored into by mirrorGhostParticles().
  *
  * @param lc The CellContainer we are operating in.
  */
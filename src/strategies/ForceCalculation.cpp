@@ -1,9 +1,16 @@
 #include "ForceCalculation.h"
 #include "objects/CellContainer.h"
+#include "objects/ClusterPairList.h"
+#include "objects/HierarchicalGrid.h"
+#include "objects/Octree.h"
 #include "objects/ParticleContainer.h"
 #include "strategies/BoundaryConditions.h"
 #include "utils/ArrayUtils.h"
+#include "utils/CPUDispatch.h"
+#include "utils/PhaseProfiler.h"
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <spdlog/spdlog.h>
 #include <vector>
 
@@ -29,21 +36,15 @@ static inline std::array<double, 3> getLJForceVec(const Particle &p1, const Part
 }
 
 // helper function to check whether particles are neighbours
-static inline bool inNeighbourVector(const std::vector<std::reference_wrapper<Particle>> vec,
-                                     const std::reference_wrapper<Particle> el) {
-    for (auto &vec_el : vec) {
-        if (vec_el.get() == el.get()) {
-            return true;
-        }
-    }
-    return false;
+static inline bool inNeighbourVector(const std::vector<ParticleHandle> &vec, ParticleHandle el) {
+    return std::find(vec.begin(), vec.end(), el) != vec.end();
 }
 
 // helper method to potentially fake the position of a ghost particle, for use with periodic boundaries
 static inline std::array<double, 3> getTruePos(const Particle &p, const Cell &c, CellContainer *lc) {
     // special case: particle j is a ghost particle
     // otherwise, we just get the real position of the particle
-    if (!c.getHaloLocation().empty()) {
+    if (c.getHaloMask() != 0) {
         // we need to fake the position of the ghost particle as if it were in the halo cell
         Cell &trueCell = lc->getCells()[p.getCellIndex()];
         std::array<double, 3> inCell = {p.getX()[0] - trueCell.getX()[0], p.getX()[1] - trueCell.getX()[1],
@@ -54,7 +55,169 @@ static inline std::array<double, 3> getTruePos(const Particle &p, const Cell &c,
     }
 }
 
+// helper function to add the forces of the static (wall) particles in cell kc onto particle i
+// static particles receive no force and never interact with each other, so each pair is only evaluated from the side of
+// the moving particle, without checking for distinct pairs
+static inline void addStaticForces(Particle &i, Cell &kc, ParticleContainer &particles, CellContainer *lc,
+                                   std::uint64_t &pairs) {
+    for (ParticleHandle hj : kc.getStaticParticles()) {
+        const Particle &j = particles.resolve(hj);
+        ++pairs;
+
+        auto distVec = i.getX() - getTruePos(j, kc, lc);
+        double dist = ArrayUtils::L2NormSquared(distVec);
+        if (dist <= SQR(lc->getCutoff())) {
+            auto forceVec = getLJForceVec(i, j, distVec, std::sqrt(dist));
+            omp_set_lock(&i.getLock());
+            i.getF() = i.getF() + forceVec;
+            omp_unset_lock(&i.getLock());
+        }
+    }
+}
+
+// a particle of a cell as seen by a cell pair, with its (possibly faked) position
+struct SortedParticle {
+    std::array<double, 3> x;
+    Particle *particle;
+    ParticleHandle handle;
+    bool isStatic;
+};
+
+// the projection of a particle onto the axis joining the centres of a cell pair, and its index within its cell
+struct ProjectedParticle {
+    double projection;
+    std::uint32_t index;
+};
+
+// the range of a cell within the collected particles, together with the tight bounding box of its particles
+struct CellRange {
+    size_t begin;
+    size_t end;
+    std::array<double, 3> boxMin;
+    std::array<double, 3> boxMax;
+};
+
+// the stencil offsets sharing an axis; a pair of particles is within the cutoff band along an axis exactly if it is
+// within the band along its negation, so opposite offsets can use the same sorted order
+struct StencilAxis {
+    std::array<double, 3> direction;
+    std::vector<int> offsets;
+};
+
+// helper function to collect the regular and static particles of a cell into its range and get their bounding box
+template <size_t DIM>
+static inline void collectCell(Cell &c, ParticleContainer &particles, CellContainer *lc, SortedParticle *sorted,
+                               CellRange &range) {
+    range.boxMin.fill(std::numeric_limits<double>::max());
+    range.boxMax.fill(std::numeric_limits<double>::lowest());
+    size_t k = range.begin;
+    for (bool isStatic : {false, true}) {
+        for (ParticleHandle h : isStatic ? c.getStaticParticles() : c.getParticles()) {
+            Particle &p = particles.resolve(h);
+            const std::array<double, 3> x = getTruePos(p, c, lc);
+            sorted[k++] = {x, &p, h, isStatic};
+            for (size_t d = 0; d < DIM; ++d) {
+                range.boxMin[d] = std::min(range.boxMin[d], x[d]);
+                range.boxMax[d] = std::max(range.boxMax[d], x[d]);
+            }
+        }
+    }
+}
+
+// helper function to sort the particles of a cell by their projection onto an axis
+template <size_t DIM>
+static inline void sortAlongAxis(const SortedParticle *sorted, ProjectedParticle *order, const CellRange &range,
+                                 const std::array<double, 3> &axis) {
+    for (size_t k = range.begin; k < range.end; ++k) {
+        double projection = 0.0;
+        for (size_t d = 0; d < DIM; ++d)
+            projection += sorted[k].x[d] * axis[d];
+        order[k] = {projection, static_cast<std::uint32_t>(k - range.begin)};
+    }
+    std::sort(order + range.begin, order + range.end,
+              [](const ProjectedParticle &a, const ProjectedParticle &b) { return a.projection < b.projection; });
+}
+
+// helper function to get the squared distance between the bounding boxes of two cells
+template <size_t DIM> static inline double boxDistanceSquared(const CellRange &a, const CellRange &b) {
+    double dist = 0.0;
+    for (size_t d = 0; d < DIM; ++d) {
+        const double gap = std::max({0.0, b.boxMin[d] - a.boxMax[d], a.boxMin[d] - b.boxMax[d]});
+        dist += gap * gap;
+    }
+    return dist;
+}
+
+// helper function to add the force between two particles within the cutoff radius, except on static particles
+// in 2D, the z-components are skipped entirely
+template <size_t DIM>
+static inline void addPairForce(SortedParticle &i, SortedParticle &j, double cutoff, std::uint64_t &pairs) {
+    ++pairs;
+    std::array<double, 3> distVec{0.0, 0.0, 0.0};
+    double dist = 0.0;
+    for (size_t d = 0; d < DIM; ++d) {
+        distVec[d] = i.x[d] - j.x[d];
+        dist += distVec[d] * distVec[d];
+    }
+    if (dist > SQR(cutoff))
+        return;
+
+    auto forceVec = getLJForceVec(*i.particle, *j.particle, distVec, std::sqrt(dist));
+    if (!i.isStatic) {
+        omp_set_lock(&i.particle->getLock());
+        for (size_t d = 0; d < DIM; ++d)
+            i.particle->getF()[d] += forceVec[d];
+        omp_unset_lock(&i.particle->getLock());
+    }
+    if (!j.isStatic) {
+        omp_set_lock(&j.particle->getLock());
+        for (size_t d = 0; d < DIM; ++d)
+            j.particle->getF()[d] -= forceVec[d];
+        omp_unset_lock(&j.particle->getLock());
+    }
+}
+
+// helper function to evaluate all masked particle pairs of a cluster pair as a dense tile
+// the inner loop over the second cluster is branch-free, so that it can be vectorized across its CLUSTER_SIZE lanes
+static inline void computeClusterPair(const ParticleCluster &ci, const ParticleCluster &cj, ClusterPairMask mask,
+                                      ClusterForces &fi, ClusterForces &fj, double cutoffSquared) {
+    // static particles receive no force
+    const double reaction = mask == ClusterPairMask::STATIC ? 0.0 : 1.0;
+    for (size_t a = 0; a < CLUSTER_SIZE && ci.handles[a] != INVALID_HANDLE; ++a) {
+        const double xi = ci.x[a], yi = ci.y[a], zi = ci.z[a];
+        const double sqrtEpsilon = ci.sqrtEpsilon[a], halfSigma = ci.halfSigma[a];
+        const ParticleHandle hi = ci.handles[a];
+        double fxi = 0.0, fyi = 0.0, fzi = 0.0;
+#pragma omp simd reduction(+ : fxi, fyi, fzi)
+        for (size_t b = 0; b < CLUSTER_SIZE; ++b) {
+            const double dx = xi - cj.x[b], dy = yi - cj.y[b], dz = zi - cj.z[b];
+            const double distSquared = dx * dx + dy * dy + dz * dz;
+
+            // padded lanes are always beyond the cutoff radius
+            const bool use = distSquared <= cutoffSquared && (mask != ClusterPairMask::TRIANGLE || a < b) &&
+                             (mask != ClusterPairMask::HANDLES || hi < cj.handles[b]);
+            const double invDistSquared = use ? 1.0 / distSquared : 0.0;
+            const double sigma = halfSigma + cj.halfSigma[b];
+            const double sigmaOverDist2 = sigma * sigma * invDistSquared;
+            const double sigmaOverDist6 = sigmaOverDist2 * sigmaOverDist2 * sigmaOverDist2;
+            const double forceMag = 24 * sqrtEpsilon * cj.sqrtEpsilon[b] * invDistSquared * sigmaOverDist6 *
+                                    (2 * sigmaOverDist6 - 1);
+
+            fxi += forceMag * dx;
+            fyi += forceMag * dy;
+            fzi += forceMag * dz;
+            fj.x[b] -= reaction * forceMag * dx;
+            fj.y[b] -= reaction * forceMag * dy;
+            fj.z[b] -= reaction * forceMag * dz;
+        }
+        fi.x[a] += fxi;
+        fi.y[a] += fyi;
+        fi.z[a] += fzi;
+    }
+}
+
 /* documented functions start here */
+DISPATCH_KERNEL
 void calculateF_Gravity(ParticleContainer &particles, double, CellContainer *) {
     // loop over unique pairs
     for (auto pair = particles.beginPairs(); pair != particles.endPairs(); ++pair) {
@@ -77,13 +240,22 @@ void calculateF_Gravity(ParticleContainer &particles, double, CellContainer *) {
     }
 }
 
+DISPATCH_KERNEL
 void calculateF_LennardJones(ParticleContainer &particles, double, CellContainer *) {
+    // count the number of pairs for profiling
+    const size_t n = particles.size();
+    PhaseProfiler::countPairs(n * (n - 1) / 2);
+
     // loop over unique pairs
     for (size_t i = 0; i < particles.size(); ++i) {
         auto &p1 = particles[i];
         for (size_t j = i + 1; j < particles.size(); ++j) {
             auto &p2 = particles[j];
 
+            // neither wall particle would receive any force
+            if (IS_WALL(p1) && IS_WALL(p2))
+                continue;
+
             auto distVec = p1.getX() - p2.getX();
             double distNorm = ArrayUtils::L2Norm(distVec);
 
@@ -101,55 +273,142 @@ void calculateF_LennardJones(ParticleContainer &particles, double, CellContainer
     }
 }
 
-void calculateF_LennardJones_LC(ParticleContainer &particles, double, CellContainer *lc) {
+void calculateF_LennardJones_LC(ParticleContainer &particles, double cutoff, CellContainer *lc) {
+    if (lc->getDim() == 2)
+        calculateF_LennardJones_LC_dim<2>(particles, cutoff, lc);
+    else
+        calculateF_LennardJones_LC_dim<3>(particles, cutoff, lc);
+}
+
+template <size_t DIM>
+DISPATCH_KERNEL void calculateF_LennardJones_LC_dim(ParticleContainer &particles, double, CellContainer *lc) {
     // mirror border particles for periodic boundaries
     if (lc->getAnyPeriodic())
         mirrorGhostParticles(lc);
 
-// loop over all (regular) cells ic
-#pragma omp parallel for
-    CONTAINER_LOOP(lc->getIterableCells(), it) {
-        // loop over all active particles i in cell ic
-        auto &ic = CONTAINER_REF(it);
-        for (auto &ri : ic.get()) {
-            // loop over all cells kc in Neighbours(ic), including the particle i's own cell
-            for (auto &kc : lc->getNeighborCells(ic.get().getIndex())) {
-                // loop over all particles j in kc
-                for (auto &rj : kc.get()) {
-                    // check if i and j form a distinct pair (N3L)
-                    // note: we don't need to check for activity here, since all particles are guaranteed active
-                    //       all inactive particles have since been removed from the cells
-                    // for checking distinct pairs, we compare the memory addresses of the two particles
-                    Particle &i = ri;
-                    Particle &j = rj;
-                    if (&i >= &j)
-                        continue;
-
-                    // get the position used to calculate the distance between to particles
-                    std::array<double, 3> truePos = getTruePos(j, kc.get(), lc);
+    // only occupied cells contribute any pairs, empty neighbours are skipped right away
+    const std::vector<int> &occupied = lc->getOccupiedCells();
+    const std::vector<int> &stencil = lc->getStencil();
+    std::vector<Cell> &cells = lc->getCells();
+    const double cutoff = lc->getCutoff();
+
+    // the particles of the occupied and ghost cells are collected once, each into its own range
+    std::vector<int> sortedCells(occupied.begin(), occupied.end());
+    sortedCells.insert(sortedCells.end(), lc->getGhostCells().begin(), lc->getGhostCells().end());
+    std::vector<int> slot(cells.size(), -1);
+    std::vector<CellRange> ranges(sortedCells.size());
+    size_t total = 0;
+    for (size_t s = 0; s < sortedCells.size(); ++s) {
+        const Cell &c = cells[sortedCells[s]];
+        slot[sortedCells[s]] = static_cast<int>(s);
+        ranges[s].begin = total;
+        total += c.getParticles().size() + c.getStaticParticles().size();
+        ranges[s].end = total;
+    }
+    std::vector<SortedParticle> sorted(total);
+    std::vector<ProjectedParticle> order(total);
+
+    // group the stencil offsets by the axis joining the cell centres; the neighbours of iterable cells never leave the
+    // container, so any occupied cell can be used to measure the axes
+    // the pairs within a cell are sorted along the x-axis, which is the axis of the neighbour at offset 1
+    std::vector<StencilAxis> axes;
+    if (!occupied.empty()) {
+        const Cell &ref = cells[occupied.front()];
+        for (int offset : stencil) {
+            if (offset <= 0)
+                continue;
+            std::array<double, 3> axis = cells[ref.getIndex() + offset].getX() - ref.getX();
+            axis = ArrayUtils::elementWiseScalarOp(1.0 / ArrayUtils::L2Norm(axis), axis, std::multiplies<>());
+            axes.push_back({axis, {offset, -offset}});
+            if (offset == 1)
+                axes.back().offsets.push_back(0);
+        }
+    }
 
-                    // calculate the distance between the two particles
-                    auto distVec = i.getX() - truePos;
-                    double dist = ArrayUtils::L2NormSquared(distVec);
+#pragma omp parallel
+    {
+        PROFILE_THREAD(Phase::FORCE);
+        std::uint64_t pairs = 0;
+#pragma omp for schedule(runtime)
+        for (size_t s = 0; s < sortedCells.size(); ++s)
+            collectCell<DIM>(cells[sortedCells[s]], particles, lc, sorted.data(), ranges[s]);
+
+        // each cell is sorted only once per axis, for all of its pairs along that axis
+        for (const StencilAxis &axis : axes) {
+#pragma omp for schedule(runtime)
+            for (size_t s = 0; s < sortedCells.size(); ++s)
+                sortAlongAxis<DIM>(sorted.data(), order.data(), ranges[s], axis.direction);
+
+// loop over all occupied (regular) cells ic
+#pragma omp for schedule(runtime)
+            CONTAINER_LOOP(occupied, it) {
+                Cell &ic = cells[CONTAINER_REF(it)];
+                const CellRange &rangeI = ranges[slot[ic.getIndex()]];
+                SortedParticle *particlesI = sorted.data() + rangeI.begin;
+                const ProjectedParticle *orderI = order.data() + rangeI.begin;
+                const size_t sizeI = rangeI.end - rangeI.begin;
+
+                // loop over all cells kc in Neighbours(ic) along this axis, including ic itself
+                for (int offset : axis.offsets) {
+                    Cell &kc = cells[ic.getIndex() + offset];
+                    const bool halo = kc.getType() == CellType::HALO;
+
+                    // each pair of iterable cells is only handled once, from the cell with the lower index
+                    // pairs with ghost particles are still distinguished by comparing the (unique) handles
+                    if ((offset < 0 && !halo) || slot[kc.getIndex()] < 0)
+                        continue;
 
-                    // compute force if distance is less than cutoff
-                    if (dist <= SQR(lc->getCutoff())) {
-                        // calculate force
-                        double distNorm = std::sqrt(dist);
-                        auto forceVec = getLJForceVec(i, j, distVec, distNorm);
+                    // within a single cell, particles are sorted along the x-axis and paired with their successors
+                    if (offset == 0) {
+                        for (size_t a = 0; a < sizeI; ++a) {
+                            for (size_t b = a + 1; b < sizeI; ++b) {
+                                // every later particle is even further away along the axis
+                                if (orderI[b].projection - orderI[a].projection > cutoff)
+                                    break;
+                                SortedParticle &i = particlesI[orderI[a].index];
+                                SortedParticle &j = particlesI[orderI[b].index];
+                                if (!i.isStatic || !j.isStatic)
+                                    addPairForce<DIM>(i, j, cutoff, pairs);
+                            }
+                        }
+                        continue;
+                    }
 
-                        // apply force on non-wall particles (no force on ghost particle)
-                        omp_set_lock(&i.getLock());
-                        DO_IF_NOT_WALL(i, i.getF() = i.getF() + forceVec);
-                        omp_unset_lock(&i.getLock());
+                    // skip the whole cell pair if the bounding boxes of their particles are too far apart
+                    const CellRange &rangeK = ranges[slot[kc.getIndex()]];
+                    if (boxDistanceSquared<DIM>(rangeI, rangeK) > SQR(cutoff))
+                        continue;
 
-                        omp_set_lock(&j.getLock());
-                        DO_IF_NOT_WALL(j, j.getF() = j.getF() - forceVec);
-                        omp_unset_lock(&j.getLock());
+                    // both cells are sorted along the axis joining their centres; the partners of each particle i are
+                    // then a window of kc's particles within the cutoff radius along the axis, which only ever moves
+                    // forward
+                    SortedParticle *particlesK = sorted.data() + rangeK.begin;
+                    const ProjectedParticle *orderK = order.data() + rangeK.begin;
+                    const size_t sizeK = rangeK.end - rangeK.begin;
+                    size_t window = 0;
+                    for (size_t a = 0; a < sizeI; ++a) {
+                        SortedParticle &i = particlesI[orderI[a].index];
+                        while (window < sizeK && orderK[window].projection < orderI[a].projection - cutoff)
+                            ++window;
+                        for (size_t b = window; b < sizeK; ++b) {
+                            if (orderK[b].projection > orderI[a].projection + cutoff)
+                                break;
+                            SortedParticle &j = particlesK[orderK[b].index];
+
+                            // static particles never interact with each other; static ghost particles interact with
+                            // the regular particles of ic, while regular ghost particles only interact with the
+                            // regular particles of ic with a smaller handle
+                            if (i.isStatic && j.isStatic)
+                                continue;
+                            if (halo && (i.isStatic || (!j.isStatic && i.handle >= j.handle)))
+                                continue;
+                            addPairForce<DIM>(i, j, cutoff, pairs);
+                        }
                     }
                 }
             }
         }
+        PhaseProfiler::countPairs(pairs);
     }
 
     // delete ghost particles in the end
@@ -157,33 +416,47 @@ void calculateF_LennardJones_LC(ParticleContainer &particles, double, CellContai
         deleteGhostParticles(lc);
 }
 
+template void calculateF_LennardJones_LC_dim<2>(ParticleContainer &particles, double, CellContainer *lc);
+template void calculateF_LennardJones_LC_dim<3>(ParticleContainer &particles, double, CellContainer *lc);
+
+DISPATCH_KERNEL
 void calculateF_LennardJones_LC_task(ParticleContainer &particles, double, CellContainer *lc) {
     // mirror border particles for periodic boundaries
     if (lc->getAnyPeriodic())
         mirrorGhostParticles(lc);
 
+    // only occupied cells contribute any pairs, empty neighbours are skipped by the inner loop
+    const std::vector<int> &occupied = lc->getOccupiedCells();
+    const std::vector<int> &stencil = lc->getStencil();
+    std::vector<Cell> &cells = lc->getCells();
+
 #pragma omp parallel
     {
 #pragma omp single nowait
         {
-            // loop over all (regular) cells ic
-            for (auto &ic : lc->getIterableCells()) {
-#pragma omp task firstprivate(ic)
+            // loop over all occupied (regular) cells ic
+            for (int index : occupied) {
+#pragma omp task firstprivate(index)
                 {
+                    PROFILE_ACCUMULATE(Phase::FORCE);
+                    std::uint64_t pairs = 0;
+                    Cell &ic = cells[index];
                     // loop over all active particles i in cell ic
-                    for (auto &ri : ic.get()) {
+                    for (ParticleHandle hi : ic) {
+                        Particle &i = particles.resolve(hi);
                         // loop over all cells kc in Neighbours(ic), including the particle i's own cell
-                        for (auto &kc : lc->getNeighborCells(ic.get().getIndex())) {
+                        for (int offset : stencil) {
+                            Cell &kc = cells[index + offset];
                             // loop over all particles j in kc
-                            for (auto &rj : kc.get()) {
+                            for (ParticleHandle hj : kc) {
                                 // check if i and j form a distinct pair (N3L)
-                                Particle &i = ri;
-                                Particle &j = rj;
-                                if (&i >= &j)
+                                if (hi >= hj)
                                     continue;
+                                Particle &j = particles.resolve(hj);
+                                ++pairs;
 
                                 // get the position used to calculate the distance between to particles
-                                std::array<double, 3> truePos = getTruePos(j, kc.get(), lc);
+                                std::array<double, 3> truePos = getTruePos(j, kc, lc);
 
                                 // calculate the distance between the two particles
                                 auto distVec = i.getX() - truePos;
@@ -209,8 +482,11 @@ void calculateF_LennardJones_LC_task(ParticleContainer &particles, double, CellC
                                     omp_unset_lock(&j.getLock());
                                 }
                             }
+                            // static particles are never the first particle of a pair
+                            addStaticForces(i, kc, particles, lc, pairs);
                         }
                     }
+                    PhaseProfiler::countPairs(pairs);
                 } // end task
             }
         } // end single region
@@ -221,74 +497,276 @@ void calculateF_LennardJones_LC_task(ParticleContainer &particles, double, CellC
         deleteGhostParticles(lc);
 }
 
-void calculateF_Membrane_LC(ParticleContainer &particles, double, CellContainer *lc) {
-    SPDLOG_TRACE("r0: {}, k: {}", particles[0].getR0(), particles[0].getK());
+DISPATCH_KERNEL
+void calculateF_LennardJones_LC_cluster(ParticleContainer &particles, double, CellContainer *lc) {
+    // the clusters and pairs are kept in the cell container between steps, so that their memory is reused
+    ClusterPairList &clusterPairs = lc->getClusterPairs();
 
     // mirror border particles for periodic boundaries
-    if (VEC_CONTAINS(lc->getConditions(), BoundaryCondition::PERIODIC))
+    if (lc->getAnyPeriodic())
         mirrorGhostParticles(lc);
+    clusterPairs.build(*lc);
 
-// loop over all cells ic
-#pragma omp parallel for
-    CONTAINER_LOOP(lc->getIterableCells(), it) {
-        auto &ic = CONTAINER_REF(it);
-        // loop over all active particles i in cell ic
-        for (auto &ri : ic.get()) {
-            Particle &i = ri;
-            // add special force to the particles that are concerned
-            // add a gravitational force on the z-axis (NOT ON THE Y AXIS AS PER USUAL)
-            // again, specific to the given scenario
-            if (particles.getSpecialForceLimit() != 0) {
-                omp_set_lock(&i.getLock());
-                i.getF()[2] += i.getFZUP();
-                omp_unset_lock(&i.getLock());
-                SPDLOG_TRACE("Added force (gravity + F_Z-UP): {}", ArrayUtils::to_string(i.getF()));
+    const std::vector<ParticleCluster> &clusters = clusterPairs.getClusters();
+    const size_t numLists = clusterPairs.getNumLists();
+    const double cutoffSquared = SQR(lc->getCutoff());
+
+// each thread processes its own pair lists into their own force buffers, so no locks are needed
+#pragma omp parallel
+    {
+        PROFILE_THREAD(Phase::FORCE);
+        std::uint64_t pairs = 0;
+        for (size_t l = omp_get_thread_num(); l < numLists; l += omp_get_num_threads()) {
+            std::vector<ClusterForces> &forces = clusterPairs.getForces(l);
+            for (const ClusterPair &pair : clusterPairs.getPairs(l))
+                computeClusterPair(clusters[pair.i], clusters[pair.j], pair.mask, forces[pair.i], forces[pair.j],
+                                   cutoffSquared);
+            pairs += clusterPairs.getPairs(l).size() * CLUSTER_SIZE * CLUSTER_SIZE;
+        }
+        PhaseProfiler::countPairs(pairs);
+    }
+    clusterPairs.applyForces(particles);
+
+    // delete ghost particles in the end
+    if (lc->getAnyPeriodic())
+        deleteGhostParticles(lc);
+}
+
+DISPATCH_KERNEL
+void calculateF_LennardJones_LC_tree(ParticleContainer &particles, double, CellContainer *lc) {
+    // the tree is kept in the cell container between steps, so that its memory is reused
+    Octree &tree = lc->getTree();
+
+    // mirror border particles for periodic boundaries
+    if (lc->getAnyPeriodic())
+        mirrorGhostParticles(lc);
+    tree.build(*lc);
+
+    const std::vector<OctreeEntry> &entries = tree.getEntries();
+    const std::vector<OctreeNode> &nodes = tree.getNodes();
+    const std::vector<std::uint32_t> &leaves = tree.getLeaves();
+    const double cutoffSquared = SQR(lc->getCutoff());
+
+// loop over all leaves; leaves in dense regions are small, so the work per leaf varies less than per cell
+#pragma omp parallel
+    {
+        PROFILE_THREAD(Phase::FORCE);
+        std::uint64_t pairs = 0;
+        std::vector<std::uint32_t> neighbors;
+#pragma omp for schedule(dynamic) nowait
+        for (size_t l = 0; l < leaves.size(); ++l) {
+            const OctreeNode &leaf = nodes[leaves[l]];
+            neighbors.clear();
+            for (std::uint32_t a = leaf.begin; a < leaf.end; ++a) {
+                // only regular particles are the first particle of a pair
+                const OctreeEntry &ei = entries[a];
+                if (ei.isStatic || ei.isGhost)
+                    continue;
+                if (neighbors.empty())
+                    tree.getNeighborLeaves(leaves[l], lc->getCutoff(), neighbors);
+                Particle &i = particles.resolve(ei.handle);
+
+                // loop over all particles j in the leaves within the cutoff radius, including i's own leaf
+                for (std::uint32_t n : neighbors) {
+                    for (std::uint32_t b = nodes[n].begin; b < nodes[n].end; ++b) {
+                        // static particles receive no force, so their pairs are only evaluated from the moving side
+                        // for checking distinct pairs otherwise, we compare the (unique) handles of the two particles
+                        const OctreeEntry &ej = entries[b];
+                        if (!ej.isStatic && ei.handle >= ej.handle)
+                            continue;
+                        Particle &j = particles.resolve(ej.handle);
+                        ++pairs;
+
+                        auto distVec = ei.x - ej.x;
+                        double dist = ArrayUtils::L2NormSquared(distVec);
+                        if (dist <= cutoffSquared) {
+                            auto forceVec = getLJForceVec(i, j, distVec, std::sqrt(dist));
+                            omp_set_lock(&i.getLock());
+                            i.getF() = i.getF() + forceVec;
+                            omp_unset_lock(&i.getLock());
+                            if (!ej.isStatic) {
+                                omp_set_lock(&j.getLock());
+                                j.getF() = j.getF() - forceVec;
+                                omp_unset_lock(&j.getLock());
+                            }
+                        }
+                    }
+                }
             }
+        }
+        PhaseProfiler::countPairs(pairs);
+    }
 
-            // loop over all cells kc in Neighbours(ic), including the particle i's own cell
-            for (auto &kc : lc->getNeighborCells(ic.get().getIndex())) {
-                // loop over all particles j in kc
-                for (auto &rj : kc.get()) {
-                    // check if j is active AND if i and j form a distinct pair (N3L)
-                    // for checking distinct pairs, we compare the memory addresses of the two particles
-                    Particle &j = rj;
-                    if (&i >= &j)
-                        continue;
+    // delete ghost particles in the end
+    if (lc->getAnyPeriodic())
+        deleteGhostParticles(lc);
+}
+
+DISPATCH_KERNEL
+void calculateF_LennardJones_LC_levels(ParticleContainer &particles, double, CellContainer *lc) {
+    // the grids are kept in the cell container between steps, so that their memory is reused
+    HierarchicalGrid &grid = lc->getGrid();
+
+    // mirror border particles for periodic boundaries
+    if (lc->getAnyPeriodic())
+        mirrorGhostParticles(lc);
+    grid.build(*lc);
+
+    const std::vector<GridEntry> &entries = grid.getEntries();
 
-                    std::array<double, 3> truePos = getTruePos(j, kc.get(), lc);
-                    std::array<double, 3> forceVec = {0.0, 0.0, 0.0};
-
-                    // calculate the distance between the two particles
-                    auto distVec = i.getX() - truePos;
-                    double distNorm = ArrayUtils::L2Norm(distVec);
-                    double specialCutoff = LJTHRESHOLD * ((i.getSigma() + j.getSigma()) / 2.0);
-
-                    if (inNeighbourVector(i.getDirectNeighbours(), rj)) {
-                        // compute scalar for direct neighbors
-                        double scalar = i.getK() * (distNorm - i.getR0()) * (1 / distNorm);
-                        // because as a distance we use x_i - x_j as distVec when the formula says x_j - x_i,
-                        // we multiply by -1
-                        forceVec = ArrayUtils::elementWiseScalarOp(-scalar, distVec, std::multiplies<>());
-                    } else if (inNeighbourVector(i.getDiagonalNeighbours(), rj)) {
-                        // compute scalar for diagonal neighbors
-                        double scalar = i.getK() * (distNorm - SQRT2 * i.getR0()) * (1 / distNorm);
-                        forceVec = ArrayUtils::elementWiseScalarOp(-scalar, distVec, std::multiplies<>());
-                    } else if (distNorm <= specialCutoff) {
-                        // calculate special LJ force to prevent self-pen
-                        forceVec = getLJForceVec(i, j, distVec, distNorm);
+// loop over all particles i, which are sorted by level and cell
+#pragma omp parallel
+    {
+        PROFILE_THREAD(Phase::FORCE);
+        std::uint64_t pairs = 0;
+#pragma omp for schedule(dynamic, 64) nowait
+        for (size_t a = 0; a < entries.size(); ++a) {
+            const GridEntry &ei = entries[a];
+            if (ei.isGhost)
+                continue;
+            Particle &i = particles.resolve(ei.handle);
+            const size_t level = HierarchicalGrid::getLevel(ei.cutoff, lc->getCutoff());
+
+            // loop over i's own level and all coarser levels
+            for (size_t l = 0; l <= level; ++l) {
+                // static particles are only the first particle of a pair across levels
+                if (ei.isStatic && l == level)
+                    continue;
+                grid.forEachNeighborCell(l, ei.x, [&](std::uint32_t begin, std::uint32_t end) {
+                    for (std::uint32_t b = begin; b < end; ++b) {
+                        // on the same level, each distinct pair is visited from the particle with the smaller handle,
+                        // like in the regular force calculation; across levels, pairs are always visited from the
+                        // finer level
+                        const GridEntry &ej = entries[b];
+                        if (ei.isStatic && ej.isStatic)
+                            continue;
+                        if (l == level && !ej.isStatic && ei.handle >= ej.handle)
+                            continue;
+                        Particle &j = particles.resolve(ej.handle);
+                        ++pairs;
+
+                        auto distVec = ei.x - ej.x;
+                        double dist = ArrayUtils::L2NormSquared(distVec);
+                        if (dist <= SQR((ei.cutoff + ej.cutoff) / 2)) {
+                            auto forceVec = getLJForceVec(i, j, distVec, std::sqrt(dist));
+                            if (!ei.isStatic) {
+                                omp_set_lock(&i.getLock());
+                                i.getF() = i.getF() + forceVec;
+                                omp_unset_lock(&i.getLock());
+                            }
+                            if (!ej.isStatic) {
+                                omp_set_lock(&j.getLock());
+                                j.getF() = j.getF() - forceVec;
+                                omp_unset_lock(&j.getLock());
+                            }
+                        }
                     }
+                });
+            }
+        }
+        PhaseProfiler::countPairs(pairs);
+    }
+
+    // delete ghost particles in the end
+    if (lc->getAnyPeriodic())
+        deleteGhostParticles(lc);
+}
+
+DISPATCH_KERNEL
+void calculateF_Membrane_LC(ParticleContainer &particles, double, CellContainer *lc) {
+    SPDLOG_TRACE("r0: {}, k: {}", particles[0].getR0(), particles[0].getK());
 
-                    // apply force on particle i (no force on ghost particle)
+    // mirror border particles for periodic boundaries
+    if (VEC_CONTAINS(lc->getConditions(), BoundaryCondition::PERIODIC))
+        mirrorGhostParticles(lc);
+
+    const std::vector<int> &occupied = lc->getOccupiedCells();
+    const std::vector<int> &stencil = lc->getStencil();
+    std::vector<Cell> &cells = lc->getCells();
+
+// loop over all occupied cells ic
+#pragma omp parallel
+    {
+        PROFILE_THREAD(Phase::FORCE);
+        std::uint64_t pairs = 0;
+#pragma omp for schedule(runtime) nowait
+        CONTAINER_LOOP(occupied, it) {
+            Cell &ic = cells[CONTAINER_REF(it)];
+            // loop over all active particles i in cell ic
+            for (ParticleHandle hi : ic) {
+                Particle &i = particles.resolve(hi);
+                // add special force to the particles that are concerned
+                // add a gravitational force on the z-axis (NOT ON THE Y AXIS AS PER USUAL)
+                // again, specific to the given scenario
+                if (particles.getSpecialForceLimit() != 0) {
                     omp_set_lock(&i.getLock());
-                    i.getF() = i.getF() + forceVec;
+                    i.getF()[2] += i.getFZUP();
                     omp_unset_lock(&i.getLock());
+                    SPDLOG_TRACE("Added force (gravity + F_Z-UP): {}", ArrayUtils::to_string(i.getF()));
+                }
+
+                // loop over all cells kc in Neighbours(ic), including the particle i's own cell
+                for (int offset : stencil) {
+                    Cell &kc = cells[ic.getIndex() + offset];
+                    // loop over all particles j in kc
+                    for (ParticleHandle hj : kc) {
+                        // check if j is active AND if i and j form a distinct pair (N3L)
+                        // for checking distinct pairs, we compare the (unique) handles of the two particles
+                        if (hi >= hj)
+                            continue;
+                        Particle &j = particles.resolve(hj);
+                        ++pairs;
+
+                        std::array<double, 3> truePos = getTruePos(j, kc, lc);
+                        std::array<double, 3> forceVec = {0.0, 0.0, 0.0};
+
+                        // calculate the distance between the two particles
+                        auto distVec = i.getX() - truePos;
+                        double distNorm = ArrayUtils::L2Norm(distVec);
+                        double specialCutoff = LJTHRESHOLD * ((i.getSigma() + j.getSigma()) / 2.0);
+
+                        if (inNeighbourVector(i.getDirectNeighbours(), hj)) {
+                            // compute scalar for direct neighbors
+                            double scalar = i.getK() * (distNorm - i.getR0()) * (1 / distNorm);
+                            // because as a distance we use x_i - x_j as distVec when the formula says x_j - x_i,
+                            // we multiply by -1
+                            forceVec = ArrayUtils::elementWiseScalarOp(-scalar, distVec, std::multiplies<>());
+                        } else if (inNeighbourVector(i.getDiagonalNeighbours(), hj)) {
+                            // compute scalar for diagonal neighbors
+                            double scalar = i.getK() * (distNorm - SQRT2 * i.getR0()) * (1 / distNorm);
+                            forceVec = ArrayUtils::elementWiseScalarOp(-scalar, distVec, std::multiplies<>());
+                        } else if (distNorm <= specialCutoff) {
+                            // calculate special LJ force to prevent self-pen
+                            forceVec = getLJForceVec(i, j, distVec, distNorm);
+                        }
 
-                    omp_set_lock(&j.getLock());
-                    j.getF() = j.getF() - forceVec;
-                    omp_unset_lock(&j.getLock());
+                        // apply force on particle i (no force on ghost particle)
+                        omp_set_lock(&i.getLock());
+                        i.getF() = i.getF() + forceVec;
+                        omp_unset_lock(&i.getLock());
+
+                        omp_set_lock(&j.getLock());
+                        j.getF() = j.getF() - forceVec;
+                        omp_unset_lock(&j.getLock());
+                    }
+                    // static particles are never the first particle of a pair, and only repel the membrane
+                    for (ParticleHandle hj : kc.getStaticParticles()) {
+                        const Particle &j = particles.resolve(hj);
+                        ++pairs;
+
+                        auto distVec = i.getX() - getTruePos(j, kc, lc);
+                        double distNorm = ArrayUtils::L2Norm(distVec);
+                        if (distNorm <= LJTHRESHOLD * ((i.getSigma() + j.getSigma()) / 2.0)) {
+                            auto forceVec = getLJForceVec(i, j, distVec, distNorm);
+                            omp_set_lock(&i.getLock());
+                            i.getF() = i.getF() + forceVec;
+                            omp_unset_lock(&i.getLock());
+                        }
+                    }
                 }
             }
         }
+        PhaseProfiler::countPairs(pairs);
     }
 
     // decrement special case iteration count
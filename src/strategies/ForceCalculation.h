@@ -61,6 +61,12 @@ void calculateF_LennardJones(ParticleContainer &particles, double, CellContainer
  * particle pair in the entire container, the algorithm only uses particles within the cell neighborhood of the current
  * particle.
  *
+ * Each pair of neighbouring cells is only visited once. Cell pairs whose particles' bounding boxes are further apart
+ * than the cutoff radius are skipped entirely. Otherwise, the particles of both cells are sorted by their projection
+ * onto the axis joining the cell centers. Since the projected distance is a lower bound of the actual distance, the
+ * partners of each particle form a sliding window of the other cell's particles, and the search stops as soon as the
+ * projected distance exceeds the cutoff radius.
+ *
  * For parallelization, the domain is split into chunks distributed amonst threads. This is done using standard OpenMP
  * loop parallelization.
  *
@@ -73,10 +79,26 @@ void calculateF_LennardJones(ParticleContainer &particles, double, CellContainer
  *
  * @image html lj-lc.png A comparison of the linked-cell LJ methods.
  *
+ * This function dispatches to calculateF_LennardJones_LC_dim() based on the dimensions of the CellContainer.
+ *
  * @param particles The ParticleContainer containing the Particle objects to iterate over.
+ * @param cutoff The cutoff radius.
  * @param lc The CellContainer for the linked cells method.
  */
-void calculateF_LennardJones_LC(ParticleContainer &particles, double, CellContainer *lc);
+void calculateF_LennardJones_LC(ParticleContainer &particles, double cutoff, CellContainer *lc);
+
+/**
+ * @brief Calculates the force \f$ F \f$ for all particles like calculateF_LennardJones_LC(), specialized for a fixed
+ * number of dimensions.
+ *
+ * @details In 2D, the z-components of distances, bounding boxes and forces are skipped at compile time. Since the
+ * dimensions never change during a simulation, the StrategyFactory picks the matching specialization once.
+ *
+ * @tparam DIM The number of dimensions of the CellContainer, either 2 or 3.
+ * @param particles The ParticleContainer containing the Particle objects to iterate over.
+ * @param lc The CellContainer for the linked cells method.
+ */
+template <size_t DIM> void calculateF_LennardJones_LC_dim(ParticleContainer &particles, double, CellContainer *lc);
 
 /**
  * @brief Calculates the force \f$ F \f$ for all particles using a naive approach for a linked-cell LennardJones
@@ -95,6 +117,69 @@ void calculateF_LennardJones_LC(ParticleContainer &particles, double, CellContai
  */
 void calculateF_LennardJones_LC_task(ParticleContainer &particles, double, CellContainer *lc);
 
+/**
+ * @brief Calculates the force \f$ F \f$ for all particles in a linked-cell LennardJones simulation using cluster pairs.
+ *
+ * @details The particles of each cell are grouped into clusters of CLUSTER_SIZE particles by a ClusterPairList, which
+ * is rebuilt every step. Each pair of neighbouring clusters within the cutoff radius is evaluated as a dense tile,
+ * whose inner loop is vectorized across the lanes of the second cluster. Pairs which are not distinct or beyond the
+ * cutoff radius are masked out instead of branched over, trading a few wasted computations for vector throughput.
+ *
+ * For parallelization, each thread processes its own cluster pair lists into a private force buffer. The buffers are
+ * summed up once all pairs have been evaluated.
+ *
+ * **Complexity:** \f$ O(N) \f$
+ *
+ * This method uses Newton's Third Law \f[ F_{ij} = -F_{ji}. \f] to avoid calculating the force twice.
+ *
+ * @param particles The ParticleContainer containing the Particle objects to iterate over.
+ * @param lc The CellContainer for the linked cells method.
+ */
+void calculateF_LennardJones_LC_cluster(ParticleContainer &particles, double, CellContainer *lc);
+
+/**
+ * @brief Calculates the force \f$ F \f$ for all particles in a linked-cell LennardJones simulation using an adaptive
+ * octree for the neighbour search.
+ *
+ * @details The particles of the CellContainer, including static and ghost particles, are sorted into an Octree, which
+ * is rebuilt every step. For each leaf, all leaves within the cutoff radius are looked up once and used as the
+ * neighbourhood of its particles. Since the leaves adapt to the local density, this avoids both scanning many nearly
+ * empty cells in dilute regions and large candidate sets in overcrowded cells, e.g. while a gas condenses into
+ * droplets.
+ *
+ * For parallelization, the leaves are distributed dynamically amongst threads.
+ *
+ * **Complexity:** \f$ O(N \log N) \f$
+ *
+ * This method uses Newton's Third Law \f[ F_{ij} = -F_{ji}. \f] to avoid calculating the force twice.
+ *
+ * @param particles The ParticleContainer containing the Particle objects to iterate over.
+ * @param lc The CellContainer for the linked cells method.
+ */
+void calculateF_LennardJones_LC_tree(ParticleContainer &particles, double, CellContainer *lc);
+
+/**
+ * @brief Calculates the force \f$ F \f$ for all particles in a linked-cell LennardJones simulation with per-pair cutoff
+ * radii using a hierarchy of grids.
+ *
+ * @details If the CellContainer has a pair cutoff factor \f$ f \f$, the cutoff radius of each pair is \f$ f \cdot
+ * \sigma_{ij} \f$, otherwise it is the cutoff radius of the CellContainer. The particles are sorted into a
+ * HierarchicalGrid every step, where each species lives on a level matching its own cutoff radius. Pairs on the same
+ * level are searched like in the regular linked cell method, pairs across levels are visited from the finer level.
+ * Mixtures of large and small particles (e.g. colloids in a solvent) thus do not impose the large cutoff radius on
+ * the many pairs of small particles.
+ *
+ * For parallelization, the particles are distributed dynamically amongst threads.
+ *
+ * **Complexity:** \f$ O(N) \f$
+ *
+ * This method uses Newton's Third Law \f[ F_{ij} = -F_{ji}. \f] to avoid calculating the force twice.
+ *
+ * @param particles The ParticleContainer containing the Particle objects to iterate over.
+ * @param lc The CellContainer for the linked cells method.
+ */
+void calculateF_LennardJones_LC_levels(ParticleContainer &particles, double, CellContainer *lc);
+
 /**
  * @brief Calculates the force \f$ F \f$ for all particles in a linked-cell membrane simulation using a standard
  * parallelization approach.
@@ -3,85 +3,137 @@
 #include "objects/CellContainer.h"
 #include "objects/ParticleContainer.h"
 #include "utils/ArrayUtils.h"
+#include "utils/CPUDispatch.h"
 #include "utils/OMPWrapper.h"
+#include "utils/PhaseProfiler.h"
 #include <functional>
 #include <spdlog/spdlog.h>
 #include <vector>
 
+DISPATCH_KERNEL
 void calculateX(ParticleContainer &particles, double delta_t, double g_grav, CellContainer *, bool) {
     SPDLOG_TRACE("Calculating new position...");
 
-#pragma omp parallel for
-    CONTAINER_LOOP(particles, it) {
-        auto &p = CONTAINER_REF(it);
-        CONTINUE_IF_INACTIVE(p);
-        SKIP_IF_WALL(p);
-
-        // update position
-        const std::array<double, 3> posSum1 = ArrayUtils::elementWiseScalarOp(delta_t, p.getV(), std::multiplies<>());
-        const std::array<double, 3> posSum2 =
-            ArrayUtils::elementWiseScalarOp((delta_t * delta_t) / (2 * p.getM()), p.getF(), std::multiplies<>());
-        p.getX() = p.getX() + posSum1 + posSum2;
-
-        // store previous force, then reset force to 0
-        p.setOldF(p.getF());
-        p.setF({0.0, p.getM() * g_grav, 0.0});
+#pragma omp parallel
+    {
+        PROFILE_THREAD(Phase::POSITION);
+#pragma omp for nowait
+        CONTAINER_LOOP(particles, it) {
+            auto &p = CONTAINER_REF(it);
+            CONTINUE_IF_INACTIVE(p);
+            SKIP_IF_WALL(p);
+
+            // update position
+            const std::array<double, 3> posSum1 =
+                ArrayUtils::elementWiseScalarOp(delta_t, p.getV(), std::multiplies<>());
+            const std::array<double, 3> posSum2 =
+                ArrayUtils::elementWiseScalarOp((delta_t * delta_t) / (2 * p.getM()), p.getF(), std::multiplies<>());
+            p.getX() = p.getX() + posSum1 + posSum2;
+
+            // store previous force, then reset force to 0
+            p.setOldF(p.getF());
+            p.setF({0.0, p.getM() * g_grav, 0.0});
+        }
     }
 }
 
 void calculateX_LC(ParticleContainer &particles, double delta_t, double g_grav, CellContainer *lc, bool membrane) {
-    SPDLOG_TRACE("Calculating new position (linked cells)...");
+    // without knowing the simulation, inactive and wall particles have to be expected
+    const StepFeatures features{lc->getDim(), true, true, membrane};
+    dispatchStepPolicy(features, [&](auto policy) {
+        calculateX_LC_policy<decltype(policy)>(particles, delta_t, g_grav, lc, membrane);
+    });
+}
 
-#pragma omp parallel for
-    CONTAINER_LOOP(particles, it) {
-        auto &p = CONTAINER_REF(it);
-        CONTINUE_IF_INACTIVE(p);
-        SKIP_IF_WALL(p);
-
-        // update position (maybe precompute dt^2, even though it's probably only marginally faster, if anything)
-        const std::array<double, 3> posSum1 = ArrayUtils::elementWiseScalarOp(delta_t, p.getV(), std::multiplies<>());
-        const std::array<double, 3> posSum2 =
-            ArrayUtils::elementWiseScalarOp((delta_t * delta_t) / (2 * p.getM()), p.getF(), std::multiplies<>());
-        p.getX() = p.getX() + posSum1 + posSum2;
-
-        // store previous force for velocity calculation, then reset force to 0
-        // optimization: add graviational force here
-        // we can do this because the forces are additive; it doesn't matter if we first calculate the forces
-        // between the particles or the gravitational force thus, we save having to iterate through all particles
-        // once again after calculating the force
-        p.getOldF() = p.getF();
-        if (!membrane) {
-            p.setF({0.0, p.getM() * g_grav, 0.0});
-        } else {
-            p.setF({0.0, 0.0, p.getM() * g_grav});
-        }
+template <typename Policy>
+DISPATCH_KERNEL void calculateX_LC_policy(ParticleContainer &particles, double delta_t, double g_grav,
+                                          CellContainer *lc, bool) {
+    SPDLOG_TRACE("Calculating new position (linked cells)...");
+    const bool lazy = lc->getSkin() > 0;
+    bool deactivated = false;
 
-        // check to see if the particle's cell index got updated
-        int newIdx = lc->getCellIndex(p.getX());
+#pragma omp parallel
+    {
+        PROFILE_THREAD(Phase::POSITION);
+#pragma omp for reduction(|| : deactivated) nowait
+        CONTAINER_LOOP(particles, it) {
+            auto &p = CONTAINER_REF(it);
+            if constexpr (Policy::OUTFLOW)
+                CONTINUE_IF_INACTIVE(p);
+            if constexpr (Policy::WALLS)
+                SKIP_IF_WALL(p);
 
-        // if the particle is somehow out of bounds, remove it
-        // note: this could probably be moved inside the next if statement...
-        if (newIdx == -1) {
-            SPDLOG_ERROR("Particle {} out of bounds! Removing...", p.toString());
-            p.markInactive();
-            p.setCellIndex(-1);
-            continue;
-        }
+            // update position (maybe precompute dt^2, even though it's probably only marginally faster, if anything)
+            // in 2D, the z-coordinate stays untouched
+            const double forceScale = (delta_t * delta_t) / (2 * p.getM());
+            for (size_t d = 0; d < Policy::DIM; ++d)
+                p.getX()[d] = p.getX()[d] + delta_t * p.getV()[d] + forceScale * p.getF()[d];
 
-        // if the particle's stored cell index does not match the newly calculated index, move it
-        if (newIdx != p.getCellIndex()) {
-            SPDLOG_TRACE("Index mismatch (current: {}, expected: {}), moving...", p.getCellIndex(), newIdx);
-            Cell &targetCell = (*lc)[newIdx];
+            // store previous force for velocity calculation, then reset force to 0
+            // optimization: add graviational force here
+            // we can do this because the forces are additive; it doesn't matter if we first calculate the forces
+            // between the particles or the gravitational force thus, we save having to iterate through all particles
+            // once again after calculating the force
+            p.getOldF() = p.getF();
+            if constexpr (!Policy::MEMBRANE) {
+                p.setF({0.0, p.getM() * g_grav, 0.0});
+            } else {
+                p.setF({0.0, 0.0, p.getM() * g_grav});
+            }
 
-            // check if the particle entered a halo cell and apply the correct boundary condition
-            if (handleHaloCell(p, targetCell, lc))
+            // with a skin, only particles which may have left their cell have to be sorted into a cell again
+            if (lazy && lc->isWithinSkin<Policy::DIM>(p.getX(), p.getCellIndex()))
                 continue;
 
-            // move particle (update stored cell index)
-            if (!lc->moveParticle(p)) {
-                SPDLOG_ERROR("Cannot move particle {}!", p.toString());
+            // check to see if the particle's cell index got updated
+            int newIdx = lc->getCellIndex<Policy::DIM>(p.getX());
+
+            // if the particle is somehow out of bounds, remove it
+            // note: this could probably be moved inside the next if statement...
+            if (newIdx == -1) {
+                SPDLOG_ERROR("Particle {} out of bounds! Removing...", p.toString());
+                // remove the handle from its old cell as well, so that no cell refers to an inactive particle
+                if (p.getCellIndex() != -1)
+                    lc->deleteParticle(p);
                 p.markInactive();
+                deactivated = true;
+                continue;
+            }
+
+            // if the particle's stored cell index does not match the newly calculated index, move it
+            if (newIdx != p.getCellIndex()) {
+                SPDLOG_TRACE("Index mismatch (current: {}, expected: {}), moving...", p.getCellIndex(), newIdx);
+                Cell &targetCell = (*lc)[newIdx];
+
+                // check if the particle entered a halo cell and apply the correct boundary condition
+                {
+                    PROFILE_ACCUMULATE(Phase::BOUNDARY);
+                    if (handleHaloCell(p, targetCell, lc)) {
+                        deactivated = deactivated || !p.isActive();
+                        continue;
+                    }
+                }
+
+                // move particle (update stored cell index)
+                PROFILE_ACCUMULATE(Phase::MIGRATION);
+                if (!lc->moveParticle(p)) {
+                    SPDLOG_ERROR("Cannot move particle {}!", p.toString());
+                    p.markInactive();
+                    deactivated = true;
+                }
             }
         }
     }
-}
\ No newline at end of file
+
+    // without outflow, the inactive check is compiled out, so the simulation has to switch to another policy
+    if constexpr (!Policy::OUTFLOW) {
+        if (deactivated)
+            lc->setParticlesDeactivated(true);
+    }
+}
+
+// explicit instantiations for all policies the StrategyFactory may choose
+#define INSTANTIATE_CALCULATE_X_LC(_dim, _outflow, _walls, _membrane)                                                  \
+    template void calculateX_LC_policy<StepPolicy<_dim, _outflow, _walls, _membrane>>(                                 \
+        ParticleContainer &, double, double, CellContainer *, bool);
+FOR_EACH_STEP_POLICY(INSTANTIATE_CALCULATE_X_LC)
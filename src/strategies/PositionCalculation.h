@@ -9,6 +9,7 @@
 #pragma once
 #include "objects/CellContainer.h"
 #include "objects/ParticleContainer.h"
+#include "strategies/StepPolicy.h"
 
 /**
  * @brief Calculates the position \f$ x \f$ for all Particle objects in a given ParticleContainer.
@@ -39,7 +40,9 @@ void calculateX(ParticleContainer &particles, double delta_t, double g_grav, Cel
  *
  * After each update, the particle may need to be moved to a different cell. The algorithm checks this and updates the
  * cell correspondence accordingly. If the particle enters a halo cell, the appropriate boundary condition will be
- * applied.
+ * applied. If the CellContainer has a skin, particles are only sorted into a new cell once they are more than the skin
+ * outside of their current cell or leave the domain, which saves the index computation for most particles and keeps
+ * particles oscillating around a cell face from being moved back and forth.
  *
  * If a particle enters a corner halo cell where one side has a different boundary condition to the other, the condition
  * is chosen based on which boundary the particle will hit first. See the report and presentation for more details.
@@ -56,4 +59,27 @@ void calculateX(ParticleContainer &particles, double delta_t, double g_grav, Cel
  * @param membrane Determines, whether gravity should be applied along the z-axis (true) or y-axis (false).
  */
 void calculateX_LC(ParticleContainer &particles, double delta_t, double g_grav, CellContainer *lc,
-                   bool membrane = false);
\ No newline at end of file
+                   bool membrane = false);
+
+/**
+ * @brief Calculates the position \f$ x \f$ for all Particle objects like calculateX_LC(), specialized for the features
+ * of the simulation.
+ *
+ * @details The checks for inactive and wall particles are only compiled in if the policy requires them, and gravity is
+ * always applied along the axis chosen by the policy. In 2D, the z-coordinate is neither updated nor used to find the
+ * new Cell of a Particle. calculateX_LC() dispatches to this function with the policy supporting all particles, while
+ * the StrategyFactory picks the fastest policy for the simulation once. If a policy without outflow deactivates a
+ * Particle anyway, e.g. because it got out of bounds, this is recorded in the CellContainer, so that the simulation can
+ * switch to a policy checking for inactive particles.
+ *
+ * @tparam Policy The StepPolicy describing the features of the simulation.
+ * @param particles The ParticleContainer containing the Particle objects to iterate over.
+ * @param delta_t The timestep \f$ \Delta t \f$.
+ * @param g_grav The gravitational force \f$ g_{grav} \f$.
+ * @param lc The CellContainer for the linked cells method.
+ * @param membrane Unused, since the policy determines the axis of gravity. Present to allow calling the function
+ * like calculateX_LC().
+ */
+template <typename Policy>
+void calculateX_LC_policy(ParticleContainer &particles, double delta_t, double g_grav, CellContainer *lc,
+                          bool membrane = false);
\ No newline at end of file
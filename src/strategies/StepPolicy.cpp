@@ -0,0 +1,17 @@
+#include "StepPolicy.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+StepFeatures StepFeatures::detect(const Arguments &args, const ParticleContainer &particles) {
+    StepFeatures features;
+    features.dim = args.dimensions;
+    features.membrane = args.membrane;
+    features.outflow =
+        (args.linkedCells && std::any_of(args.conditions.begin(), args.conditions.end(),
+                                         [](BoundaryCondition c) { return c == BoundaryCondition::OUTFLOW; })) ||
+        particles.activeSize() != particles.size();
+    features.walls = std::any_of(particles.begin(), particles.end(), [](const Particle &p) { return IS_WALL(p); });
+    SPDLOG_DEBUG("Detected step features: {}D, outflow: {}, walls: {}, membrane: {}.", features.dim, features.outflow,
+                 features.walls, features.membrane);
+    return features;
+}
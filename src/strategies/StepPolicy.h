@@ -0,0 +1,111 @@
+/**
+ * @file StepPolicy.h
+ * @brief Compile-time feature policies for specializing the per-particle loops of a time step.
+ * @date 2025-02-24
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "objects/ParticleContainer.h"
+#include "utils/Arguments.h"
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Compile-time description of the features a simulation needs in its per-particle loops.
+ *
+ * @details Each absent feature removes the corresponding branch from the loops, e.g. the check for inactive particles
+ * if no particle can ever leave the simulation. The policy is chosen once at startup from the input using
+ * dispatchStepPolicy(), so that these fast paths no longer require a separate build (see NOUTFLOW).
+ *
+ * @tparam DIM_ The number of dimensions, either 2 or 3.
+ * @tparam OUTFLOW_ Whether particles may be or become inactive, e.g. due to outflow boundaries.
+ * @tparam WALLS_ Whether there are any wall particles, which never move.
+ * @tparam MEMBRANE_ Whether a membrane is simulated, i.e. whether gravity acts along the z-axis instead of the y-axis.
+ */
+template <size_t DIM_, bool OUTFLOW_, bool WALLS_, bool MEMBRANE_> struct StepPolicy {
+    static_assert(DIM_ == 2 || DIM_ == 3, "Only 2D and 3D simulations are supported!");
+    /// @brief The number of dimensions.
+    static constexpr size_t DIM = DIM_;
+    /// @brief Whether particles may be or become inactive.
+    static constexpr bool OUTFLOW = OUTFLOW_;
+    /// @brief Whether there are any wall particles.
+    static constexpr bool WALLS = WALLS_;
+    /// @brief Whether gravity acts along the z-axis instead of the y-axis.
+    static constexpr bool MEMBRANE = MEMBRANE_;
+};
+
+/// @brief The policy supporting every feature, for callers which do not know the simulation.
+template <size_t DIM> using GenericStepPolicy = StepPolicy<DIM, true, true, false>;
+
+/// @brief Expands a macro for each combination of StepPolicy parameters, e.g. to explicitly instantiate a kernel.
+#define FOR_EACH_STEP_POLICY(_m)                                                                                       \
+    _m(2, false, false, false)                                                                                         \
+    _m(2, false, false, true)                                                                                          \
+    _m(2, false, true, false)                                                                                          \
+    _m(2, false, true, true)                                                                                           \
+    _m(2, true, false, false)                                                                                          \
+    _m(2, true, false, true)                                                                                           \
+    _m(2, true, true, false)                                                                                           \
+    _m(2, true, true, true)                                                                                            \
+    _m(3, false, false, false)                                                                                         \
+    _m(3, false, false, true)                                                                                          \
+    _m(3, false, true, false)                                                                                          \
+    _m(3, false, true, true)                                                                                           \
+    _m(3, true, false, false)                                                                                          \
+    _m(3, true, false, true)                                                                                           \
+    _m(3, true, true, false)                                                                                           \
+    _m(3, true, true, true)
+
+/// @brief Runtime description of the features of a simulation, used for choosing a StepPolicy.
+struct StepFeatures {
+    /// @brief The number of dimensions, either 2 or 3 (default: 3).
+    size_t dim{3};
+    /// @brief Whether particles may be or become inactive (default: true).
+    bool outflow{true};
+    /// @brief Whether there are any wall particles (default: true).
+    bool walls{true};
+    /// @brief Whether gravity acts along the z-axis instead of the y-axis (default: false).
+    bool membrane{false};
+
+    /**
+     * @brief Detects the features of a simulation from its arguments and initial particles.
+     *
+     * Particles may only become inactive through outflow boundaries of the linked cell method. Particles which are
+     * already inactive, e.g. those read from a checkpoint, keep the check as well.
+     *
+     * @param args The Arguments of the simulation.
+     * @param particles The ParticleContainer containing the initial particles.
+     * @return The features of the simulation.
+     */
+    static StepFeatures detect(const Arguments &args, const ParticleContainer &particles);
+};
+
+// helper function to turn a runtime flag into a compile-time constant
+template <typename F> auto withStepFlag(bool flag, F f) {
+    return flag ? f(std::true_type{}) : f(std::false_type{});
+}
+
+/**
+ * @brief Calls a function object with the StepPolicy matching the given features.
+ *
+ * @tparam F The type of the function object, callable with a default-constructed StepPolicy of any combination.
+ * @param features The features of the simulation.
+ * @param f The function object, e.g. a generic lambda returning the specialization of a kernel for the policy.
+ * @return The return value of the function object, which must be the same for all policies.
+ */
+template <typename F> auto dispatchStepPolicy(const StepFeatures &features, F f) {
+    auto withDim = [&](auto dim) {
+        return withStepFlag(features.outflow, [&](auto outflow) {
+            return withStepFlag(features.walls, [&](auto walls) {
+                return withStepFlag(features.membrane, [&](auto membrane) {
+                    return f(StepPolicy<decltype(dim)::value, decltype(outflow)::value, decltype(walls)::value,
+                                        decltype(membrane)::value>{});
+                });
+            });
+        });
+    };
+    return features.dim == 2 ? withDim(std::integral_constant<size_t, 2>{})
+                             : withDim(std::integral_constant<size_t, 3>{});
+}
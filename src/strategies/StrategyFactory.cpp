@@ -8,23 +8,26 @@
 #include <tuple>
 
 static inline std::tuple<TimeIntegrationFuncs, StrategyFactory::FFunc>
-getSimulationFunctions_nonLC(SimulationType type) {
+getSimulationFunctions_nonLC(SimulationType type, const StepFeatures &features) {
     SPDLOG_DEBUG("Getting physics functions for non-linked cell simulation...");
+    const TimeIntegrationFuncs ti(type, false, features);
     switch (type) {
     case SimulationType::GRAVITY:
         SPDLOG_DEBUG("Chose physics calculations for gravitational simulation.");
-        return std::make_tuple(TimeIntegrationFuncs(type, false), calculateF_Gravity);
+        return std::make_tuple(ti, calculateF_Gravity);
     case SimulationType::LJ:
         SPDLOG_DEBUG("Chose physics calculations for Lennard-Jones simulation.");
-        return std::make_tuple(TimeIntegrationFuncs(type, false), calculateF_LennardJones);
+        return std::make_tuple(ti, calculateF_LennardJones);
     default:
         CLIUtils::error("Invalid simulation type!");
     }
-    return std::make_tuple(TimeIntegrationFuncs(type, false), calculateF_LennardJones); // stop compiler warnings
+    return std::make_tuple(ti, calculateF_LennardJones); // stop compiler warnings
 }
 
-static inline std::tuple<TimeIntegrationFuncs, StrategyFactory::FFunc> getSimulationFunctions_LC(Arguments &args) {
+static inline std::tuple<TimeIntegrationFuncs, StrategyFactory::FFunc>
+getSimulationFunctions_LC(Arguments &args, const StepFeatures &features) {
     SPDLOG_DEBUG("Getting physics functions for linked cell simulation...");
+    const TimeIntegrationFuncs ti(args.sim, true, features);
     switch (args.sim) {
     case SimulationType::GRAVITY:
         CLIUtils::error("Linked cells method is currently unsupported with gravitational simulation!", "", false);
@@ -32,39 +35,77 @@ static inline std::tuple<TimeIntegrationFuncs, StrategyFactory::FFunc> getSimula
     case SimulationType::LJ:
         SPDLOG_DEBUG("Chose physics calculations for linked-cell Lennard-Jones simulation.");
 
+        if (args.pairCutoffFactor > 0 && args.pairSearch != PairSearchType::LEVELS) {
+            CLIUtils::error("Per-pair cutoff radii are only supported by the levels pair search!");
+        }
+        if (args.pairSearch == PairSearchType::CLUSTERS) {
+            SPDLOG_DEBUG("Chose cluster pair search.");
+            if (args.membrane) {
+                CLIUtils::error("Cluster pair search unsupported with membrane simulation!");
+            }
+            return std::make_tuple(ti, calculateF_LennardJones_LC_cluster);
+        }
+        if (args.pairSearch == PairSearchType::TREE) {
+            SPDLOG_DEBUG("Chose octree pair search.");
+            if (args.membrane) {
+                CLIUtils::error("Octree pair search unsupported with membrane simulation!");
+            }
+            return std::make_tuple(ti, calculateF_LennardJones_LC_tree);
+        }
+        if (args.pairSearch == PairSearchType::LEVELS) {
+            SPDLOG_DEBUG("Chose hierarchical grid pair search.");
+            if (args.membrane) {
+                CLIUtils::error("Hierarchical grid pair search unsupported with membrane simulation!");
+            }
+            return std::make_tuple(ti, calculateF_LennardJones_LC_levels);
+        }
+
         if (args.parallelization == ParallelizationType::COARSE) {
             SPDLOG_DEBUG("Chose coarse-grained (standard) parallelization strategy.");
             if (args.membrane) {
-                return std::make_tuple(TimeIntegrationFuncs(args.sim, true), calculateF_Membrane_LC);
+                return std::make_tuple(ti, calculateF_Membrane_LC);
             }
-            return std::make_tuple(TimeIntegrationFuncs(args.sim, true), calculateF_LennardJones_LC);
+            // the dimensions never change, so the specialized kernel is chosen once instead of in every iteration
+            const StrategyFactory::FFunc f =
+                args.dimensions == 2 ? calculateF_LennardJones_LC_dim<2> : calculateF_LennardJones_LC_dim<3>;
+            return std::make_tuple(ti, f);
 
         } else {
             SPDLOG_DEBUG("Chose fine-grained (task-based) parallelization strategy.");
             if (args.membrane) {
                 CLIUtils::error("Fine-grained parallelization unsupported with membrane simulation!");
             }
-            return std::make_tuple(TimeIntegrationFuncs(args.sim, true), calculateF_LennardJones_LC_task);
+            return std::make_tuple(ti, calculateF_LennardJones_LC_task);
         }
         break;
     default:
         CLIUtils::error("Invalid simulation type!");
     }
-    return std::make_tuple(TimeIntegrationFuncs(args.sim, true), calculateF_LennardJones_LC); // stop compiler warnings
+    return std::make_tuple(ti, calculateF_LennardJones_LC); // stop compiler warnings
 }
 
-TimeIntegrationFuncs::TimeIntegrationFuncs(SimulationType type, bool lc) {
+TimeIntegrationFuncs::TimeIntegrationFuncs(SimulationType type, bool lc, const StepFeatures &features) {
     switch (type) {
     case SimulationType::GRAVITY:
     case SimulationType::LJ:
-        vf = calculateV;
-        xf = lc ? calculateX_LC : calculateX;
+        // the features never change during a simulation, so the specialized loops are chosen once here
+        vf = dispatchStepPolicy(features, [](auto policy) -> VFunc { return calculateV_policy<decltype(policy)>; });
+        vtf = dispatchStepPolicy(
+            features, [](auto policy) -> VTFunc { return calculateV_Thermostat_policy<decltype(policy)>; });
+        if (lc)
+            xf = dispatchStepPolicy(features,
+                                    [](auto policy) -> XFunc { return calculateX_LC_policy<decltype(policy)>; });
+        else
+            xf = calculateX;
         break;
     default:
         CLIUtils::error("Unknown type!", "", false);
     }
 }
 
-std::tuple<TimeIntegrationFuncs, StrategyFactory::FFunc> StrategyFactory::getSimulationFunctions(Arguments &args) {
-    return args.linkedCells ? getSimulationFunctions_LC(args) : getSimulationFunctions_nonLC(args.sim);
+std::tuple<TimeIntegrationFuncs, StrategyFactory::FFunc>
+StrategyFactory::getSimulationFunctions(Arguments &args, const ParticleContainer &particles) {
+    const StepFeatures features = StepFeatures::detect(args, particles);
+    return args.linkedCells ? getSimulationFunctions_LC(args, features)
+                            : getSimulationFunctions_nonLC(args.sim, features);
 }
\ No newline at end of file
@@ -10,6 +10,8 @@
 #pragma once
 #include "objects/CellContainer.h"
 #include "objects/ParticleContainer.h"
+#include "objects/Thermostat.h"
+#include "strategies/StepPolicy.h"
 #include "utils/Arguments.h"
 #include <functional>
 #include <tuple>
@@ -20,20 +22,24 @@ struct TimeIntegrationFuncs {
     using VFunc = void (*)(ParticleContainer &, double);
     /// @brief Typedef for position-calculating functions.
     using XFunc = void (*)(ParticleContainer &, double, double, CellContainer *, bool);
-    /// @brief Typedef for velocity-calculating functions for the linked cell method.
+    /// @brief Typedef for velocity-calculating functions which also gather the sums needed by the Thermostat.
+    using VTFunc = void (*)(ParticleContainer &, double, KineticSums &);
 
     /// @brief The velocity-calculating function.
     VFunc vf;
     /// @brief The position-calculating function.
     XFunc xf;
+    /// @brief The velocity-calculating function for iterations directly preceding a thermostat application.
+    VTFunc vtf;
 
     /**
      * @brief Constructor for choosing the appropriate functions based on the simulation type.
      *
      * @param type The simulation type.
      * @param lc Whether or not the linked cells method is used.
+     * @param features The features of the simulation, used for choosing the specialized position and velocity loops.
      */
-    explicit TimeIntegrationFuncs(SimulationType type, bool lc);
+    explicit TimeIntegrationFuncs(SimulationType type, bool lc, const StepFeatures &features);
 };
 
 /// @brief Factory class for choosing the appropriate functions based on the Simulation.
@@ -46,7 +52,10 @@ class StrategyFactory {
      * @brief Return a 2-tuple of the physics functions corresponding to the chosen simulation.
      *
      * @param args The Arguments struct containing the simulation type and linked cells boolean.
+     * @param particles The ParticleContainer containing the initial particles, used for detecting the features of the
+     * simulation.
      * @return A 2-tuple of the physics functions corresponding to the chosen simulation.
      */
-    static std::tuple<TimeIntegrationFuncs, FFunc> getSimulationFunctions(Arguments &args);
+    static std::tuple<TimeIntegrationFuncs, FFunc> getSimulationFunctions(Arguments &args,
+                                                                          const ParticleContainer &particles);
 };
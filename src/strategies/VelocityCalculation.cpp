@@ -1,20 +1,73 @@
 #include "VelocityCalculation.h"
 #include "objects/ParticleContainer.h"
 #include "utils/ArrayUtils.h"
+#include "utils/CPUDispatch.h"
 #include "utils/OMPWrapper.h"
+#include "utils/PhaseProfiler.h"
 #include <functional>
 #include <spdlog/spdlog.h>
 
 void calculateV(ParticleContainer &particles, double delta_t) {
-#pragma omp parallel for
-    CONTAINER_LOOP(particles, it) {
-        auto &p = CONTAINER_REF(it);
-        CONTINUE_IF_INACTIVE(p);
-        SKIP_IF_WALL(p);
+    calculateV_policy<GenericStepPolicy<3>>(particles, delta_t);
+}
 
-        // calculate velocity
-        const std::array<double, 3> velocityUpdate =
-            ArrayUtils::elementWiseScalarOp(delta_t / (2 * p.getM()), p.getOldF() + p.getF(), std::multiplies<>());
-        p.getV() = p.getV() + velocityUpdate;
+template <typename Policy>
+DISPATCH_KERNEL void calculateV_policy(ParticleContainer &particles, double delta_t) {
+#pragma omp parallel
+    {
+        PROFILE_THREAD(Phase::VELOCITY);
+#pragma omp for nowait
+        CONTAINER_LOOP(particles, it) {
+            auto &p = CONTAINER_REF(it);
+            if constexpr (Policy::OUTFLOW)
+                CONTINUE_IF_INACTIVE(p);
+            if constexpr (Policy::WALLS)
+                SKIP_IF_WALL(p);
+
+            // calculate velocity
+            // in 2D, the z-component stays untouched
+            const double scale = delta_t / (2 * p.getM());
+            for (size_t d = 0; d < Policy::DIM; ++d)
+                p.getV()[d] = p.getV()[d] + scale * (p.getOldF()[d] + p.getF()[d]);
+        }
+    }
+}
+
+// explicit instantiations for all policies the StrategyFactory may choose
+#define INSTANTIATE_CALCULATE_V(_dim, _outflow, _walls, _membrane)                                                     \
+    template void calculateV_policy<StepPolicy<_dim, _outflow, _walls, _membrane>>(ParticleContainer &, double);
+FOR_EACH_STEP_POLICY(INSTANTIATE_CALCULATE_V)
+
+void calculateV_Thermostat(ParticleContainer &particles, double delta_t, KineticSums &sums) {
+    calculateV_Thermostat_policy<GenericStepPolicy<3>>(particles, delta_t, sums);
+}
+
+template <typename Policy>
+DISPATCH_KERNEL void calculateV_Thermostat_policy(ParticleContainer &particles, double delta_t, KineticSums &sums) {
+    KineticSums local;
+#pragma omp parallel
+    {
+        PROFILE_THREAD(Phase::VELOCITY);
+#pragma omp for reduction(+ : local) nowait
+        CONTAINER_LOOP(particles, it) {
+            auto &p = CONTAINER_REF(it);
+            if constexpr (Policy::OUTFLOW)
+                CONTINUE_IF_INACTIVE(p);
+            if (!Policy::WALLS || !IS_WALL(p)) {
+                // calculate velocity
+                // in 2D, the z-component stays untouched
+                const double scale = delta_t / (2 * p.getM());
+                for (size_t d = 0; d < Policy::DIM; ++d)
+                    p.getV()[d] = p.getV()[d] + scale * (p.getOldF()[d] + p.getF()[d]);
+            }
+            local.accumulate(p);
+        }
     }
-}
\ No newline at end of file
+    sums = local;
+}
+
+// explicit instantiations for all policies the StrategyFactory may choose
+#define INSTANTIATE_CALCULATE_V_THERMOSTAT(_dim, _outflow, _walls, _membrane)                                          \
+    template void calculateV_Thermostat_policy<StepPolicy<_dim, _outflow, _walls, _membrane>>(                         \
+        ParticleContainer &, double, KineticSums &);
+FOR_EACH_STEP_POLICY(INSTANTIATE_CALCULATE_V_THERMOSTAT)
\ No newline at end of file
@@ -8,6 +8,8 @@
  */
 #pragma once
 #include "objects/ParticleContainer.h"
+#include "objects/Thermostat.h"
+#include "strategies/StepPolicy.h"
 
 /**
  * @brief Calculates the velocity \f$ v \f$ for all Particle objects in a given ParticleContainer.
@@ -18,4 +20,47 @@
  * @param particles The ParticleContainer containing the Particle objects to iterate over.
  * @param delta_t The timestep \f$ \Delta t \f$.
  */
-void calculateV(ParticleContainer &particles, double delta_t);
\ No newline at end of file
+void calculateV(ParticleContainer &particles, double delta_t);
+
+/**
+ * @brief Calculates the velocity \f$ v \f$ for all Particle objects like calculateV(), specialized for the features of
+ * the simulation.
+ *
+ * @details The checks for inactive and wall particles are only compiled in if the policy requires them. In 2D, the
+ * z-component is not updated. calculateV() uses the policy supporting all particles, while the StrategyFactory picks
+ * the fastest policy for the simulation once.
+ *
+ * @tparam Policy The StepPolicy describing the features of the simulation.
+ * @param particles The ParticleContainer containing the Particle objects to iterate over.
+ * @param delta_t The timestep \f$ \Delta t \f$.
+ */
+template <typename Policy> void calculateV_policy(ParticleContainer &particles, double delta_t);
+
+/**
+ * @brief Calculates the velocity \f$ v \f$ for all Particle objects in a given ParticleContainer and gathers the sums
+ * needed by the Thermostat in the same pass.
+ *
+ * @details This is used for iterations directly preceding a thermostat application, so that the Thermostat does not
+ * need to perform its own reduction over all particles. Wall particles are not moved, but still contribute to the
+ * kinetic energy.
+ *
+ * @param particles The ParticleContainer containing the Particle objects to iterate over.
+ * @param delta_t The timestep \f$ \Delta t \f$.
+ * @param sums The KineticSums object in which the sums over all active particles are stored.
+ */
+void calculateV_Thermostat(ParticleContainer &particles, double delta_t, KineticSums &sums);
+
+/**
+ * @brief Calculates the velocity \f$ v \f$ and gathers the Thermostat sums like calculateV_Thermostat(), specialized
+ * for the features of the simulation.
+ *
+ * @details Like calculateV_policy(), the checks for inactive and wall particles are only compiled in if the policy
+ * requires them, and in 2D, the z-component is not updated.
+ *
+ * @tparam Policy The StepPolicy describing the features of the simulation.
+ * @param particles The ParticleContainer containing the Particle objects to iterate over.
+ * @param delta_t The timestep \f$ \Delta t \f$.
+ * @param sums The KineticSums object in which the sums over all active particles are stored.
+ */
+template <typename Policy>
+void calculateV_Thermostat_policy(ParticleContainer &particles, double delta_t, KineticSums &sums);
\ No newline at end of file
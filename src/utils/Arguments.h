@@ -17,7 +17,7 @@
 #include <string>
 
 /// @brief Enum containing each (valid) type of output writer.
-enum class WriterType { VTK, XYZ, NIL };
+enum class WriterType { VTK, VTKB, XYZ, TRAJ, NIL };
 
 /// @brief Enum containg each possible Simulation to be performed.
 enum class SimulationType { GRAVITY, LJ };
@@ -25,22 +25,61 @@ enum class SimulationType { GRAVITY, LJ };
 /// @brief Enum containing each possible parallelization strategy.
 enum class ParallelizationType { COARSE, FINE };
 
+/// @brief Enum containing each possible pair search scheme of the linked cell force calculation.
+enum class PairSearchType { CELLS, CLUSTERS, TREE, LEVELS };
+
 /**
  * @brief Struct containing each option configurable via command line arguments.
  */
 struct Arguments {
     /// @brief Start time of a simulation (default: simulation-specific).
     double startTime{};
+    /// @brief The number of the first iteration, non-zero when resuming from a checkpoint (default: 0).
+    int startIteration{0};
     /// @brief End time of a simulation (default: simulation-specific).
     double endTime{};
     /// @brief Duration of a timestep (default: simulation-specific).
     double delta_t{};
     /// @brief Logging frequency (default: every 10 iterations)
     int itFreq{10};
+    /// @brief Checkpoint frequency, i.e. after how many iterations a binary checkpoint is saved, 0 to disable (default:
+    /// 0).
+    int checkpointFreq{0};
+    /// @brief Maximum number of output frames queued for the background writer thread, 0 to write synchronously
+    /// (default: 2).
+    size_t outputQueue{2};
+    /// @brief Determines whether binary VTK output stores floating point data as Float64 instead of Float32 (default:
+    /// false).
+    bool doublePrecision{false};
+    /// @brief Determines whether binary VTK and trajectory output is compressed using zlib (default: false).
+    bool compressOutput{false};
+    /// @brief Determines whether per-phase timings are recorded and written as CSV summary and Chrome trace (default:
+    /// false).
+    bool profilePhases{false};
+    /// @brief Determines whether hardware performance counters are read for each phase, implies profilePhases
+    /// (default: false).
+    bool profileCounters{false};
+    /// @brief Determines whether the linked cell configuration is chosen by measuring each candidate at runtime
+    /// (default: false).
+    bool autoTune{false};
+    /// @brief The number of steps after which the configuration is tuned again, 0 to only re-tune when the density
+    /// changes (default: 0).
+    int tuneInterval{0};
+    /// @brief The input file of the simulation, used as key for cached auto-tuning results (default: none).
+    std::string inputFile{};
     /// @brief Domain size for linked cells (default: unspecified, will fail if not specified!)
     std::array<double, 3> domainSize{INFINITY, INFINITY, INFINITY};
     /// @brief Cutoff radius for linked cells (default: 3.0)
     double cutoffRadius{3.0};
+    /// @brief The minimum cell size relative to the cutoff radius, either at least 1 or 1/k for k halo layers (default:
+    /// 1.0).
+    double cellSizeFactor{1.0};
+    /// @brief The distance particles may move outside of their cell before being moved to another cell, 0 to move them
+    /// immediately (default: 0).
+    double cellSkin{0.0};
+    /// @brief The cutoff radius of each particle pair relative to its mixed sigma, 0 to use the cutoff radius for all
+    /// pairs (default: 0).
+    double pairCutoffFactor{0.0};
     /// @brief The gravity that the particles are exposed to (default: 0).
     double gravity{0.0};
     /// @brief The basename of the output file (default: type-specific).
@@ -51,6 +90,8 @@ struct Arguments {
     SimulationType sim{SimulationType::LJ};
     /// @brief Parallelization type (default: coarse-grained).
     ParallelizationType parallelization{ParallelizationType::COARSE};
+    /// @brief Pair search scheme of the linked cell force calculation (default: cells).
+    PairSearchType pairSearch{PairSearchType::CELLS};
     /// @brief Decide, whether or not to use the linked cell method (default: true)
     bool linkedCells{true};
     /// @brief The type of condition to be applied at each boundary (default: outflow)
@@ -81,7 +122,8 @@ struct Arguments {
         return startTime == other.startTime && endTime == other.endTime && delta_t == other.delta_t &&
                itFreq == other.itFreq && domainSize == other.domainSize && cutoffRadius == other.cutoffRadius &&
                gravity == other.gravity && basename == other.basename && type == other.type && sim == other.sim &&
-               parallelization == other.parallelization && linkedCells == other.linkedCells &&
+               parallelization == other.parallelization && pairSearch == other.pairSearch &&
+               linkedCells == other.linkedCells &&
                conditions == other.conditions && dimensions == other.dimensions;
     }
 };
@@ -11,10 +11,11 @@
 #include <cstdlib>
 #include <iostream>
 #include <spdlog/spdlog.h>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <unordered_map>
-#define OPTSTRING "s:e:d:f:g:b:o:p:t:B:D:R:h"
+#define OPTSTRING "s:e:d:f:g:b:c:o:p:q:t:A:B:C:D:K:L:P:R:S:HTzh"
 #define BOLD_ON "\033[1m"
 #define BOLD_OFF "\033[0m"
 #define RED "\e[0;31m"
@@ -29,6 +30,14 @@ namespace CLIUtils {
  */
 static inline std::string_view filename{"./MolSim"};
 
+/**
+ * @brief Determines whether fatal errors on the current thread throw a std::runtime_error instead of exiting.
+ *
+ * Set on background threads, which must not exit the program while the main thread is still running. Unlike the other
+ * variables here, it is not static, so that errors raised in any translation unit see the same flag.
+ */
+inline thread_local bool throwOnError{false};
+
 /**
  * @brief Mapping from getopt option characters to their full names.
  */
@@ -38,7 +47,11 @@ static inline std::unordered_map<char, std::string> optionNames = {
     {'f', "Output frequency"}, {'g', "Gravity"},
     {'o', "Output type"},      {'p', "Parallelization type"},
     {'t', "Simulation type"},  {'B', "Boundary Conditions"},
-    {'D', "Domain Size"},      {'R', "Cutoff Radius"}};
+    {'D', "Domain Size"},      {'R', "Cutoff Radius"},
+    {'q', "Output queue depth"}, {'P', "Output precision"},
+    {'c', "Checkpoint frequency"}, {'A', "Auto-tuning interval"},
+    {'C', "Cell size factor"}, {'S', "Pair search type"},
+    {'L', "Pair cutoff factor"}, {'K', "Cell skin"}};
 
 /**
  * @brief Gets the name of the compiler used to build the program executable (or "unknown" if the compiler is not
@@ -100,16 +113,50 @@ static inline void printHelp() {
            "present in input!).\n"
            "-R <number>  : Sets the cutoff radius (decimal) for the linked cell method (MUST be specified if not "
            "present in input!).\n"
+           "-C <number>  : Sets the minimum cell size relative to the cutoff radius for the linked cell method "
+           "(default: 1). Values of 1/k (e.g. 0.5) use k cells per cutoff radius with a k cells thick halo.\n"
+           "-K <number>  : Lets particles move up to <number> outside of their cell before they are moved to another "
+           "cell, enlarging the cells by twice that distance (default: 0, disabled). Saves cell bookkeeping in dense, "
+           "slow liquids.\n"
            "-f <number>  : Sets the output frequency, i.e. after how many iterations a new VTK file should be "
            "written (default: 10).\n"
+           "-c <number>  : Sets the checkpoint frequency, i.e. after how many iterations a binary checkpoint should be "
+           "saved (default: 0, disabled). Pass the checkpoint file instead of an XML file to resume from it.\n"
            "-o <type>    : Sets the output file type and directory (default: vtk).\n"
            "  - vtk      : Generates VTK Unstructured Grid (.vtu) files.\n"
+           "  - vtkb     : Generates VTK Unstructured Grid (.vtu) files with raw binary appended data.\n"
            "  - xyz      : Generates XYZ (.xyz) files.\n"
+           "  - traj     : Generates a single binary trajectory (.traj) file. Use TrajConvert to extract frames.\n"
            "  - nil      : Logs to stdout. Used for debugging purposes.\n"
            "-p <type>    : Sets the parallelization strategy used (default: coarse).\n"
            "               If OpenMP support is disabled, this option has no effect.\n"
            "  - coarse   : Uses the standard OpenMP for-loop parallelization strategy.\n"
            "  - fine     : Uses a finer-grained, task-based parallelization approach.\n"
+           "-S <type>    : Sets the pair search scheme of the linked cell Lennard-Jones force calculation (default: "
+           "cells).\n"
+           "  - cells    : Iterates over the particles of neighbouring cells one by one.\n"
+           "  - clusters : Groups the particles of each cell into small clusters and evaluates each pair of nearby "
+           "clusters at once using SIMD instructions. Overrides -p; unsupported with membranes.\n"
+           "  - tree     : Sorts the particles into an adaptive octree whose leaves follow the local density. Useful "
+           "for highly non-uniform densities, e.g. condensation. Overrides -p; unsupported with membranes.\n"
+           "  - levels   : Sorts each species into a grid level matching its own cutoff radius (see -L). Useful for "
+           "mixtures of very differently sized particles. Overrides -p; unsupported with membranes.\n"
+           "-L <number>  : Uses a cutoff radius of <number> times the mixed sigma for each particle pair instead of "
+           "the global cutoff radius, which must be at least as large as the largest pair cutoff radius (default: 0, "
+           "disabled). Requires -S levels.\n"
+           "-A <number>  : Enables auto-tuning for linked cell simulations, overriding -p. Each combination of "
+           "parallelization strategy, OpenMP schedule and cell size is measured for a few steps and the fastest is "
+           "used. Tuning is repeated every <number> steps (0: only if the density changes significantly). Results "
+           "are cached per input file in MolSim_tuning.cache.\n"
+           "-P <bits>    : Sets the floating point precision of binary VTK output, either 32 or 64 (default: 32).\n"
+           "-z           : Compresses binary VTK and trajectory output using zlib, if available. Trajectory frames are "
+           "additionally delta encoded.\n"
+           "-q <number>  : Sets the maximum number of output frames queued for the background writer thread "
+           "(default: 2). If this is 0, output files are written synchronously.\n"
+           "-T           : Records the time spent in each phase of every step and writes it to <basename>_phases.csv "
+           "(per-step summary) and <basename>_trace.json (Chrome / Perfetto trace).\n"
+           "-H           : Like -T, but additionally reads the hardware performance counters of each thread (cycles, "
+           "instructions, LLC misses, FP vector ops) and writes them to <basename>_counters.csv. Linux only.\n"
            "-t <type>    : Sets the desired simulation to be performed (default: lj).\n"
            "  - gravity  : Performs a gravitational simulation (t_0 = 0, t_end = 1000, dt = 0.014).\n"
            "  - lj       : Performs a simulation of Lennard-Jones potential (t_0 = 0, t_end = 5, dt = 0.0002).\n"
@@ -144,13 +191,17 @@ static inline int getPercentage(int x, int y) {
  * @param msg The message to be printed to stderr.
  * @param opt An optional extra string to be appended at the end (default: empty).
  * @param usage An optional boolean which defines whether or not the usage string should be printed.
- * @param close An optional boolean which defines whether or not the program should completely exit afterwards.
+ * @param close An optional boolean which defines whether or not the program should completely exit afterwards. If
+ * throwOnError is set for the current thread, a std::runtime_error is thrown instead.
  */
 static inline void error(const char *msg, const std::string &opt = "", bool usage = true, bool close = true) {
     SPDLOG_ERROR("{}{}{}", msg, (opt.empty() ? "" : ": "), opt);
     if (usage)
         printUsage();
-    if (close)
+    if (close) {
+        if (throwOnError)
+            throw std::runtime_error(std::string(msg) + (opt.empty() ? "" : ": ") + opt);
         std::exit(EXIT_FAILURE);
+    }
 }
 } // namespace CLIUtils
@@ -0,0 +1,17 @@
+#include "CPUDispatch.h"
+
+std::string CPUDispatch::getKernelLevel() {
+#if CPU_DISPATCH_ACTIVE
+    // the loader resolves each kernel to the highest level the CPU supports, so the same checks yield its choice
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("x86-64-v4"))
+        return "x86-64-v4";
+    if (__builtin_cpu_supports("x86-64-v3"))
+        return "x86-64-v3";
+    if (__builtin_cpu_supports("x86-64-v2"))
+        return "x86-64-v2";
+    return "x86-64";
+#else
+    return "not dispatched (build target)";
+#endif
+}
@@ -0,0 +1,37 @@
+/**
+ * @file CPUDispatch.h
+ * @brief Helpers for compiling hot kernels for several x86-64 ISA levels within a single portable binary.
+ * @date 2025-02-25
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include <string>
+
+// with CPU_DISPATCH defined (cmake -DENABLE_CPU_DISPATCH=ON), the build does not target the build machine. instead,
+// every kernel marked with DISPATCH_KERNEL is compiled once per ISA level, and the dynamic loader picks the best one
+// for the running CPU when the program starts (via ifunc, using CPUID). the OpenMP regions of a kernel are cloned
+// together with it, and the helper functions inlined into a kernel are compiled for its ISA level as well.
+// other compilers and architectures simply get a single, portable version of each kernel.
+#if defined(CPU_DISPATCH) && defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+#define CPU_DISPATCH_ACTIVE 1
+/// @brief Compiles the following function for the baseline, x86-64-v2 (SSE4.2), x86-64-v3 (AVX2, FMA) and x86-64-v4
+/// (AVX-512), choosing the best version at startup.
+#define DISPATCH_KERNEL                                                                                                \
+    __attribute__((target_clones("default", "arch=x86-64-v2", "arch=x86-64-v3", "arch=x86-64-v4")))
+#else
+#define CPU_DISPATCH_ACTIVE 0
+/// @brief Does nothing.
+#define DISPATCH_KERNEL
+#endif
+
+/// @brief Namespace containing functions for reporting the kernel versions chosen for the running CPU.
+namespace CPUDispatch {
+/**
+ * @brief Gets a description of the kernel versions used on the running CPU.
+ *
+ * @return The ISA level of the dispatched kernels (e.g. "x86-64-v3"), or a note that the kernels are not dispatched.
+ */
+std::string getKernelLevel();
+} // namespace CPUDispatch
@@ -9,6 +9,7 @@
 #pragma once
 #include "CLIUtils.h"
 #include <bitset>
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -17,11 +18,13 @@
 /// @brief Enum containing the possible types of boundary conditions.
 enum class BoundaryCondition { OUTFLOW, REFLECTIVE, PERIODIC };
 /// @brief Enum containing the possible types of cells.
-enum class CellType { INNER, BORDER, HALO };
+enum class CellType : std::uint8_t { INNER, BORDER, HALO };
 /// @brief Enum containing the possible corner and edge directions of halo cells.
 enum class HaloLocation { NORTH, SOUTH, WEST, EAST, ABOVE, BELOW };
 /// @brief Enum containing the possible corner and edge directions of border cells
 enum class BorderLocation { NORTH = 0, SOUTH = 1, WEST = 2, EAST = 3, ABOVE = 4, BELOW = 5 };
+/// @brief Set of halo or border locations, where bit i is set if the location with the value i is part of the set.
+using LocationMask = std::uint8_t;
 
 /// @brief Namespace containing utility functions for Cell and CellContainer objects.
 namespace CellUtils {
@@ -157,6 +160,52 @@ static inline std::string fromHaloVec(const std::vector<HaloLocation> &vec) {
     return ss.str();
 }
 
+/**
+ * @brief Gets the bit of a single HaloLocation or BorderLocation in a LocationMask.
+ *
+ * @tparam Location The type of the location, either HaloLocation or BorderLocation.
+ * @param location The location.
+ * @return A LocationMask containing only the given location.
+ */
+template <typename Location> constexpr LocationMask toMask(Location location) {
+    return static_cast<LocationMask>(1u << static_cast<unsigned>(location));
+}
+
+/**
+ * @brief Gets the number of locations in a LocationMask.
+ *
+ * @param mask The LocationMask.
+ * @return The number of set bits.
+ */
+static inline int countLocations(LocationMask mask) { return __builtin_popcount(mask); }
+
+/**
+ * @brief Gets the location with the lowest value in a non-empty LocationMask.
+ *
+ * @tparam Location The type of the location, either HaloLocation or BorderLocation.
+ * @param mask The LocationMask, which must not be empty.
+ * @return The first location, in the order North, South, West, East, Above, Below.
+ */
+template <typename Location> Location firstLocation(LocationMask mask) {
+    return static_cast<Location>(__builtin_ctz(mask));
+}
+
+/**
+ * @brief Converts a LocationMask to a vector of locations.
+ *
+ * @tparam Location The type of the location, either HaloLocation or BorderLocation.
+ * @param mask The LocationMask.
+ * @return The locations contained in the mask, in the order North, South, West, East, Above, Below.
+ */
+template <typename Location> std::vector<Location> fromMask(LocationMask mask) {
+    std::vector<Location> locations;
+    for (unsigned i = 0; i < 6; ++i) {
+        if (mask & (1u << i))
+            locations.push_back(static_cast<Location>(i));
+    }
+    return locations;
+}
+
 /**
  * @brief Converts an array of BoundaryCondition enums to a truncated, concatenated string.
  *
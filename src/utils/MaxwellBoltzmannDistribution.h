@@ -10,31 +10,38 @@
 
 #pragma once
 
+#include "RandomUtils.h"
 #include <array>
-#include <random>
+#include <cstdint>
 
 /**
  * @brief Generate a random velocity vector according to the Maxwell-Boltzmann
  * distribution, with a given average velocity.
  *
+ * The velocity only depends on the seed, the particle index and the stream, so it
+ * may be called in any order and from any thread with the same results.
+ *
  * @param averageVelocity The average velocity of the brownian motion for the
  * system.
  * @param dimensions Number of dimensions for which the velocity vector shall be
  * generated. Set this to 2 or 3.
+ * @param id The index of the particle the velocity is generated for.
+ * @param stream The random stream, distinguishing independent uses for the same particle.
+ * @param seed The seed. A constant default is used for repeatability.
  * @return Array containing the generated velocity vector.
  */
-inline std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions) {
-    // we use a constant seed for repeatability.
-    // random engine needs static lifetime otherwise it would be recreated for
-    // every call.
-    static std::default_random_engine randomEngine(42);
-
+inline std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions,
+                                                                 std::uint64_t id, RandomStream stream,
+                                                                 std::uint64_t seed = RNG_SEED_DEFAULT) {
     // when adding independent normally distributed values to all velocity
     // components the velocity change is maxwell boltzmann distributed
-    std::normal_distribution<double> normalDistribution{0, 1};
+    const std::array<double, 2> first = RandomUtils::toNormal(RandomUtils::generate(seed, id, stream, 0));
     std::array<double, 3> randomVelocity{};
-    for (size_t i = 0; i < dimensions; ++i) {
-        randomVelocity[i] = averageVelocity * normalDistribution(randomEngine);
+    for (size_t i = 0; i < dimensions && i < 2; ++i) {
+        randomVelocity[i] = averageVelocity * first[i];
+    }
+    if (dimensions > 2) {
+        randomVelocity[2] = averageVelocity * RandomUtils::toNormal(RandomUtils::generate(seed, id, stream, 1))[0];
     }
     return randomVelocity;
 }
@@ -27,4 +27,10 @@ inline void omp_destroy_lock(omp_lock_t *) { return; }
 inline void omp_set_lock(omp_lock_t *) { return; }
 inline void omp_unset_lock(omp_lock_t *) { return; }
 inline int omp_get_max_threads() { return 1; }
+typedef enum omp_sched_t { omp_sched_static = 1, omp_sched_dynamic = 2, omp_sched_guided = 3 } omp_sched_t;
+inline void omp_set_schedule(omp_sched_t, int) { return; }
+inline void omp_get_schedule(omp_sched_t *kind, int *chunk) {
+    *kind = omp_sched_static;
+    *chunk = 0;
+}
 #endif
\ No newline at end of file
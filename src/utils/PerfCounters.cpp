@@ -0,0 +1,141 @@
+#include "PerfCounters.h"
+#include <spdlog/spdlog.h>
+#include <utility>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <linux/perf_event.h>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// FP_ARITH_INST_RETIRED with all packed (128, 256 and 512 bit, single and double precision) umask bits set
+#define INTEL_FP_ARITH_PACKED 0xfcc7
+
+// helper function to open a single user space event, optionally as part of a group
+static int openEvent(std::uint32_t type, std::uint64_t config, int groupFd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = groupFd == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+// helper function to check whether the cpu is made by intel, for model-specific raw events
+static bool isIntel() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("vendor_id", 0) == 0)
+            return line.find("GenuineIntel") != std::string::npos;
+    }
+    return false;
+}
+#endif
+
+PerfCounters::~PerfCounters() { close(); }
+
+PerfCounters::PerfCounters(PerfCounters &&other) noexcept
+    : m_leader{std::exchange(other.m_leader, -1)}, m_fds{std::move(other.m_fds)}, m_order{std::move(other.m_order)} {
+}
+
+PerfCounters &PerfCounters::operator=(PerfCounters &&other) noexcept {
+    if (this != &other) {
+        close();
+        m_leader = std::exchange(other.m_leader, -1);
+        m_fds = std::move(other.m_fds);
+        m_order = std::move(other.m_order);
+    }
+    return *this;
+}
+
+bool PerfCounters::open() {
+    close();
+#ifdef __linux__
+    m_leader = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (m_leader == -1) {
+        SPDLOG_DEBUG("Could not open cycle counter: {}", std::strerror(errno));
+        return false;
+    }
+    m_fds.push_back(m_leader);
+    m_order.push_back(Counter::CYCLES);
+
+    // the remaining events are optional
+    auto addEvent = [this](Counter counter, std::uint32_t type, std::uint64_t config) {
+        const int fd = openEvent(type, config, m_leader);
+        if (fd == -1) {
+            SPDLOG_DEBUG("Could not open {} counter: {}", getName(counter), std::strerror(errno));
+            return;
+        }
+        m_fds.push_back(fd);
+        m_order.push_back(counter);
+    };
+    addEvent(Counter::INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    addEvent(Counter::LLC_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    if (isIntel())
+        addEvent(Counter::FP_VECTOR_OPS, PERF_TYPE_RAW, INTEL_FP_ARITH_PACKED);
+
+    ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PerfCounters::close() {
+#ifdef __linux__
+    for (int fd : m_fds)
+        ::close(fd);
+#endif
+    m_fds.clear();
+    m_order.clear();
+    m_leader = -1;
+}
+
+bool PerfCounters::isAvailable(Counter counter) const {
+    for (Counter c : m_order) {
+        if (c == counter)
+            return true;
+    }
+    return false;
+}
+
+CounterValues PerfCounters::read() const {
+    CounterValues values{};
+#ifdef __linux__
+    if (m_leader == -1)
+        return values;
+
+    // group read format: { nr, values[nr] }
+    std::array<std::uint64_t, 1 + static_cast<size_t>(Counter::COUNT)> buffer{};
+    if (::read(m_leader, buffer.data(), sizeof(buffer)) < static_cast<ssize_t>(sizeof(std::uint64_t)))
+        return values;
+    for (size_t i = 0; i < m_order.size() && i < buffer[0]; ++i)
+        values[static_cast<size_t>(m_order[i])] = buffer[i + 1];
+#endif
+    return values;
+}
+
+const char *PerfCounters::getName(Counter counter) {
+    switch (counter) {
+    case Counter::CYCLES:
+        return "cycles";
+    case Counter::INSTRUCTIONS:
+        return "instructions";
+    case Counter::LLC_MISSES:
+        return "llc_misses";
+    case Counter::FP_VECTOR_OPS:
+        return "fp_vector_ops";
+    default:
+        return "unknown";
+    }
+}
@@ -0,0 +1,96 @@
+/**
+ * @file PerfCounters.h
+ * @brief Per-thread hardware performance counters read through Linux perf_event_open.
+ * @date 2025-02-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Enum containing each hardware event which may be counted.
+enum class Counter : std::uint8_t { CYCLES, INSTRUCTIONS, LLC_MISSES, FP_VECTOR_OPS, COUNT };
+
+/// @brief The value of each counter, indexed by Counter.
+using CounterValues = std::array<std::uint64_t, static_cast<size_t>(Counter::COUNT)>;
+
+/**
+ * @brief Class reading the hardware counters of the thread which opened it.
+ *
+ * @details All available events are opened as a single group led by the cycle counter, so that they are scheduled
+ * onto the PMU together and can be read with a single system call. Only user space is counted, which works with the
+ * default perf_event_paranoid setting. Events the CPU (or kernel, or container) does not support are skipped and read
+ * as 0. Packed floating point operations are only counted on Intel CPUs, using the FP_ARITH_INST_RETIRED event.
+ *
+ * On systems other than Linux, opening always fails.
+ */
+class PerfCounters {
+  private:
+    /// @brief The file descriptor of the group leader (cycles), or -1 if closed.
+    int m_leader{-1};
+
+    /// @brief The file descriptors of all opened events, including the leader.
+    std::vector<int> m_fds;
+
+    /// @brief The counter belonging to each opened event, in the order of the group's read format.
+    std::vector<Counter> m_order;
+
+  public:
+    /// @brief Constructs closed counters.
+    PerfCounters() = default;
+
+    /// @brief Closes the counters.
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+    PerfCounters(PerfCounters &&other) noexcept;
+    PerfCounters &operator=(PerfCounters &&other) noexcept;
+
+    /**
+     * @brief Opens and starts the counters for the calling thread.
+     *
+     * @return true if at least the cycle counter could be opened.
+     * @return false if hardware counters are unavailable.
+     */
+    bool open();
+
+    /// @brief Stops and closes the counters.
+    void close();
+
+    /**
+     * @brief Checks whether the counters are open.
+     *
+     * @return true if the counters are open.
+     * @return false otherwise.
+     */
+    inline bool isOpen() const { return m_leader != -1; }
+
+    /**
+     * @brief Checks whether a counter is available.
+     *
+     * @param counter The counter to be checked.
+     * @return true if the counter has been opened.
+     * @return false otherwise.
+     */
+    bool isAvailable(Counter counter) const;
+
+    /**
+     * @brief Reads the current values of all counters. Unavailable counters are 0.
+     *
+     * @return The current counter values.
+     */
+    CounterValues read() const;
+
+    /**
+     * @brief Gets the name of a counter, as used in the output files.
+     *
+     * @param counter The counter.
+     * @return The lowercase name of the counter.
+     */
+    static const char *getName(Counter counter);
+};
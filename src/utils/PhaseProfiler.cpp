@@ -0,0 +1,278 @@
+#include "PhaseProfiler.h"
+#include "CLIUtils.h"
+#include <iomanip>
+#include <spdlog/spdlog.h>
+
+bool PhaseProfiler::s_enabled{false};
+bool PhaseProfiler::s_countersEnabled{false};
+PhaseProfiler::Clock::time_point PhaseProfiler::s_origin{};
+std::int64_t PhaseProfiler::s_stepStart{0};
+std::vector<PhaseProfiler::ThreadBuffer> PhaseProfiler::s_buffers{};
+std::ofstream PhaseProfiler::s_csv{};
+std::ofstream PhaseProfiler::s_trace{};
+std::ofstream PhaseProfiler::s_counterCsv{};
+PhaseProfiler::Totals PhaseProfiler::s_totals{};
+bool PhaseProfiler::s_traceHasEvents{false};
+
+// nanoseconds to (fractional) microseconds, the time unit of both output files
+static inline double toMicros(std::int64_t ns) { return static_cast<double>(ns) * 1e-3; }
+
+// instructions per cycle, or 0 if no cycles were counted
+static inline double getIPC(const CounterValues &c) {
+    const auto cycles = c[static_cast<size_t>(Counter::CYCLES)];
+    return cycles ? static_cast<double>(c[static_cast<size_t>(Counter::INSTRUCTIONS)]) / cycles : 0.0;
+}
+
+// the size of a cache line, i.e. the number of bytes transferred per last level cache miss
+#define CACHE_LINE_BYTES 64
+
+const char *PhaseProfiler::getName(Phase phase) {
+    switch (phase) {
+    case Phase::POSITION:
+        return "position";
+    case Phase::MIGRATION:
+        return "migration";
+    case Phase::BOUNDARY:
+        return "boundary";
+    case Phase::GHOSTS:
+        return "ghosts";
+    case Phase::FORCE:
+        return "force";
+    case Phase::VELOCITY:
+        return "velocity";
+    case Phase::THERMOSTAT:
+        return "thermostat";
+    case Phase::ANALYZER:
+        return "analyzer";
+    case Phase::OUTPUT:
+        return "output";
+    default:
+        return "unknown";
+    }
+}
+
+bool PhaseProfiler::openCounters() {
+    bool opened = true;
+#pragma omp parallel reduction(&& : opened)
+    {
+        const auto tid = static_cast<size_t>(omp_get_thread_num());
+        opened = tid < s_buffers.size() && s_buffers[tid].perf.open();
+    }
+    if (!opened) {
+        for (ThreadBuffer &buffer : s_buffers)
+            buffer.perf.close();
+        return false;
+    }
+    for (size_t i = 1; i < static_cast<size_t>(Counter::COUNT); ++i) {
+        if (!s_buffers[0].perf.isAvailable(static_cast<Counter>(i)))
+            SPDLOG_WARN("Hardware counter {} is not available and will be reported as 0.",
+                        PerfCounters::getName(static_cast<Counter>(i)));
+    }
+    return true;
+}
+
+bool PhaseProfiler::start(const std::string &basename, bool counters) {
+    if (s_enabled)
+        stop();
+
+    s_csv.open(basename + "_phases.csv");
+    s_trace.open(basename + "_trace.json");
+    if (counters)
+        s_counterCsv.open(basename + "_counters.csv");
+    if (!s_csv || !s_trace || (counters && !s_counterCsv)) {
+        CLIUtils::error("Failed to open profiling output files", basename + "_{phases.csv,trace.json,counters.csv}",
+                        false, false);
+        s_csv.close();
+        s_trace.close();
+        s_counterCsv.close();
+        return false;
+    }
+    s_csv << std::fixed << std::setprecision(3);
+    s_trace << std::fixed << std::setprecision(3);
+
+    // csv header: one column per phase
+    s_csv << "step,thread";
+    for (size_t i = 0; i < static_cast<size_t>(Phase::COUNT); ++i)
+        s_csv << ',' << getName(static_cast<Phase>(i));
+    s_csv << '\n';
+
+    // trace header: name the tracks, the simulation itself on track 0 and each thread on its own track
+    const int threads = omp_get_max_threads();
+    s_trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    s_trace << R"({"name":"thread_name","ph":"M","pid":0,"tid":0,"args":{"name":"simulation"}})";
+    for (int t = 0; t < threads; ++t)
+        s_trace << ",\n"
+                << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << t + 1 << R"(,"args":{"name":"thread )" << t
+                << "\"}}";
+    s_traceHasEvents = true;
+
+    s_buffers.clear();
+    s_buffers.resize(static_cast<size_t>(threads));
+    s_countersEnabled = counters && openCounters();
+    if (counters && !s_countersEnabled) {
+        SPDLOG_WARN("Hardware counters are unavailable (check /proc/sys/kernel/perf_event_paranoid), continuing "
+                    "without them.");
+        s_counterCsv.close();
+    }
+    if (s_countersEnabled) {
+        s_counterCsv << std::fixed << std::setprecision(3);
+        s_counterCsv << "step,phase";
+        for (size_t i = 0; i < static_cast<size_t>(Counter::COUNT); ++i)
+            s_counterCsv << ',' << PerfCounters::getName(static_cast<Counter>(i));
+        s_counterCsv << ",ipc\n";
+    }
+
+    s_totals = Totals{};
+    s_origin = Clock::now();
+    s_stepStart = 0;
+    s_enabled = true;
+    SPDLOG_INFO("Phase profiling enabled, writing to {}_phases.csv and {}_trace.json{}.", basename, basename,
+                s_countersEnabled ? " with hardware counters" : "");
+    return true;
+}
+
+void PhaseProfiler::stop() {
+    if (!s_enabled)
+        return;
+    s_enabled = false;
+    report();
+    s_countersEnabled = false;
+    s_trace << "\n]}\n";
+    s_csv.close();
+    s_trace.close();
+    s_counterCsv.close();
+    s_buffers.clear();
+}
+
+void PhaseProfiler::report() {
+    const double elapsed = static_cast<double>(s_totals.elapsed) * 1e-9;
+    SPDLOG_INFO("Phase profile ({:.3f}s):", elapsed);
+    for (size_t i = 0; i < static_cast<size_t>(Phase::COUNT); ++i) {
+        if (s_totals.wall[i] == 0)
+            continue;
+        const double ms = static_cast<double>(s_totals.wall[i]) * 1e-6;
+        const CounterValues &c = s_totals.counters[i];
+        if (s_countersEnabled) {
+            SPDLOG_INFO("  {:<10}: {:>10.3f}ms ({:>5.1f}%), IPC {:.2f}, LLC misses {}, FP vector ops {}",
+                        getName(static_cast<Phase>(i)), ms, 100.0 * s_totals.wall[i] / s_totals.elapsed, getIPC(c),
+                        c[static_cast<size_t>(Counter::LLC_MISSES)], c[static_cast<size_t>(Counter::FP_VECTOR_OPS)]);
+        } else {
+            SPDLOG_INFO("  {:<10}: {:>10.3f}ms ({:>5.1f}%)", getName(static_cast<Phase>(i)), ms,
+                        100.0 * s_totals.wall[i] / s_totals.elapsed);
+        }
+    }
+
+    // derived metrics
+    const auto force = static_cast<size_t>(Phase::FORCE);
+    if (s_totals.pairs > 0 && s_totals.wall[force] > 0) {
+        SPDLOG_INFO("Force pairs per second: {:.4g}",
+                    s_totals.pairs / (static_cast<double>(s_totals.wall[force]) * 1e-9));
+        if (s_countersEnabled)
+            SPDLOG_INFO("LLC bytes per pair    : {:.3f}",
+                        static_cast<double>(s_totals.counters[force][static_cast<size_t>(Counter::LLC_MISSES)]) *
+                            CACHE_LINE_BYTES / s_totals.pairs);
+    }
+    if (s_totals.moleculeUpdates > 0 && elapsed > 0)
+        SPDLOG_INFO("Molecule Updates per Second (MUPS): {:.4g}", s_totals.moleculeUpdates / elapsed);
+}
+
+void PhaseProfiler::writeTraceEvent(const char *name, const char *category, int tid, std::int64_t start,
+                                    std::int64_t duration, int step, const CounterValues *counters) {
+    if (s_traceHasEvents)
+        s_trace << ",\n";
+    s_trace << "{\"name\":\"" << name << "\",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+            << ",\"ts\":" << toMicros(start) << ",\"dur\":" << toMicros(duration) << ",\"args\":{\"step\":" << step;
+    if (counters) {
+        for (size_t i = 0; i < counters->size(); ++i)
+            s_trace << ",\"" << PerfCounters::getName(static_cast<Counter>(i)) << "\":" << (*counters)[i];
+    }
+    s_trace << "}}";
+    s_traceHasEvents = true;
+}
+
+void PhaseProfiler::endStep(int step, size_t moleculeUpdates) {
+    if (!s_enabled)
+        return;
+    constexpr size_t phases = static_cast<size_t>(Phase::COUNT);
+    const CounterValues *noCounters = nullptr;
+
+    // wall-clock times of the whole step, and the counters of phases without thread scopes
+    std::array<std::int64_t, phases> wall{};
+    std::array<CounterValues, phases> stepCounters{}, threadCounters{};
+    std::array<bool, phases> hasThreadScopes{};
+    for (size_t t = 0; t < s_buffers.size(); ++t) {
+        for (const Event &e : s_buffers[t].events) {
+            const auto i = static_cast<size_t>(e.phase);
+            auto &counters = e.kind == PhaseKind::STEP ? stepCounters[i] : threadCounters[i];
+            for (size_t c = 0; c < counters.size(); ++c)
+                counters[c] += e.counters[c];
+            if (e.kind != PhaseKind::STEP) {
+                hasThreadScopes[i] = true;
+                continue;
+            }
+            wall[i] += e.duration;
+            writeTraceEvent(getName(e.phase), "step", 0, e.start, e.duration, step,
+                            s_countersEnabled ? &e.counters : noCounters);
+        }
+    }
+    s_csv << step << ",all";
+    for (size_t i = 0; i < phases; ++i)
+        s_csv << ',' << toMicros(wall[i]);
+    s_csv << '\n';
+
+    // busy times of each thread
+    for (size_t t = 0; t < s_buffers.size(); ++t) {
+        ThreadBuffer &buffer = s_buffers[t];
+        std::array<std::int64_t, phases> busy = buffer.accumulated;
+        for (const Event &e : buffer.events) {
+            if (e.kind != PhaseKind::THREAD)
+                continue;
+            busy[static_cast<size_t>(e.phase)] += e.duration;
+            writeTraceEvent(getName(e.phase), "thread", static_cast<int>(t) + 1, e.start, e.duration, step,
+                            s_countersEnabled ? &e.counters : noCounters);
+        }
+        s_csv << step << ',' << t;
+        for (size_t i = 0; i < phases; ++i)
+            s_csv << ',' << toMicros(busy[i]);
+        s_csv << '\n';
+    }
+
+    // accumulated scopes have no single start, so they are shown as counters at the start of the step
+    for (size_t i = 0; i < phases; ++i) {
+        bool any = false;
+        for (const ThreadBuffer &buffer : s_buffers)
+            any |= buffer.accumulated[i] != 0;
+        if (!any)
+            continue;
+        s_trace << ",\n{\"name\":\"" << getName(static_cast<Phase>(i)) << "\",\"ph\":\"C\",\"pid\":0,\"ts\":"
+                << toMicros(s_stepStart) << ",\"args\":{";
+        for (size_t t = 0; t < s_buffers.size(); ++t)
+            s_trace << (t ? "," : "") << "\"thread " << t << "\":" << toMicros(s_buffers[t].accumulated[i]);
+        s_trace << "}}";
+    }
+
+    // hardware counters of each phase, summed over all threads
+    for (size_t i = 0; i < phases; ++i) {
+        const CounterValues &counters = hasThreadScopes[i] ? threadCounters[i] : stepCounters[i];
+        for (size_t c = 0; c < counters.size(); ++c)
+            s_totals.counters[i][c] += counters[c];
+        if (!s_countersEnabled || (wall[i] == 0 && !hasThreadScopes[i]))
+            continue;
+        s_counterCsv << step << ',' << getName(static_cast<Phase>(i));
+        for (std::uint64_t value : counters)
+            s_counterCsv << ',' << value;
+        s_counterCsv << ',' << getIPC(counters) << '\n';
+    }
+
+    for (size_t i = 0; i < phases; ++i)
+        s_totals.wall[i] += wall[i];
+    for (ThreadBuffer &buffer : s_buffers) {
+        s_totals.pairs += buffer.pairs;
+        buffer.pairs = 0;
+        buffer.events.clear();
+        buffer.accumulated.fill(0);
+    }
+    s_totals.moleculeUpdates += moleculeUpdates;
+    s_stepStart = now();
+    s_totals.elapsed = s_stepStart;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file PhaseProfiler.h
+ * @brief Low-overhead scoped timers for the individual phases of a simulation step.
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include "OMPWrapper.h"
+#include "PerfCounters.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define PROFILE_CONCAT_IMPL(_a, _b) _a##_b
+#define PROFILE_CONCAT(_a, _b) PROFILE_CONCAT_IMPL(_a, _b)
+
+/// @brief Times the enclosing scope as a phase of the whole step. Must be used outside of parallel regions.
+#define PROFILE_PHASE(_p) ScopedPhase PROFILE_CONCAT(_phase_, __LINE__)(_p, PhaseKind::STEP)
+/// @brief Times the enclosing scope as the work of the current thread inside a parallel region.
+#define PROFILE_THREAD(_p) ScopedPhase PROFILE_CONCAT(_phase_, __LINE__)(_p, PhaseKind::THREAD)
+/// @brief Adds the duration of the enclosing scope to the current thread's total for the step. Used for short scopes
+/// executed many times per step, which would flood the trace with events.
+#define PROFILE_ACCUMULATE(_p) ScopedPhase PROFILE_CONCAT(_phase_, __LINE__)(_p, PhaseKind::ACCUMULATE)
+
+/// @brief Enum containing each profiled phase of a simulation step.
+enum class Phase : std::uint8_t {
+    POSITION,
+    MIGRATION,
+    BOUNDARY,
+    GHOSTS,
+    FORCE,
+    VELOCITY,
+    THERMOSTAT,
+    ANALYZER,
+    OUTPUT,
+    COUNT
+};
+
+/// @brief Enum describing how a timed scope is recorded.
+enum class PhaseKind : std::uint8_t {
+    /// @brief Wall-clock time of a phase, measured on the thread driving the simulation.
+    STEP,
+    /// @brief Busy time of a single thread inside a parallel region of a phase.
+    THREAD,
+    /// @brief Busy time of a single thread, summed up over the step.
+    ACCUMULATE
+};
+
+/**
+ * @brief Class collecting phase timings and writing them as a per-step CSV summary and a Chrome trace.
+ *
+ * @details Profiling is toggled at runtime. While disabled, each timed scope costs a single branch. While enabled,
+ * every thread records into its own buffer, so no synchronization is needed; the buffers are drained by the
+ * simulation thread at the end of each step, keeping memory usage independent of the number of steps.
+ *
+ * Optionally, the hardware counters of each thread are read at the start and end of every step and thread scope, so
+ * that cycles, instructions, last level cache misses and packed floating point operations can be attributed to the
+ * individual phases. A phase's counters are the sum of its thread scopes if it has any, otherwise those of its step
+ * scope. Reading the counters costs a system call per scope, so it is only suited for scopes running long enough.
+ *
+ * The trace uses the Trace Event Format and can be opened in chrome://tracing or https://ui.perfetto.dev.
+ */
+class PhaseProfiler {
+  public:
+    /// @brief The clock used for all measurements.
+    using Clock = std::chrono::steady_clock;
+
+  private:
+    /// @brief A single timed scope.
+    struct Event {
+        /// @brief The phase of the scope.
+        Phase phase;
+        /// @brief Whether the scope belongs to the whole step or to a single thread.
+        PhaseKind kind;
+        /// @brief The start of the scope in nanoseconds since the profiler was started.
+        std::int64_t start;
+        /// @brief The duration of the scope in nanoseconds.
+        std::int64_t duration;
+        /// @brief The hardware events counted during the scope.
+        CounterValues counters;
+    };
+
+    /// @brief The events and accumulated times of a single thread, padded to avoid false sharing.
+    struct alignas(64) ThreadBuffer {
+        /// @brief The events recorded during the current step.
+        std::vector<Event> events;
+        /// @brief The accumulated times of each phase during the current step, in nanoseconds.
+        std::array<std::int64_t, static_cast<size_t>(Phase::COUNT)> accumulated{};
+        /// @brief The number of particle pairs the force was computed for during the current step.
+        std::uint64_t pairs{0};
+        /// @brief The hardware counters of the thread.
+        PerfCounters perf;
+    };
+
+    /// @brief Totals over all steps, for the final report.
+    struct Totals {
+        /// @brief The wall-clock time of each phase in nanoseconds.
+        std::array<std::int64_t, static_cast<size_t>(Phase::COUNT)> wall{};
+        /// @brief The hardware events counted in each phase.
+        std::array<CounterValues, static_cast<size_t>(Phase::COUNT)> counters{};
+        /// @brief The number of particle pairs the force was computed for.
+        std::uint64_t pairs{0};
+        /// @brief The number of molecule updates.
+        std::uint64_t moleculeUpdates{0};
+        /// @brief The wall-clock time of all steps in nanoseconds.
+        std::int64_t elapsed{0};
+    };
+
+    /// @brief Determines whether timed scopes are recorded.
+    static bool s_enabled;
+
+    /// @brief Determines whether hardware counters are read for step and thread scopes.
+    static bool s_countersEnabled;
+
+    /// @brief The point in time the profiler was started.
+    static Clock::time_point s_origin;
+
+    /// @brief The start of the current step in nanoseconds since the origin.
+    static std::int64_t s_stepStart;
+
+    /// @brief One buffer per thread.
+    static std::vector<ThreadBuffer> s_buffers;
+
+    /// @brief The per-step CSV summary.
+    static std::ofstream s_csv;
+
+    /// @brief The Chrome trace.
+    static std::ofstream s_trace;
+
+    /// @brief The per-step hardware counters of each phase.
+    static std::ofstream s_counterCsv;
+
+    /// @brief The totals over all steps.
+    static Totals s_totals;
+
+    /// @brief Determines whether an event has already been written to the trace (for comma placement).
+    static bool s_traceHasEvents;
+
+    /**
+     * @brief Writes a single complete event to the trace.
+     *
+     * @param name The name of the event.
+     * @param category The category of the event.
+     * @param tid The track of the event.
+     * @param start The start of the event in nanoseconds.
+     * @param duration The duration of the event in nanoseconds.
+     * @param step The step the event belongs to.
+     * @param counters The hardware events counted during the event, or nullptr if counters are disabled.
+     */
+    static void writeTraceEvent(const char *name, const char *category, int tid, std::int64_t start,
+                                std::int64_t duration, int step, const CounterValues *counters);
+
+    /// @brief Logs the time, hardware counters and derived metrics of each phase over all steps.
+    static void report();
+
+    /**
+     * @brief Opens the hardware counters of each OpenMP thread.
+     *
+     * @return true if the counters of every thread could be opened.
+     * @return false if hardware counters are unavailable.
+     */
+    static bool openCounters();
+
+  public:
+    /**
+     * @brief Starts profiling and opens the output files "<basename>_phases.csv" and "<basename>_trace.json", as well
+     * as "<basename>_counters.csv" if hardware counters are requested.
+     *
+     * If a file cannot be opened, an error is logged and profiling stays disabled. If hardware counters are
+     * unavailable (e.g. due to perf_event_paranoid or missing PMU access), a warning is logged and profiling continues
+     * without them.
+     *
+     * @param basename The basename of the output files.
+     * @param counters Determines whether hardware counters are read.
+     * @return true if profiling was started.
+     * @return false if an output file could not be opened.
+     */
+    static bool start(const std::string &basename, bool counters = false);
+
+    /// @brief Stops profiling, reports the totals of each phase and finalizes the output files.
+    static void stop();
+
+    /**
+     * @brief Writes the timings recorded during the given step and clears all buffers. Must be called outside of
+     * parallel regions.
+     *
+     * @param step The step which has just been completed.
+     * @param moleculeUpdates The number of molecules updated during the step, for computing MUPS.
+     */
+    static void endStep(int step, size_t moleculeUpdates = 0);
+
+    /**
+     * @brief Checks whether hardware counters are read.
+     *
+     * @return true if hardware counters are read for step and thread scopes.
+     * @return false otherwise.
+     */
+    static inline bool countersEnabled() { return s_countersEnabled; }
+
+    /**
+     * @brief Reads the hardware counters of the calling thread.
+     *
+     * @return The current counter values, or 0 if counters are disabled.
+     */
+    static inline CounterValues readCounters() {
+        const auto tid = static_cast<size_t>(omp_get_thread_num());
+        return tid < s_buffers.size() ? s_buffers[tid].perf.read() : CounterValues{};
+    }
+
+    /**
+     * @brief Adds to the number of particle pairs the calling thread computed the force for.
+     *
+     * @param pairs The number of pairs.
+     */
+    static inline void countPairs(std::uint64_t pairs) {
+        const auto tid = static_cast<size_t>(omp_get_thread_num());
+        if (s_enabled && tid < s_buffers.size())
+            s_buffers[tid].pairs += pairs;
+    }
+
+    /**
+     * @brief Checks whether profiling is enabled.
+     *
+     * @return true if timed scopes are recorded.
+     * @return false otherwise.
+     */
+    static inline bool isEnabled() { return s_enabled; }
+
+    /**
+     * @brief Gets the current time in nanoseconds since the profiler was started.
+     *
+     * @return The current time in nanoseconds.
+     */
+    static inline std::int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - s_origin).count();
+    }
+
+    /**
+     * @brief Records a timed scope for the calling thread.
+     *
+     * @param phase The phase of the scope.
+     * @param kind How the scope is recorded.
+     * @param start The start of the scope in nanoseconds.
+     * @param end The end of the scope in nanoseconds.
+     * @param counters The hardware events counted during the scope.
+     */
+    static inline void record(Phase phase, PhaseKind kind, std::int64_t start, std::int64_t end,
+                              const CounterValues &counters = {}) {
+        const auto tid = static_cast<size_t>(omp_get_thread_num());
+        if (tid >= s_buffers.size())
+            return;
+        ThreadBuffer &buffer = s_buffers[tid];
+        if (kind == PhaseKind::ACCUMULATE)
+            buffer.accumulated[static_cast<size_t>(phase)] += end - start;
+        else
+            buffer.events.push_back({phase, kind, start, end - start, counters});
+    }
+
+    /**
+     * @brief Gets the name of a phase, as used in the output files.
+     *
+     * @param phase The phase.
+     * @return The lowercase name of the phase.
+     */
+    static const char *getName(Phase phase);
+};
+
+/// @brief RAII guard timing the scope it lives in. Use the PROFILE_* macros instead of constructing it directly.
+class ScopedPhase {
+  private:
+    /// @brief The start of the scope in nanoseconds, or -1 if profiling was disabled on entry.
+    std::int64_t m_start{-1};
+    /// @brief The hardware counters at the start of the scope, if they are read.
+    CounterValues m_counters{};
+    /// @brief The phase of the scope.
+    Phase m_phase;
+    /// @brief How the scope is recorded.
+    PhaseKind m_kind;
+
+  public:
+    /**
+     * @brief Starts timing a scope, if profiling is enabled.
+     *
+     * @param phase The phase of the scope.
+     * @param kind How the scope is recorded.
+     */
+    ScopedPhase(Phase phase, PhaseKind kind) : m_phase{phase}, m_kind{kind} {
+        if (PhaseProfiler::isEnabled()) {
+            if (PhaseProfiler::countersEnabled() && m_kind != PhaseKind::ACCUMULATE)
+                m_counters = PhaseProfiler::readCounters();
+            m_start = PhaseProfiler::now();
+        }
+    }
+
+    /// @brief Stops timing the scope and records it.
+    ~ScopedPhase() {
+        if (m_start < 0)
+            return;
+        const std::int64_t end = PhaseProfiler::now();
+        if (PhaseProfiler::countersEnabled() && m_kind != PhaseKind::ACCUMULATE) {
+            const CounterValues counters = PhaseProfiler::readCounters();
+            for (size_t i = 0; i < m_counters.size(); ++i)
+                m_counters[i] = counters[i] - m_counters[i];
+        }
+        PhaseProfiler::record(m_phase, m_kind, m_start, end, m_counters);
+    }
+
+    ScopedPhase(const ScopedPhase &) = delete;
+    ScopedPhase &operator=(const ScopedPhase &) = delete;
+};
@@ -0,0 +1,97 @@
+/**
+ * @file RandomUtils.h
+ * @brief Counter-based random number generation (Philox4x32-10).
+ * @date 2025-02-03
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/// @brief Default seed used for all generated velocities, kept constant for repeatability.
+#define RNG_SEED_DEFAULT 42
+
+/**
+ * @brief Independent random streams. Every stream yields uncorrelated numbers for the same particle.
+ *
+ */
+enum class RandomStream : std::uint32_t { INITIAL_VELOCITY = 0, BROWNIAN_MOTION = 1 };
+
+/**
+ * @brief Namespace containing a counter-based random number generator.
+ *
+ * @details Unlike a stateful engine, Philox is a pure function of a counter and a key: the random numbers of a
+ * particle only depend on the seed, the particle's index and the stream, not on how many numbers were drawn before or
+ * by which thread. This makes bulk generation trivially parallel and reproducible for any number of threads.
+ *
+ * See: J. K. Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC '11.
+ */
+namespace RandomUtils {
+/// @brief Four 32-bit words, used as counter and output block of Philox4x32.
+using Block = std::array<std::uint32_t, 4>;
+/// @brief Two 32-bit words, used as the key of Philox4x32.
+using Key = std::array<std::uint32_t, 2>;
+
+/**
+ * @brief Compute the Philox4x32-10 bijection of the given counter under the given key.
+ *
+ * @param counter The counter, e.g. the particle index, stream and block number.
+ * @param key The key, e.g. the seed.
+ * @return Four uniformly distributed 32-bit words.
+ */
+inline Block philox4x32(Block counter, Key key) {
+    constexpr std::uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    constexpr std::uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+    for (int round = 0; round < 10; ++round) {
+        const std::uint64_t p0 = static_cast<std::uint64_t>(M0) * counter[0];
+        const std::uint64_t p1 = static_cast<std::uint64_t>(M1) * counter[2];
+        counter = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(p1),
+                   static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(p0)};
+        key[0] += W0;
+        key[1] += W1;
+    }
+    return counter;
+}
+
+/**
+ * @brief Generate four random 32-bit words for the given particle, stream and block.
+ *
+ * @param seed The seed of the simulation.
+ * @param id The index of the particle.
+ * @param stream The random stream.
+ * @param block The block number, for drawing more than four words per particle and stream.
+ * @return Four uniformly distributed 32-bit words.
+ */
+inline Block generate(std::uint64_t seed, std::uint64_t id, RandomStream stream, std::uint32_t block = 0) {
+    return philox4x32({static_cast<std::uint32_t>(id), static_cast<std::uint32_t>(id >> 32),
+                       static_cast<std::uint32_t>(stream), block},
+                      {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)});
+}
+
+/**
+ * @brief Convert two 32-bit words into a uniformly distributed double in the open interval (0, 1).
+ *
+ * @param hi The upper word.
+ * @param lo The lower word.
+ * @return A double in (0, 1) with 53 bits of randomness.
+ */
+inline double toUniform(std::uint32_t hi, std::uint32_t lo) {
+    const std::uint64_t bits = ((static_cast<std::uint64_t>(hi) << 32) | lo) >> 11;
+    return (static_cast<double>(bits) + 0.5) * 0x1p-53;
+}
+
+/**
+ * @brief Generate two independent standard normally distributed numbers from one block (Box-Muller transform).
+ *
+ * @param block Four uniformly distributed 32-bit words.
+ * @return Two standard normally distributed doubles.
+ */
+inline std::array<double, 2> toNormal(const Block &block) {
+    const double radius = std::sqrt(-2.0 * std::log(toUniform(block[0], block[1])));
+    const double angle = 2.0 * M_PI * toUniform(block[2], block[3]);
+    return {radius * std::cos(angle), radius * std::sin(angle)};
+}
+} // namespace RandomUtils
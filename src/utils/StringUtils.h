@@ -21,7 +21,8 @@
 
 /// @brief Map containing conversion information for converting a string to a WriterType enum.
 static inline const std::unordered_map<std::string, WriterType> writerTable = {
-    {"vtk", WriterType::VTK}, {"xyz", WriterType::XYZ}, {"nil", WriterType::NIL}};
+    {"vtk", WriterType::VTK},   {"vtkb", WriterType::VTKB}, {"xyz", WriterType::XYZ},
+    {"traj", WriterType::TRAJ}, {"nil", WriterType::NIL}};
 
 /// @brief Map containing conversion information for converting a string to a SimulationType enum.
 static inline const std::unordered_map<std::string, SimulationType> simulationTable = {
@@ -31,6 +32,11 @@ static inline const std::unordered_map<std::string, SimulationType> simulationTa
 static inline const std::unordered_map<std::string, ParallelizationType> parallelizationTable = {
     {"coarse", ParallelizationType::COARSE}, {"fine", ParallelizationType::FINE}};
 
+/// @brief Map containing conversion information for converting a string to a PairSearchType enum.
+static inline const std::unordered_map<std::string, PairSearchType> pairSearchTable = {
+    {"cells", PairSearchType::CELLS}, {"clusters", PairSearchType::CLUSTERS}, {"tree", PairSearchType::TREE},
+    {"levels", PairSearchType::LEVELS}};
+
 /// @brief Reverse map containing conversion information for converting a WriterType enum to a string.
 static inline const std::unordered_map<WriterType, std::string> writerStringTable = []() {
     std::unordered_map<WriterType, std::string> reverseMap;
@@ -55,6 +61,14 @@ static inline const std::unordered_map<ParallelizationType, std::string> paralle
     return reverseMap;
 }();
 
+/// @brief Reverse map containing conversion information for converting a PairSearchType enum to a string.
+static inline const std::unordered_map<PairSearchType, std::string> pairSearchStringTable = []() {
+    std::unordered_map<PairSearchType, std::string> reverseMap;
+    for (const auto &pair : pairSearchTable)
+        reverseMap[pair.second] = pair.first;
+    return reverseMap;
+}();
+
 /**
  * @brief Finds a given substring in a string. Case-insensitive.
  *
@@ -237,6 +251,21 @@ static inline ParallelizationType toParallelizationType(const std::string &type)
     return ParallelizationType::COARSE; // shouldn't reach this; included to silence warning
 }
 
+/**
+ * @brief Converts a string to a PairSearchType enum using a dedicated map.
+ *
+ * @param type The string containing the desired PairSearchType.
+ * @return The desired PairSearchType enum if the type string is valid, otherwise terminates with error.
+ */
+static inline PairSearchType toPairSearchType(const std::string &type) {
+    auto it = pairSearchTable.find(type);
+    if (it != pairSearchTable.end())
+        return it->second;
+    else
+        CLIUtils::error("Invalid pair search type", type);
+    return PairSearchType::CELLS; // shouldn't reach this; included to silence warning
+}
+
 /**
  * @brief Converts a char to a string.
  *
@@ -276,6 +305,16 @@ static inline std::string fromParallelizationType(ParallelizationType paralleliz
     return parallelizationStringTable.at(parallelizationType);
 }
 
+/**
+ * @brief Converts a PairSearchType to a string.
+ *
+ * @param pairSearchType An instance of the PairSearchType enum to be converted.
+ * @return The resulting string.
+ */
+static inline std::string fromPairSearchType(PairSearchType pairSearchType) {
+    return pairSearchStringTable.at(pairSearchType);
+}
+
 /**
  * @brief Converts a number to a string.
  *
@@ -0,0 +1,93 @@
+#include "io/output/AsyncWriter.h"
+#include "io/output/FileWriter.h"
+#include "objects/ParticleContainer.h"
+#include "utils/CLIUtils.h"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// writer which records all frames it is given, slowly enough for the queue to fill up
+class RecordingWriter : public FileWriter {
+  public:
+    std::vector<Frame> &frames;
+    explicit RecordingWriter(std::vector<Frame> &frames) : frames{frames} {}
+    void writeFrame(const Frame &frame) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        frames.push_back(frame);
+    }
+};
+
+// writer which fails on every frame, like a writer which cannot open its output file
+class FailingWriter : public FileWriter {
+  public:
+    void writeFrame(const Frame &) override { CLIUtils::error("Failed to open file", "", false); }
+};
+
+// Test capturing the active particles of a container into a frame.
+TEST(AsyncWriterTests, CaptureFrame) {
+    ParticleContainer pc;
+    pc.addParticle({1, 2, 3}, {4, 5, 6}, 7, 1);
+    pc.addParticle({9, 9, 9}, {9, 9, 9}, 9);
+    pc.addParticle({3, 2, 1}, {6, 5, 4}, 2);
+    pc[1].markInactive();
+
+    Frame f;
+    f.capture(pc, 10, 100);
+
+    EXPECT_EQ(f.iteration, 10);
+    EXPECT_EQ(f.total, 100);
+    ASSERT_EQ(f.size(), 2);
+    EXPECT_EQ(f.positions, (std::vector<double>{1, 2, 3, 3, 2, 1}));
+    EXPECT_EQ(f.velocities, (std::vector<double>{4, 5, 6, 6, 5, 4}));
+    EXPECT_EQ(f.masses, (std::vector<double>{7, 2}));
+    EXPECT_EQ(f.types, (std::vector<int>{1, 0}));
+}
+
+// Test that all frames are written in order and reflect the state at the time of capture.
+TEST(AsyncWriterTests, WriteFramesInOrder) {
+    ParticleContainer pc;
+    pc.addParticle({0, 0, 0}, {0, 0, 0}, 1);
+
+    std::vector<Frame> frames;
+    AsyncWriter writer{std::make_unique<RecordingWriter>(frames), 2};
+    for (int i = 0; i < 20; ++i) {
+        pc[0].setX({static_cast<double>(i), 0, 0});
+        writer.writeParticles(pc, i, 20);
+    }
+    writer.flush();
+
+    ASSERT_EQ(frames.size(), 20);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(frames[i].iteration, i);
+        EXPECT_EQ(frames[i].positions[0], i);
+    }
+}
+
+// Test that a write error of the background thread exits the program from the simulation thread once it flushes.
+TEST(AsyncWriterTests, ReportErrorOnFlush) {
+    ParticleContainer pc;
+    pc.addParticle({0, 0, 0}, {0, 0, 0}, 1);
+    auto write = [&pc]() {
+        AsyncWriter writer(std::make_unique<FailingWriter>(), 2);
+        writer.writeParticles(pc, 0, 1);
+        writer.flush();
+        std::exit(EXIT_SUCCESS);
+    };
+    EXPECT_EXIT(write(), ::testing::ExitedWithCode(EXIT_FAILURE), "");
+}
+
+// Test that destroying the writer without flushing only logs a write error instead of exiting the program.
+TEST(AsyncWriterTests, LogErrorOnDestruction) {
+    ParticleContainer pc;
+    pc.addParticle({0, 0, 0}, {0, 0, 0}, 1);
+    auto write = [&pc]() {
+        {
+            AsyncWriter writer(std::make_unique<FailingWriter>(), 2);
+            writer.writeParticles(pc, 0, 1);
+        }
+        std::exit(EXIT_SUCCESS);
+    };
+    EXPECT_EXIT(write(), ::testing::ExitedWithCode(EXIT_SUCCESS), "");
+}
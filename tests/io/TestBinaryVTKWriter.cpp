@@ -0,0 +1,104 @@
+#include "io/output/BinaryVTKWriter.h"
+#include "objects/ParticleContainer.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#endif
+
+class BinaryVTKWriterTests : public ::testing::Test {
+  protected:
+    Frame frame;
+
+    void SetUp() override {
+        ParticleContainer pc;
+        pc.addParticle({1, 2, 3}, {4, 5, 6}, 7, 1);
+        pc.addParticle({3, 2, 1}, {6, 5, 4}, 2);
+        frame.capture(pc, 42, 100);
+    }
+
+    // reads the whole generated file for the test frame
+    static std::string readFile(const std::string &dirname) {
+        std::ifstream file(dirname + "/test_0042.vtu", std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // gets the start of the raw data of the appended data array with the given name
+    static const char *arrayStart(const std::string &content, const std::string &name) {
+        const size_t attr = content.find("Name=\"" + name + "\"");
+        const size_t offsetPos = content.find("offset=\"", attr) + 8;
+        const size_t offset = std::stoul(content.substr(offsetPos));
+        return content.data() + content.find("_", content.find("<AppendedData")) + 1 + offset;
+    }
+};
+
+// Test writing uncompressed Float32 data.
+TEST_F(BinaryVTKWriterTests, WriteRawFloat32) {
+    BinaryVTKWriter w{"test", "vtkb_test", false, false};
+    w.writeFrame(frame);
+    const std::string content = readFile("vtkb_test");
+
+    EXPECT_NE(content.find("NumberOfPoints=\"2\""), std::string::npos);
+    EXPECT_EQ(content.find("compressor"), std::string::npos);
+
+    const char *points = arrayStart(content, "points");
+    std::uint64_t bytes;
+    std::memcpy(&bytes, points, sizeof(bytes));
+    ASSERT_EQ(bytes, 6 * sizeof(float));
+    float values[6];
+    std::memcpy(values, points + sizeof(bytes), sizeof(values));
+    for (int i = 0; i < 6; ++i)
+        EXPECT_FLOAT_EQ(values[i], frame.positions[i]);
+
+    const char *types = arrayStart(content, "type");
+    std::int32_t type[2];
+    std::memcpy(type, types + sizeof(bytes), sizeof(type));
+    EXPECT_EQ(type[0], 1);
+    EXPECT_EQ(type[1], 0);
+}
+
+// Test writing uncompressed Float64 data.
+TEST_F(BinaryVTKWriterTests, WriteRawFloat64) {
+    BinaryVTKWriter w{"test", "vtkb_test", true, false};
+    w.writeFrame(frame);
+    const std::string content = readFile("vtkb_test");
+
+    EXPECT_NE(content.find("type=\"Float64\" Name=\"velocity\""), std::string::npos);
+    const char *velocities = arrayStart(content, "velocity");
+    std::uint64_t bytes;
+    std::memcpy(&bytes, velocities, sizeof(bytes));
+    ASSERT_EQ(bytes, 6 * sizeof(double));
+    double values[6];
+    std::memcpy(values, velocities + sizeof(bytes), sizeof(values));
+    for (int i = 0; i < 6; ++i)
+        EXPECT_EQ(values[i], frame.velocities[i]);
+}
+
+#ifdef HAS_ZLIB
+// Test writing zlib-compressed data.
+TEST_F(BinaryVTKWriterTests, WriteCompressed) {
+    BinaryVTKWriter w{"test", "vtkb_test", true, true};
+    w.writeFrame(frame);
+    const std::string content = readFile("vtkb_test");
+
+    EXPECT_NE(content.find("compressor=\"vtkZLibDataCompressor\""), std::string::npos);
+    const char *masses = arrayStart(content, "mass");
+    std::uint64_t header[4];
+    std::memcpy(header, masses, sizeof(header));
+    ASSERT_EQ(header[0], 1);
+    EXPECT_EQ(header[2], 2 * sizeof(double));
+
+    double values[2];
+    uLongf size = sizeof(values);
+    ASSERT_EQ(uncompress(reinterpret_cast<Bytef *>(values), &size,
+                         reinterpret_cast<const Bytef *>(masses + sizeof(header)), header[3]),
+              Z_OK);
+    EXPECT_EQ(values[0], 7);
+    EXPECT_EQ(values[1], 2);
+}
+#endif
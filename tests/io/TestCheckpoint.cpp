@@ -0,0 +1,159 @@
+#include "io/input/CheckpointReader.h"
+#include "io/output/CheckpointWriter.h"
+#include "objects/Cuboid.h"
+#include "objects/FlowSimulationAnalyzer.h"
+#include "objects/ParticleContainer.h"
+#include "objects/Thermostat.h"
+#include "utils/Arguments.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+class CheckpointTests : public ::testing::Test {
+  protected:
+    ParticleContainer pc;
+    Arguments args;
+    Thermostat t{pc};
+    FlowSimulationAnalyzer fsa{pc};
+
+    void SetUp() override {
+        // 3x3 membrane, one corner particle has left the simulation
+        Cuboid c{pc, {1., 1., 1.}, {3, 3, 1}, {1., 2., 3.}, 1.0, 1., 0, 1, 1, 300, 2.2, 0.8};
+        c.getSpecialCases() = {{1, 1, 0}};
+        c.initialize(2);
+        c.initializeNeighbours();
+        for (auto &p : pc) {
+            p.setF({p.getX()[0], 1., 2.});
+            p.setOldF({3., p.getX()[1], 4.});
+            p.setThermalMotion({0.5, p.getX()[0], 0.});
+        }
+        pc.setSpecialForceLimit(150);
+        pc[8].markInactive();
+
+        args.endTime = 20;
+        args.delta_t = 0.0005;
+        args.itFreq = 50;
+        args.checkpointFreq = 1000;
+        args.domainSize = {10, 10, 1};
+        args.cutoffRadius = 4;
+        args.gravity = -0.001;
+        args.basename = "checkpoint_test";
+        args.type = WriterType::TRAJ;
+        args.conditions = {BoundaryCondition::REFLECTIVE, BoundaryCondition::PERIODIC, BoundaryCondition::OUTFLOW,
+                           BoundaryCondition::REFLECTIVE, BoundaryCondition::PERIODIC, BoundaryCondition::OUTFLOW};
+        args.membrane = true;
+
+        t.initialize(2, 40, 1000, 45, 0.5, true, true, true);
+        fsa.initialize(3, 0, 6, 100, "checkpoint_statistics", "checkpoint_csv", true);
+        fsa.sample();
+        fsa.sample();
+    }
+
+    void TearDown() override { std::remove("checkpoint_test.chk"); }
+};
+
+// Test restoring a complete simulation state, including bonds and analyzer samples.
+TEST_F(CheckpointTests, RoundTrip) {
+    CheckpointWriter w{"checkpoint_test.chk"};
+    w.write(pc, args, t, fsa, 12.5, 25000);
+    ASSERT_TRUE(CheckpointReader::isCheckpoint("checkpoint_test.chk"));
+
+    ParticleContainer rpc;
+    Arguments rargs;
+    Thermostat rt{rpc};
+    FlowSimulationAnalyzer rfsa{rpc};
+    CheckpointReader r{"checkpoint_test.chk"};
+    EXPECT_EQ(r.readCheckpoint(rargs, rpc, rt, rfsa), 25000);
+
+    // arguments
+    Arguments expected = args;
+    expected.startTime = 12.5;
+    EXPECT_TRUE(rargs == expected);
+    EXPECT_EQ(rargs.checkpointFreq, args.checkpointFreq);
+    EXPECT_EQ(rargs.membrane, args.membrane);
+    EXPECT_TRUE(rargs.argsSet.all());
+
+    // thermostat and analyzer
+    EXPECT_EQ(rt.getDimension(), 2);
+    EXPECT_EQ(rt.getInitTemp(), 40);
+    EXPECT_EQ(rt.getTargetTemp(), 45);
+    EXPECT_EQ(rt.getDeltaT(), 0.5);
+    EXPECT_EQ(rt.getTimestep(), 1000);
+    EXPECT_TRUE(rt.getNanoflow());
+    EXPECT_TRUE(rt.doScalingLimit());
+    EXPECT_EQ(rfsa.getBinNumber(), 3);
+    EXPECT_EQ(rfsa.getFrequency(), 100);
+    EXPECT_EQ(rfsa.getDirname(), "checkpoint_statistics");
+    EXPECT_EQ(rfsa.getBasename(), "checkpoint_csv");
+    EXPECT_TRUE(rfsa.isAccumulating());
+    EXPECT_EQ(rfsa.getSamples(), 2);
+    EXPECT_EQ(rfsa.getCountSums(), fsa.getCountSums());
+    EXPECT_EQ(rfsa.getVelocitySums(), fsa.getVelocitySums());
+
+    // particles; the inactive particle is dropped
+    EXPECT_EQ(rpc.getSpecialForceLimit(), 150);
+    ASSERT_EQ(rpc.size(), 8);
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(rpc[i], pc[i]);
+        EXPECT_EQ(rpc[i].getThermalMotion(), pc[i].getThermalMotion());
+        EXPECT_EQ(rpc[i].getCellIndex(), pc[i].getCellIndex());
+        EXPECT_EQ(rpc[i].getK(), pc[i].getK());
+        EXPECT_EQ(rpc[i].getR0(), pc[i].getR0());
+        EXPECT_EQ(rpc[i].getFZUP(), pc[i].getFZUP());
+    }
+    EXPECT_EQ(rpc[4].getFZUP(), 0.8);
+
+    // bonds point to the same particles, except for the ones to the dropped particle
+    auto expectBonds = [&](const std::vector<ParticleHandle> &restored, const std::vector<ParticleHandle> &original) {
+        std::vector<size_t> expected, actual;
+        for (ParticleHandle h : original) {
+            if (pc.resolve(h).isActive())
+                expected.push_back(pc.indexOf(h));
+        }
+        for (ParticleHandle h : restored)
+            actual.push_back(rpc.indexOf(h));
+        EXPECT_EQ(actual, expected);
+    };
+    for (size_t i = 0; i < 8; ++i) {
+        expectBonds(rpc[i].getDirectNeighbours(), pc[i].getDirectNeighbours());
+        expectBonds(rpc[i].getDiagonalNeighbours(), pc[i].getDiagonalNeighbours());
+    }
+    EXPECT_EQ(rpc[4].getDirectNeighbours().size(), 4);
+    EXPECT_EQ(rpc[4].getDiagonalNeighbours().size(), 3);
+}
+
+// Test restoring the linked cell settings, which must not be reset to their defaults when resuming.
+TEST_F(CheckpointTests, RoundTripLinkedCellSettings) {
+    args.pairSearch = PairSearchType::LEVELS;
+    args.pairCutoffFactor = 2.5;
+    args.cellSizeFactor = 0.5;
+    args.cellSkin = 0.3;
+    args.autoTune = true;
+    args.tuneInterval = 500;
+    CheckpointWriter w{"checkpoint_test.chk"};
+    w.write(pc, args, t, fsa, 12.5, 25000);
+
+    ParticleContainer rpc;
+    Arguments rargs;
+    Thermostat rt{rpc};
+    FlowSimulationAnalyzer rfsa{rpc};
+    CheckpointReader r{"checkpoint_test.chk"};
+    r.readCheckpoint(rargs, rpc, rt, rfsa);
+
+    EXPECT_EQ(rargs.pairSearch, PairSearchType::LEVELS);
+    EXPECT_EQ(rargs.pairCutoffFactor, 2.5);
+    EXPECT_EQ(rargs.cellSizeFactor, 0.5);
+    EXPECT_EQ(rargs.cellSkin, 0.3);
+    EXPECT_TRUE(rargs.autoTune);
+    EXPECT_EQ(rargs.tuneInterval, 500);
+}
+
+// Test that other files are not mistaken for checkpoints.
+TEST_F(CheckpointTests, DetectCheckpoint) {
+    std::ofstream("checkpoint_test.chk") << "<?xml version=\"1.0\"?>";
+    EXPECT_FALSE(CheckpointReader::isCheckpoint("checkpoint_test.chk"));
+    EXPECT_FALSE(CheckpointReader::isCheckpoint("checkpoint_test_nonexistent.chk"));
+}
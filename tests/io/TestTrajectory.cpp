@@ -0,0 +1,96 @@
+#include "io/input/TrajectoryReader.h"
+#include "io/output/TrajectoryWriter.h"
+#include "objects/ParticleContainer.h"
+#include "utils/ArrayUtils.h"
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+class TrajectoryTests : public ::testing::Test {
+  protected:
+    ParticleContainer pc;
+    std::vector<Frame> expected;
+
+    void SetUp() override {
+        pc.addParticle({0, 0, 0}, {1, 0, 0}, 1);
+        pc.addParticle({1, 1, 0}, {0, 1, 0}, 2, 1);
+        pc.addParticle({2, 0, 1}, {0, 0, 1}, 3);
+    }
+
+    // writes 40 frames with slowly moving particles; a particle is removed halfway through
+    void writeTrajectory(bool compress) {
+        TrajectoryWriter w{"test", "traj_test", compress};
+        for (int i = 0; i < 40; ++i) {
+            for (auto &p : pc)
+                p.setX(p.getX() + std::array<double, 3>{0.01 * i, 0.1, 0});
+            if (i == 25)
+                pc[0].markInactive();
+            Frame f;
+            f.capture(pc, i * 10, 400);
+            w.writeFrame(f);
+            expected.push_back(f);
+        }
+    }
+
+    static void expectEqualFrames(const Frame &a, const Frame &b) {
+        EXPECT_EQ(a.iteration, b.iteration);
+        EXPECT_EQ(a.total, b.total);
+        EXPECT_EQ(a.positions, b.positions);
+        EXPECT_EQ(a.velocities, b.velocities);
+        EXPECT_EQ(a.masses, b.masses);
+        EXPECT_EQ(a.types, b.types);
+        EXPECT_EQ(a.ids, b.ids);
+    }
+};
+
+// Test reading back frames in arbitrary order from an uncompressed trajectory.
+TEST_F(TrajectoryTests, RandomAccessRaw) {
+    writeTrajectory(false);
+    TrajectoryReader r{"traj_test/test.traj"};
+    ASSERT_EQ(r.frameCount(), expected.size());
+    Frame f;
+    for (size_t i : {39, 0, 17, 25, 26, 3}) {
+        r.readFrame(i, f);
+        expectEqualFrames(f, expected[i]);
+    }
+    EXPECT_EQ(r.getIteration(17), 170);
+}
+
+#ifdef HAS_ZLIB
+// Test reading back frames in arbitrary order from a delta encoded, compressed trajectory.
+TEST_F(TrajectoryTests, RandomAccessDeltaCompressed) {
+    writeTrajectory(true);
+    TrajectoryReader r{"traj_test/test.traj"};
+    ASSERT_EQ(r.frameCount(), expected.size());
+    Frame f;
+    for (size_t i : {39, 0, 17, 15, 25, 26, 31, 3}) {
+        r.readFrame(i, f);
+        expectEqualFrames(f, expected[i]);
+    }
+}
+
+// Test reading a range of delta encoded frames in order, each decoded on top of its predecessor.
+TEST_F(TrajectoryTests, SequentialDeltaCompressed) {
+    writeTrajectory(true);
+    TrajectoryReader r{"traj_test/test.traj"};
+    size_t index = 13;
+    r.readFrames(13, 39, [&](const Frame &f) { expectEqualFrames(f, expected[index++]); });
+    EXPECT_EQ(index, 40);
+}
+#endif
+
+// Test locating frames in a trajectory without a footer index.
+TEST_F(TrajectoryTests, ScanWithoutIndex) {
+    writeTrajectory(false);
+    // cut off the index and half of the last frame
+    const auto size = std::filesystem::file_size("traj_test/test.traj");
+    const auto indexSize = 40 * sizeof(TrajectoryFormat::IndexEntry) + 24;
+    std::filesystem::resize_file("traj_test/test.traj", size - indexSize - 20);
+
+    TrajectoryReader r{"traj_test/test.traj"};
+    ASSERT_EQ(r.frameCount(), expected.size() - 1);
+    Frame f;
+    r.readFrame(38, f);
+    expectEqualFrames(f, expected[38]);
+}
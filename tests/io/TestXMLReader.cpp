@@ -143,4 +143,52 @@ TEST_F(XMLReaderTests, OpenFilesInvalid) {
     EXPECT_DEATH({ READ_XML("/testXMLInvalid_MissingType.xml"); }, "");
     EXPECT_DEATH({ READ_XML("/testXMLInvalid_MissingObjectsTag.xml"); }, "");
     EXPECT_DEATH({ READ_XML("/testXMLInvalid_MissingObjectsContents.xml"); }, "");
-}
\ No newline at end of file
+}
+
+// Test that single particles are added as soon as they are read, while discs and cuboids following single particles
+// are added afterwards, in the order cuboids, then discs.
+TEST_F(XMLReaderTests, ObjectOrder) {
+    constexpr std::array<std::array<double, 3>, 10> x = {{{5, 5, 0},
+                                                          {3, 3, 0},
+                                                          {4, 3, 0},
+                                                          {3, 4, 0},
+                                                          {4, 4, 0},
+                                                          {10, 9, 0},
+                                                          {9, 10, 0},
+                                                          {10, 10, 0},
+                                                          {11, 10, 0},
+                                                          {10, 11, 0}}};
+    constexpr std::array<double, 10> m = {0.5, 2, 2, 2, 2, 1, 1, 1, 1, 1};
+
+    Arguments args;
+    ParticleContainer pc;
+    Thermostat t{pc};
+    FlowSimulationAnalyzer fsa{pc};
+    READ_XML("/testXMLValid_MixedOrder.xml");
+
+    ASSERT_EQ(pc.size(), 10);
+    for (size_t i = 0; i < pc.size(); ++i) {
+        EXPECT_EQ(pc[i].getX(), x[i]);
+        EXPECT_EQ(pc[i].getM(), m[i]);
+        EXPECT_EQ(pc[i].getHandle(), i);
+    }
+}
+
+// Test that a continuation file containing only particles keeps their order and fills the container reserved from
+// <totalParticles> without growing it.
+TEST_F(XMLReaderTests, ParticlesOnly) {
+    constexpr std::array<std::array<double, 3>, 3> x = {{{7, 1, 0}, {2, 8, 0}, {4, 4, 0}}};
+
+    Arguments args;
+    ParticleContainer pc;
+    Thermostat t{pc};
+    FlowSimulationAnalyzer fsa{pc};
+    READ_XML("/testXMLValid_ParticlesOnly.xml");
+
+    ASSERT_EQ(pc.size(), 3);
+    EXPECT_EQ(pc.capacity(), 3);
+    for (size_t i = 0; i < pc.size(); ++i) {
+        EXPECT_EQ(pc[i].getX(), x[i]);
+        EXPECT_EQ(pc[i].getHandle(), i);
+    }
+}
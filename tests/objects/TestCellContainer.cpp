@@ -2,6 +2,7 @@
 #include "objects/Particle.h"
 #include "objects/ParticleContainer.h"
 #include <gtest/gtest.h>
+#include <vector>
 
 class CellContainerTest : public ::testing::Test {
   protected:
@@ -55,6 +56,72 @@ TEST_F(CellContainerTest, InitializeUninitializedValues) {
     EXPECT_DEATH(CellContainer(domainSize, conditions, INFINITY, particles, 3), "");
 }
 
+// Test initializing a cell container with cells larger than the cutoff radius.
+TEST_F(CellContainerTest, CellSizeFactor) {
+    for (Particle &p : particles)
+        p.setCellIndex(-1);
+    CellContainer larger{domainSize, conditions, cutoff, particles, 2, 1.5};
+    EXPECT_NEAR(larger.getCellSize()[0], 10.0 / 3.0, 1e-9);
+    EXPECT_EQ(larger.getNumCells()[0], 5);
+    EXPECT_EQ(larger.getNumCells()[1], 5);
+    size_t count = 0;
+    for (Cell &c : larger.getCells())
+        count += c.getParticles().size();
+    EXPECT_EQ(count, particles.size());
+
+    // the whole domain is a single cell if the factor exceeds it
+    for (Particle &p : particles)
+        p.setCellIndex(-1);
+    CellContainer single{domainSize, conditions, cutoff, particles, 2, 6.0};
+    EXPECT_EQ(single.getCellSize()[0], 10.0);
+    EXPECT_EQ(single.getNumCells()[0], 3);
+
+    EXPECT_DEATH(CellContainer(domainSize, conditions, cutoff, particles, 2, 0.7), "");
+    EXPECT_DEATH(CellContainer(domainSize, conditions, cutoff, particles, 2, 0.0), "");
+}
+
+// Test initializing a cell container with cells smaller than the cutoff radius.
+// The halo and border are as thick as there are cells per cutoff radius, and the domain stays in place.
+TEST_F(CellContainerTest, SubCells) {
+    for (Particle &p : particles)
+        p.setCellIndex(-1);
+    CellContainer sub{domainSize, conditions, cutoff, particles, 2, 0.5};
+    EXPECT_EQ(sub.getHaloWidth(), 2);
+    EXPECT_EQ(sub.getCellSize()[0], 1.0);
+    EXPECT_EQ(sub.getNumCells()[0], 14);
+    EXPECT_EQ(sub.getNumCells()[1], 14);
+    EXPECT_EQ(sub.getHaloCells().size(), 14 * 14 - 10 * 10);
+    EXPECT_EQ(sub.getBorderCells().size(), 10 * 10 - 6 * 6);
+    EXPECT_EQ(sub.getIterableCells().size(), 10 * 10);
+
+    // the first cell of the domain starts at the same position as with cells of the cutoff radius
+    EXPECT_EQ(sub[2 * 14 + 2].getX()[0], container[1 * 7 + 1].getX()[0]);
+    EXPECT_EQ(sub[2 * 14 + 2].getType(), CellType::BORDER);
+    EXPECT_EQ(sub[1 * 14 + 1].getType(), CellType::HALO);
+    EXPECT_EQ(sub[4 * 14 + 4].getType(), CellType::INNER);
+
+    // particles end up in the cells containing them
+    for (Particle &p : particles) {
+        const Cell &c = sub[p.getCellIndex()];
+        EXPECT_GE(p.getX()[0], c.getX()[0]);
+        EXPECT_LT(p.getX()[0], c.getX()[0] + c.getSize()[0]);
+        EXPECT_GE(p.getX()[1], c.getX()[1]);
+        EXPECT_LT(p.getX()[1], c.getX()[1] + c.getSize()[1]);
+    }
+
+    // the stencil covers 5x5 cells, clipped at the edges
+    EXPECT_EQ(sub.getNeighbors(7 * 14 + 7).size(), 25);
+    EXPECT_EQ(sub.getNeighbors(0).size(), 9);
+
+    // reflection mirrors across the boundary, periodic boundaries map across the domain
+    EXPECT_EQ(sub.getOppositeNeighbor(7 * 14 + 1, HaloLocation::WEST), 7 * 14 + 2);
+    EXPECT_EQ(sub.getOppositeNeighbor(7 * 14 + 0, HaloLocation::WEST), 7 * 14 + 3);
+    EXPECT_EQ(sub.getOppositeNeighbor(12 * 14 + 7, HaloLocation::NORTH), 11 * 14 + 7);
+    EXPECT_EQ(sub.getOppositeNeighbor(13 * 14 + 7, HaloLocation::NORTH), 10 * 14 + 7);
+    EXPECT_EQ(sub.getOppositeOfHalo(sub[7 * 14 + 0], HaloLocation::WEST), 7 * 14 + 10);
+    EXPECT_EQ(sub.getOppositeOfBorder(sub[7 * 14 + 3], BorderLocation::WEST), 7 * 14 + 13);
+}
+
 // Test adding a particle to a cell container.
 TEST_F(CellContainerTest, AddParticle) {
     Particle p1({2.0, 2.0, 0.0},
@@ -64,9 +131,10 @@ TEST_F(CellContainerTest, AddParticle) {
                     0.,
                 },
                 1);
-    ASSERT_TRUE(container.addParticle(p1));
-    EXPECT_EQ(p1.getCellIndex(), 8);
-    EXPECT_EQ(p1.getCellIndex(), container.getCellIndex(p1.getX()));
+    Particle &p = particles.resolve(particles.addParticle(p1));
+    ASSERT_TRUE(container.addParticle(p));
+    EXPECT_EQ(p.getCellIndex(), 8);
+    EXPECT_EQ(p.getCellIndex(), container.getCellIndex(p.getX()));
 }
 
 // Test attempting to add a particle outside the domain.
@@ -78,8 +146,9 @@ TEST_F(CellContainerTest, ParticleAdditionOutsideDomain) {
                     0.,
                 },
                 1);
-    ASSERT_FALSE(container.addParticle(p1));
-    EXPECT_EQ(p1.getCellIndex(), -1);
+    Particle &p = particles.resolve(particles.addParticle(p1));
+    ASSERT_FALSE(container.addParticle(p));
+    EXPECT_EQ(p.getCellIndex(), -1);
 }
 
 // Test moving a particle to its correct cell.
@@ -106,6 +175,73 @@ TEST_F(CellContainerTest, GetNeighbors) {
     EXPECT_TRUE(std::find(neighbors.begin(), neighbors.end(), cellIndex) != neighbors.end());
 }
 
+// Test that the shared stencil yields the same neighbors as the clipped neighbor computation for iterable cells.
+TEST_F(CellContainerTest, Stencil) {
+    EXPECT_EQ(container.getStencil().size(), 9);
+    for (const Cell &c : container.getIterableCells()) {
+        std::vector<int> neighbors;
+        for (int offset : container.getStencil())
+            neighbors.push_back(c.getIndex() + offset);
+        EXPECT_EQ(neighbors, container.getNeighbors(c.getIndex()));
+    }
+}
+
+// Test that the index lookup specialized for a fixed number of dimensions matches the generic one, ignoring z in 2D.
+TEST_F(CellContainerTest, CellIndexDimensions) {
+    for (double x = -1.0; x < 16.0; x += 0.7) {
+        for (double y = -1.0; y < 16.0; y += 0.9) {
+            EXPECT_EQ(container.getCellIndex<2>({x, y, 0.0}), container.getCellIndex({x, y, 0.0}));
+            EXPECT_EQ(container.getCellIndex<2>({x, y, 42.0}), container.getCellIndex({x, y, 0.0}));
+        }
+    }
+
+    CellContainer cc{{3, 3, 3}, conditions, 1, particles, 3};
+    for (double x = -0.5; x < 6.0; x += 0.4)
+        for (double z = -0.5; z < 6.0; z += 0.3)
+            EXPECT_EQ(cc.getCellIndex<3>({x, 2.5, z}), cc.getCellIndex({x, 2.5, z}));
+}
+
+// Test that a skin enlarges the cells and lets positions stay in their cell until they are more than the skin outside
+// of it or leave the domain.
+TEST_F(CellContainerTest, Skin) {
+    for (Particle &p : particles)
+        p.setCellIndex(-1);
+    CellContainer skinned{domainSize, conditions, cutoff, particles, 2, 1.0, 0.0, 0.5};
+    EXPECT_EQ(skinned.getSkin(), 0.5);
+    EXPECT_NEAR(skinned.getCellSize()[0], 10.0 / 3.0, 1e-9);
+    EXPECT_NEAR(skinned.getCellSize()[1], 10.0 / 3.0, 1e-9);
+
+    // the domain stays in place, the cell containing (2.5, 2.5) spans [2, 16/3) in each dimension
+    const int index = skinned.getCellIndex({2.5, 2.5, 0.0});
+    EXPECT_TRUE(skinned.isWithinSkin<2>({2.5, 2.5, 0.0}, index));
+    EXPECT_TRUE(skinned.isWithinSkin<2>({5.7, 2.5, 0.0}, index));
+    EXPECT_FALSE(skinned.isWithinSkin<2>({5.9, 2.5, 0.0}, index));
+    EXPECT_FALSE(skinned.isWithinSkin<2>({2.5, 1.9, 0.0}, index));
+    EXPECT_TRUE(skinned.isWithinSkin<2>({2.5, 2.5, 42.0}, index));
+
+    EXPECT_DEATH(CellContainer(domainSize, conditions, cutoff, particles, 2, 1.0, 0.0, -1.0), "");
+}
+
+// Test collecting the occupied cells, which are collected again whenever a cell becomes empty or non-empty.
+TEST_F(CellContainerTest, OccupiedCells) {
+    // the particle in the halo cell is not part of the iterable cells
+    EXPECT_EQ(container.getOccupiedCells(), (std::vector<int>{16, 32}));
+
+    Particle &p = particles[2];
+    p.setX({3.0, 3.0, 0.0});
+    ASSERT_TRUE(container.moveParticle(p));
+    EXPECT_EQ(container.getOccupiedCells(), (std::vector<int>{8, 16}));
+
+    // with more particles than iterable cells, the cells are scanned instead, with the same result
+    for (int i = 0; i < 30; ++i) {
+        Particle &q = particles.resolve(particles.addParticle(Particle({9.0, 9.0, 0.0}, {0., 0., 0.}, 1)));
+        ASSERT_TRUE(container.addParticle(q));
+    }
+    EXPECT_EQ(container.getOccupiedCells(), (std::vector<int>{8, 16, 32}));
+    container.deleteParticle(particles[1]);
+    EXPECT_EQ(container.getOccupiedCells(), (std::vector<int>{8, 32}));
+}
+
 // Test iterating over boundary particles.
 TEST_F(CellContainerTest, BoundaryIterator) {
     Particle p1({0.5, 0.5, 0.0},
@@ -130,9 +266,12 @@ TEST_F(CellContainerTest, BoundaryIterator) {
                 },
                 1);
 
-    container.addParticle(p1);
-    container.addParticle(p2);
-    container.addParticle(p3);
+    ParticleHandle h1 = particles.addParticle(p1);
+    ParticleHandle h2 = particles.addParticle(p2);
+    ParticleHandle h3 = particles.addParticle(p3);
+    container.addParticle(particles.resolve(h1));
+    container.addParticle(particles.resolve(h2));
+    container.addParticle(particles.resolve(h3));
 
     // check boundary particles
     auto it = container.boundaryBegin();
@@ -200,9 +339,12 @@ TEST_F(CellContainerTest, HaloIterator) {
                    },
                    1};
 
-    container.addParticle(p1);
-    container.addParticle(p2);
-    container.addParticle(p3);
+    ParticleHandle h1 = particles.addParticle(p1);
+    ParticleHandle h2 = particles.addParticle(p2);
+    ParticleHandle h3 = particles.addParticle(p3);
+    container.addParticle(particles.resolve(h1));
+    container.addParticle(particles.resolve(h2));
+    container.addParticle(particles.resolve(h3));
 
     // check halo particles
     auto it = container.haloBegin();
@@ -384,3 +526,34 @@ TEST_F(CellContainerTest, Additional3DTests) {
     EXPECT_EQ(cc.getOppositeOfHalo(cc.getCells()[6], HaloLocation::BELOW), 81);
     EXPECT_EQ(cc.getOppositeOfHalo(cc.getCells()[100], HaloLocation::ABOVE), 25);
 }
+
+// Test the location masks of the cells and the periodic lookups of the opposite cells.
+TEST_F(CellContainerTest, LocationMasks) {
+    // the lower left halo corner lies both south and west of the domain, the cell diagonally inside it on its border
+    const Cell &haloCorner = container.getCells()[0];
+    const Cell &borderCorner = container.getCells()[8];
+    EXPECT_EQ(haloCorner.getHaloMask(), CellUtils::toMask(HaloLocation::SOUTH) | CellUtils::toMask(HaloLocation::WEST));
+    EXPECT_EQ(haloCorner.getHaloLocation(), (std::vector<HaloLocation>{HaloLocation::SOUTH, HaloLocation::WEST}));
+    EXPECT_EQ(haloCorner.getBorderMask(), 0);
+    EXPECT_EQ(borderCorner.getHaloMask(), 0);
+    EXPECT_EQ(borderCorner.getBorderLocation(),
+              (std::vector<BorderLocation>{BorderLocation::SOUTH, BorderLocation::WEST}));
+    EXPECT_EQ(container.getCells()[24].getType(), CellType::INNER);
+    EXPECT_EQ(container.getCells()[24].getHaloMask() | container.getCells()[24].getBorderMask(), 0);
+    EXPECT_EQ(container.getPeriodicMask(), 0);
+
+    // with periodic boundaries, the lower left border corner is mirrored into the other three halo corners
+    std::array<BoundaryCondition, 6> periodic;
+    periodic.fill(BoundaryCondition::PERIODIC);
+    ParticleContainer pc;
+    CellContainer cc{domainSize, periodic, cutoff, pc, 2};
+    EXPECT_EQ(cc.getPeriodicMask(), 0b001111);
+    EXPECT_EQ(cc.getOppositeOfBorder(cc.getCells()[8], BorderLocation::SOUTH), 43);
+    EXPECT_EQ(cc.getOppositeOfBorder(cc.getCells()[8], BorderLocation::WEST), 13);
+    EXPECT_EQ(cc.getOppositeOfBorderCorner(cc.getCells()[8], cc.getCells()[8].getBorderMask()),
+              (std::vector<int>{48}));
+    EXPECT_EQ(CellContainer::getBorderCombinations(CellUtils::toMask(BorderLocation::NORTH) |
+                                                   CellUtils::toMask(BorderLocation::WEST) |
+                                                   CellUtils::toMask(BorderLocation::ABOVE)),
+              (std::vector<LocationMask>{0b000101, 0b010001, 0b010100, 0b010101}));
+}
@@ -0,0 +1,143 @@
+#include "objects/CellContainer.h"
+#include "objects/ClusterPairList.h"
+#include "objects/Particle.h"
+#include "objects/ParticleContainer.h"
+#include "strategies/ForceCalculation.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+class ClusterPairListTest : public ::testing::Test {
+  protected:
+    std::array<BoundaryCondition, 6> conditions{BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE,
+                                                BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE,
+                                                BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE};
+    ParticleContainer particles;
+
+    void SetUp() override {
+        // 7 regular particles in the first cell, 2 wall particles in the second one and a single particle far away
+        // the domain starts after the halo cells, i.e. at the cutoff radius
+        for (int i = 0; i < 7; ++i)
+            particles.addParticle(Particle{{2.5 + 0.1 * i, 3.5 - 0.2 * i, 0.0}, {0., 0., 0.}, 1.});
+        particles.addParticle(Particle{{4.5, 2.5, 0.0}, {0., 0., 0.}, 1., 1});
+        particles.addParticle(Particle{{5.0, 2.5, 0.0}, {0., 0., 0.}, 1., 1});
+        particles.addParticle(Particle{{11.5, 11.5, 0.0}, {0., 0., 0.}, 1.});
+    }
+};
+
+// Test that the particles of each cell are split into sorted and padded clusters with fitting bounding boxes.
+TEST_F(ClusterPairListTest, Clusters) {
+    CellContainer cc{{10.0, 10.0, 1.0}, conditions, 2.0, particles, 2};
+    ClusterPairList list;
+    list.build(cc);
+
+    const auto numClusters = [](size_t n) { return (n + CLUSTER_SIZE - 1) / CLUSTER_SIZE; };
+    const auto &clusters = list.getClusters();
+    ASSERT_EQ(clusters.size(), numClusters(7) + numClusters(2) + numClusters(1));
+
+    size_t regular = 0, walls = 0;
+    for (const ParticleCluster &cluster : clusters) {
+        EXPECT_FALSE(cluster.isGhost);
+        double last = -INFINITY;
+        for (size_t lane = 0; lane < CLUSTER_SIZE; ++lane) {
+            if (cluster.handles[lane] == INVALID_HANDLE) {
+                EXPECT_EQ(cluster.x[lane], CLUSTER_PADDING);
+                continue;
+            }
+            const Particle &p = particles.resolve(cluster.handles[lane]);
+            EXPECT_EQ(p.getType() == 1, cluster.isStatic);
+            EXPECT_EQ(p.getCellIndex(), cluster.cellIndex);
+            EXPECT_EQ(cluster.x[lane], p.getX()[0]);
+            EXPECT_EQ(cluster.y[lane], p.getX()[1]);
+
+            // sorted along the last dimension
+            EXPECT_GE(cluster.y[lane], last);
+            last = cluster.y[lane];
+            for (size_t d = 0; d < 3; ++d) {
+                EXPECT_LE(cluster.boxMin[d], p.getX()[d]);
+                EXPECT_GE(cluster.boxMax[d], p.getX()[d]);
+            }
+            ++(cluster.isStatic ? walls : regular);
+        }
+    }
+    EXPECT_EQ(regular, 8);
+    EXPECT_EQ(walls, 2);
+}
+
+// Test that only nearby clusters are paired, that no pair starts at a static cluster and that each pair is listed once.
+TEST_F(ClusterPairListTest, Pairs) {
+    CellContainer cc{{10.0, 10.0, 1.0}, conditions, 2.0, particles, 2};
+    ClusterPairList list;
+    list.build(cc);
+
+    const auto &clusters = list.getClusters();
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> seen;
+    for (size_t l = 0; l < list.getNumLists(); ++l) {
+        for (const ClusterPair &pair : list.getPairs(l)) {
+            EXPECT_FALSE(clusters[pair.i].isStatic);
+            EXPECT_EQ(clusters[pair.j].isStatic, pair.mask == ClusterPairMask::STATIC);
+            EXPECT_EQ(pair.i == pair.j, pair.mask == ClusterPairMask::TRIANGLE);
+
+            // the lonely particle has no neighbouring clusters except itself
+            const bool lonely = particles.resolve(clusters[pair.i].handles[0]).getX()[0] > 11.0 ||
+                                particles.resolve(clusters[pair.j].handles[0]).getX()[0] > 11.0;
+            EXPECT_TRUE(!lonely || pair.i == pair.j);
+
+            for (const auto &other : seen)
+                EXPECT_FALSE(other.first == pair.i && other.second == pair.j);
+            seen.emplace_back(pair.i, pair.j);
+        }
+    }
+    EXPECT_EQ(seen.size(), list.getNumPairs());
+    EXPECT_GT(seen.size(), 0);
+}
+
+// Test that the cluster pair lists kept between steps belong to their cell container, i.e. that repeated force
+// calculations on two differently sized containers both still match the linked cell force calculation.
+TEST_F(ClusterPairListTest, SeparateContainers) {
+    // perturbed lattices of different sizes with a wall at the bottom, inside the domains which start after the halo
+    // cells
+    auto lattice = [](ParticleContainer &pc, int n) {
+        for (int x = 0; x < n; ++x)
+            for (int y = 0; y < n; ++y)
+                pc.addParticle(Particle{{2.5 + 1.1 * x + 0.05 * std::sin(x + 3 * y), 2.5 + 1.1 * y, 0.0},
+                                        {0., 0., 0.},
+                                        1.,
+                                        y == 0 ? 1 : 0});
+    };
+    ParticleContainer small, large;
+    lattice(small, 5);
+    lattice(large, 12);
+    CellContainer cc{{8.0, 8.0, 1.0}, conditions, 2.0, small, 2};
+    CellContainer ccLarge{{16.0, 16.0, 1.0}, conditions, 2.0, large, 2};
+
+    auto forces = [](void (*f)(ParticleContainer &, double, CellContainer *), ParticleContainer &pc,
+                     CellContainer &lc) {
+        for (Particle &p : pc)
+            p.setFToZero();
+        f(pc, 2.0, &lc);
+        std::vector<std::array<double, 3>> result;
+        for (const Particle &p : pc)
+            result.push_back(p.getF());
+        return result;
+    };
+    auto expectForces = [](const std::vector<std::array<double, 3>> &actual,
+                           const std::vector<std::array<double, 3>> &expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            for (size_t d = 0; d < 3; ++d)
+                EXPECT_NEAR(actual[i][d], expected[i][d], 1e-9 * (1.0 + std::fabs(expected[i][d])));
+    };
+
+    const auto expected = forces(calculateF_LennardJones_LC, small, cc);
+    const auto expectedLarge = forces(calculateF_LennardJones_LC, large, ccLarge);
+    // both containers are in use at the same time, like in simulations running side by side
+    std::thread other([&]() {
+        for (int round = 0; round < 20; ++round)
+            expectForces(forces(calculateF_LennardJones_LC_cluster, large, ccLarge), expectedLarge);
+    });
+    for (int round = 0; round < 20; ++round)
+        expectForces(forces(calculateF_LennardJones_LC_cluster, small, cc), expected);
+    other.join();
+}
@@ -11,6 +11,13 @@ TEST(CuboidTests, InitializeCuboidParticlesEmpty) {
     ASSERT_EQ(c.getParticles().size(), 0);
 }
 
+// Test that a non-empty cuboid with an invalid mass is rejected before any particles are generated.
+TEST(CuboidTests, InitializeCuboidParticlesInvalidMass) {
+    ParticleContainer pc;
+    Cuboid c{pc, {0., 0., 0.}, {2, 2, 1}, {0., 0., 0.}, 1., 0.};
+    EXPECT_DEATH(c.initialize(), "");
+}
+
 // Test initializing the cuboid particles (i.e. if the positions are correct, if the force effective is 0 and if the
 // masses of all the particles are the same).
 TEST(CuboidTests, InitializeCuboidParticlesNonEmpty) {
@@ -73,19 +80,19 @@ TEST(CuboidTests, InitializeCuboidMembrane) {
     }
     // check the references of some of the particles
     /* particle 0 */
-    EXPECT_EQ(c.getParticles()[0].getDirectNeighbours()[0].get(), c.getParticles()[1]);
-    EXPECT_EQ(c.getParticles()[0].getDirectNeighbours()[1].get(), c.getParticles()[3]);
-    EXPECT_EQ(c.getParticles()[0].getDiagonalNeighbours()[0].get(), c.getParticles()[4]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[0].getDirectNeighbours()[0]), c.getParticles()[1]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[0].getDirectNeighbours()[1]), c.getParticles()[3]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[0].getDiagonalNeighbours()[0]), c.getParticles()[4]);
     /* particle 4*/
-    EXPECT_EQ(c.getParticles()[4].getDirectNeighbours()[0].get(), c.getParticles()[3]);
-    EXPECT_EQ(c.getParticles()[4].getDirectNeighbours()[1].get(), c.getParticles()[5]);
-    EXPECT_EQ(c.getParticles()[4].getDirectNeighbours()[2].get(), c.getParticles()[1]);
-    EXPECT_EQ(c.getParticles()[4].getDirectNeighbours()[3].get(), c.getParticles()[7]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[4].getDirectNeighbours()[0]), c.getParticles()[3]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[4].getDirectNeighbours()[1]), c.getParticles()[5]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[4].getDirectNeighbours()[2]), c.getParticles()[1]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[4].getDirectNeighbours()[3]), c.getParticles()[7]);
 
-    EXPECT_EQ(c.getParticles()[4].getDiagonalNeighbours()[0].get(), c.getParticles()[6]);
-    EXPECT_EQ(c.getParticles()[4].getDiagonalNeighbours()[1].get(), c.getParticles()[0]);
-    EXPECT_EQ(c.getParticles()[4].getDiagonalNeighbours()[2].get(), c.getParticles()[8]);
-    EXPECT_EQ(c.getParticles()[4].getDiagonalNeighbours()[3].get(), c.getParticles()[2]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[4].getDiagonalNeighbours()[0]), c.getParticles()[6]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[4].getDiagonalNeighbours()[1]), c.getParticles()[0]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[4].getDiagonalNeighbours()[2]), c.getParticles()[8]);
+    EXPECT_EQ(c.getParticles().resolve(c.getParticles()[4].getDiagonalNeighbours()[3]), c.getParticles()[2]);
 }
 
 // Test the equality operator on two Cuboid objects.
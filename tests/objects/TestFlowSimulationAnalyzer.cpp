@@ -49,3 +49,54 @@ TEST_F(FlowSimulationAnalyzerTests, CalculateDensitiesAndVelocities) {
     EXPECT_EQ(a.getVelocities()[1], 0);
     EXPECT_EQ(a.getVelocities()[2], 4);
 }
+
+// Test that wall particles, inactive particles and particles outside the walls are ignored.
+TEST_F(FlowSimulationAnalyzerTests, IgnoreWallAndInactiveParticles) {
+    constexpr int binNumber = 3;
+    constexpr double leftWallPosX = 0;
+    constexpr double rightWallPosX = 6;
+    constexpr int n_analzer = 10;
+    pc.addParticle({1, 1, 1}, {0, 10, 0}, 1, 1); // wall particle
+    pc.addParticle({7, 1, 1}, {0, 10, 0}, 1);    // outside of the walls
+    pc.addParticle({-1, 1, 1}, {0, 10, 0}, 1);   // outside of the walls
+    pc.addParticle({3, 1, 1}, {0, 10, 0}, 1);
+    pc[pc.size() - 1].markInactive();
+    FlowSimulationAnalyzer a(pc, binNumber, leftWallPosX, rightWallPosX, n_analzer);
+
+    a.calculateDensitiesAndVelocities();
+
+    EXPECT_EQ(a.getDensities()[0], 3);
+    EXPECT_EQ(a.getDensities()[1], 1);
+    EXPECT_EQ(a.getDensities()[2], 1);
+
+    EXPECT_EQ(a.getVelocities()[0], 2);
+    EXPECT_EQ(a.getVelocities()[1], 0);
+    EXPECT_EQ(a.getVelocities()[2], 4);
+}
+
+// Test averaging densities and velocities over multiple samples.
+TEST_F(FlowSimulationAnalyzerTests, AccumulateSamples) {
+    constexpr int binNumber = 3;
+    constexpr double leftWallPosX = 0;
+    constexpr double rightWallPosX = 6;
+    constexpr int n_analzer = 10;
+    FlowSimulationAnalyzer a(pc, binNumber, leftWallPosX, rightWallPosX, n_analzer, "statistics", "MD_csv", true);
+
+    a.sample();
+    pc[4].setX({3, 5, 5});
+    pc[4].setV({4, 8, 4});
+    a.calculateDensitiesAndVelocities();
+
+    EXPECT_DOUBLE_EQ(a.getDensities()[0], 3);
+    EXPECT_DOUBLE_EQ(a.getDensities()[1], 1.5);
+    EXPECT_DOUBLE_EQ(a.getDensities()[2], 0.5);
+
+    EXPECT_DOUBLE_EQ(a.getVelocities()[0], 2);
+    EXPECT_DOUBLE_EQ(a.getVelocities()[1], 8.0 / 3);
+    EXPECT_DOUBLE_EQ(a.getVelocities()[2], 4);
+
+    // the running sums are reset after each computation
+    a.calculateDensitiesAndVelocities();
+    EXPECT_DOUBLE_EQ(a.getDensities()[1], 2);
+    EXPECT_DOUBLE_EQ(a.getDensities()[2], 0);
+}
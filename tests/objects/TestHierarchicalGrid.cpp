@@ -0,0 +1,131 @@
+#include "objects/CellContainer.h"
+#include "objects/HierarchicalGrid.h"
+#include "strategies/ForceCalculation.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+// Test that each particle is placed on the finest level whose cells are at least as large as its cutoff radius.
+TEST(HierarchicalGridTests, Levels) {
+    EXPECT_EQ(HierarchicalGrid::getLevel(8.0, 8.0), 0);
+    EXPECT_EQ(HierarchicalGrid::getLevel(5.0, 8.0), 0);
+    EXPECT_EQ(HierarchicalGrid::getLevel(4.0, 8.0), 1);
+    EXPECT_EQ(HierarchicalGrid::getLevel(2.5, 8.0), 1);
+    EXPECT_EQ(HierarchicalGrid::getLevel(2.0, 8.0), 2);
+    EXPECT_EQ(HierarchicalGrid::getLevel(1e-9, 8.0), HGRID_MAX_LEVELS - 1);
+
+    std::vector<GridEntry> entries;
+    ParticleHandle handle = 0;
+    for (int x = 0; x < 10; ++x) {
+        for (int y = 0; y < 10; ++y) {
+            const double cutoff = (x + y) % 7 == 0 ? 8.0 : 2.0;
+            entries.push_back({{1.0 * x, 1.0 * y, 0.0}, cutoff, handle++, false, false});
+        }
+    }
+    HierarchicalGrid grid;
+    grid.build(entries, 2, 8.0);
+    const auto &levels = grid.getLevels();
+    ASSERT_EQ(levels.size(), 3);
+    EXPECT_EQ(levels[0].cellSize, 8.0);
+    EXPECT_EQ(levels[2].cellSize, 2.0);
+    EXPECT_EQ(levels[1].begin, levels[1].end);
+
+    // the entries of each level are sorted by cell
+    for (size_t l = 0; l < levels.size(); ++l) {
+        for (std::uint32_t e = levels[l].begin; e < levels[l].end; ++e)
+            EXPECT_EQ(HierarchicalGrid::getLevel(grid.getEntries()[e].cutoff, 8.0), l);
+        for (size_t c = 0; c + 1 < levels[l].cellStart.size(); ++c)
+            EXPECT_LE(levels[l].cellStart[c], levels[l].cellStart[c + 1]);
+    }
+    EXPECT_EQ(levels[0].end - levels[0].begin + levels[2].end - levels[2].begin, entries.size());
+}
+
+// Test that the neighbouring cells of a position on each level contain all entries of that level within its cell size.
+TEST(HierarchicalGridTests, NeighborCells) {
+    std::vector<GridEntry> entries;
+    ParticleHandle handle = 0;
+    for (int i = 0; i < 300; ++i)
+        entries.push_back({{std::fmod(1.37 * i, 20.0), std::fmod(2.71 * i, 20.0), std::fmod(0.53 * i, 20.0)},
+                           i % 3 == 0 ? 4.0 : 1.0,
+                           handle++,
+                           false,
+                           false});
+    HierarchicalGrid grid;
+    grid.build(entries, 3, 4.0);
+    const auto &sorted = grid.getEntries();
+    const auto &levels = grid.getLevels();
+
+    for (const GridEntry &a : sorted) {
+        for (size_t l = 0; l < levels.size(); ++l) {
+            std::vector<bool> found(sorted.size(), false);
+            grid.forEachNeighborCell(l, a.x, [&](std::uint32_t begin, std::uint32_t end) {
+                for (std::uint32_t b = begin; b < end; ++b)
+                    found[b] = true;
+            });
+            for (std::uint32_t b = levels[l].begin; b < levels[l].end; ++b) {
+                double dist = 0.0;
+                for (size_t d = 0; d < 3; ++d)
+                    dist += (a.x[d] - sorted[b].x[d]) * (a.x[d] - sorted[b].x[d]);
+                if (dist <= levels[l].cellSize * levels[l].cellSize) {
+                    EXPECT_TRUE(found[b]);
+                }
+            }
+        }
+    }
+}
+
+// Test that the hierarchical grid kept between steps belongs to its cell container, i.e. that repeated force
+// calculations with per-pair cutoff radii on two differently sized containers both still match a direct sum.
+TEST(HierarchicalGridTests, SeparateContainers) {
+    const double factor = 2.5;
+    std::array<BoundaryCondition, 6> conditions;
+    conditions.fill(BoundaryCondition::REFLECTIVE);
+    // a few large particles in lattices of small ones, inside the domains which start after the halo cells
+    auto mixture = [](ParticleContainer &pc, int n) {
+        for (int x = 0; x < n; ++x)
+            for (int y = 0; y < n; ++y)
+                pc.addParticle(
+                    Particle{{8.5 + 0.9 * x + 0.1 * std::sin(x * y), 8.5 + 0.9 * y + 0.1 * std::cos(x + y), 0.0},
+                             {0., 0., 0.},
+                             1.,
+                             0,
+                             1.,
+                             (x % 5 == 2 && y % 5 == 2) ? 3.0 : 1.0});
+    };
+    ParticleContainer small, large;
+    mixture(small, 6);
+    mixture(large, 12);
+    CellContainer cc{{8.0, 8.0, 1.0}, conditions, factor * 3.0, small, 2, 1.0, factor};
+    CellContainer ccLarge{{15.0, 15.0, 1.0}, conditions, factor * 3.0, large, 2, 1.0, factor};
+
+    auto expectDirectSum = [&](ParticleContainer &pc, CellContainer &lc) {
+        for (Particle &p : pc)
+            p.setFToZero();
+        calculateF_LennardJones_LC_levels(pc, factor * 3.0, &lc);
+        for (const Particle &i : pc) {
+            std::array<double, 3> expected{0.0, 0.0, 0.0};
+            for (const Particle &j : pc) {
+                const double dx = i.getX()[0] - j.getX()[0], dy = i.getX()[1] - j.getX()[1];
+                const double dist = std::sqrt(dx * dx + dy * dy);
+                const double sigma = (i.getSigma() + j.getSigma()) / 2;
+                if (&i == &j || dist > factor * sigma)
+                    continue;
+                const double s6 = std::pow(sigma / dist, 6);
+                const double forceMag = 24 * i.getEpsilon() / (dist * dist) * s6 * (2 * s6 - 1);
+                expected[0] += forceMag * dx;
+                expected[1] += forceMag * dy;
+            }
+            for (size_t d = 0; d < 2; ++d)
+                EXPECT_NEAR(i.getF()[d], expected[d], 1e-9 * (1.0 + std::fabs(expected[d])));
+        }
+    };
+    // both containers are in use at the same time, like in simulations running side by side
+    std::thread other([&]() {
+        for (int round = 0; round < 20; ++round)
+            expectDirectSum(large, ccLarge);
+    });
+    for (int round = 0; round < 20; ++round)
+        expectDirectSum(small, cc);
+    other.join();
+}
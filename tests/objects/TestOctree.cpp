@@ -0,0 +1,152 @@
+#include "objects/CellContainer.h"
+#include "objects/Octree.h"
+#include "strategies/ForceCalculation.h"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+// helper function to create a dense droplet inside a dilute gas
+static std::vector<OctreeEntry> getDropletEntries() {
+    std::vector<OctreeEntry> entries;
+    ParticleHandle handle = 0;
+    for (int i = 0; i < 400; ++i) {
+        // droplet of radius 1 around (5, 5, 5)
+        const double r = std::cbrt((i % 97) / 97.0), phi = 0.7 * i, theta = 1.3 * i;
+        entries.push_back({{5 + r * std::sin(theta) * std::cos(phi), 5 + r * std::sin(theta) * std::sin(phi),
+                            5 + r * std::cos(theta)},
+                           handle++,
+                           false,
+                           false});
+    }
+    for (int i = 0; i < 50; ++i)
+        entries.push_back({{std::fmod(3.7 * i, 10.0), std::fmod(5.3 * i, 10.0), std::fmod(7.9 * i, 10.0)},
+                           handle++,
+                           false,
+                           false});
+    return entries;
+}
+
+// Test that every entry is in exactly one leaf, that leaves are small and that the boxes contain their entries.
+TEST(OctreeTests, Build) {
+    Octree tree;
+    tree.build(getDropletEntries(), 3);
+    const auto &entries = tree.getEntries();
+    const auto &nodes = tree.getNodes();
+    ASSERT_EQ(entries.size(), 450);
+
+    std::vector<int> count(entries.size(), 0);
+    size_t smallLeaves = 0;
+    for (std::uint32_t leaf : tree.getLeaves()) {
+        const OctreeNode &node = nodes[leaf];
+        EXPECT_EQ(node.numChildren, 0);
+        EXPECT_LE(node.end - node.begin, OCTREE_LEAF_CAPACITY);
+        for (std::uint32_t e = node.begin; e < node.end; ++e) {
+            ++count[entries[e].handle];
+            for (size_t d = 0; d < 3; ++d) {
+                EXPECT_LE(node.boxMin[d], entries[e].x[d]);
+                EXPECT_GE(node.boxMax[d], entries[e].x[d]);
+            }
+        }
+        // leaves inside the droplet are much smaller than the domain
+        if (node.boxMax[0] - node.boxMin[0] < 1.0)
+            ++smallLeaves;
+    }
+    for (int c : count)
+        EXPECT_EQ(c, 1);
+    EXPECT_GT(smallLeaves, 0);
+}
+
+// Test that the neighbour leaves of each leaf contain all entries within the cutoff radius.
+TEST(OctreeTests, NeighborLeaves) {
+    Octree tree;
+    tree.build(getDropletEntries(), 3);
+    const auto &entries = tree.getEntries();
+    const auto &nodes = tree.getNodes();
+    const double cutoff = 1.5;
+
+    std::vector<std::uint32_t> neighbors;
+    for (std::uint32_t leaf : tree.getLeaves()) {
+        tree.getNeighborLeaves(leaf, cutoff, neighbors);
+        EXPECT_NE(std::find(neighbors.begin(), neighbors.end(), leaf), neighbors.end());
+        std::vector<bool> found(entries.size(), false);
+        for (std::uint32_t n : neighbors)
+            for (std::uint32_t e = nodes[n].begin; e < nodes[n].end; ++e)
+                found[e] = true;
+
+        for (std::uint32_t a = nodes[leaf].begin; a < nodes[leaf].end; ++a) {
+            for (std::uint32_t b = 0; b < entries.size(); ++b) {
+                double dist = 0.0;
+                for (size_t d = 0; d < 3; ++d)
+                    dist += (entries[a].x[d] - entries[b].x[d]) * (entries[a].x[d] - entries[b].x[d]);
+                if (dist <= cutoff * cutoff) {
+                    EXPECT_TRUE(found[b]);
+                }
+            }
+        }
+    }
+}
+
+// Test that particles at identical positions end up in a single leaf instead of being split endlessly.
+TEST(OctreeTests, IdenticalPositions) {
+    std::vector<OctreeEntry> entries;
+    for (ParticleHandle h = 0; h < 3 * OCTREE_LEAF_CAPACITY; ++h)
+        entries.push_back({{1.0, 2.0, 0.0}, h, false, false});
+    Octree tree;
+    tree.build(entries, 2);
+    ASSERT_EQ(tree.getLeaves().size(), 1);
+    EXPECT_EQ(tree.getNodes()[tree.getLeaves()[0]].end, 3 * OCTREE_LEAF_CAPACITY);
+}
+
+// Test that the octree kept between steps belongs to its cell container, i.e. that repeated force calculations on
+// two differently sized containers both still match the linked cell force calculation.
+TEST(OctreeTests, SeparateContainers) {
+    std::array<BoundaryCondition, 6> conditions;
+    conditions.fill(BoundaryCondition::REFLECTIVE);
+    // perturbed lattices of different sizes, inside the domains which start after the halo cells
+    auto lattice = [](ParticleContainer &pc, int n) {
+        for (int x = 0; x < n; ++x)
+            for (int y = 0; y < n; ++y)
+                for (int z = 0; z < n; ++z)
+                    pc.addParticle(Particle{{2.5 + 1.1 * x + 0.05 * std::sin(x + 3 * y + z), 2.5 + 1.1 * y,
+                                             2.5 + 1.1 * z + 0.05 * std::cos(x * z)},
+                                            {0., 0., 0.},
+                                            1.,
+                                            z == 0 ? 1 : 0});
+    };
+    ParticleContainer small, large;
+    lattice(small, 3);
+    lattice(large, 8);
+    CellContainer cc{{6.0, 6.0, 6.0}, conditions, 2.0, small, 3};
+    CellContainer ccLarge{{12.0, 12.0, 12.0}, conditions, 2.0, large, 3};
+
+    auto forces = [](void (*f)(ParticleContainer &, double, CellContainer *), ParticleContainer &pc,
+                     CellContainer &lc) {
+        for (Particle &p : pc)
+            p.setFToZero();
+        f(pc, 2.0, &lc);
+        std::vector<std::array<double, 3>> result;
+        for (const Particle &p : pc)
+            result.push_back(p.getF());
+        return result;
+    };
+    auto expectForces = [](const std::vector<std::array<double, 3>> &actual,
+                           const std::vector<std::array<double, 3>> &expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            for (size_t d = 0; d < 3; ++d)
+                EXPECT_NEAR(actual[i][d], expected[i][d], 1e-9 * (1.0 + std::fabs(expected[i][d])));
+    };
+
+    const auto expected = forces(calculateF_LennardJones_LC, small, cc);
+    const auto expectedLarge = forces(calculateF_LennardJones_LC, large, ccLarge);
+    // both containers are in use at the same time, like in simulations running side by side
+    std::thread other([&]() {
+        for (int round = 0; round < 20; ++round)
+            expectForces(forces(calculateF_LennardJones_LC_tree, large, ccLarge), expectedLarge);
+    });
+    for (int round = 0; round < 20; ++round)
+        expectForces(forces(calculateF_LennardJones_LC_tree, small, cc), expected);
+    other.join();
+}
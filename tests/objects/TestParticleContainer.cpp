@@ -137,4 +137,40 @@ TEST(ParticleContainerTests, IteratePairNonEmpty) {
 
         ++index;
     }
-}
\ No newline at end of file
+}
+
+// Test that particle handles stay valid while the container grows past its reserved capacity.
+TEST(ParticleContainerTests, HandlesStableOnGrowth) {
+    ParticleContainer pc(1);
+    ParticleHandle first = pc.addParticle({1, 2, 3}, {0, 0, 0}, 1);
+    for (int i = 0; i < 100; ++i) {
+        pc.addParticle({0, 0, 0}, {0, 0, 0}, 2);
+    }
+
+    ASSERT_TRUE(pc.isValid(first));
+    EXPECT_EQ(pc.indexOf(first), 0);
+    EXPECT_EQ(pc.resolve(first).getHandle(), first);
+    EXPECT_EQ(pc.resolve(first).getX(), (std::array<double, 3>{1, 2, 3}));
+    EXPECT_FALSE(pc.isValid(101));
+}
+
+// Test removing inactive particles, which should keep the handles of the remaining particles valid.
+TEST(ParticleContainerTests, RemoveInactiveParticles) {
+    ParticleContainer pc;
+    ParticleHandle h0 = pc.addParticle({0, 0, 0}, {0, 0, 0}, 1);
+    ParticleHandle h1 = pc.addParticle({0, 0, 0}, {0, 0, 0}, 2);
+    ParticleHandle h2 = pc.addParticle({0, 0, 0}, {0, 0, 0}, 3);
+    pc.resolve(h1).markInactive();
+
+    pc.removeInactiveParticles();
+    ASSERT_EQ(pc.size(), 2);
+    EXPECT_FALSE(pc.isValid(h1));
+    EXPECT_EQ(pc.indexOf(h2), 1);
+    EXPECT_EQ(pc.resolve(h0).getM(), 1);
+    EXPECT_EQ(pc.resolve(h2).getM(), 3);
+
+    // new particles never reuse old handles
+    ParticleHandle h3 = pc.addParticle({0, 0, 0}, {0, 0, 0}, 4);
+    EXPECT_EQ(h3, 3);
+    EXPECT_EQ(pc.resolve(h3).getM(), 4);
+}
@@ -175,4 +175,30 @@ TEST_F(ThermostatTests, UpdateSystemWithThermalMotions) {
 
     constexpr std::array<double, 3> v1 = {2, 4, -2};
     EXPECT_EQ(pc.getParticles()[1].getV(), v1);
-}
\ No newline at end of file
+}
+
+// Test that applying precomputed sums yields the same result as the thermostat's own reduction.
+TEST_F(ThermostatTests, UpdateSystemWithPrecomputedSums) {
+    constexpr int dim = 2;
+    constexpr double T_init = 4;
+    constexpr int n_thermostat = 10;
+    constexpr double T_target = 9;
+    constexpr double delta_T = 12.0;
+    constexpr bool initBrownianMotion = false;
+    constexpr bool nanoFlow = true;
+    Thermostat t{pc, dim, T_init, n_thermostat, T_target, delta_T, initBrownianMotion, nanoFlow};
+
+    EXPECT_FALSE(t.isDue(0));
+    EXPECT_FALSE(t.isDue(5));
+    EXPECT_TRUE(t.isDue(100));
+
+    t.setKineticSums(t.calculateKineticSums());
+    t.updateSystemTemp(100);
+    EXPECT_DOUBLE_EQ(t.getTemp(), 1);
+
+    constexpr std::array<double, 3> v0 = {2, -2, 4};
+    EXPECT_EQ(pc.getParticles()[0].getV(), v0);
+
+    constexpr std::array<double, 3> v1 = {2, 4, -2};
+    EXPECT_EQ(pc.getParticles()[1].getV(), v1);
+}
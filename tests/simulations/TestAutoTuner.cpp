@@ -0,0 +1,158 @@
+#include "simulations/AutoTuner.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// helper function to create three distinct candidates
+static std::vector<TuningConfiguration> getTestCandidates() {
+    return {{ParallelizationType::COARSE, 1.0, omp_sched_static, 0},
+            {ParallelizationType::COARSE, 1.5, omp_sched_dynamic, 4},
+            {ParallelizationType::FINE, 2.0, omp_sched_static, 0}};
+}
+
+// helper function to measure each candidate once, with the given step time per candidate
+static void runTuningPhase(AutoTuner &tuner, int &iteration, const std::vector<std::int64_t> &times, double density) {
+    for (std::int64_t time : times) {
+        for (int i = 0; i < TUNING_SAMPLES; ++i)
+            tuner.addSample(iteration++, time, [density]() { return density; });
+    }
+}
+
+// Test that each candidate is measured in order and the fastest one is chosen afterwards.
+TEST(AutoTunerTests, ChoosesFastest) {
+    const auto candidates = getTestCandidates();
+    AutoTuner tuner{candidates, 0};
+    EXPECT_TRUE(tuner.isTuning());
+
+    int iteration = 0;
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        EXPECT_EQ(tuner.getConfiguration(), candidates[c]);
+        // a single outlier does not change the median
+        EXPECT_FALSE(tuner.addSample(iteration++, c == 1 ? 1000 : 300, []() { return 1.0; }));
+        EXPECT_FALSE(tuner.addSample(iteration++, c == 1 ? 100 : 300, []() { return 1.0; }));
+        const bool changed = tuner.addSample(iteration++, c == 1 ? 100 : 300, []() { return 1.0; });
+        // after the last candidate, the configuration switches back to the winner
+        EXPECT_TRUE(changed);
+    }
+    EXPECT_FALSE(tuner.isTuning());
+    EXPECT_EQ(tuner.getConfiguration(), candidates[1]);
+
+    // the winner is kept while nothing changes
+    for (int i = 0; i < 5 * TUNING_DENSITY_INTERVAL; ++i)
+        EXPECT_FALSE(tuner.addSample(iteration++, 1, []() { return 1.0; }));
+    EXPECT_FALSE(tuner.isTuning());
+}
+
+// Test that tuning is repeated periodically and when the density changes significantly.
+TEST(AutoTunerTests, Retuning) {
+    const auto candidates = getTestCandidates();
+    int iteration = 0;
+
+    // periodic
+    AutoTuner periodic{candidates, 50};
+    runTuningPhase(periodic, iteration, {300, 200, 100}, 1.0);
+    EXPECT_EQ(periodic.getConfiguration(), candidates[2]);
+    const int end = iteration - 1;
+    while (iteration < end + 50)
+        periodic.addSample(iteration++, 1, []() { return 1.0; });
+    EXPECT_FALSE(periodic.isTuning());
+    EXPECT_TRUE(periodic.addSample(iteration++, 1, []() { return 1.0; }));
+    EXPECT_TRUE(periodic.isTuning());
+    EXPECT_EQ(periodic.getConfiguration(), candidates[0]);
+
+    // density
+    iteration = 0;
+    AutoTuner density{candidates, 0};
+    runTuningPhase(density, iteration, {100, 200, 300}, 1.0);
+    EXPECT_EQ(density.getConfiguration(), candidates[0]);
+    for (int i = 0; i < 2 * TUNING_DENSITY_INTERVAL; ++i)
+        density.addSample(iteration++, 1, []() { return 1.1; });
+    EXPECT_FALSE(density.isTuning());
+    for (int i = 0; i < TUNING_DENSITY_INTERVAL && !density.isTuning(); ++i)
+        density.addSample(iteration++, 1, []() { return 0.5; });
+    EXPECT_TRUE(density.isTuning());
+}
+
+// Test that the winner is cached and used by the next run with the same key.
+TEST(AutoTunerTests, Cache) {
+    std::remove(TUNING_CACHE_FILE);
+    const auto candidates = getTestCandidates();
+    int iteration = 0;
+    {
+        AutoTuner other{candidates, 0, "other"};
+        runTuningPhase(other, iteration, {100, 200, 300}, 1.0);
+        AutoTuner tuner{candidates, 0, "key"};
+        runTuningPhase(tuner, iteration, {300, 100, 200}, 1.0);
+    }
+
+    AutoTuner cached{candidates, 0, "key"};
+    EXPECT_FALSE(cached.isTuning());
+    EXPECT_EQ(cached.getConfiguration(), candidates[1]);
+    AutoTuner otherCached{candidates, 0, "other"};
+    EXPECT_FALSE(otherCached.isTuning());
+    EXPECT_EQ(otherCached.getConfiguration(), candidates[0]);
+
+    // unknown keys and configurations which are no longer candidates are tuned again
+    EXPECT_TRUE((AutoTuner{candidates, 0, "unknown"}.isTuning()));
+    EXPECT_TRUE((AutoTuner{{candidates[0], candidates[2]}, 0, "key"}.isTuning()));
+    std::remove(TUNING_CACHE_FILE);
+}
+
+// Test that the cache key depends on the contents of the input file.
+TEST(AutoTunerTests, CacheKey) {
+    Arguments args;
+    args.inputFile = "testAutoTunerInput.xml";
+    std::ofstream(args.inputFile) << "<input>1</input>";
+    const std::string key = AutoTuner::getCacheKey(args);
+    EXPECT_FALSE(key.empty());
+    EXPECT_EQ(AutoTuner::getCacheKey(args), key);
+    std::ofstream(args.inputFile) << "<input>2</input>";
+    EXPECT_NE(AutoTuner::getCacheKey(args), key);
+    std::remove(args.inputFile.c_str());
+    EXPECT_EQ(AutoTuner::getCacheKey(args), "");
+}
+
+// Test that the cache key depends on the arguments overriding the input file, but not on unrelated ones.
+TEST(AutoTunerTests, CacheKeyArguments) {
+    Arguments args;
+    args.inputFile = "testAutoTunerInput.xml";
+    std::ofstream(args.inputFile) << "<input>1</input>";
+    const std::string key = AutoTuner::getCacheKey(args);
+
+    Arguments other = args;
+    other.pairSearch = PairSearchType::LEVELS;
+    EXPECT_NE(AutoTuner::getCacheKey(other), key);
+    other = args;
+    other.pairCutoffFactor = 2.0;
+    EXPECT_NE(AutoTuner::getCacheKey(other), key);
+    other = args;
+    other.cellSkin = 0.2;
+    EXPECT_NE(AutoTuner::getCacheKey(other), key);
+    other = args;
+    other.basename = "other";
+    other.endTime = 10;
+    EXPECT_EQ(AutoTuner::getCacheKey(other), key);
+    std::remove(args.inputFile.c_str());
+}
+
+// Test that only the cell size factor is tuned for pair searches which ignore the parallelization strategy.
+TEST(AutoTunerTests, CandidatesPairSearch) {
+    Arguments args;
+    args.pairSearch = PairSearchType::TREE;
+    const auto candidates = AutoTuner::getCandidates(args);
+    EXPECT_EQ(candidates.size(), 5);
+    for (const TuningConfiguration &c : candidates) {
+        EXPECT_EQ(c.parallelization, ParallelizationType::COARSE);
+        EXPECT_EQ(c.schedule, omp_sched_static);
+        EXPECT_EQ(c.chunk, 0);
+    }
+
+    args.pairSearch = PairSearchType::CELLS;
+#ifdef _OPENMP
+    EXPECT_EQ(AutoTuner::getCandidates(args).size(), 25);
+#else
+    EXPECT_EQ(AutoTuner::getCandidates(args).size(), 5);
+#endif
+}
@@ -426,3 +426,45 @@ TEST(BoundaryConditionTests, PeriodicMirroring3D) {
     // single boundary
     test({3.5, 2.5, 2.5}, {0., 0., 0.}, {3.5, 2.5, 2.5}, {0., 0., 0.}, 60); // X
 }
+
+// Test handling boundaries with two cells per cutoff radius, i.e. two halo and border layers.
+TEST(BoundaryConditionTests, SubCells2D) {
+    constexpr double delta_t = 0.05;
+    std::array<BoundaryCondition, 6> reflective{BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE,
+                                                BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE,
+                                                BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE};
+    std::array<BoundaryCondition, 6> periodic{BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC,
+                                              BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC,
+                                              BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC};
+
+    auto testMove = [&](const std::array<BoundaryCondition, 6> &conditions, const std::array<double, 3> &domain,
+                        const std::array<double, 3> &position, const std::array<double, 3> &velocity,
+                        const std::array<double, 3> &expectedPos, const std::array<double, 3> &expectedVel,
+                        int expectedIndex) {
+        ParticleContainer pc;
+        Particle p{position, velocity, 1, 0};
+        pc.addParticle(p);
+        CellContainer c{domain, conditions, 1., pc, 2, 0.5};
+        calculateX_LC(pc, delta_t, 0.0, &c);
+        EXPECT_EQ(c.activeSize(), 1);
+        EXPECT_EQ(pc[0].getX(), expectedPos);
+        EXPECT_EQ(pc[0].getV(), expectedVel);
+        EXPECT_EQ(pc[0].getCellIndex(), expectedIndex);
+    };
+    // reflected from the inner halo layer into the outer border layer
+    testMove(reflective, {10., 10., 1.}, {10.75, 10.75, 0}, {0., 10., 0.}, {10.75, 10.75, 0}, {0, -10., 0.}, 525);
+    testMove(reflective, {10., 10., 1.}, {1.25, 1.25, 0}, {0., -10., 0.}, {1.25, 1.25, 0}, {0, 10., 0.}, 50);
+    // moved across the domain
+    testMove(periodic, {5., 5., 1.}, {1.5, 5.5, 0}, {0., 10., 0.}, {1.5, 1.0, 0}, {0., 10., 0.}, 31);
+
+    // border particles are mirrored into both halo layers on the opposite sides
+    ParticleContainer pc;
+    pc.addParticle(Particle{{1.25, 5.75, 0}, {0., 0., 0.}, 1, 0});
+    CellContainer c{{5., 5., 1.}, periodic, 1., pc, 2, 0.5};
+    mirrorGhostParticles(&c);
+    EXPECT_EQ(c.getCells()[16].getParticles().size(), 1);  // south
+    EXPECT_EQ(c.getCells()[166].getParticles().size(), 1); // east
+    EXPECT_EQ(c.getCells()[26].getParticles().size(), 1);  // south east
+    deleteGhostParticles(&c);
+    EXPECT_EQ(c.getCells()[16].getParticles().size(), 0);
+}
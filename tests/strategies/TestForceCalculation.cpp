@@ -1,5 +1,8 @@
 #include "strategies/ForceCalculation.h"
+#include <algorithm>
+#include <cmath>
 #include <gtest/gtest.h>
+#include <vector>
 
 class ForceTests : public ::testing::Test {
   protected:
@@ -100,8 +103,8 @@ TEST_F(ForceTests, ForceMembrane) {
 
     pc3[0].setDirectNeighbours({});
     pc3[1].setDirectNeighbours({});
-    pc3[0].setDiagonalNeighbours({{pc3[1]}});
-    pc3[1].setDiagonalNeighbours({{pc3[0]}});
+    pc3[0].setDiagonalNeighbours({pc3[1].getHandle()});
+    pc3[1].setDiagonalNeighbours({pc3[0].getHandle()});
 
     calculateF_Membrane_LC(pc3, 0, &cc);
 
@@ -135,3 +138,254 @@ TEST_F(ForceTests, ForceMembrane) {
     EXPECT_EQ(pc3[0].getF(), force[6]);
     EXPECT_EQ(pc3[1].getF(), force[7]);
 }
+
+// Test that cells smaller than the cutoff radius yield the same forces as cells of the cutoff radius, including the
+// contributions of ghost particles across periodic boundaries.
+TEST(ForceSubCellTests, SubCellsMatchCells) {
+    const std::array<BoundaryCondition, 6> conditions{BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC,
+                                                      BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC,
+                                                      BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC};
+    for (size_t dim : {2, 3}) {
+        const std::array<double, 3> domain{7.5, 7.5, dim == 3 ? 7.5 : 1.0};
+        auto forces = [&](double cellSizeFactor) {
+            // slightly perturbed lattice filling the whole domain, which starts at the cutoff radius
+            ParticleContainer pc;
+            for (int x = 0; x < 6; ++x)
+                for (int y = 0; y < 6; ++y)
+                    for (int z = 0; z < (dim == 3 ? 6 : 1); ++z)
+                        pc.addParticle(Particle{{2.6 + 1.25 * x + 0.05 * std::sin(x + 3 * y + 7 * z),
+                                                 2.6 + 1.25 * y + 0.05 * std::cos(2 * x + y),
+                                                 dim == 3 ? 2.6 + 1.25 * z + 0.05 * std::sin(x * y + z) : 0.0},
+                                                {0., 0., 0.},
+                                                1.,
+                                                0,
+                                                1.,
+                                                1.});
+            CellContainer cc{domain, conditions, 2.5, pc, dim, cellSizeFactor};
+            calculateF_LennardJones_LC(pc, 2.5, &cc);
+            std::vector<std::array<double, 3>> f;
+            for (const Particle &p : pc)
+                f.push_back(p.getF());
+            return f;
+        };
+
+        const auto expected = forces(1.0);
+        for (double factor : {0.5, 1.0 / 3.0}) {
+            const auto actual = forces(factor);
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t i = 0; i < expected.size(); ++i)
+                for (size_t d = 0; d < 3; ++d)
+                    EXPECT_NEAR(actual[i][d], expected[i][d], 1e-9 * (1.0 + std::fabs(expected[i][d])));
+        }
+    }
+}
+
+// Test that static wall particles exert the same forces on the other particles as regular ones, but receive none.
+TEST(ForceStaticTests, WallsMatchRegularParticles) {
+    const std::array<BoundaryCondition, 6> periodic{BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC,
+                                                    BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC,
+                                                    BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC};
+    const std::array<BoundaryCondition, 6> reflective{BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE,
+                                                      BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE,
+                                                      BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE};
+    for (const auto &conditions : {periodic, reflective}) {
+        // the two lowest rows of a slightly perturbed lattice are walls, which lie in the periodic border cells
+        auto forces = [&](int wallType) {
+            ParticleContainer pc;
+            for (int x = 0; x < 6; ++x)
+                for (int y = 0; y < 6; ++y)
+                    pc.addParticle(Particle{{2.6 + 1.25 * x + 0.05 * std::sin(x + 3 * y),
+                                             2.6 + 1.25 * y + 0.05 * std::cos(2 * x + y), 0.0},
+                                            {0., 0., 0.},
+                                            1.,
+                                            y < 2 ? wallType : 0,
+                                            1.,
+                                            1.});
+            CellContainer cc{{7.5, 7.5, 1.0}, conditions, 2.5, pc, 2};
+            calculateF_LennardJones_LC(pc, 2.5, &cc);
+            std::vector<std::array<double, 3>> f;
+            for (const Particle &p : pc)
+                f.push_back(p.getF());
+            return f;
+        };
+
+        const auto expected = forces(0);
+        const auto actual = forces(1);
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            const bool wall = (i % 6) < 2;
+            for (size_t d = 0; d < 3; ++d)
+                EXPECT_NEAR(actual[i][d], wall ? 0.0 : expected[i][d], 1e-9 * (1.0 + std::fabs(expected[i][d])));
+        }
+    }
+}
+
+// helper function to check that a linked cell force calculation matches the regular one, including ghost and wall
+// particles as well as mixed parameters
+static void expectMatchesLinkedCells(void (*calculateF)(ParticleContainer &, double, CellContainer *)) {
+    const std::array<BoundaryCondition, 6> periodic{BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC,
+                                                    BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC,
+                                                    BoundaryCondition::PERIODIC, BoundaryCondition::PERIODIC};
+    const std::array<BoundaryCondition, 6> reflective{BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE,
+                                                      BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE,
+                                                      BoundaryCondition::REFLECTIVE, BoundaryCondition::REFLECTIVE};
+    for (size_t dim : {2, 3}) {
+        for (const auto &conditions : {periodic, reflective}) {
+            // a slightly perturbed lattice with a wall at the bottom and two kinds of particles
+            // note that the domain starts after the halo cells
+            auto forces = [&](void (*f)(ParticleContainer &, double, CellContainer *)) {
+                ParticleContainer pc;
+                const int nz = dim == 3 ? 5 : 1;
+                for (int x = 0; x < 5; ++x)
+                    for (int y = 0; y < 5; ++y)
+                        for (int z = 0; z < nz; ++z)
+                            pc.addParticle(Particle{{1.25 * x + 3.2 + 0.05 * std::sin(x + 3 * y + z),
+                                                     1.25 * y + 3.2 + 0.05 * std::cos(2 * x + y),
+                                                     dim == 3 ? 1.25 * z + 3.2 + 0.05 * std::sin(x * z) : 0.0},
+                                                    {0., 0., 0.},
+                                                    1.,
+                                                    y == 0 ? 1 : 0,
+                                                    (x + z) % 2 ? 1. : 2.,
+                                                    (x + y) % 2 ? 1. : 1.2});
+                CellContainer cc{{6.25, 6.25, dim == 3 ? 6.25 : 1.0}, conditions, 2.5, pc, dim};
+                f(pc, 2.5, &cc);
+                std::vector<std::array<double, 3>> result;
+                for (const Particle &p : pc)
+                    result.push_back(p.getF());
+                return result;
+            };
+
+            const auto expected = forces(calculateF_LennardJones_LC);
+            const auto actual = forces(calculateF);
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t i = 0; i < expected.size(); ++i)
+                for (size_t d = 0; d < 3; ++d)
+                    EXPECT_NEAR(actual[i][d], expected[i][d], 1e-9 * (1.0 + std::fabs(expected[i][d])));
+        }
+    }
+}
+
+// Test that the cluster pair force calculation matches the regular linked cell force calculation.
+TEST(ForceClusterTests, MatchesLinkedCells) { expectMatchesLinkedCells(calculateF_LennardJones_LC_cluster); }
+
+// Test that the octree force calculation matches the regular linked cell force calculation.
+TEST(ForceTreeTests, MatchesLinkedCells) { expectMatchesLinkedCells(calculateF_LennardJones_LC_tree); }
+
+// Test that the hierarchical grid force calculation matches the regular linked cell force calculation.
+TEST(ForceLevelsTests, MatchesLinkedCells) { expectMatchesLinkedCells(calculateF_LennardJones_LC_levels); }
+
+// Test that the hierarchical grid force calculation applies the cutoff radius of each pair in a mixture of small and
+// large particles, compared to a direct sum.
+TEST(ForceLevelsTests, PairCutoffs) {
+    const double factor = 2.5;
+    std::array<BoundaryCondition, 6> conditions;
+    conditions.fill(BoundaryCondition::REFLECTIVE);
+    // a few large particles in a lattice of small ones, inside the domain which starts after the halo cells
+    ParticleContainer pc;
+    for (int x = 0; x < 12; ++x)
+        for (int y = 0; y < 12; ++y)
+            pc.addParticle(Particle{{8.0 + 0.9 * x + 0.1 * std::sin(x * y), 8.0 + 0.9 * y + 0.1 * std::cos(x + y), 0.0},
+                                    {0., 0., 0.},
+                                    1.,
+                                    0,
+                                    1.,
+                                    (x % 5 == 2 && y % 5 == 2) ? 3.0 : 1.0});
+    CellContainer cc{{15.0, 15.0, 1.0}, conditions, factor * 3.0, pc, 2, 1.0, factor};
+    calculateF_LennardJones_LC_levels(pc, factor * 3.0, &cc);
+
+    for (const Particle &i : pc) {
+        std::array<double, 3> expected{0.0, 0.0, 0.0};
+        for (const Particle &j : pc) {
+            const double dx = i.getX()[0] - j.getX()[0], dy = i.getX()[1] - j.getX()[1];
+            const double dist = std::sqrt(dx * dx + dy * dy);
+            const double sigma = (i.getSigma() + j.getSigma()) / 2;
+            if (&i == &j || dist > factor * sigma)
+                continue;
+            const double s6 = std::pow(sigma / dist, 6);
+            const double forceMag = 24 * i.getEpsilon() / (dist * dist) * s6 * (2 * s6 - 1);
+            expected[0] += forceMag * dx;
+            expected[1] += forceMag * dy;
+        }
+        for (size_t d = 0; d < 2; ++d)
+            EXPECT_NEAR(i.getF()[d], expected[d], 1e-9 * (1.0 + std::fabs(expected[d])));
+    }
+}
+
+// Test that the sorted cell pairs of the linked cell force calculation find exactly the pairs within the cutoff radius
+// in an irregular 3D distribution, compared to a direct sum.
+TEST(ForceSortedTests, MatchesDirectSum) {
+    std::array<BoundaryCondition, 6> conditions;
+    conditions.fill(BoundaryCondition::REFLECTIVE);
+    // scattered particles inside the domain, which starts after the halo cells
+    ParticleContainer pc;
+    for (int n = 0; n < 200; ++n)
+        pc.addParticle(Particle{{2.6 + 4.9 * (1.0 + std::sin(1.3 * n)), 2.6 + 4.9 * (1.0 + std::sin(2.1 * n + 1.0)),
+                                 2.6 + 4.9 * (1.0 + std::sin(3.7 * n + 2.0))},
+                                {0., 0., 0.},
+                                1.,
+                                0,
+                                1.,
+                                0.8});
+    CellContainer cc{{10.0, 10.0, 10.0}, conditions, 2.5, pc, 3};
+    calculateF_LennardJones_LC(pc, 2.5, &cc);
+
+    for (const Particle &i : pc) {
+        std::array<double, 3> expected{0.0, 0.0, 0.0};
+        for (const Particle &j : pc) {
+            const std::array<double, 3> diff{i.getX()[0] - j.getX()[0], i.getX()[1] - j.getX()[1],
+                                             i.getX()[2] - j.getX()[2]};
+            const double dist = std::sqrt(diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2]);
+            if (&i == &j || dist > 2.5)
+                continue;
+            const double s6 = std::pow(0.8 / dist, 6);
+            const double forceMag = 24 / (dist * dist) * s6 * (2 * s6 - 1);
+            for (size_t d = 0; d < 3; ++d)
+                expected[d] += forceMag * diff[d];
+        }
+        for (size_t d = 0; d < 3; ++d)
+            EXPECT_NEAR(i.getF()[d], expected[d], 1e-9 * (1.0 + std::fabs(expected[d])));
+    }
+}
+
+// Test that the linked cell force calculation still finds all pairs within the cutoff radius if the particles moved up
+// to the skin outside of their cells, compared to a direct sum.
+TEST(ForceSkinTests, MatchesDirectSum) {
+    std::array<BoundaryCondition, 6> conditions;
+    conditions.fill(BoundaryCondition::REFLECTIVE);
+    ParticleContainer pc;
+    for (int n = 0; n < 200; ++n)
+        pc.addParticle(Particle{{2.6 + 4.9 * (1.0 + std::sin(1.3 * n)), 2.6 + 4.9 * (1.0 + std::sin(2.1 * n + 1.0)),
+                                 2.6 + 4.9 * (1.0 + std::sin(3.7 * n + 2.0))},
+                                {0., 0., 0.},
+                                1.,
+                                0,
+                                1.,
+                                0.8});
+    CellContainer cc{{10.0, 10.0, 10.0}, conditions, 2.5, pc, 3, 1.0, 0.0, 0.4};
+
+    // move the particles without sorting them into new cells, staying inside the domain
+    int n = 0;
+    for (Particle &p : pc) {
+        for (size_t d = 0; d < 3; ++d)
+            p.getX()[d] = std::clamp(p.getX()[d] + 0.39 * std::sin(5.0 * n + d), 2.51, 12.49);
+        ++n;
+    }
+    calculateF_LennardJones_LC(pc, 2.5, &cc);
+
+    for (const Particle &i : pc) {
+        std::array<double, 3> expected{0.0, 0.0, 0.0};
+        for (const Particle &j : pc) {
+            const std::array<double, 3> diff{i.getX()[0] - j.getX()[0], i.getX()[1] - j.getX()[1],
+                                             i.getX()[2] - j.getX()[2]};
+            const double dist = std::sqrt(diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2]);
+            if (&i == &j || dist > 2.5)
+                continue;
+            const double s6 = std::pow(0.8 / dist, 6);
+            const double forceMag = 24 / (dist * dist) * s6 * (2 * s6 - 1);
+            for (size_t d = 0; d < 3; ++d)
+                expected[d] += forceMag * diff[d];
+        }
+        for (size_t d = 0; d < 3; ++d)
+            EXPECT_NEAR(i.getF()[d], expected[d], 1e-9 * (1.0 + std::fabs(expected[d])));
+    }
+}
@@ -1,4 +1,5 @@
 #include "strategies/PositionCalculation.h"
+#include <cmath>
 #include <gtest/gtest.h>
 
 // Test calculating the new position of a particle.
@@ -11,4 +12,84 @@ TEST(PositionTests, UpdatePositions) {
     calculateX(pc, 0.5, 0.0);
 
     EXPECT_EQ(pc[0].getX(), xAfter);
-}
\ No newline at end of file
+}
+
+// Test that the linked cell position update specialized for a simulation without inactive and wall particles matches
+// the one supporting all particles, including particles changing their cells and being reflected.
+TEST(PositionTests, SpecializedMatchesGeneric) {
+    std::array<BoundaryCondition, 6> conditions;
+    conditions.fill(BoundaryCondition::REFLECTIVE);
+    auto positions = [&](bool specialized) {
+        ParticleContainer pc;
+        for (int i = 0; i < 10; ++i)
+            pc.addParticle({1.5 + i, 1.2 + 0.9 * i, 0.0}, {20. * std::sin(i), 20. * std::cos(i), 0.0}, 1. + 0.1 * i);
+        CellContainer c{{10., 10., 1.}, conditions, 1., pc, 2};
+        for (int step = 0; step < 5; ++step) {
+            if (specialized)
+                calculateX_LC_policy<StepPolicy<2, false, false, false>>(pc, 0.01, -12.44, &c);
+            else
+                calculateX_LC(pc, 0.01, -12.44, &c);
+        }
+        std::vector<std::array<double, 3>> x;
+        for (const Particle &p : pc) {
+            EXPECT_EQ(p.getCellIndex(), c.getCellIndex(p.getX()));
+            x.push_back(p.getX());
+        }
+        return x;
+    };
+    EXPECT_EQ(positions(true), positions(false));
+}
+
+// Test that particles are only moved to another cell once they are more than the skin outside of their cell, and that
+// they are still reflected as soon as they leave the domain.
+TEST(PositionTests, LazyRebinning) {
+    std::array<BoundaryCondition, 6> conditions;
+    conditions.fill(BoundaryCondition::REFLECTIVE);
+    ParticleContainer pc;
+    pc.addParticle({5.2, 3.0, 0.0}, {1.0, 0.0, 0.0}, 1.0);
+    pc.addParticle({11.95, 3.0, 0.0}, {1.0, 0.0, 0.0}, 1.0);
+    CellContainer c{{10., 10., 1.}, conditions, 2., pc, 2, 1.0, 0.0, 0.5};
+    const int first = pc[0].getCellIndex();
+
+    // the cell face lies at 16/3, so the first particle overshoots it by up to 0.4 within the first 6 steps
+    for (int step = 0; step < 6; ++step) {
+        calculateX_LC(pc, 0.1, 0.0, &c);
+        EXPECT_EQ(pc[0].getCellIndex(), first);
+    }
+    calculateX_LC(pc, 0.1, 0.0, &c);
+    EXPECT_EQ(pc[0].getCellIndex(), c.getCellIndex(pc[0].getX()));
+    EXPECT_NE(pc[0].getCellIndex(), first);
+
+    // the second particle left the domain ending at 12 and has been reflected back into it
+    EXPECT_LT(pc[1].getX()[0], 12.0);
+    EXPECT_EQ(pc[1].getCellIndex(), c.getCellIndex(pc[1].getX()));
+}
+
+// Test that a position update specialized for a simulation without outflow reports particles it deactivates, since it
+// does not skip them afterwards.
+TEST(PositionTests, ReportDeactivated) {
+    std::array<BoundaryCondition, 6> conditions;
+    conditions.fill(BoundaryCondition::REFLECTIVE);
+    ParticleContainer pc;
+    pc.addParticle({5.0, 5.0, 0.0}, {1.0, 0.0, 0.0}, 1.0);
+    CellContainer c{{10., 10., 1.}, conditions, 1., pc, 2};
+    calculateX_LC_policy<StepPolicy<2, false, false, false>>(pc, 0.1, 0.0, &c);
+    EXPECT_FALSE(c.getParticlesDeactivated());
+
+    // the particle jumps past the halo cells, which can only happen due to numerical errors
+    // it is removed from its old cell as well, so that the force calculation does not see it anymore
+    const int oldIdx = pc[0].getCellIndex();
+    pc[0].setV({1000.0, 0.0, 0.0});
+    calculateX_LC_policy<StepPolicy<2, false, false, false>>(pc, 0.1, 0.0, &c);
+    EXPECT_FALSE(pc[0].isActive());
+    EXPECT_EQ(pc[0].getCellIndex(), -1);
+    EXPECT_TRUE(c[oldIdx].isEmpty());
+    EXPECT_TRUE(c.getParticlesDeactivated());
+
+    // policies with outflow skip inactive particles anyway
+    pc.addParticle({5.0, 5.0, 0.0}, {1000.0, 0.0, 0.0}, 1.0);
+    CellContainer c2{{10., 10., 1.}, conditions, 1., pc, 2};
+    calculateX_LC_policy<StepPolicy<2, true, false, false>>(pc, 0.1, 0.0, &c2);
+    EXPECT_FALSE(pc[1].isActive());
+    EXPECT_FALSE(c2.getParticlesDeactivated());
+}
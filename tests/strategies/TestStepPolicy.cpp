@@ -0,0 +1,48 @@
+#include "strategies/StepPolicy.h"
+#include <gtest/gtest.h>
+#include <tuple>
+
+// Test detecting the features of a simulation from its arguments and particles.
+TEST(StepPolicyTests, DetectFeatures) {
+    Arguments args;
+    args.dimensions = 3;
+    args.conditions.fill(BoundaryCondition::REFLECTIVE);
+    ParticleContainer pc;
+    pc.addParticle({1., 1., 1.}, {0., 0., 0.}, 1.);
+    pc.addParticle({2., 1., 1.}, {0., 0., 0.}, 1.);
+
+    StepFeatures features = StepFeatures::detect(args, pc);
+    EXPECT_EQ(features.dim, 3);
+    EXPECT_FALSE(features.outflow);
+    EXPECT_FALSE(features.walls);
+    EXPECT_FALSE(features.membrane);
+
+    // a single outflow boundary suffices, but only with linked cells
+    args.conditions[2] = BoundaryCondition::OUTFLOW;
+    EXPECT_TRUE(StepFeatures::detect(args, pc).outflow);
+    args.linkedCells = false;
+    EXPECT_FALSE(StepFeatures::detect(args, pc).outflow);
+
+    // particles which are already inactive and wall particles
+    pc[1].markInactive();
+    EXPECT_TRUE(StepFeatures::detect(args, pc).outflow);
+    pc.addParticle({3., 1., 1.}, {0., 0., 0.}, 1., 1);
+    args.membrane = true;
+    features = StepFeatures::detect(args, pc);
+    EXPECT_TRUE(features.walls);
+    EXPECT_TRUE(features.membrane);
+}
+
+// Test that each combination of features is dispatched to the matching policy.
+TEST(StepPolicyTests, Dispatch) {
+    for (size_t dim : {2, 3}) {
+        for (int flags = 0; flags < 8; ++flags) {
+            const StepFeatures features{dim, (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0};
+            const auto result = dispatchStepPolicy(features, [](auto policy) {
+                using P = decltype(policy);
+                return std::make_tuple(P::DIM, P::OUTFLOW, P::WALLS, P::MEMBRANE);
+            });
+            EXPECT_EQ(result, std::make_tuple(features.dim, features.outflow, features.walls, features.membrane));
+        }
+    }
+}
@@ -18,4 +18,63 @@ TEST(VelocityTests, UpdateVelocity) {
     for (size_t i = 0; i < vAfter.size(); ++i) {
         EXPECT_NEAR(pc[0].getV()[i], vAfter[i], eps);
     }
-}
\ No newline at end of file
+}
+
+// Test that the fused velocity update produces the same velocities and thermostat sums as separate passes.
+TEST(VelocityTests, UpdateVelocityWithKineticSums) {
+    ParticleContainer pc(3);
+    pc.addParticle({0., 0., 0.}, {1., 2., 3.}, 2.);
+    pc.addParticle({1., 0., 0.}, {-1., 0., 1.}, 1.);
+    pc.addParticle({2., 0., 0.}, {3., 0., 0.}, 1., 1); // wall particle
+    for (auto &p : pc) {
+        p.setOldF({1., 1., 1.});
+        p.setF({2., 0., -2.});
+    }
+    ParticleContainer expected = pc;
+    calculateV(expected, 0.1);
+
+    KineticSums sums;
+    calculateV_Thermostat(pc, 0.1, sums);
+    for (size_t i = 0; i < pc.size(); ++i) {
+        EXPECT_EQ(pc[i].getV(), expected[i].getV());
+    }
+
+    Thermostat t{expected, 2, 1., 10, 1., 1., false, true};
+    const KineticSums reference = t.calculateKineticSums();
+    EXPECT_EQ(sums.mobileCount, 2);
+    EXPECT_EQ(sums.mobileCount, reference.mobileCount);
+    EXPECT_DOUBLE_EQ(sums.energy, reference.energy);
+    EXPECT_DOUBLE_EQ(sums.mobileEnergy, reference.mobileEnergy);
+    EXPECT_DOUBLE_EQ(sums.mass, reference.mass);
+    for (int d = 0; d < 3; ++d) {
+        EXPECT_DOUBLE_EQ(sums.velocity[d], reference.velocity[d]);
+        EXPECT_DOUBLE_EQ(sums.momentum[d], reference.momentum[d]);
+    }
+}
+
+// Test that the specialized fused velocity update matches the specialized velocity update and only moves in 2D.
+TEST(VelocityTests, UpdateVelocityWithKineticSumsPolicy) {
+    using Policy = StepPolicy<2, false, false, false>;
+    ParticleContainer pc(2);
+    pc.addParticle({0., 0., 0.}, {1., 2., 0.5}, 2.);
+    pc.addParticle({1., 0., 0.}, {-1., 0., 0.}, 1.);
+    for (auto &p : pc) {
+        p.setOldF({1., 1., 1.});
+        p.setF({2., 0., -2.});
+    }
+    ParticleContainer expected = pc;
+    calculateV_policy<Policy>(expected, 0.1);
+
+    KineticSums sums;
+    calculateV_Thermostat_policy<Policy>(pc, 0.1, sums);
+    for (size_t i = 0; i < pc.size(); ++i) {
+        EXPECT_EQ(pc[i].getV(), expected[i].getV());
+    }
+    EXPECT_EQ(pc[0].getV()[2], 0.5);
+
+    Thermostat t{expected, 2, 1., 10, 1., 1., false, true};
+    const KineticSums reference = t.calculateKineticSums();
+    EXPECT_EQ(sums.mobileCount, 2);
+    EXPECT_DOUBLE_EQ(sums.energy, reference.energy);
+    EXPECT_DOUBLE_EQ(sums.mass, reference.mass);
+}
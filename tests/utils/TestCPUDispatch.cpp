@@ -0,0 +1,12 @@
+#include "utils/CPUDispatch.h"
+#include <gtest/gtest.h>
+#include <string>
+
+// Test if the level of the selected kernels is reported.
+TEST(CPUDispatchTests, KernelLevel) {
+    const std::string level = CPUDispatch::getKernelLevel();
+    EXPECT_FALSE(level.empty());
+#if CPU_DISPATCH_ACTIVE
+    EXPECT_EQ(level.rfind("x86-64", 0), 0);
+#endif
+}
@@ -0,0 +1,166 @@
+#include "utils/OMPWrapper.h"
+#include "utils/PerfCounters.h"
+#include "utils/PhaseProfiler.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// helper function to read a whole file into a string
+static std::string readFile(const std::string &filename) {
+    std::ifstream file(filename);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+// helper function to split a csv file into its rows and columns
+static std::vector<std::vector<std::string>> readCSV(const std::string &filename) {
+    std::vector<std::vector<std::string>> rows;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::vector<std::string> row;
+        std::stringstream ss(line);
+        std::string cell;
+        while (std::getline(ss, cell, ','))
+            row.push_back(cell);
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+// Test that timed scopes are not recorded while profiling is disabled.
+TEST(PhaseProfilerTests, DisabledByDefault) {
+    EXPECT_FALSE(PhaseProfiler::isEnabled());
+    {
+        PROFILE_PHASE(Phase::FORCE);
+        PROFILE_ACCUMULATE(Phase::MIGRATION);
+    }
+    PhaseProfiler::endStep(0);
+    PhaseProfiler::stop();
+    EXPECT_FALSE(PhaseProfiler::isEnabled());
+}
+
+// Test that the CSV summary contains the wall-clock and per-thread times of each step.
+TEST(PhaseProfilerTests, WritesStepSummary) {
+    const std::string basename = "testPhaseProfiler";
+    ASSERT_TRUE(PhaseProfiler::start(basename));
+    ASSERT_TRUE(PhaseProfiler::isEnabled());
+    const int threads = omp_get_max_threads();
+
+    for (int step = 0; step < 2; ++step) {
+        {
+            PROFILE_PHASE(Phase::FORCE);
+#pragma omp parallel
+            {
+                PROFILE_THREAD(Phase::FORCE);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        {
+            PROFILE_ACCUMULATE(Phase::MIGRATION);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        PhaseProfiler::endStep(step);
+    }
+    PhaseProfiler::stop();
+    EXPECT_FALSE(PhaseProfiler::isEnabled());
+
+    const auto rows = readCSV(basename + "_phases.csv");
+    ASSERT_EQ(rows.size(), 1 + 2 * static_cast<size_t>(1 + threads));
+    const std::vector<std::string> header = {"step",  "thread",   "position",   "migration", "boundary", "ghosts",
+                                             "force", "velocity", "thermostat", "analyzer",  "output"};
+    EXPECT_EQ(rows[0], header);
+
+    for (int step = 0; step < 2; ++step) {
+        const auto &wall = rows[1 + step * (1 + threads)];
+        EXPECT_EQ(wall[0], std::to_string(step));
+        EXPECT_EQ(wall[1], "all");
+        EXPECT_GE(std::stod(wall[6]), 1000.0); // force
+        EXPECT_EQ(std::stod(wall[2]), 0.0);    // position
+        EXPECT_EQ(std::stod(wall[3]), 0.0);    // migration is only measured per thread
+
+        for (int t = 0; t < threads; ++t) {
+            const auto &row = rows[2 + step * (1 + threads) + t];
+            EXPECT_EQ(row[1], std::to_string(t));
+            EXPECT_GE(std::stod(row[6]), 1000.0);
+            EXPECT_LE(std::stod(row[6]), std::stod(wall[6]));
+        }
+        EXPECT_GE(std::stod(rows[2 + step * (1 + threads)][3]), 1000.0);
+    }
+
+    const std::string trace = readFile(basename + "_trace.json");
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+    EXPECT_NE(trace.find("\"name\":\"force\",\"cat\":\"step\",\"ph\":\"X\",\"pid\":0,\"tid\":0"), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"force\",\"cat\":\"thread\",\"ph\":\"X\",\"pid\":0,\"tid\":1"), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"migration\",\"ph\":\"C\""), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+
+    std::remove((basename + "_phases.csv").c_str());
+    std::remove((basename + "_trace.json").c_str());
+}
+
+// Test that profiling stays disabled if the output files cannot be opened.
+TEST(PhaseProfilerTests, InvalidBasename) {
+    EXPECT_FALSE(PhaseProfiler::start("nonexistent/directory/file"));
+    EXPECT_FALSE(PhaseProfiler::isEnabled());
+}
+
+// Test that the hardware counters of the calling thread increase while doing work.
+TEST(PhaseProfilerTests, HardwareCounters) {
+    PerfCounters counters;
+    if (!counters.open())
+        GTEST_SKIP() << "Hardware counters are unavailable on this system.";
+
+    const CounterValues before = counters.read();
+    volatile double sum = 0.0;
+    for (int i = 0; i < 1000000; ++i)
+        sum = sum + i * 0.5;
+    const CounterValues after = counters.read();
+
+    EXPECT_GT(after[static_cast<size_t>(Counter::CYCLES)], before[static_cast<size_t>(Counter::CYCLES)]);
+    const auto instructions = static_cast<size_t>(Counter::INSTRUCTIONS);
+    if (counters.isAvailable(Counter::INSTRUCTIONS)) {
+        EXPECT_GE(after[instructions] - before[instructions], 1000000u);
+    }
+    counters.close();
+    EXPECT_FALSE(counters.isOpen());
+    EXPECT_EQ(counters.read(), CounterValues{});
+}
+
+// Test that profiling continues with or without hardware counters.
+TEST(PhaseProfilerTests, CountersAndPairs) {
+    const std::string basename = "testPhaseProfilerCounters";
+    ASSERT_TRUE(PhaseProfiler::start(basename, true));
+    {
+        PROFILE_PHASE(Phase::FORCE);
+#pragma omp parallel
+        {
+            PROFILE_THREAD(Phase::FORCE);
+            PhaseProfiler::countPairs(10);
+        }
+    }
+    PhaseProfiler::endStep(0, 100);
+    const bool counters = PhaseProfiler::countersEnabled();
+    PhaseProfiler::stop();
+    EXPECT_FALSE(PhaseProfiler::countersEnabled());
+
+    const std::string trace = readFile(basename + "_trace.json");
+    EXPECT_EQ(trace.find("\"cycles\":") != std::string::npos, counters);
+    if (counters) {
+        const auto rows = readCSV(basename + "_counters.csv");
+        ASSERT_EQ(rows.size(), 2);
+        EXPECT_EQ(rows[0], (std::vector<std::string>{"step", "phase", "cycles", "instructions", "llc_misses",
+                                                     "fp_vector_ops", "ipc"}));
+        EXPECT_EQ(rows[1][1], "force");
+        EXPECT_GT(std::stoull(rows[1][2]), 0u);
+    }
+
+    std::remove((basename + "_phases.csv").c_str());
+    std::remove((basename + "_trace.json").c_str());
+    std::remove((basename + "_counters.csv").c_str());
+}
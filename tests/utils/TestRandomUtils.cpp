@@ -0,0 +1,73 @@
+#include "objects/Cuboid.h"
+#include "objects/ParticleContainer.h"
+#include "utils/MaxwellBoltzmannDistribution.h"
+#include "utils/RandomUtils.h"
+#include <array>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Test the generator against the known answers of the Random123 reference implementation.
+TEST(RandomUtilsTests, PhiloxKnownAnswers) {
+    EXPECT_EQ(RandomUtils::philox4x32({0, 0, 0, 0}, {0, 0}),
+              (RandomUtils::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(RandomUtils::philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+              (RandomUtils::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    EXPECT_EQ(RandomUtils::philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+              (RandomUtils::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+// Test that velocities only depend on seed, particle and stream.
+TEST(RandomUtilsTests, VelocityIsCounterBased) {
+    const auto v = maxwellBoltzmannDistributedVelocity(1.0, 3, 7, RandomStream::INITIAL_VELOCITY);
+    maxwellBoltzmannDistributedVelocity(1.0, 3, 8, RandomStream::INITIAL_VELOCITY);
+    EXPECT_EQ(maxwellBoltzmannDistributedVelocity(1.0, 3, 7, RandomStream::INITIAL_VELOCITY), v);
+    EXPECT_NE(maxwellBoltzmannDistributedVelocity(1.0, 3, 8, RandomStream::INITIAL_VELOCITY), v);
+    EXPECT_NE(maxwellBoltzmannDistributedVelocity(1.0, 3, 7, RandomStream::BROWNIAN_MOTION), v);
+    EXPECT_NE(maxwellBoltzmannDistributedVelocity(1.0, 3, 7, RandomStream::INITIAL_VELOCITY, 43), v);
+    EXPECT_EQ(maxwellBoltzmannDistributedVelocity(1.0, 2, 7, RandomStream::INITIAL_VELOCITY)[2], 0.0);
+}
+
+// Test that the generated velocities are standard normally distributed.
+TEST(RandomUtilsTests, VelocityDistribution) {
+    constexpr size_t n = 100000;
+    std::array<double, 3> mean{}, variance{};
+    for (size_t i = 0; i < n; ++i) {
+        const auto v = maxwellBoltzmannDistributedVelocity(1.0, 3, i, RandomStream::INITIAL_VELOCITY);
+        for (size_t d = 0; d < 3; ++d) {
+            mean[d] += v[d] / n;
+            variance[d] += v[d] * v[d] / n;
+        }
+    }
+    for (size_t d = 0; d < 3; ++d) {
+        EXPECT_NEAR(mean[d], 0.0, 0.02);
+        EXPECT_NEAR(variance[d], 1.0, 0.02);
+    }
+}
+
+// Test that parallel generation is reproducible and independent of the number of threads.
+TEST(RandomUtilsTests, CuboidGenerationIsReproducible) {
+    auto generate = [](int threads) {
+        ParticleContainer pc;
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+        Cuboid c{pc, {0., 0., 0.}, {20, 10, 5}, {1., 0., 0.}, 1.1, 1.0, 0, 1, 1};
+        c.initialize(3);
+        std::vector<std::array<double, 3>> velocities;
+        for (const auto &p : pc)
+            velocities.push_back(p.getV());
+        return std::make_pair(velocities, pc[999].getX());
+    };
+    const auto single = generate(1);
+    const auto multi = generate(4);
+#ifdef _OPENMP
+    omp_set_num_threads(omp_get_num_procs());
+#endif
+    ASSERT_EQ(single.first.size(), 1000);
+    EXPECT_EQ(single.first, multi.first);
+    EXPECT_EQ(single.second, (std::array<double, 3>{19 * 1.1, 9 * 1.1, 4 * 1.1}));
+    EXPECT_NE(single.first[0], single.first[1]);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file TrajConvert.cpp
+ * @brief Offline converter from binary trajectory (.traj) files to VTK or XYZ output.
+ * @date 2025-02-05
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "io/input/TrajectoryReader.h"
+#include "io/output/Frame.h"
+#include "io/output/WriterFactory.h"
+#include "utils/Arguments.h"
+#include "utils/CLIUtils.h"
+#include "utils/StringUtils.h"
+#include <getopt.h>
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <string>
+
+// prints a help string explaining the functionality of the converter
+static void printConverterHelp(const char *filename) {
+    std::cout << "Converts frames of a binary trajectory file generated by MolSim to VTK or XYZ files.\n"
+              << BOLD_ON << "USAGE" << BOLD_OFF << ": " << filename << " [options] <filename>\n\n"
+              << BOLD_ON << "OPTIONS" << BOLD_OFF
+              << ":\n"
+                 "-o <type>    : Sets the output file type and directory (default: vtkb).\n"
+                 "  - vtk      : Generates VTK Unstructured Grid (.vtu) files.\n"
+                 "  - vtkb     : Generates VTK Unstructured Grid (.vtu) files with raw binary appended data.\n"
+                 "  - xyz      : Generates XYZ (.xyz) files.\n"
+                 "-b <name>    : Sets the base name of the generated files (default: MD_vtk).\n"
+                 "-r <a:b>     : Converts only the frames with indices from a up to and including b (default: all).\n"
+                 "-P <bits>    : Sets the floating point precision of binary VTK output, either 32 or 64 (default: 32).\n"
+                 "-z           : Compresses binary VTK output using zlib, if available.\n"
+                 "-h           : Prints out a help message.\n";
+}
+
+int main(int argc, char *argv[]) {
+    WriterType type = WriterType::VTKB;
+    std::string basename = "MD_vtk";
+    bool doublePrecision = false, compress = false;
+    long first = 0, last = -1;
+    int ch;
+    CLIUtils::filename = argv[0];
+    opterr = 0;
+
+    while ((ch = getopt(argc, argv, "o:b:r:P:zh")) != -1) {
+        switch (ch) {
+        case 'o':
+            type = StringUtils::toWriterType(optarg);
+            if (type == WriterType::TRAJ || type == WriterType::NIL)
+                CLIUtils::error("Unsupported output type for conversion", optarg);
+            break;
+        case 'b':
+            basename = optarg;
+            break;
+        case 'r': {
+            const std::string range{optarg};
+            const size_t sep = range.find(':');
+            if (sep == std::string::npos)
+                CLIUtils::error("Invalid frame range", range);
+            first = StringUtils::toInt(range.substr(0, sep));
+            last = StringUtils::toInt(range.substr(sep + 1));
+            break;
+        }
+        case 'P': {
+            const int bits = StringUtils::toInt(optarg);
+            if (bits != 32 && bits != 64)
+                CLIUtils::error("Output precision must be either 32 or 64!", optarg);
+            doublePrecision = bits == 64;
+            break;
+        }
+        case 'z':
+            compress = true;
+            break;
+        case 'h':
+            printConverterHelp(argv[0]);
+            return EXIT_SUCCESS;
+        default:
+            CLIUtils::error("Invalid option or missing argument", StringUtils::fromChar(optopt));
+        }
+    }
+    if (optind != argc - 1)
+        CLIUtils::error("Invalid syntax - no trajectory file provided!");
+
+    TrajectoryReader reader{argv[optind]};
+    if (reader.frameCount() == 0)
+        CLIUtils::error("Trajectory file contains no frames", argv[optind], false);
+    if (last < 0 || last >= static_cast<long>(reader.frameCount()))
+        last = static_cast<long>(reader.frameCount()) - 1;
+    if (first < 0 || first > last)
+        CLIUtils::error("Invalid frame range", std::to_string(first) + ":" + std::to_string(last), false);
+
+    // convert the chosen frames sequentially, decoding each frame on top of the previous one
+    auto writer = WriterFactory::createWriter(type, basename, 0, doublePrecision, compress);
+    reader.readFrames(static_cast<size_t>(first), static_cast<size_t>(last),
+                      [&writer](const Frame &frame) { writer->writeFrame(frame); });
+    SPDLOG_INFO("Converted {} frames.", last - first + 1);
+}